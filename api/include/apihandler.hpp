@@ -155,9 +155,6 @@ public:
     bool isBDLoaded() { return isBDLoaded_; }
     
 private:
-#ifdef USE_DEPRECATED_STATS
-    ::csstats::AllStats stats_;
-#endif // 0
     cs::Executor& executor_;
     cs::DumbCv dumbCv_;
 
@@ -288,7 +285,6 @@ private:
 private slots:
     void updateSmartCachesPool(const csdb::Pool& pool);
     void store_block_slot(const csdb::Pool& pool);
-    void collect_all_stats_slot(const csdb::Pool& pool);
     void baseLoaded(const csdb::Pool& pool);
     void maxBlocksCount(cs::Sequence lastBlockNum);
 };
@@ -23,6 +23,8 @@
 #include <memory>
 #include <thread>
 
+#include <metricsprocessor.hpp>
+
 #ifdef PROFILE_API
 #include <profiler/profilerprocessor.hpp>
 #include <profiler/profilereventhandler.hpp>
@@ -37,7 +39,7 @@ public:
 #ifdef PROFILE_API
     using ApiProcessor = cs::ProfilerProcessor;
 #else
-    using ApiProcessor = ::api::APIProcessor;
+    using ApiProcessor = cs::MetricsProcessor;
 #endif
 
     explicit connector(BlockChain& m_blockchain, cs::SolverCore* solver);
@@ -49,9 +51,6 @@ public:
     void onReadFromDB(csdb::Pool pool, bool* should_stop) {
         if (!*should_stop) {
             api_handler->updateSmartCachesPool(pool);
-#ifdef MONITOR_NODE
-            api_handler->collect_all_stats_slot(pool);
-#endif
             api_handler->baseLoaded(pool);
         }
     }
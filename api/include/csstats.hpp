@@ -1,19 +1,17 @@
 #ifndef CSSTATS_HPP
 #define CSSTATS_HPP
 
-#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <csnode/blockchain.hpp>
 #include <cstdint>
-#include <deque>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
-#define NO_STATS_TEST
-#define NO_FAST_UPDATE
-#define LOG_STATS_TO_FILE
-
 namespace csstats {
 
 using period_t = std::chrono::seconds::rep;
@@ -53,8 +51,6 @@ struct PeriodStats {
 };
 
 using StatsPerPeriod = std::vector<PeriodStats>;
-using StatsCut = std::deque<PeriodStats>;
-using AllStats = std::pair<StatsCut, StatsPerPeriod>;
 
 enum PeriodIndex {
     Day = 0,
@@ -65,46 +61,84 @@ enum PeriodIndex {
     PeriodsCount
 };
 
-#ifdef NO_FAST_UPDATE
-const uint32_t updateTimeSec = 3;
-#else
-const uint32_t updateTimeSec = 30;
-#endif
 const uint32_t secondsPerDay = 24 * 60 * 60;
 const Periods collectionPeriods = {secondsPerDay, secondsPerDay * 7, secondsPerDay * 30, secondsPerDay * 365 * 100};
 
+// blocks are rolled up by minutes of their time for the longest period except total
+const uint32_t secondsPerBucket = 60;
+const size_t bucketsCount = secondsPerDay * 30 / secondsPerBucket;
+
+// changed rollups are saved not more often
+const uint32_t saveIntervalSec = 60;
+
+///
+/// Transactions statistics of periods up to now.
+///
+/// Every block is folded once, when it is read from database or stored, into a ring of
+/// per minute buckets by block time, so stats of period is a sum of its buckets. Rollups
+/// are saved to file with hash of the last folded block and blocks folded before restart are
+/// skipped while database is read. Rollups are rebuilt if database ends before that block or
+/// has other block in its place.
+///
 class csstats {
 public:
-    csstats(BlockChain& blockchain);
+    explicit csstats(BlockChain& blockchain);
 
     StatsPerPeriod getStats();
 
     ~csstats();
 
-	void run(const ::csstats::AllStats& allStats);
+    // starts periodic saving of rollups
+    void run();
+
+public slots:
+    void onStartReadBlocks(cs::Sequence lastWrittenSequence);
+    void onReadBlock(const csdb::Pool& block, bool* shouldStop);
+    void onStoreBlock(const csdb::Pool& block);
+    void onRemoveBlock(const csdb::Pool& block);
 
 private:
-    std::thread thread;
+    struct Bucket {
+        int64_t minute = -1;    // since epoch, -1 if bucket is empty
+        Count poolsCount = 0;
+        Count transactionsCount = 0;
+        Count smartContractsCount = 0;
+        Count transactionsSmartCount = 0;
+        std::vector<std::pair<Currency, TotalAmount>> balancePerCurrency;
+    };
 
-    std::mutex mutex;
-    using ScopedLock = std::lock_guard<std::mutex>;
-    std::atomic<bool> quit = {false};
+    // adds block to rollups with sign 1 or removes it with sign -1
+    void fold(const csdb::Pool& block, int sign);
+
+    bool isFolded(const csdb::Pool& block);
 
-    StatsPerPeriod currentStats;
-    StatsCut statsCut;
+    // drops rollups and folds blocks of chain before sequence again
+    void rebuild(cs::Sequence sequence);
+    void reset();
 
-    std::mutex currentStatsMutex;
-    std::chrono::system_clock::time_point lastUpdateTime = std::chrono::system_clock::from_time_t(0);
+    static void add(Bucket& bucket, const Bucket& delta, int sign);
+    static void add(PeriodStats& stats, const Bucket& bucket, int sign);
+
+    bool load();
+    void save();
 
     BlockChain& blockchain;
 
-    StatsPerPeriod collectStats(const Periods& periods);
-    //AllStats collectAllStats(const Periods& periods);
+    std::thread thread;
+    std::condition_variable condition;
+    bool quit = false;
+
+    // guards rollups
+    std::mutex mutex;
+    using ScopedLock = std::lock_guard<std::mutex>;
 
-    template <class F>
-    void matchPeriod(const Periods& periods, period_t period, F func);
+    std::vector<Bucket> buckets;
+    PeriodStats total;
 
-    std::map<std::string, Currency> currencies_indexed = {{"CS", (Currency)1}};
+    // the last folded block, blocks are folded in order
+    cs::Sequence lastSequence = cs::kWrongSequence;
+    csdb::PoolHash lastHash;
+    bool changed = false;
 };
 }  // namespace csstats
 
@@ -19,6 +19,7 @@
 #endif
 
 #include <any>
+#include <list>
 #include <memory>
 #include <optional>
 
@@ -27,10 +28,14 @@
 #include <lib/system/reference.hpp>
 
 #include <csnode/blockchain.hpp>
+#include <csnode/contractstatestore.hpp>
 
 #include <csdb/currency.hpp>
 
 #include "executormanager.hpp"
+#include "gettercache.hpp"
+#include "executorpool.hpp"
+#include "speculations.hpp"
 
 class BlockChain;
 
@@ -122,6 +127,8 @@ public:
         general::AccessID acceessId;
         // measured execution duration in milliseconds
         long long timeExecute;
+        // speculative execution made callbacks to node
+        bool isCalledBack = false;
     };
 
     // Pass kUseLastSequence to executeByteCode...() to use current last sequence automatically
@@ -144,15 +151,36 @@ public:
     bool isConnected() const;
     void stop();
 
+    // latency of executor calls by lane
+    LatencyHistogram::Snapshot latency(ExecutorLane lane) const;
+
+    using GetterCacheStatistics = GetterCache<executor::ExecuteByteCodeResult>::Statistics;
+    GetterCacheStatistics getterCacheStatistics() const;
+
+    struct SpeculationStatistics {
+        size_t started = 0;     // calls executed before their blocks
+        size_t dropped = 0;     // calls not executed as all speculative slots were busy
+        size_t hits = 0;        // scheduled calls answered by speculative result
+        size_t misses = 0;      // scheduled calls speculated against other inputs
+        LatencyHistogram::Snapshot saved;   // execution time saved by hits
+    };
+
+    SpeculationStatistics speculationStatistics() const;
+
     std::optional<cs::Sequence> getSequence(const general::AccessID& accessId);
     std::optional<csdb::TransactionID> getDeployTrxn(const csdb::Address& address);
 
+    // executor calls node back while executing, results of speculative executions that did are not reused,
+    // callback without access id is counted to all speculative executions in flight
+    void onCallback(const general::AccessID& accessId);
+    void onCallback();
+
     void updateDeployTrxns(const csdb::Address& address, const csdb::TransactionID& trxnsId);
     void setLastState(const csdb::Address& address, const std::string& state);
 
     std::optional<std::string> getState(const csdb::Address& address);
 
-    void updateCacheLastStates(const csdb::Address& address, const cs::Sequence& sequence, const std::string& state);
+    // state of contract actual at sequence of access, the last one if it is not indexed
     std::optional<std::string> getAccessState(const general::AccessID& accessId, const csdb::Address& address);
 
     void addInnerSendTransaction(const general::AccessID& accessId, const csdb::Transaction& transaction);
@@ -175,6 +203,10 @@ public:
     std::optional<ExecuteResult> executeTransaction(const std::vector<ExecuteTransactionInfo>& smarts, std::string forceContractState);
     std::optional<ExecuteResult> reexecuteContract(ExecuteTransactionInfo& contract, std::string forceContractState);
 
+    // executes contract call of not yet included transaction in background against the latest state,
+    // executeTransaction() of the same call reuses the result if state and all other inputs are the same
+    void speculate(const ExecuteTransactionInfo& smart);
+
     csdb::Transaction makeTransaction(const api::Transaction& transaction);
 
     void stateUpdate(const csdb::Pool& pool);
@@ -222,37 +254,77 @@ private:
     uint64_t getFutureAccessId();
     void deleteAccessId(const general::AccessID& accessId);
 
-    // explicit sequence sets the sequence for accessId attached to execution
+    // explicit sequence sets the sequence for accessId attached to execution, lane is used by not getters
     std::optional<OriginExecuteResult> execute(const std::string& address, const executor::SmartContractBinary& smartContractBinary,
-        std::vector<executor::MethodHeader>& methodHeader, bool isGetter, cs::Sequence explicitSequence);
+        std::vector<executor::MethodHeader>& methodHeader, bool isGetter, cs::Sequence explicitSequence,
+        ExecutorLane lane = ExecutorLane::Consensus);
+
+    // executor call made of transactions of executeTransaction()
+    struct Invocation {
+        std::string source;
+        executor::SmartContractBinary binary;
+        std::vector<executor::MethodHeader> headers;
+        std::vector<general::Address> usedContracts;
+        bool isDeploy = false;
+    };
+
+    std::optional<Invocation> makeInvocation(const std::vector<ExecuteTransactionInfo>& smarts, const std::string& forceContractState);
+
+    // executes call, takes result of its speculative execution if there was one with the same inputs
+    std::optional<OriginExecuteResult> executeSpeculated(const ExecuteTransactionInfo& smart, Invocation& invocation);
+
+    // state of contract set by new state transaction
+    std::optional<std::string> loadAccessState(const csdb::Address& address, const csdb::TransactionID& id);
 
     bool connect();
     void disconnect();
-    void notifyError();
 
-    using OriginExecutor = executor::ContractExecutorConcurrentClient;
-    using BinaryProtocol = apache::thrift::protocol::TBinaryProtocol;
+    // wakes up watcher thread to check connection and executor process
+    void notifyError();
 
-    void recreateOriginExecutor();
+    static ExecutorConnectionPool::Settings connectionPoolSettings();
+    static ContractStateStore::Settings statesSettings();
 
 private:
     const BlockChain& blockchain_;
     const cs::SolverCore& solver_;
 
-    ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::transport::TSocket> socket_;
-    ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::transport::TTransport> executorTransport_;
+    ExecutorConnectionPool connections_;
+
+    // results of getters by contract, its state, caller and call
+    GetterCache<executor::ExecuteByteCodeResult> getterCache_;
+
+    // results of speculative calls by their inputs
+    constexpr static size_t kSpeculationsCapacity = 1024;
+
+    Speculations<OriginExecuteResult> speculations_;
+
+    const size_t speculationsInFlight_;
+    std::atomic_size_t speculating_{0};
+    std::atomic_size_t speculationsDropped_{0};
+    LatencyHistogram speculationSaved_;
+
+    // contract states below are stored once for all of their holders
+    ContractStateStore states_;
+
+    // states of contracts requested by access sequences, by their new state transactions,
+    // most recently used first
+    constexpr static size_t kAccessStatesCapacity = 256;
+
+    using AccessStates = std::list<std::pair<csdb::TransactionID, ContractStateStore::StateId>>;
+
+    AccessStates accessStatesOrder_;
+    std::map<csdb::TransactionID, AccessStates::iterator> accessStates_;
+    std::mutex accessStatesMutex_;
 
-    std::unique_ptr<executor::ContractExecutorConcurrentClient> origExecutor_;
     std::unique_ptr<cs::Process> executorProcess_;
 
     general::AccessID lastAccessId_{};
     std::map<general::AccessID, cs::Sequence> accessSequence_;
     std::map<csdb::Address, csdb::TransactionID> deployTrxns_;
-    std::map<csdb::Address, std::string> lastState_;
-    std::map<csdb::Address, std::unordered_map<cs::Sequence, std::string>> cacheLastStates_;
+    std::map<csdb::Address, ContractStateStore::StateId> lastState_;
     std::map<general::AccessID, std::vector<csdb::Transaction>> innerSendTransactions_;
 
-    std::shared_mutex sharedErrorMutex_;
     std::shared_mutex mutex_;
     std::atomic_size_t execCount_{0};
 
@@ -261,7 +333,6 @@ private:
 
     const int16_t EXECUTOR_VERSION = 3;
 
-    std::mutex callExecutorLock_;
     std::atomic<bool> isWatcherRunning_ = { false };
 
     cs::ExecutorManager manager_;
@@ -0,0 +1,108 @@
+#ifndef EXECUTORLANES_HPP
+#define EXECUTORLANES_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cs {
+// calls to executor by priority, lower value is served first
+enum class ExecutorLane : uint8_t {
+    Consensus,
+    Getter,
+    Compile,
+    Speculative
+};
+
+constexpr size_t kExecutorLanesCount = 4;
+
+const char* executorLaneName(ExecutorLane lane);
+
+// lock free latency histogram with fixed exponential buckets
+class LatencyHistogram {
+public:
+    // upper bounds of buckets in milliseconds, the last bucket is unbounded
+    static constexpr std::array<uint32_t, 12> kBounds = {1, 2, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000};
+    static constexpr size_t kBucketsCount = kBounds.size() + 1;
+
+    struct Snapshot {
+        std::array<uint64_t, kBucketsCount> buckets{};
+        uint64_t count = 0;
+        uint64_t sum = 0;
+
+        // returns upper bound of bucket containing percentile, max of uint32_t for the last bucket
+        uint32_t percentile(double value) const;
+        std::string toString() const;
+    };
+
+    void add(std::chrono::milliseconds latency);
+    Snapshot snapshot() const;
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketsCount> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+};
+
+///
+/// Admission of calls to a set of executor connections (slots).
+///
+/// Every lane has its own limit of calls in flight. A free slot is given to the waiting lane
+/// of the highest priority, so consensus executions never wait behind API getters or compiles
+/// once a connection is released.
+///
+class ExecutorLanes {
+public:
+    static constexpr size_t kNoSlot = std::numeric_limits<size_t>::max();
+
+    using Limits = std::array<size_t, kExecutorLanesCount>;
+
+    ExecutorLanes(size_t slots, const Limits& limits);
+
+    // blocks until slot is available for lane, returns kNoSlot if lanes are stopped
+    size_t acquire(ExecutorLane lane);
+    void release(ExecutorLane lane, size_t slot);
+
+    // wakes up and rejects all waiting and further calls
+    void stop();
+
+    size_t slotsCount() const {
+        return busy_.size();
+    }
+
+    size_t inFlight(ExecutorLane lane) const;
+    size_t waiting(ExecutorLane lane) const;
+
+    const LatencyHistogram& latency(ExecutorLane lane) const {
+        return latency_[static_cast<size_t>(lane)];
+    }
+
+    LatencyHistogram& latency(ExecutorLane lane) {
+        return latency_[static_cast<size_t>(lane)];
+    }
+
+private:
+    bool isAdmissible(size_t lane) const;
+    size_t freeSlot() const;
+
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+
+    std::vector<bool> busy_;
+    Limits limits_;
+    std::array<size_t, kExecutorLanesCount> inFlight_{};
+    std::array<size_t, kExecutorLanesCount> waiting_{};
+    bool stopped_ = false;
+
+    std::array<LatencyHistogram, kExecutorLanesCount> latency_;
+};
+}
+
+#endif // EXECUTORLANES_HPP
@@ -0,0 +1,118 @@
+#ifndef EXECUTORPOOL_HPP
+#define EXECUTORPOOL_HPP
+
+#if defined(_MSC_VER)
+#pragma warning(push, 0)
+#endif
+
+#include <ContractExecutor.h>
+
+#include <thrift/transport/TSocket.h>
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "executorlanes.hpp"
+
+namespace cs {
+///
+/// Pool of connections to contract executor.
+///
+/// Every call leases a connection through priority lanes, so consensus executions are not
+/// queued behind API getters and compiles. A connection broken by transport error is closed
+/// and its client is replaced, the connection is reopened by the next lease.
+///
+class ExecutorConnectionPool {
+public:
+    using Client = executor::ContractExecutorConcurrentClient;
+
+    struct Settings {
+        std::string host;
+        uint16_t port = 0;
+        int sendTimeout = 0;
+        int receiveTimeout = 0;
+        size_t connections = 1;
+        ExecutorLanes::Limits limits{};
+    };
+
+    class Lease {
+    public:
+        Lease(Lease&&) noexcept;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease();
+
+        explicit operator bool() const {
+            return client_ != nullptr;
+        }
+
+        Client* operator->() const {
+            return client_;
+        }
+
+        // call failed on transport level, connection is closed and its client is replaced
+        void invalidate();
+
+    private:
+        Lease(ExecutorConnectionPool* pool, ExecutorLane lane, size_t slot, Client* client);
+
+        ExecutorConnectionPool* pool_;
+        ExecutorLane lane_;
+        size_t slot_;
+        Client* client_;
+        bool invalidated_ = false;
+        std::chrono::steady_clock::time_point start_;
+
+        friend class ExecutorConnectionPool;
+    };
+
+    explicit ExecutorConnectionPool(const Settings& settings);
+    ~ExecutorConnectionPool();
+
+    // blocks until connection is available for the lane, returns empty lease if it can not be opened
+    Lease acquire(ExecutorLane lane);
+
+    // opens all closed connections, returns true if at least one is open
+    bool connect();
+    void disconnect();
+    bool isConnected() const;
+
+    // rejects all waiting and further leases
+    void stop();
+
+    LatencyHistogram::Snapshot latency(ExecutorLane lane) const {
+        return lanes_.latency(lane).snapshot();
+    }
+
+    size_t size() const {
+        return connections_.size();
+    }
+
+private:
+    struct Connection {
+        ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::transport::TSocket> socket;
+        ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::transport::TTransport> transport;
+        std::unique_ptr<Client> client;
+
+        // guards transport open, close and open check, leases of one connection never overlap
+        std::mutex mutex;
+    };
+
+    static bool open(Connection& connection);
+    static void close(Connection& connection);
+    static void recreate(Connection& connection);
+
+    void release(Lease& lease);
+
+    std::vector<std::unique_ptr<Connection>> connections_;
+    ExecutorLanes lanes_;
+};
+}
+
+#endif // EXECUTORPOOL_HPP
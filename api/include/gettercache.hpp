@@ -0,0 +1,191 @@
+#ifndef GETTERCACHE_HPP
+#define GETTERCACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+
+#include <csdb/address.hpp>
+#include <lib/system/common.hpp>
+
+namespace cs {
+///
+/// Bounded LRU cache of read-only contract getter results.
+///
+/// Result of getter depends only on contract, its state, caller and call itself (method and params),
+/// so key is a hash of all of them and the contract is kept aside to drop its entries once
+/// a new state of contract is seen. Concurrent requests of the same key are coalesced:
+/// the first one executes getter, others wait for its result. Failed executions are not cached.
+///
+template <typename Value>
+class GetterCache {
+public:
+    struct Statistics {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t coalesced = 0;
+    };
+
+    // returns nullopt if value must not be cached (execution failed)
+    using Producer = std::function<std::optional<Value>()>;
+
+    explicit GetterCache(size_t capacity)
+    : capacity_(capacity) {
+    }
+
+    std::optional<Value> get(const csdb::Address& contract, const cs::Hash& key, const Producer& producer) {
+        std::unique_lock lock(mutex_);
+
+        if (auto it = entries_.find(key); it != entries_.end()) {
+            ++statistics_.hits;
+            order_.splice(order_.begin(), order_, it->second);
+
+            return it->second->value;
+        }
+
+        if (auto it = inflight_.find(key); it != inflight_.end()) {
+            ++statistics_.coalesced;
+            auto future = it->second;
+
+            lock.unlock();
+
+            // shared execution failed, try by own without caching
+            if (auto value = future.get(); value.has_value()) {
+                return value;
+            }
+
+            return producer();
+        }
+
+        ++statistics_.misses;
+
+        std::promise<std::optional<Value>> promise;
+        inflight_.emplace(key, promise.get_future().share());
+
+        lock.unlock();
+
+        std::optional<Value> value;
+
+        try {
+            value = producer();
+        }
+        catch (...) {
+            lock.lock();
+            inflight_.erase(key);
+
+            promise.set_value(std::nullopt);
+            throw;
+        }
+
+        lock.lock();
+        inflight_.erase(key);
+
+        if (value.has_value() && capacity_ != 0) {
+            insert(contract, key, *value);
+        }
+
+        lock.unlock();
+
+        promise.set_value(value);
+        return value;
+    }
+
+    // drops all cached results of contract, called when its new state is seen
+    void invalidate(const csdb::Address& contract) {
+        std::lock_guard lock(mutex_);
+
+        auto it = byContract_.find(contract);
+
+        if (it == byContract_.end()) {
+            return;
+        }
+
+        for (const auto& key : it->second) {
+            if (auto entry = entries_.find(key); entry != entries_.end()) {
+                order_.erase(entry->second);
+                entries_.erase(entry);
+            }
+        }
+
+        byContract_.erase(it);
+    }
+
+    void clear() {
+        std::lock_guard lock(mutex_);
+
+        entries_.clear();
+        order_.clear();
+        byContract_.clear();
+    }
+
+    size_t size() const {
+        std::lock_guard lock(mutex_);
+        return entries_.size();
+    }
+
+    Statistics statistics() const {
+        std::lock_guard lock(mutex_);
+        return statistics_;
+    }
+
+private:
+    struct Entry {
+        cs::Hash key;
+        csdb::Address contract;
+        Value value;
+    };
+
+    using Order = std::list<Entry>;
+
+    void insert(const csdb::Address& contract, const cs::Hash& key, const Value& value) {
+        if (auto it = entries_.find(key); it != entries_.end()) {
+            it->second->value = value;
+            order_.splice(order_.begin(), order_, it->second);
+            return;
+        }
+
+        while (entries_.size() >= capacity_) {
+            evict();
+        }
+
+        order_.push_front(Entry{key, contract, value});
+        entries_.emplace(key, order_.begin());
+        byContract_[contract].insert(key);
+    }
+
+    void evict() {
+        const Entry& last = order_.back();
+
+        if (auto it = byContract_.find(last.contract); it != byContract_.end()) {
+            it->second.erase(last.key);
+
+            if (it->second.empty()) {
+                byContract_.erase(it);
+            }
+        }
+
+        entries_.erase(last.key);
+        order_.pop_back();
+    }
+
+    const size_t capacity_;
+
+    mutable std::mutex mutex_;
+
+    // most recently used first
+    Order order_;
+    std::map<cs::Hash, typename Order::iterator> entries_;
+    std::map<csdb::Address, std::set<cs::Hash>> byContract_;
+    std::map<cs::Hash, std::shared_future<std::optional<Value>>> inflight_;
+
+    Statistics statistics_;
+};
+}
+
+#endif // GETTERCACHE_HPP
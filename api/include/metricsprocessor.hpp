@@ -0,0 +1,17 @@
+#ifndef METRICSPROCESSOR_HPP
+#define METRICSPROCESSOR_HPP
+
+#include <API.h>
+
+namespace cs {
+// records time of every public API method to metrics registry, calls of unknown methods are timed together
+class MetricsProcessor : public ::api::APIProcessor {
+public:
+    explicit MetricsProcessor(::apache::thrift::stdcxx::shared_ptr<api::APIIf> iface);
+    virtual bool dispatchCall(::apache::thrift::protocol::TProtocol* iprot,
+                              ::apache::thrift::protocol::TProtocol* oprot,
+                              const std::string& fname, int32_t seqid, void* callContext) override;
+};
+}
+
+#endif // METRICSPROCESSOR_HPP
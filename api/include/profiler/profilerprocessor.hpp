@@ -1,10 +1,10 @@
 #ifndef PROFILERPROCESSOR_HPP
 #define PROFILERPROCESSOR_HPP
 
-#include <API.h>
+#include <metricsprocessor.hpp>
 
 namespace cs {
-class ProfilerProcessor : public ::api::APIProcessor {
+class ProfilerProcessor : public cs::MetricsProcessor {
 public:
     explicit ProfilerProcessor(::apache::thrift::stdcxx::shared_ptr<api::APIIf> iface);
     virtual bool dispatchCall(::apache::thrift::protocol::TProtocol* iprot,
@@ -0,0 +1,166 @@
+#ifndef SPECULATIONS_HPP
+#define SPECULATIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+
+#include <csdb/address.hpp>
+#include <lib/system/common.hpp>
+
+#include "gettercache.hpp"
+
+namespace cs {
+///
+/// Results of contract calls executed before their blocks.
+///
+/// Call is speculated once by signature of its transaction, result is kept by hash of all inputs
+/// passed to executor and is taken only if the scheduled call has the same inputs. Result of call
+/// that made any callback to node (seed, wallets, blocks, other contracts, emitted transactions)
+/// depends on more than its inputs, so it is never kept. Callbacks without access id of execution
+/// are counted to all speculative executions in flight.
+///
+template <typename Result>
+class Speculations {
+public:
+    using AccessId = int64_t;
+    using Producer = typename GetterCache<Result>::Producer;
+
+    struct Statistics {
+        size_t started = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+    };
+
+    explicit Speculations(size_t capacity)
+    : capacity_(capacity)
+    , results_(capacity) {
+    }
+
+    // registers call by inputs, returns false if the call is speculated already
+    bool start(const cs::Signature& signature, const cs::Hash& key) {
+        std::lock_guard lock(mutex_);
+
+        if (!calls_.emplace(signature, key).second) {
+            return false;
+        }
+
+        order_.push_back(signature);
+
+        while (order_.size() > capacity_) {
+            calls_.erase(order_.front());
+            order_.pop_front();
+        }
+
+        ++statistics_.started;
+        return true;
+    }
+
+    // executes speculative call, producer returns nullopt if result must not be kept
+    void run(const csdb::Address& contract, const cs::Hash& key, const Producer& producer) {
+        results_.get(contract, key, producer);
+    }
+
+    // takes result of speculated call if its inputs are the same, waits for speculation in flight
+    std::optional<Result> take(const cs::Signature& signature, const csdb::Address& contract, const cs::Hash& key) {
+        {
+            std::lock_guard lock(mutex_);
+            auto it = calls_.find(signature);
+
+            if (it == calls_.end()) {
+                return std::nullopt;
+            }
+
+            const bool isSame = (it->second == key);
+            calls_.erase(it);
+
+            if (!isSame) {
+                ++statistics_.misses;
+                return std::nullopt;
+            }
+        }
+
+        // never executes by itself through the cache
+        auto result = results_.get(contract, key, [] { return std::optional<Result>{}; });
+
+        std::lock_guard lock(mutex_);
+
+        if (result.has_value()) {
+            ++statistics_.hits;
+        }
+        else {
+            ++statistics_.misses;
+        }
+
+        return result;
+    }
+
+    // drops results of contract, called when its new state is seen
+    void invalidate(const csdb::Address& contract) {
+        results_.invalidate(contract);
+    }
+
+    // callbacks of execution are counted from watch till release
+    void watch(AccessId accessId) {
+        std::lock_guard lock(mutex_);
+        watched_[accessId] = false;
+    }
+
+    // returns true if execution made any callback
+    bool release(AccessId accessId) {
+        std::lock_guard lock(mutex_);
+        auto it = watched_.find(accessId);
+
+        if (it == watched_.end()) {
+            return false;
+        }
+
+        const bool isCalledBack = it->second;
+        watched_.erase(it);
+
+        return isCalledBack;
+    }
+
+    void onCallback(AccessId accessId) {
+        std::lock_guard lock(mutex_);
+
+        if (auto it = watched_.find(accessId); it != watched_.end()) {
+            it->second = true;
+        }
+    }
+
+    void onCallback() {
+        std::lock_guard lock(mutex_);
+
+        for (auto& [accessId, isCalledBack] : watched_) {
+            isCalledBack = true;
+        }
+    }
+
+    Statistics statistics() const {
+        std::lock_guard lock(mutex_);
+        return statistics_;
+    }
+
+private:
+    const size_t capacity_;
+
+    GetterCache<Result> results_;
+
+    mutable std::mutex mutex_;
+
+    // inputs by signatures of speculated transactions, oldest first in order
+    std::map<cs::Signature, cs::Hash> calls_;
+    std::deque<cs::Signature> order_;
+
+    // speculative executions in flight and whether they made callbacks
+    std::map<AccessId, bool> watched_;
+
+    Statistics statistics_;
+};
+}
+
+#endif // SPECULATIONS_HPP
@@ -1,7 +1,10 @@
 #ifndef TOKENS_HPP
 #define TOKENS_HPP
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <set>
@@ -15,6 +18,8 @@
 
 #include <ContractExecutor.h>
 
+#include "executorlanes.hpp"
+
 namespace api {
 class APIHandler;
 class SmartContractInvocation;
@@ -53,7 +58,16 @@ using HoldersMap = std::unordered_map<HolderKey, std::set<TokenId>>;
 
 class TokensMaster {
 public:
-    TokensMaster(api::APIHandler*);
+    // holders to refresh by token, all holders if full
+    struct Refresh {
+        bool full = false;
+        std::set<HolderKey> holders;
+    };
+
+    // refreshes balances of token holders, executor calls of refreshTokenState if not set
+    using Refresher = std::function<void(const csdb::Address& token, const Refresh&)>;
+
+    TokensMaster(api::APIHandler*, Refresher refresher = Refresher{});
     ~TokensMaster();
 
     void checkNewDeploy(const csdb::Address& sc, const csdb::Address& deployer, const api::SmartContractInvocation&);
@@ -84,15 +98,59 @@ public:
     };
 
     void updateTokenChaches(const csdb::Address& addr, const std::string& newState, const TokenInvocationData::Params& params);
-    
-    void refreshTokenState(const csdb::Address& token, const std::string& newState, bool checkBalance = false);
+
+    // holders whose balances may be changed by invocation, all holders for unknown methods
+    static Refresh refreshOf(int64_t tokenStandard, const TokenInvocationData::Params& params);
+
+    // balanceOf params of holders for executeByteCodeMultiple, kBalancesBatchSize holders per call
+    static std::vector<std::vector<std::vector<general::Variant>>> balanceOfParams(const std::vector<csdb::Address>& holders);
+
+    // merges refresh into the queued one of token
+    void enqueue(const csdb::Address& token, Refresh&& refresh);
+
+    // queues refresh of all tokens with all their holders
+    void refreshAll();
+
+    struct Statistics {
+        size_t queuedTokens = 0;
+        size_t queuedHolders = 0;
+        uint64_t refreshes = 0;         // tokens refreshed
+        uint64_t balances = 0;          // holders balances requested
+        uint64_t executorCalls = 0;     // batched balanceOf calls
+        cs::LatencyHistogram::Snapshot latency;    // of token refresh
+    };
+
+    Statistics statistics() const;
+
+    // max holders in one balanceOf batch
+    constexpr static size_t kBalancesBatchSize = 500;
+
+    // changes of tokens arriving within the delay are refreshed at once
+    constexpr static std::chrono::milliseconds kCoalesceDelay{50};
 
 private:
     void initiateHolder(Token&, const csdb::Address& token, const csdb::Address& holder, bool increaseTransfers = false);
 
-    api::APIHandler* api_;
+    void run();
+    void refreshTokenState(const csdb::Address& token, const Refresh& refresh);
 
-    std::mutex cvMut_;
+    // updates statistics in metrics registry, called by worker only
+    void publishStatistics();
+
+    api::APIHandler* api_;
+    Refresher refresher_;
+
+    mutable std::mutex cvMut_;
+    std::condition_variable cv_;
+    std::map<TokenId, Refresh> queue_;
+    bool stop_ = false;
+    std::thread worker_;
+
+    std::atomic<uint64_t> refreshes_{0};
+    std::atomic<uint64_t> balances_{0};
+    std::atomic<uint64_t> executorCalls_{0};
+    cs::LatencyHistogram latency_;
+    Statistics published_;
 
     struct DeployTask {
         csdb::Address address;
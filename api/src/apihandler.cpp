@@ -41,27 +41,13 @@ APIHandler::APIHandler(BlockChain& blockchain, cs::SolverCore& _solver, cs::Exec
 , stats(blockchain)
 #endif
 , tm_(this) {
-#ifdef USE_DEPRECATED_STATS //MONITOR_NODE
-    if (static bool firstTime = true; firstTime) {
-        stats_.second.resize(::csstats::collectionPeriods.size());
-        auto nowGlobal = std::chrono::system_clock::now();
-        auto lastTimePoint = nowGlobal - std::chrono::seconds(::csstats::collectionPeriods[::csstats::PeriodIndex::Month]);
-
-        for (auto time = nowGlobal; time > lastTimePoint; time -= std::chrono::seconds(::csstats::updateTimeSec)) {
-            ::csstats::PeriodStats cut;
-            cut.timeStamp = time;
-            stats_.first.push_back(cut);
-        }
-        firstTime = false;
-    }
-#endif
 }
 
 void APIHandler::run() {
     if (!blockchain_.isGood())
         return;
 #ifdef USE_DEPRECATED_STATS //MONITOR_NODE
-    stats.run(stats_);
+    stats.run();
 #endif
     state_updater_running.test_and_set(std::memory_order_acquire);
 }
@@ -112,18 +98,16 @@ void APIHandlerBase::SetResponseStatus(general::APIResponse& response, bool comm
 
 void APIHandler::WalletDataGet(WalletDataGetResult& _return, const general::Address& address) {
     const csdb::Address addr = BlockChain::getAddressFromKey(address);
-    BlockChain::WalletData wallData{};
-    BlockChain::WalletId wallId{};
-    if (!blockchain_.findWalletData(addr, wallData, wallId)) {
-        if (!blockchain_.findWalletData(addr, wallData)) { // **
-            return;
-        }
+    cs::PublishedWallets::Wallet wallet;
+    if (!blockchain_.findPublishedWallet(addr, wallet)) {
+        return;
     }
-    _return.walletData.walletId = static_cast<int>(wallId); // may be default value if **
-    _return.walletData.balance.integral = wallData.balance_.integral();
-    _return.walletData.balance.fraction = static_cast<decltype(_return.walletData.balance.fraction)>(wallData.balance_.fraction());
-    const cs::TransactionsTail& tail = wallData.trxTail_;
-    _return.walletData.lastTransactionId = tail.empty() ? 0 : tail.getLastTransactionId();
+    BlockChain::WalletId wallId{};
+    blockchain_.findWalletId(addr, wallId); // may keep default value
+    _return.walletData.walletId = static_cast<int>(wallId);
+    _return.walletData.balance.integral = wallet.balance.integral();
+    _return.walletData.balance.fraction = static_cast<decltype(_return.walletData.balance.fraction)>(wallet.balance.fraction());
+    _return.walletData.lastTransactionId = wallet.lastInnerId;
 
     SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
 }
@@ -143,23 +127,23 @@ void APIHandler::WalletIdGet(api::WalletIdGetResult& _return, const general::Add
 
 void APIHandler::WalletTransactionsCountGet(api::WalletTransactionsCountGetResult& _return, const general::Address& address) {
     const csdb::Address addr = BlockChain::getAddressFromKey(address);
-    BlockChain::WalletData wallData{};
-    if (!blockchain_.findWalletData(addr, wallData)) {
+    cs::PublishedWallets::Wallet wallet;
+    if (!blockchain_.findPublishedWallet(addr, wallet)) {
         SetResponseStatus(_return.status, APIRequestStatusType::NOT_FOUND);
         return;
     }
-    _return.lastTransactionInnerId = wallData.trxTail_.empty() ? 0 : wallData.trxTail_.getLastTransactionId();
+    _return.lastTransactionInnerId = wallet.lastInnerId;
     SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
 }
 
 void APIHandler::WalletBalanceGet(api::WalletBalanceGetResult& _return, const general::Address& address) {
     const csdb::Address addr = BlockChain::getAddressFromKey(address);
-    BlockChain::WalletData wallData{};
-    if (!blockchain_.findWalletData(addr, wallData)) {
+    cs::PublishedWallets::Wallet wallet;
+    if (!blockchain_.findPublishedWallet(addr, wallet)) {
         return;
     }
-    _return.balance.integral = wallData.balance_.integral();
-    _return.balance.fraction = static_cast<decltype(_return.balance.fraction)>(wallData.balance_.fraction());
+    _return.balance.integral = wallet.balance.integral();
+    _return.balance.fraction = static_cast<decltype(_return.balance.fraction)>(wallet.balance.fraction());
     SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
 }
 
@@ -994,17 +978,7 @@ void APIHandler::baseLoaded(const csdb::Pool& pool) {
     if (maxReadSequence && pool.sequence() == maxReadSequence) {
         isBDLoaded_ = true;
 #ifdef TOKENS_CACHE   
-        tm_.loadTokenInfo([&](const TokensMap& tokens, const HoldersMap&) {
-            int count{}, i{};
-            size_t tokenSize = tokens.size();
-            cslog() << "tokens are loading(" << tokenSize << ")...";
-            for (auto& tk : tokens) {
-                if (tokenSize > 100 && !(i++ % (tokenSize / 10)))
-                    cslog() << "loading tokens: " << 10 * (count++) << "%";
-                tm_.refreshTokenState(tk.first, cs::SmartContracts::get_contract_state(get_s_blockchain(), tk.first), true);
-            }
-            cslog() << "tokens loaded!";
-            });
+        tm_.refreshAll();
 #endif
     }
 }
@@ -1015,94 +989,6 @@ void APIHandler::maxBlocksCount(cs::Sequence lastBlockNum) {
     maxReadSequence = lastBlockNum;
 }
 
-
-void APIHandler::collect_all_stats_slot(const csdb::Pool& pool) {
-#ifdef USE_DEPRECATED_STATS
-    const ::csstats::Periods periods = ::csstats::collectionPeriods;
-
-    static unsigned int currentCutIndex = 0;
-    static auto startCutTime = stats_.first[currentCutIndex].timeStamp;
-    static auto endCutTime = stats_.first[currentCutIndex + 1].timeStamp;
-
-    auto now = std::chrono::system_clock::now();
-    auto poolTime_t = atoll(pool.user_field(0).value<std::string>().c_str()) / 1000;
-    auto poolTime = std::chrono::system_clock::from_time_t(poolTime_t);
-
-    using Seconds = std::chrono::seconds;
-    Seconds poolAgeSec = std::chrono::duration_cast<Seconds>(now - poolTime);
-
-    if (startCutTime <= poolTime && poolTime < endCutTime) {
-        ::csstats::PeriodStats& periodStats = stats_.first[currentCutIndex];
-        ++periodStats.poolsCount;
-
-        size_t transactionsCount = pool.transactions_count();
-        periodStats.transactionsCount += static_cast<uint32_t>(transactionsCount);
-
-        for (size_t i = 0; i < transactionsCount; ++i) {
-            const auto& transaction = pool.transaction(csdb::TransactionID(pool.sequence(), i));
-
-#ifdef MONITOR_NODE
-            if (is_smart(transaction) || is_smart_state(transaction))
-                ++periodStats.transactionsSmartCount;
-#endif
-
-            if (is_deploy_transaction(transaction)) {
-                ++periodStats.smartContractsCount;
-            }
-
-            Currency currency = 1;
-
-            const auto& amount = transaction.amount();
-
-            periodStats.balancePerCurrency[cs::Byte(currency)].integral += amount.integral();
-            periodStats.balancePerCurrency[cs::Byte(currency)].fraction += amount.fraction();
-        }
-    }
-    else if ((currentCutIndex + 1) < stats_.first.size()) {
-        startCutTime = stats_.first[currentCutIndex].timeStamp;
-        endCutTime = stats_.first[currentCutIndex + 1].timeStamp;
-        ++currentCutIndex;
-    }
-
-    auto period = csstats::Period(poolAgeSec.count());
-    for (size_t periodIndex = 0; periodIndex < periods.size(); ++periodIndex) {
-        if (period < periods[periodIndex]) {
-            csstats::PeriodStats& periodStats = stats_.second[periodIndex];
-            periodStats.poolsCount++;
-
-            size_t transactionsCount = pool.transactions_count();
-            periodStats.transactionsCount += static_cast<uint32_t>(transactionsCount);
-
-            for (size_t i = 0; i < transactionsCount; ++i) {
-                const auto& transaction = pool.transaction(csdb::TransactionID(pool.sequence(), i));
-
-                if (transaction.source() == blockchain_.getGenesisAddress()) {
-                    continue;
-                }
-#ifdef MONITOR_NODE
-                if (is_smart(transaction) || is_smart_state(transaction)) {
-                    ++periodStats.transactionsSmartCount;
-                }
-#endif
-
-                if (is_deploy_transaction(transaction)) {
-                    ++periodStats.smartContractsCount;
-                }
-
-                //Currency currency = currencies_indexed[transaction.currency().to_string()];
-                Currency currency = 1;
-
-                const auto& amount = transaction.amount();
-
-                periodStats.balancePerCurrency[cs::Byte(currency)].integral += amount.integral();
-                periodStats.balancePerCurrency[cs::Byte(currency)].fraction += amount.fraction();
-            }
-        }
-    }
-#else
-    csunused(pool);
-#endif // USE_DEPRECATED_STATS
-}
 //
 
 bool APIHandler::updateSmartCachesTransaction(csdb::Transaction trxn, cs::Sequence sequence) {
@@ -1591,7 +1477,7 @@ void APIHandler::tokenTransactionsInternal(ResultType& _return, APIHandler& hand
 
 void APIHandler::iterateOverTokenTransactions(const csdb::Address& addr, const std::function<bool(const csdb::Pool&, const csdb::Transaction&)> func) {
     std::list<csdb::TransactionID> l_id;
-    for (auto trIt = cs::TransactionsIterator(blockchain_, addr); trIt.isValid(); trIt.next()) {
+    for (auto trIt = cs::TransactionsIterator(blockchain_, addr, cs::TransactionsIterator::ReadAhead{}); trIt.isValid(); trIt.next()) {
         if (is_smart_state(*trIt)) {
             cs::SmartContractRef smart_ref;
             smart_ref.from_user_field(trIt->user_field(cs::trx_uf::new_state::RefStart));
@@ -2207,6 +2093,7 @@ void APIHandler::SyncStateGet(api::SyncStateResult& _return) {
 }
 
 void apiexec::APIEXECHandler::GetSeed(apiexec::GetSeedResult& _return, const general::AccessID accessId) {
+    executor_.onCallback(accessId);
     if (accessId == cs::Executor::ACCESS_ID_RESERVE::GETTER) { // for getter
         std::default_random_engine random(std::random_device{}());
         const auto randSequence = random() % blockchain_.getLastSeq();
@@ -2227,12 +2114,12 @@ void apiexec::APIEXECHandler::GetSeed(apiexec::GetSeedResult& _return, const gen
 
 void apiexec::APIEXECHandler::SendTransaction(apiexec::SendTransactionResult& _return, const general::AccessID accessId, const api::Transaction& transaction) {
     csunused(_return);
-    csunused(accessId);
+    executor_.onCallback(accessId);
     executor_.addInnerSendTransaction(accessId, executor_.makeTransaction(transaction));
 }
 
 void apiexec::APIEXECHandler::WalletIdGet(api::WalletIdGetResult& _return, const general::AccessID accessId, const general::Address& address) {
-    csunused(accessId);
+    executor_.onCallback(accessId);
     const csdb::Address addr = BlockChain::getAddressFromKey(address);
     BlockChain::WalletData wallData{};
     BlockChain::WalletId wallId{};
@@ -2245,6 +2132,7 @@ void apiexec::APIEXECHandler::WalletIdGet(api::WalletIdGetResult& _return, const
 }
 
 void apiexec::APIEXECHandler::SmartContractGet(SmartContractGetResult& _return, const general::AccessID accessId, const general::Address& address) {
+    executor_.onCallback(accessId);
     const auto addr = BlockChain::getAddressFromKey(address);
     auto opt_transaction_id = executor_.getDeployTrxn(addr);
     if (!opt_transaction_id.has_value()) {
@@ -2267,16 +2155,19 @@ void apiexec::APIEXECHandler::SmartContractGet(SmartContractGetResult& _return,
 }
 
 void apiexec::APIEXECHandler::WalletBalanceGet(api::WalletBalanceGetResult& _return, const general::Address& address) {
+    // executor does not pass access id here
+    executor_.onCallback();
     const csdb::Address addr = BlockChain::getAddressFromKey(address);
-    BlockChain::WalletData wallData{};
-    if (!blockchain_.findWalletData(addr, wallData))
+    cs::PublishedWallets::Wallet wallet;
+    if (!blockchain_.findPublishedWallet(addr, wallet))
         return;
-    _return.balance.integral = wallData.balance_.integral();
-    _return.balance.fraction = static_cast<decltype(_return.balance.fraction)>(wallData.balance_.fraction());
+    _return.balance.integral = wallet.balance.integral();
+    _return.balance.fraction = static_cast<decltype(_return.balance.fraction)>(wallet.balance.fraction());
     SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
 }
 
 void apiexec::APIEXECHandler::PoolGet(PoolGetResult& _return, const int64_t sequence) {
+    executor_.onCallback();
     auto poolBin = executor_.loadBlockApi(static_cast<cs::Sequence>(sequence)).to_binary();
     _return.pool.reserve(poolBin.size());
     std::copy(poolBin.begin(), poolBin.end(), std::back_inserter(_return.pool));
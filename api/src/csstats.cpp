@@ -2,348 +2,442 @@
 
 #include <algorithm>
 #include <apihandler.hpp>
-#include <cassert>
 #include <client/params.hpp>
+#include <csdb/amount.hpp>
 #include <csdb/currency.hpp>
+#include <csdb/internal/utils.hpp>
+#include <csnode/datastream.hpp>
 #include <csstats.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
 
-namespace csstats {
+namespace {
+const char* kStatsPath = "./caches/stats";
+const uint32_t kStatsVersion = 2;
 
-template <class F>
-void csstats::matchPeriod(const Periods& periods, period_t period, F func) {
-    for (size_t i = 0; i < periods.size(); ++i) {
-        if (period < periods[i]) {
-            func(i);
-        }
+const int64_t kMaxFraction = static_cast<int64_t>(csdb::Amount::AMOUNT_MAX_FRACTION);
+
+int64_t minuteOf(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count() / csstats::secondsPerBucket;
+}
+
+// keeps fraction within [0, kMaxFraction), so sums of fractions never overflow
+void normalize(csstats::TotalAmount& amount) {
+    amount.integral += amount.fraction / kMaxFraction;
+    amount.fraction %= kMaxFraction;
+
+    if (amount.fraction < 0) {
+        amount.fraction += kMaxFraction;
+        --amount.integral;
     }
 }
 
-StatsPerPeriod csstats::collectStats(const Periods& periods) {
-    assert(std::is_sorted(std::begin(periods), std::end(periods), [](const Period& l, const Period& r) { return l < r; }));
+void add(csstats::TotalAmount& amount, const csstats::TotalAmount& delta, int sign) {
+    amount.integral += sign * delta.integral;
+    amount.fraction += sign * delta.fraction;
+    normalize(amount);
+}
+}  // namespace
 
-    cstrace() << " Collecting stats: started";
+namespace csstats {
+csstats::csstats(BlockChain& blockchain)
+: blockchain(blockchain)
+, buckets(bucketsCount) {
+    total.periodSec = collectionPeriods[PeriodIndex::Total];
 
-    auto stats = currentStats;
-    auto startTime = std::chrono::high_resolution_clock::now();
-    auto blockHash = blockchain.getLastHash();
+    if (load()) {
+        cslog() << "STATS> rollups are loaded up to block " << lastSequence;
+    }
 
-	static auto lastHash = blockHash;
+    cs::Connector::connect(&blockchain.startReadingBlocksEvent(), this, &csstats::onStartReadBlocks);
+    cs::Connector::connect<&csstats::onReadBlock>(&blockchain.readBlockEvent(), this);
+    cs::Connector::connect<&csstats::onStoreBlock>(&blockchain.storeBlockEvent, this);
+    cs::Connector::connect(&blockchain.removeBlockEvent, this, &csstats::onRemoveBlock);
 
-    PeriodStats periodStats;
-    periodStats.timeStamp = std::chrono::system_clock::now();
+    cstrace() << "STATS> csstats start, " << bucketsCount << " buckets of " << secondsPerBucket << " sec";
+}
 
-    {
-        auto future_last_hash = blockHash;
+void csstats::run() {
+#ifndef STATS
+    return;
+#else
+    ScopedLock lock(mutex);
 
-        if (blockHash.is_empty()) {
-            cserror() << "Stats: no bricks in the wall (last hash is empty)";
-        }
+    if (thread.joinable()) {
+        return;
+    }
 
-        while (blockHash != lastHash && !blockHash.is_empty()) {
-            csdb::Pool pool = blockchain.loadBlock(blockHash);
-            periodStats.poolsCount++;
-            std::size_t transactionsCount = pool.transactions_count();
-            periodStats.transactionsCount += static_cast<uint32_t>(transactionsCount);
+    thread = std::thread([this]() {
+        cstrace() << "STATS> csstats thread started";
 
-            for (std::size_t i = 0; i < transactionsCount; ++i) {
-                const auto& transaction = pool.transaction(csdb::TransactionID(pool.sequence(), i));
-#ifdef MONITOR_NODE
-                if (is_smart(transaction) || is_smart_state(transaction))
-                    ++periodStats.transactionsSmartCount;
-#endif
-                if (is_deploy_transaction(transaction))
-                    ++periodStats.smartContractsCount;
+        std::unique_lock lock(mutex);
 
-                Currency currency = currencies_indexed[transaction.currency().to_string()];
-                const auto& amount = transaction.amount();
-                periodStats.balancePerCurrency[currency].integral += amount.integral();
-                periodStats.balancePerCurrency[currency].fraction += amount.fraction();
+        while (!quit) {
+            condition.wait_for(lock, std::chrono::seconds(saveIntervalSec), [this] { return quit; });
+
+            if (!quit && changed) {
+                lock.unlock();
+                save();
+                lock.lock();
             }
-            blockHash = pool.previous_hash();
         }
-        lastHash = future_last_hash;
+
+        cstrace() << "STATS> csstats thread stopped";
+    });
+#endif
+}
+
+csstats::~csstats() {
+    cstrace() << "STATS> csstats stop";
+
+    {
+        ScopedLock lock(mutex);
+        quit = true;
     }
 
-    // total
-    auto& total = stats[PeriodIndex::Total];
-    total.poolsCount += periodStats.poolsCount;
-    total.transactionsCount += periodStats.transactionsCount;
-    total.smartContractsCount += periodStats.smartContractsCount;
-    total.transactionsSmartCount += periodStats.transactionsSmartCount;
+    condition.notify_all();
 
-    for (auto& element : periodStats.balancePerCurrency) {
-        total.balancePerCurrency[element.first].integral += element.second.integral;
-        total.balancePerCurrency[element.first].fraction += element.second.fraction;
+    if (thread.joinable()) {
+        thread.join();
     }
 
-    for (size_t i = 0; i < periods.size(); ++i) {
-        assert(updateTimeSec != 0);
+    save();
+}
 
-        std::size_t index = (periods[i] / updateTimeSec) - 1;
+StatsPerPeriod csstats::getStats() {
+    StatsPerPeriod stats(PeriodIndex::PeriodsCount);
+    const auto now = std::chrono::system_clock::now();
+    const auto nowMinute = minuteOf(now);
 
-        try {
-            auto& lastPeriodStats = statsCut.at(index);
-            auto& stat = stats.at(i);
+    for (size_t i = 0; i < stats.size(); ++i) {
+        stats[i].periodSec = collectionPeriods[i];
+        stats[i].timeStamp = now;
+    }
 
-            // remove last stats
-            stat.poolsCount -= lastPeriodStats.poolsCount;
-            stat.smartContractsCount -= lastPeriodStats.smartContractsCount;
-            stat.transactionsCount -= lastPeriodStats.transactionsCount;
-            stat.transactionsSmartCount -= lastPeriodStats.transactionsSmartCount;
+    ScopedLock lock(mutex);
 
-            for (auto& element : lastPeriodStats.balancePerCurrency) {
-                stat.balancePerCurrency[element.first].integral -= element.second.integral;
-                stat.balancePerCurrency[element.first].fraction -= element.second.fraction;
-            }
+    for (const auto& bucket : buckets) {
+        if (bucket.minute < 0) {
+            continue;
+        }
 
-            // add new stats
-            stat.poolsCount += periodStats.poolsCount;
-            stat.smartContractsCount += periodStats.smartContractsCount;
-            stat.transactionsCount += periodStats.transactionsCount;
-            stat.transactionsSmartCount += periodStats.transactionsSmartCount;
+        const auto ageSec = (nowMinute - bucket.minute) * secondsPerBucket;
 
-            for (auto& element : periodStats.balancePerCurrency) {
-                stat.balancePerCurrency[element.first].integral += element.second.integral;
-                stat.balancePerCurrency[element.first].fraction += element.second.fraction;
+        for (size_t i = 0; i < PeriodIndex::Total; ++i) {
+            if (ageSec < collectionPeriods[i]) {
+                add(stats[i], bucket, 1);
             }
         }
-        catch (const std::exception& e) {
-            cslog() << "STATS> " << e.what();
-        }
     }
 
-    // update cuts
-    statsCut.push_front(periodStats);
-    statsCut.pop_back();
-
-    auto finishTime = std::chrono::high_resolution_clock::now();
-
-    using Seconds = std::chrono::seconds;
-    Seconds seconds = std::chrono::duration_cast<Seconds>(finishTime - startTime);
-
-    cstrace() << "STATS> Collecting stats: finished (took " << seconds.count() << "s";
-    cslog() << "STATS> Stats updated";
+    const auto timeStamp = stats[PeriodIndex::Total].timeStamp;
+    stats[PeriodIndex::Total] = total;
+    stats[PeriodIndex::Total].timeStamp = timeStamp;
 
     return stats;
 }
 
-/*AllStats csstats::collectAllStats(const Periods& periods) {
-    assert(std::is_sorted(std::begin(periods), std::end(periods), [](const Period& l, const Period& r) { return l < r; }));
+void csstats::onStartReadBlocks(cs::Sequence lastWrittenSequence) {
+    ScopedLock lock(mutex);
+
+    // block folded before restart was stored, but not written
+    if (lastSequence != cs::kWrongSequence && lastSequence > lastWrittenSequence) {
+        cswarning() << "STATS> rollups up to block " << lastSequence << " are ahead of database, blocks will be rescanned";
+        reset();
+    }
+}
 
-    cstrace() << "STATS>  Collecting All stats: started";
+void csstats::onReadBlock(const csdb::Pool& block, bool* shouldStop) {
+    csunused(shouldStop);
 
-    AllStats stats;
-    stats.second.resize(periods.size());
+    bool isDiffered = false;
 
-    auto nowGlobal = std::chrono::system_clock::now();
-    auto lastTimePoint = nowGlobal - std::chrono::seconds(collectionPeriods[PeriodIndex::Month]);
+    {
+        ScopedLock lock(mutex);
 
-    for (auto time = nowGlobal; time > lastTimePoint; time -= std::chrono::seconds(updateTimeSec)) {
-        PeriodStats cut;
-        cut.timeStamp = time;
+        if (lastSequence != cs::kWrongSequence && block.sequence() == lastSequence && block.hash() != lastHash) {
+            cswarning() << "STATS> block " << lastSequence << " differs from folded one, rollups are rebuilt";
+            reset();
+            isDiffered = true;
+        }
+    }
 
-        stats.first.push_back(cut);
+    // blocks before it are skipped already
+    if (isDiffered) {
+        rebuild(block.sequence());
     }
 
-    auto startTime = std::chrono::system_clock::now();
-    auto blockHash = blockchain.getLastHash();
-    unsigned int currentCutIndex = 0;
-    auto startCutTime = stats.first[currentCutIndex].timeStamp;
-    auto endCutTime = stats.first[currentCutIndex + 1].timeStamp;
+    // folded before restart
+    if (isFolded(block)) {
+        return;
+    }
 
-    auto future_lastHash = blockchain.getLastHash();
+    fold(block, 1);
+}
 
-    static bool log_to_console = true;
-    size_t cnt = 0;
-    if (log_to_console) {
-        std::cout << "STATS> analizing blockchain...\n";
+void csstats::onStoreBlock(const csdb::Pool& block) {
+    // deferred block may be stored once more
+    if (isFolded(block)) {
+        return;
     }
 
-    while (!blockHash.is_empty() && !quit) {
-        const csdb::Pool pool = blockchain.loadBlock(blockHash);
+    fold(block, 1);
+}
 
-        auto now = std::chrono::system_clock::now();
-        auto poolTime_t = atoll(pool.user_field(0).value<std::string>().c_str()) / 1000;
-        auto poolTime = std::chrono::system_clock::from_time_t(poolTime_t);
+void csstats::onRemoveBlock(const csdb::Pool& block) {
+    {
+        ScopedLock lock(mutex);
 
-        using Seconds = std::chrono::seconds;
-        Seconds poolAgeSec = std::chrono::duration_cast<Seconds>(now - poolTime);
+        if (lastSequence == cs::kWrongSequence || block.sequence() != lastSequence) {
+            return;
+        }
+    }
 
-        if (startCutTime <= poolTime && poolTime < endCutTime) {
-            PeriodStats& periodStats = stats.first[currentCutIndex];
-            ++periodStats.poolsCount;
+    fold(block, -1);
+}
 
-            size_t transactionsCount = pool.transactions_count();
-            periodStats.transactionsCount += (uint32_t)transactionsCount;
+void csstats::fold(const csdb::Pool& block, int sign) {
+    Bucket delta;
+    delta.minute = atoll(block.user_field(0).value<std::string>().c_str()) / 1000 / secondsPerBucket;
+    delta.poolsCount = 1;
 
-            for (size_t i = 0; i < transactionsCount; ++i) {
-                const auto& transaction = pool.transaction(csdb::TransactionID(pool.hash(), i));
+    const auto& transactions = block.transactions();
+    delta.transactionsCount = static_cast<Count>(transactions.size());
+
+    const auto& genesis = blockchain.getGenesisAddress();
+
+    for (const auto& transaction : transactions) {
+        if (transaction.source() == genesis) {
+            continue;
+        }
 
 #ifdef MONITOR_NODE
-                if (is_smart(transaction) || is_smart_state(transaction))
-                    ++periodStats.transactionsSmartCount;
+        if (is_smart(transaction) || is_smart_state(transaction)) {
+            ++delta.transactionsSmartCount;
+        }
 #endif
 
-                if (is_deploy_transaction(transaction))
-                    ++periodStats.smartContractsCount;
+        if (is_deploy_transaction(transaction)) {
+            ++delta.smartContractsCount;
+        }
 
-                Currency currency = currencies_indexed[transaction.currency().to_string()];
+        const Currency currency = transaction.currency().id();
+        const auto& amount = transaction.amount();
 
-                const auto& amount = transaction.amount();
+        auto it = std::find_if(delta.balancePerCurrency.begin(), delta.balancePerCurrency.end(), [currency](const auto& element) { return element.first == currency; });
 
-                periodStats.balancePerCurrency[currency].integral += amount.integral();
-                periodStats.balancePerCurrency[currency].fraction += amount.fraction();
-            }
+        if (it == delta.balancePerCurrency.end()) {
+            it = delta.balancePerCurrency.insert(it, std::make_pair(currency, TotalAmount{}));
         }
-        else if ((currentCutIndex + 1) < stats.first.size()) {
-            startCutTime = stats.first[currentCutIndex].timeStamp;
-            endCutTime = stats.first[currentCutIndex + 1].timeStamp;
 
-            ++currentCutIndex;
-            continue;
-        }
+        ::add(it->second, TotalAmount{amount.integral(), static_cast<int64_t>(amount.fraction())}, 1);
+    }
 
-        matchPeriod(periods, (Period)poolAgeSec.count(), [&](size_t periodIndex) {
-            PeriodStats& periodStats = stats.second[periodIndex];
-            periodStats.poolsCount++;
+    ScopedLock lock(mutex);
 
-            size_t transactionsCount = pool.transactions_count();
-            periodStats.transactionsCount += (uint32_t)transactionsCount;
+    add(total, delta, sign);
 
-            for (size_t i = 0; i < transactionsCount; ++i) {
-                const auto& transaction = pool.transaction(csdb::TransactionID(pool.hash(), i));
+    if (delta.minute >= 0) {
+        auto& bucket = buckets[static_cast<size_t>(delta.minute) % bucketsCount];
 
-                if (transaction.source() == blockchain.getGenesisAddress())
-                    continue;
-#ifdef MONITOR_NODE
-                if (is_smart(transaction) || is_smart_state(transaction))
-                    ++periodStats.transactionsSmartCount;
-#endif
+        // the slot keeps the most recent minute only, older blocks remain in total
+        if (bucket.minute < delta.minute && sign > 0) {
+            bucket = Bucket{};
+            bucket.minute = delta.minute;
+        }
+
+        if (bucket.minute == delta.minute) {
+            add(bucket, delta, sign);
+        }
+    }
 
-                if (is_deploy_transaction(transaction))
-                    ++periodStats.smartContractsCount;
+    lastSequence = sign > 0 ? block.sequence() : block.sequence() - 1;
+    lastHash = sign > 0 ? block.hash() : block.previous_hash();
+    changed = true;
+}
 
-                Currency currency = currencies_indexed[transaction.currency().to_string()];
+bool csstats::isFolded(const csdb::Pool& block) {
+    ScopedLock lock(mutex);
+    return lastSequence != cs::kWrongSequence && block.sequence() <= lastSequence;
+}
 
-                const auto& amount = transaction.amount();
+void csstats::rebuild(cs::Sequence sequence) {
+    for (cs::Sequence i = 0; i < sequence; ++i) {
+        const auto block = blockchain.loadBlock(i);
 
-                periodStats.balancePerCurrency[currency].integral += amount.integral();
-                periodStats.balancePerCurrency[currency].fraction += amount.fraction();
-            }
-        });
+        if (block.is_valid()) {
+            fold(block, 1);
+        }
+    }
+}
+
+void csstats::reset() {
+    buckets.assign(bucketsCount, Bucket{});
+    total = PeriodStats{};
+    total.periodSec = collectionPeriods[PeriodIndex::Total];
+    lastSequence = cs::kWrongSequence;
+    lastHash = csdb::PoolHash{};
+    changed = true;
+}
 
-        blockHash = pool.previous_hash();
+void csstats::add(Bucket& bucket, const Bucket& delta, int sign) {
+    bucket.poolsCount += sign * delta.poolsCount;
+    bucket.transactionsCount += sign * delta.transactionsCount;
+    bucket.smartContractsCount += sign * delta.smartContractsCount;
+    bucket.transactionsSmartCount += sign * delta.transactionsSmartCount;
 
-        ++cnt;
-        if (log_to_console && (cnt % 1000) == 0) {
-            std::cout << '\r' << WithDelimiters(cnt);
+    for (const auto& [currency, amount] : delta.balancePerCurrency) {
+        auto it = std::find_if(bucket.balancePerCurrency.begin(), bucket.balancePerCurrency.end(), [currency = currency](const auto& element) { return element.first == currency; });
+
+        if (it == bucket.balancePerCurrency.end()) {
+            it = bucket.balancePerCurrency.insert(it, std::make_pair(currency, TotalAmount{}));
         }
+
+        ::add(it->second, amount, sign);
     }
+}
 
-    if (log_to_console) {
-        std::cout << '\r' << WithDelimiters(cnt) << "... Done\n";
-        log_to_console = false;
+void csstats::add(PeriodStats& stats, const Bucket& bucket, int sign) {
+    stats.poolsCount += sign * bucket.poolsCount;
+    stats.transactionsCount += sign * bucket.transactionsCount;
+    stats.smartContractsCount += sign * bucket.smartContractsCount;
+    stats.transactionsSmartCount += sign * bucket.transactionsSmartCount;
+
+    for (const auto& [currency, amount] : bucket.balancePerCurrency) {
+        ::add(stats.balancePerCurrency[currency], amount, sign);
     }
+}
 
-    // lastHash = blockchain.getLastHash();
-    lastHash = future_lastHash;
+bool csstats::load() {
+    std::ifstream file(kStatsPath, std::ios::binary);
 
-    auto finishTime = std::chrono::system_clock::now();
-    auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(finishTime - startTime);
+    if (!file) {
+        return false;
+    }
 
-    cstrace() << "Collecting All stats: finished (took " << milliseconds.count() << "ms)";
+    cs::Bytes bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    cs::DataStream stream(bytes.data(), bytes.size());
 
-    return stats;
-}*/
+    auto readBalances = [&stream](auto& balances) {
+        uint32_t count = 0;
+        stream >> count;
 
-csstats::csstats(BlockChain& blockchain)
-: blockchain(blockchain) {
-    cstrace() << "STATS> csstats start "
-              << "update interval is " << updateTimeSec << " sec";
-}
+        for (uint32_t i = 0; i < count && stream.isValid(); ++i) {
+            Currency currency = 0;
+            TotalAmount amount;
 
-void csstats::run(const ::csstats::AllStats& allStats) {
-    csunused(allStats);
-#ifndef STATS
-    csunused(allStats);
-    return;
-#else
-    ScopedLock lock(mutex);
+            stream >> currency >> amount.integral >> amount.fraction;
+            balances[currency] = amount;
+        }
+    };
 
-	//lastHash = blockchain.getLastHash();
+    uint32_t version = 0;
+    stream >> version;
 
-    thread = std::thread([this, allStats]() {
-        cstrace() << "STATS> csstats thread started";
+    if (version != kStatsVersion) {
+        cswarning() << "STATS> rollups of unknown version " << version << " are dropped";
+        return false;
+    }
 
-        currentStats = std::move(allStats.second);
-        statsCut = std::move(allStats.first);
+    PeriodStats loadedTotal;
+    cs::Sequence sequence = cs::kWrongSequence;
+    csdb::PoolHash hash;
 
-        assert(currentStats.size() == collectionPeriods.size());
+    stream >> sequence >> hash;
+    stream >> loadedTotal.poolsCount >> loadedTotal.transactionsCount >> loadedTotal.smartContractsCount >> loadedTotal.transactionsSmartCount;
+    readBalances(loadedTotal.balancePerCurrency);
 
-        for (auto i = 0ull; i < currentStats.size(); ++i)
-            currentStats[i].periodSec = collectionPeriods[i];
+    std::vector<Bucket> loadedBuckets(bucketsCount);
+    uint32_t count = 0;
+    stream >> count;
 
-        while (!quit) {
-            using namespace std::chrono_literals;
+    for (uint32_t i = 0; i < count && stream.isValid(); ++i) {
+        Bucket bucket;
+        stream >> bucket.minute >> bucket.poolsCount >> bucket.transactionsCount >> bucket.smartContractsCount >> bucket.transactionsSmartCount;
 
-            if (!quit) {
-                auto periods = collectionPeriods;
-                periods.pop_back();
+        std::map<Currency, TotalAmount> balances;
+        readBalances(balances);
+        bucket.balancePerCurrency.assign(balances.begin(), balances.end());
 
-                StatsPerPeriod stats = collectStats(periods);
+        if (bucket.minute >= 0) {
+            loadedBuckets[static_cast<size_t>(bucket.minute) % bucketsCount] = std::move(bucket);
+        }
+    }
 
-                for (auto& s : stats) {
-                    std::stringstream ss;
-                    ss << "Period " << s.periodSec << " collected ";
-                    ss << s.poolsCount << " pools, " << s.transactionsCount;
-                    ss << " transactions";
+    if (!stream.isValid()) {
+        cswarning() << "STATS> rollups file is damaged, blocks will be rescanned";
+        return false;
+    }
 
-                    cstrace() << "STATS> " << ss.str();
-#ifdef LOG_STATS_TO_FILE
-                    cstrace() << "STATS> " << ss.str();
+    ScopedLock lock(mutex);
 
-                    ss.str(std::string());
+    loadedTotal.periodSec = total.periodSec;
+    total = std::move(loadedTotal);
+    buckets = std::move(loadedBuckets);
+    lastSequence = sequence;
+    lastHash = hash;
 
-                    ss << "Blockchain size:";
-                    ss << this->blockchain.getSize();
+    return true;
+}
 
-                    cstrace() << "STATS> " << ss.str();
-#endif
-                    for (auto& t : s.balancePerCurrency) {
-                        cstrace() << "STATS> "
-                                  << "'" << t.first << "' = " << std::to_string(t.second.integral) << "." << std::to_string(t.second.fraction);
-                    }
-                }
-
-                {
-                    ScopedLock lock(currentStatsMutex);
-                    currentStats = std::move(stats);
-                }
-            }
+void csstats::save() {
+    cs::Bytes bytes;
+
+    {
+        cs::DataStream stream(bytes);
+        ScopedLock lock(mutex);
 
-            std::this_thread::sleep_for(std::chrono::seconds(updateTimeSec));
+        if (!changed) {
+            return;
         }
 
-        cstrace() << "STATS> csstats thread stopped";
-    });
+        stream << kStatsVersion << lastSequence << lastHash;
+        stream << total.poolsCount << total.transactionsCount << total.smartContractsCount << total.transactionsSmartCount;
 
-#endif
-}
+        stream << static_cast<uint32_t>(total.balancePerCurrency.size());
 
-csstats::~csstats() {
-    cstrace() << "STATS> csstats stop";
+        for (const auto& [currency, amount] : total.balancePerCurrency) {
+            stream << currency << amount.integral << amount.fraction;
+        }
 
-    ScopedLock lock(mutex);
+        const auto count = std::count_if(buckets.begin(), buckets.end(), [](const Bucket& bucket) { return bucket.minute >= 0; });
+        stream << static_cast<uint32_t>(count);
 
-    quit = true;
+        for (const auto& bucket : buckets) {
+            if (bucket.minute < 0) {
+                continue;
+            }
 
-    if (thread.joinable()) {
-        thread.join();
+            stream << bucket.minute << bucket.poolsCount << bucket.transactionsCount << bucket.smartContractsCount << bucket.transactionsSmartCount;
+            stream << static_cast<uint32_t>(bucket.balancePerCurrency.size());
+
+            for (const auto& [currency, amount] : bucket.balancePerCurrency) {
+                stream << currency << amount.integral << amount.fraction;
+            }
+        }
+
+        changed = false;
     }
-}
 
-StatsPerPeriod csstats::getStats() {
-    ScopedLock lock(currentStatsMutex);
-    return currentStats;
+    csdb::internal::path_make("./caches");
+
+    // rollups are replaced at once, so a crash while saving keeps the previous file
+    const std::string temporary = std::string(kStatsPath) + ".tmp";
+
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+        if (!file) {
+            cswarning() << "STATS> can not write rollups to " << temporary;
+            return;
+        }
+    }
+
+    if (std::rename(temporary.c_str(), kStatsPath) != 0) {
+        cswarning() << "STATS> can not replace rollups file " << kStatsPath;
+    }
 }
 }  // namespace csstats
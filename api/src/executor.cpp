@@ -1,22 +1,40 @@
 #include <executor.hpp>
 
-#if defined(_MSC_VER)
-#pragma warning(push, 0)
-#endif
-
-#include <thrift/transport/TBufferTransports.h>
-
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
-
 #include "serializer.hpp"
 
 #include <csnode/configholder.hpp>
 
+#include <lib/system/hash.hpp>
+
 #include <solver/solvercore.hpp>
 #include <solver/smartcontracts.hpp>
 
+namespace {
+constexpr const char* kStatesPath = "./caches/contractstates";
+
+// getter result depends on contract binary (address, byte code and state), caller and called methods with params
+cs::Hash getterKey(const std::string& caller, const executor::SmartContractBinary& binary, const std::vector<executor::MethodHeader>& headers) {
+    std::string data = cs::Serializer::serialize(binary);
+    data += caller;
+
+    for (const auto& header : headers) {
+        data += cs::Serializer::serialize(header);
+    }
+
+    return generateHash(data.data(), data.size());
+}
+
+// speculative result is reused only if everything passed to executor is the same
+cs::Hash speculationKey(const std::string& caller, const executor::SmartContractBinary& binary, const std::vector<executor::MethodHeader>& headers, cs::Sequence sequence) {
+    const auto key = getterKey(caller, binary, headers);
+
+    cs::Bytes data(key.begin(), key.end());
+    data.insert(data.end(), reinterpret_cast<const cs::Byte*>(&sequence), reinterpret_cast<const cs::Byte*>(&sequence) + sizeof(sequence));
+
+    return generateHash(data.data(), data.size());
+}
+}  // namespace
+
 void cs::ExecutorSettings::set(cs::Reference<const BlockChain> blockchain, cs::Reference<const cs::SolverCore> solver) {
     blockchain_ = blockchain;
     solver_ = solver;
@@ -35,26 +53,58 @@ cs::ExecutorSettings::Types cs::ExecutorSettings::get() {
 void cs::Executor::executeByteCode(executor::ExecuteByteCodeResult& resp, const std::string& address, const std::string& smart_address,
                                    const std::vector<general::ByteCodeObject>& code, const std::string& state,
                                    std::vector<executor::MethodHeader>& methodHeader, bool isGetter, cs::Sequence sequence) {
-    static std::mutex mutex;
-    std::lock_guard lock(mutex);  // temporary solution
+    if (code.empty()) {
+        return;
+    }
 
-    if (!code.empty()) {
-        executor::SmartContractBinary smartContractBinary;
-        smartContractBinary.contractAddress = smart_address;
-        smartContractBinary.object.byteCodeObjects = code;
-        smartContractBinary.object.instance = state;
-        smartContractBinary.stateCanModify = solver_.isContractLocked(BlockChain::getAddressFromKey(smart_address)) ? true : false;
+    const auto contract = BlockChain::getAddressFromKey(smart_address);
+
+    executor::SmartContractBinary smartContractBinary;
+    smartContractBinary.contractAddress = smart_address;
+    smartContractBinary.object.byteCodeObjects = code;
+    smartContractBinary.object.instance = state;
+    smartContractBinary.stateCanModify = solver_.isContractLocked(contract) ? true : false;
 
+    if (!isGetter) {
         if (auto optOriginRes = execute(address, smartContractBinary, methodHeader, isGetter, sequence)) {
             resp = optOriginRes.value().resp;
         }
+
+        return;
+    }
+
+    // failed execution is returned as is but not cached
+    std::optional<executor::ExecuteByteCodeResult> failed;
+
+    auto result = getterCache_.get(contract, getterKey(address, smartContractBinary, methodHeader), [&]() -> std::optional<executor::ExecuteByteCodeResult> {
+        auto optOriginRes = execute(address, smartContractBinary, methodHeader, isGetter, sequence);
+
+        if (!optOriginRes.has_value()) {
+            return std::nullopt;
+        }
+
+        if (optOriginRes.value().resp.status.code != 0) {
+            failed = std::move(optOriginRes.value().resp);
+            return std::nullopt;
+        }
+
+        return std::make_optional(std::move(optOriginRes.value().resp));
+    });
+
+    if (result.has_value()) {
+        resp = std::move(result).value();
+    }
+    else if (failed.has_value()) {
+        resp = std::move(failed).value();
     }
 }
 
 void cs::Executor::executeByteCodeMultiple(executor::ExecuteByteCodeMultipleResult& _return, const general::Address& initiatorAddress,
                                            const executor::SmartContractBinary& invokedContract, const std::string& method,
                                            const std::vector<std::vector<general::Variant>>& params, const int64_t executionTime, cs::Sequence sequence) {
-    if (!isConnected()) {
+    auto lease = connections_.acquire(ExecutorLane::Getter);
+
+    if (!lease) {
         _return.status.code = 1;
         _return.status.message = "No executor connection!";
 
@@ -66,14 +116,10 @@ void cs::Executor::executeByteCodeMultiple(executor::ExecuteByteCodeMultipleResu
     ++execCount_;
 
     try {
-        std::shared_lock lock(sharedErrorMutex_);
-        origExecutor_->executeByteCodeMultiple(_return, static_cast<general::AccessID>(accessId), initiatorAddress, invokedContract, method, params, executionTime, EXECUTOR_VERSION);
+        lease->executeByteCodeMultiple(_return, static_cast<general::AccessID>(accessId), initiatorAddress, invokedContract, method, params, executionTime, EXECUTOR_VERSION);
     }
     catch (::apache::thrift::transport::TTransportException& x) {
-        // sets stop_ flag to true forever, replace with new instance
-        if (x.getType() == ::apache::thrift::transport::TTransportException::NOT_OPEN) {
-            recreateOriginExecutor();
-        }
+        lease.invalidate();
 
         _return.status.code = 1;
         _return.status.message = x.what();
@@ -81,6 +127,8 @@ void cs::Executor::executeByteCodeMultiple(executor::ExecuteByteCodeMultipleResu
         notifyError();
     }
     catch (std::exception& x) {
+        lease.invalidate();
+
         _return.status.code = 1;
         _return.status.message = x.what();
 
@@ -92,15 +140,21 @@ void cs::Executor::executeByteCodeMultiple(executor::ExecuteByteCodeMultipleResu
 }
 
 void cs::Executor::getContractMethods(executor::GetContractMethodsResult& _return, const std::vector<general::ByteCodeObject>& byteCodeObjects) {
+    auto lease = connections_.acquire(ExecutorLane::Getter);
+
+    if (!lease) {
+        _return.status.code = 1;
+        _return.status.message = "No executor connection!";
+
+        notifyError();
+        return;
+    }
+
     try {
-        std::shared_lock lock(sharedErrorMutex_);
-        origExecutor_->getContractMethods(_return, byteCodeObjects, EXECUTOR_VERSION);
+        lease->getContractMethods(_return, byteCodeObjects, EXECUTOR_VERSION);
     }
     catch (const ::apache::thrift::transport::TTransportException& x) {
-        // sets stop_ flag to true forever, replace with new instance
-        if (x.getType() == ::apache::thrift::transport::TTransportException::NOT_OPEN) {
-            recreateOriginExecutor();
-        }
+        lease.invalidate();
 
         _return.status.code = 1;
         _return.status.message = x.what();
@@ -108,6 +162,8 @@ void cs::Executor::getContractMethods(executor::GetContractMethodsResult& _retur
         notifyError();
     }
     catch(const std::exception& x ) {
+        lease.invalidate();
+
         _return.status.code = 1;
         _return.status.message = x.what();
 
@@ -116,15 +172,21 @@ void cs::Executor::getContractMethods(executor::GetContractMethodsResult& _retur
 }
 
 void cs::Executor::getContractVariables(executor::GetContractVariablesResult& _return, const std::vector<general::ByteCodeObject>& byteCodeObjects, const std::string& contractState) {
+    auto lease = connections_.acquire(ExecutorLane::Getter);
+
+    if (!lease) {
+        _return.status.code = 1;
+        _return.status.message = "No executor connection!";
+
+        notifyError();
+        return;
+    }
+
     try {
-        std::shared_lock lock(sharedErrorMutex_);
-        origExecutor_->getContractVariables(_return, byteCodeObjects, contractState, EXECUTOR_VERSION);
+        lease->getContractVariables(_return, byteCodeObjects, contractState, EXECUTOR_VERSION);
     }
     catch (const ::apache::thrift::transport::TTransportException& x) {
-        // sets stop_ flag to true forever, replace with new instance
-        if (x.getType() == ::apache::thrift::transport::TTransportException::NOT_OPEN) {
-            recreateOriginExecutor();
-        }
+        lease.invalidate();
 
         _return.status.code = 1;
         _return.status.message = x.what();
@@ -132,6 +194,8 @@ void cs::Executor::getContractVariables(executor::GetContractVariablesResult& _r
         notifyError();
     }
     catch(const std::exception& x ) {
+        lease.invalidate();
+
         _return.status.code = 1;
         _return.status.message = x.what();
 
@@ -140,15 +204,21 @@ void cs::Executor::getContractVariables(executor::GetContractVariablesResult& _r
 }
 
 void cs::Executor::compileSourceCode(executor::CompileSourceCodeResult& _return, const std::string& sourceCode) {
+    auto lease = connections_.acquire(ExecutorLane::Compile);
+
+    if (!lease) {
+        _return.status.code = 1;
+        _return.status.message = "No executor connection!";
+
+        notifyError();
+        return;
+    }
+
     try {
-        std::shared_lock slk(sharedErrorMutex_);
-        origExecutor_->compileSourceCode(_return, sourceCode, EXECUTOR_VERSION);
+        lease->compileSourceCode(_return, sourceCode, EXECUTOR_VERSION);
     }
     catch (::apache::thrift::transport::TTransportException& x) {
-        // sets stop_ flag to true forever, replace with new instance
-        if (x.getType() == ::apache::thrift::transport::TTransportException::NOT_OPEN) {
-            recreateOriginExecutor();
-        }
+        lease.invalidate();
 
         _return.status.code = 1;
         _return.status.message = x.what();
@@ -156,6 +226,8 @@ void cs::Executor::compileSourceCode(executor::CompileSourceCodeResult& _return,
         notifyError();
     }
     catch(const std::exception& x ) {
+        lease.invalidate();
+
         _return.status.code = 1;
         _return.status.message = x.what();
 
@@ -164,15 +236,21 @@ void cs::Executor::compileSourceCode(executor::CompileSourceCodeResult& _return,
 }
 
 void cs::Executor::getExecutorBuildVersion(executor::ExecutorBuildVersionResult& _return) {
+    auto lease = connections_.acquire(ExecutorLane::Consensus);
+
+    if (!lease) {
+        _return.status.code = 1;
+        _return.status.message = "No executor connection!";
+
+        notifyError();
+        return;
+    }
+
     try {
-        std::shared_lock slk(sharedErrorMutex_);
-        origExecutor_->getExecutorBuildVersion(_return, EXECUTOR_VERSION);
+        lease->getExecutorBuildVersion(_return, EXECUTOR_VERSION);
     }
     catch (::apache::thrift::transport::TTransportException& x) {
-        // sets stop_ flag to true forever, replace with new instance
-        if (x.getType() == ::apache::thrift::transport::TTransportException::NOT_OPEN) {
-            recreateOriginExecutor();
-        }
+        lease.invalidate();
 
         _return.status.code = 1;
         _return.status.message = x.what();
@@ -180,6 +258,8 @@ void cs::Executor::getExecutorBuildVersion(executor::ExecutorBuildVersionResult&
         notifyError();
     }
     catch (const std::exception& x) {
+        lease.invalidate();
+
         _return.status.code = 1;
         _return.status.message = x.what();
 
@@ -193,11 +273,23 @@ cs::Executor& cs::Executor::instance() {
 }
 
 bool cs::Executor::isConnected() const {
-    return executorTransport_->isOpen();
+    return connections_.isConnected();
 }
 
 void cs::Executor::stop() {
     requestStop_ = true;
+    connections_.stop();
+
+    const auto getters = getterCache_.statistics();
+    csdebug() << "Executor getter cache: hits " << getters.hits << ", misses " << getters.misses << ", coalesced " << getters.coalesced;
+
+    const auto speculations = speculationStatistics();
+    csdebug() << "Executor speculations: started " << speculations.started << ", dropped " << speculations.dropped << ", hits " << speculations.hits
+              << ", misses " << speculations.misses << ", saved " << speculations.saved.toString();
+
+    const auto states = states_.statistics();
+    csdebug() << "Executor contract states: " << states.states << " states of " << states.logicalBytes << " bytes kept in "
+              << states.chunks << " chunks of " << states.chunkBytes << " bytes and " << states.recipeBytes << " bytes of chunk lists";
 
     while (isWatcherRunning_.load(std::memory_order_acquire)) {
         notifyError(); // wake up watching thread if it sleeps
@@ -216,6 +308,35 @@ void cs::Executor::stop() {
     }
 }
 
+cs::LatencyHistogram::Snapshot cs::Executor::latency(ExecutorLane lane) const {
+    return connections_.latency(lane);
+}
+
+cs::Executor::GetterCacheStatistics cs::Executor::getterCacheStatistics() const {
+    return getterCache_.statistics();
+}
+
+cs::Executor::SpeculationStatistics cs::Executor::speculationStatistics() const {
+    const auto speculations = speculations_.statistics();
+
+    SpeculationStatistics statistics;
+    statistics.started = speculations.started;
+    statistics.dropped = speculationsDropped_.load();
+    statistics.hits = speculations.hits;
+    statistics.misses = speculations.misses;
+    statistics.saved = speculationSaved_.snapshot();
+
+    return statistics;
+}
+
+void cs::Executor::onCallback(const general::AccessID& accessId) {
+    speculations_.onCallback(accessId);
+}
+
+void cs::Executor::onCallback() {
+    speculations_.onCallback();
+}
+
 std::optional<cs::Sequence> cs::Executor::getSequence(const general::AccessID& accessId) {
     std::shared_lock lock(mutex_);
 
@@ -243,7 +364,12 @@ void cs::Executor::updateDeployTrxns(const csdb::Address& address, const csdb::T
 
 void cs::Executor::setLastState(const csdb::Address& address, const std::string& state) {
     std::lock_guard lock(mutex_);
-    lastState_[address] = state;
+    const auto id = states_.put(address, state);
+
+    if (auto [it, inserted] = lastState_.try_emplace(address, id); !inserted) {
+        states_.release(it->second);
+        it->second = id;
+    }
 }
 
 std::optional<std::string> cs::Executor::getState(const csdb::Address& address) {
@@ -262,35 +388,78 @@ std::optional<std::string> cs::Executor::getState(const csdb::Address& address)
     return std::make_optional(std::move(state));
 }
 
-void cs::Executor::updateCacheLastStates(const csdb::Address& address, const cs::Sequence& sequence, const std::string& state) {
-    std::lock_guard lock(mutex_);
+std::optional<std::string> cs::Executor::getAccessState(const general::AccessID& accessId, const csdb::Address& address) {
+    if (const auto accessSequence = getSequence(accessId); accessSequence.has_value()) {
+        if (const auto id = blockchain_.getStateTransaction(address, accessSequence.value()); id.is_valid()) {
+            if (auto state = loadAccessState(address, id); state.has_value()) {
+                return state;
+            }
+        }
+    }
+
+    return getState(address);
+}
+
+std::optional<std::string> cs::Executor::loadAccessState(const csdb::Address& address, const csdb::TransactionID& id) {
+    {
+        std::lock_guard lock(accessStatesMutex_);
 
-    if (execCount_) {
-        (cacheLastStates_[address])[sequence] = state;
+        if (auto it = accessStates_.find(id); it != accessStates_.end()) {
+            accessStatesOrder_.splice(accessStatesOrder_.begin(), accessStatesOrder_, it->second);
+            return states_.get(it->second->second);
+        }
     }
-    else if (cacheLastStates_.size()) {
-        cacheLastStates_.clear();
+
+    const auto transaction = loadTransactionApi(id);
+
+    if (!transaction.is_valid()) {
+        return std::nullopt;
     }
-}
 
-std::optional<std::string> cs::Executor::getAccessState(const general::AccessID& accessId, const csdb::Address& address) {
-    std::shared_lock lock(mutex_);
-    const auto accessSequence = getSequence(accessId);
+    std::optional<std::string> state;
+    ContractStateStore::StateId stateId;
 
-    if (const auto unmapStatesIter = cacheLastStates_.find(address); unmapStatesIter != cacheLastStates_.end()) {
-        std::pair<cs::Sequence, std::string> prevSeqState{};
+    if (const auto value = transaction.user_field(cs::trx_uf::new_state::Value); value.is_valid() && !value.value<std::string>().empty()) {
+        state = value.value<std::string>();
+        stateId = states_.put(address, state.value());
+    }
+    else {
+        // hashed state is available only if it is still held by store
+        const auto hash = transaction.user_field(cs::trx_uf::new_state::Hash).value<std::string>();
 
-        for (const auto& [currSeq, currState] : unmapStatesIter->second) {
-            if (currSeq > accessSequence) {
-                return prevSeqState.first ? std::make_optional<std::string>(prevSeqState.second) : std::nullopt;
-            }
+        if (hash.size() != stateId.size()) {
+            return std::nullopt;
+        }
+
+        std::copy(hash.begin(), hash.end(), stateId.begin());
+        states_.acquire(stateId);
+        state = states_.get(stateId);
 
-            prevSeqState = { currSeq, currState };
+        if (!state.has_value()) {
+            states_.release(stateId);
+            return std::nullopt;
         }
     }
 
-    auto lastState = getState(address);
-    return lastState.has_value() ? std::make_optional<std::string>(std::move(lastState).value()) : std::nullopt;
+    std::lock_guard lock(accessStatesMutex_);
+
+    if (accessStates_.count(id)) {
+        states_.release(stateId);
+        return state;
+    }
+
+    accessStatesOrder_.emplace_front(id, stateId);
+    accessStates_.emplace(id, accessStatesOrder_.begin());
+
+    if (accessStatesOrder_.size() > kAccessStatesCapacity) {
+        const auto& [lastId, lastStateId] = accessStatesOrder_.back();
+
+        states_.release(lastStateId);
+        accessStates_.erase(lastId);
+        accessStatesOrder_.pop_back();
+    }
+
+    return state;
 }
 
 void cs::Executor::addInnerSendTransaction(const general::AccessID& accessId, const csdb::Transaction& transaction) {
@@ -326,6 +495,123 @@ bool cs::Executor::isDeploy(const csdb::Transaction& transaction) {
 }
 
 std::optional<cs::Executor::ExecuteResult> cs::Executor::executeTransaction(const std::vector<cs::Executor::ExecuteTransactionInfo>& smarts, std::string forceContractState) {
+    auto invocation = makeInvocation(smarts, forceContractState);
+
+    if (!invocation.has_value()) {
+        return std::nullopt;
+    }
+
+    for (const auto& addrLock : invocation->usedContracts) {
+        addToLockSmart(addrLock, static_cast<general::AccessID>(getFutureAccessId()));
+    }
+
+    const auto optOriginRes = (smarts.size() == 1) ? executeSpeculated(smarts.front(), invocation.value())
+                                                   : execute(invocation->source, invocation->binary, invocation->headers, false /*isGetter*/, smarts[0].sequence /*sequence*/);
+
+    for (const auto& smart : smarts) {
+        if (!invocation->isDeploy) {
+            if (smart.convention == MethodNameConvention::Default) {
+                const auto fld = smart.transaction.user_field(0);
+                if (fld.is_valid()) {
+                    auto sci = cs::Serializer::deserialize<api::SmartContractInvocation>(smart.transaction.user_field(0).value<std::string>());
+                    for (const auto& addrLock : sci.usedContracts) {
+                        deleteFromLockSmart(addrLock, static_cast<general::AccessID>(getFutureAccessId()));
+                    }
+                }
+            }
+        }
+    }
+
+    if (!optOriginRes.has_value()) {
+        return std::nullopt;
+    }
+
+    // fill res
+    ExecuteResult res;
+    res.response = optOriginRes.value().resp.status;
+
+    deleteInnerSendTransactions(optOriginRes.value().acceessId);
+    res.selfMeasuredCost = static_cast<long>(optOriginRes.value().timeExecute);
+
+    for (const auto& setters : optOriginRes.value().resp.results) {
+        auto& smartRes = res.smartsRes.emplace_back(ExecuteResult::SmartRes{});
+        smartRes.retValue = setters.ret_val;
+        smartRes.executionCost = setters.executionCost;
+        smartRes.response = setters.status;
+
+        for (auto& states : setters.contractsState) {  // state
+            auto addr = BlockChain::getAddressFromKey(states.first);
+            smartRes.states[BlockChain::getAddressFromKey(states.first)] = states.second;
+        }
+
+        for (auto transaction : setters.emittedTransactions) {  // emittedTransactions
+            ExecuteResult::EmittedTrxn emittedTrxn;
+            emittedTrxn.source = BlockChain::getAddressFromKey(transaction.source);
+            emittedTrxn.target = BlockChain::getAddressFromKey(transaction.target);
+            emittedTrxn.amount = csdb::Amount(transaction.amount.integral, static_cast<uint64_t>(transaction.amount.fraction));
+            emittedTrxn.userData = transaction.userData;
+            smartRes.emittedTransactions.push_back(emittedTrxn);
+        }
+    }
+
+    return std::make_optional(std::move(res));
+}
+
+void cs::Executor::speculate(const ExecuteTransactionInfo& smart) {
+    if (speculationsInFlight_ == 0 || requestStop_ || !isConnected()) {
+        return;
+    }
+
+    if (!smart.transaction.is_valid() || !smart.deploy.is_valid() || smart.convention != MethodNameConvention::Default) {
+        return;
+    }
+
+    // speculation never waits for executor, it is dropped if there is no free speculative slot
+    if (speculating_.fetch_add(1) >= speculationsInFlight_) {
+        --speculating_;
+        ++speculationsDropped_;
+        return;
+    }
+
+    auto runnable = [this, smart] {
+        auto invocation = makeInvocation({smart}, std::string{});
+
+        // calls of other contracts depend on their states, so they are never speculated
+        if (invocation.has_value() && !invocation->isDeploy && invocation->usedContracts.empty()) {
+            const auto key = speculationKey(invocation->source, invocation->binary, invocation->headers, smart.sequence);
+            const auto contract = BlockChain::getAddressFromKey(invocation->binary.contractAddress);
+
+            if (speculations_.start(smart.transaction.signature(), key)) {
+                speculations_.run(contract, key, [&]() -> std::optional<OriginExecuteResult> {
+                    auto result = execute(invocation->source, invocation->binary, invocation->headers, false /*isGetter*/, smart.sequence, ExecutorLane::Speculative);
+
+                    if (!result.has_value()) {
+                        return std::nullopt;
+                    }
+
+                    // result depends on what node answered, not only on inputs
+                    if (result.value().isCalledBack) {
+                        deleteInnerSendTransactions(result.value().acceessId);
+                        return std::nullopt;
+                    }
+
+                    if (result.value().resp.status.code != 0) {
+                        return std::nullopt;
+                    }
+
+                    return result;
+                });
+            }
+        }
+
+        --speculating_;
+    };
+
+    // speculations wait for executor, they must not hold workers of thread pool
+    cs::Concurrent::run(runnable, cs::ConcurrentPolicy::Thread);
+}
+
+std::optional<cs::Executor::Invocation> cs::Executor::makeInvocation(const std::vector<ExecuteTransactionInfo>& smarts, const std::string& forceContractState) {
     if (smarts.empty()) {
         return std::nullopt;
     }
@@ -350,17 +636,20 @@ std::optional<cs::Executor::ExecuteResult> cs::Executor::executeTransaction(cons
     auto smartSource = blockchain_.getAddressByType(source, BlockChain::AddressType::PublicKey);
     auto smartTarget = blockchain_.getAddressByType(target, BlockChain::AddressType::PublicKey);
 
+    Invocation invocation;
+    invocation.source = smartSource.to_api_addr();
+
     // get deploy transaction
-    const auto isdeploy = (headTransaction.id() == deployTrxn.id()); //isDeploy(head_transaction);
+    invocation.isDeploy = (headTransaction.id() == deployTrxn.id()); //isDeploy(head_transaction);
 
     // fill smartContractBinary
     const auto sciDeploy = cs::Serializer::deserialize<api::SmartContractInvocation>(deployTrxn.user_field(cs::trx_uf::deploy::Code).value<std::string>());
-    executor::SmartContractBinary smartContractBinary;
+    executor::SmartContractBinary& smartContractBinary = invocation.binary;
     smartContractBinary.contractAddress = smartTarget.to_api_addr();
     smartContractBinary.object.byteCodeObjects = sciDeploy.smartContractDeploy.byteCodeObjects;
 
     // may contain temporary last new state not yet written into block chain (to allow "speculative" multi-executions of the same contract)
-    if (!isdeploy) {
+    if (!invocation.isDeploy) {
         if (!forceContractState.empty()) {
             smartContractBinary.object.instance = forceContractState;
         }
@@ -376,7 +665,6 @@ std::optional<cs::Executor::ExecuteResult> cs::Executor::executeTransaction(cons
     smartContractBinary.stateCanModify = solver_.isContractLocked(smartTarget);
 
     // fill methodHeaders
-    std::vector<executor::MethodHeader> methodHeaders;
     for (const auto& smartItem : smarts) {
         executor::MethodHeader header;
         const csdb::Transaction& smart = smartItem.transaction;
@@ -420,69 +708,44 @@ std::optional<cs::Executor::ExecuteResult> cs::Executor::executeTransaction(cons
             if (!fld.is_valid()) {
                 return std::nullopt;
             }
-            else if (!isdeploy) {
+            else if (!invocation.isDeploy) {
                 sci = cs::Serializer::deserialize<api::SmartContractInvocation>(fld.value<std::string>());
                 header.methodName = sci.method;
                 header.params = sci.params;
 
-                for (const auto& addrLock : sci.usedContracts) {
-                    addToLockSmart(addrLock, static_cast<general::AccessID>(getFutureAccessId()));
-                }
+                invocation.usedContracts.insert(invocation.usedContracts.end(), sci.usedContracts.begin(), sci.usedContracts.end());
             }
         }
 
-        methodHeaders.push_back(header);
+        invocation.headers.push_back(header);
     }
 
-    const auto optOriginRes = execute(smartSource.to_api_addr(), smartContractBinary, methodHeaders, false /*isGetter*/, smarts[0].sequence /*sequence*/);
+    return std::make_optional(std::move(invocation));
+}
 
-    for (const auto& smart : smarts) {
-        if (!isdeploy) {
-            if (smart.convention == MethodNameConvention::Default) {
-                const auto fld = smart.transaction.user_field(0);
-                if (fld.is_valid()) {
-                    auto sci = cs::Serializer::deserialize<api::SmartContractInvocation>(smart.transaction.user_field(0).value<std::string>());
-                    for (const auto& addrLock : sci.usedContracts) {
-                        deleteFromLockSmart(addrLock, static_cast<general::AccessID>(getFutureAccessId()));
-                    }
-                }
-            }
-        }
-    }
+std::optional<cs::Executor::OriginExecuteResult> cs::Executor::executeSpeculated(const ExecuteTransactionInfo& smart, Invocation& invocation) {
+    auto executeNow = [&] {
+        return execute(invocation.source, invocation.binary, invocation.headers, false /*isGetter*/, smart.sequence);
+    };
 
-    if (!optOriginRes.has_value()) {
-        return std::nullopt;
+    if (speculationsInFlight_ == 0 || invocation.isDeploy || !invocation.usedContracts.empty()) {
+        return executeNow();
     }
 
-    // fill res
-    ExecuteResult res;
-    res.response = optOriginRes.value().resp.status;
+    // state or anything else the call depends on may have changed since speculation
+    const auto key = speculationKey(invocation.source, invocation.binary, invocation.headers, smart.sequence);
+    const auto start = std::chrono::steady_clock::now();
 
-    deleteInnerSendTransactions(optOriginRes.value().acceessId);
-    res.selfMeasuredCost = static_cast<long>(optOriginRes.value().timeExecute);
+    auto result = speculations_.take(smart.transaction.signature(), BlockChain::getAddressFromKey(invocation.binary.contractAddress), key);
 
-    for (const auto& setters : optOriginRes.value().resp.results) {
-        auto& smartRes = res.smartsRes.emplace_back(ExecuteResult::SmartRes{});
-        smartRes.retValue = setters.ret_val;
-        smartRes.executionCost = setters.executionCost;
-        smartRes.response = setters.status;
-
-        for (auto& states : setters.contractsState) {  // state
-            auto addr = BlockChain::getAddressFromKey(states.first);
-            smartRes.states[BlockChain::getAddressFromKey(states.first)] = states.second;
-        }
-
-        for (auto transaction : setters.emittedTransactions) {  // emittedTransactions
-            ExecuteResult::EmittedTrxn emittedTrxn;
-            emittedTrxn.source = BlockChain::getAddressFromKey(transaction.source);
-            emittedTrxn.target = BlockChain::getAddressFromKey(transaction.target);
-            emittedTrxn.amount = csdb::Amount(transaction.amount.integral, static_cast<uint64_t>(transaction.amount.fraction));
-            emittedTrxn.userData = transaction.userData;
-            smartRes.emittedTransactions.push_back(emittedTrxn);
-        }
+    if (!result.has_value()) {
+        return executeNow();
     }
 
-    return std::make_optional(std::move(res));
+    const auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    speculationSaved_.add(std::max(std::chrono::milliseconds(result.value().timeExecute) - waited, std::chrono::milliseconds(0)));
+
+    return result;
 }
 
 std::optional<cs::Executor::ExecuteResult> cs::Executor::reexecuteContract(cs::Executor::ExecuteTransactionInfo& contract, std::string forceContractState) {
@@ -666,7 +929,10 @@ void cs::Executor::stateUpdate(const csdb::Pool& pool) {
 
             if (!newstate.empty()) {
                 setLastState(address, newstate);
-                updateCacheLastStates(address, pool.sequence(), newstate);
+
+                // getters and speculations results of previous states are not requested anymore
+                getterCache_.invalidate(address);
+                speculations_.invalidate(address);
             }
         }
     }
@@ -731,6 +997,7 @@ void cs::Executor::onExecutorFinished(int code, const std::error_code&) {
         return;
     }
 
+    disconnect();
     notifyError();
 }
 
@@ -766,6 +1033,7 @@ void cs::Executor::checkExecutorVersion() {
 
         auto terminate = [this] {
             executorProcess_->terminate();
+            disconnect();
             notifyError();
         };
 
@@ -776,13 +1044,11 @@ void cs::Executor::checkExecutorVersion() {
 cs::Executor::Executor(const cs::ExecutorSettings::Types& types)
 : blockchain_(std::get<cs::Reference<const BlockChain>>(types))
 , solver_(std::get<cs::Reference<const cs::SolverCore>>(types))
-, socket_(::apache::thrift::stdcxx::make_shared<::apache::thrift::transport::TSocket>(cs::ConfigHolder::instance().config()->getApiSettings().executorHost,
-                                                                                      cs::ConfigHolder::instance().config()->getApiSettings().executorPort))
-, executorTransport_(new ::apache::thrift::transport::TBufferedTransport(socket_))
-, origExecutor_(std::make_unique<executor::ContractExecutorConcurrentClient>(::apache::thrift::stdcxx::make_shared<apache::thrift::protocol::TBinaryProtocol>(executorTransport_))) {
-    socket_->setSendTimeout(cs::ConfigHolder::instance().config()->getApiSettings().executorSendTimeout);
-    socket_->setRecvTimeout(cs::ConfigHolder::instance().config()->getApiSettings().executorReceiveTimeout);
-
+, connections_(connectionPoolSettings())
+, getterCache_(cs::ConfigHolder::instance().config()->getApiSettings().executorGetterCacheSize)
+, speculations_(kSpeculationsCapacity)
+, speculationsInFlight_(cs::ConfigHolder::instance().config()->getApiSettings().executorSpeculativeInFlight)
+, states_(statesSettings()) {
     commitMin_ = cs::ConfigHolder::instance().config()->getApiSettings().executorCommitMin;
     commitMax_ = cs::ConfigHolder::instance().config()->getApiSettings().executorCommitMax;
 
@@ -887,11 +1153,14 @@ void cs::Executor::deleteAccessId(const general::AccessID& accessId) {
 }
 
 std::optional<cs::Executor::OriginExecuteResult> cs::Executor::execute(const std::string& address, const executor::SmartContractBinary& smartContractBinary,
-                                                                       std::vector<executor::MethodHeader>& methodHeader, bool isGetter, cs::Sequence explicitSequence) {
+                                                                       std::vector<executor::MethodHeader>& methodHeader, bool isGetter, cs::Sequence explicitSequence,
+                                                                       ExecutorLane lane) {
     constexpr uint64_t EXECUTION_TIME = Consensus::T_smart_contract;
     OriginExecuteResult originExecuteRes{};
 
-    if (!isConnected()) {
+    auto lease = connections_.acquire(isGetter ? ExecutorLane::Getter : lane);
+
+    if (!lease) {
         notifyError();
         return std::nullopt;
     }
@@ -902,20 +1171,19 @@ std::optional<cs::Executor::OriginExecuteResult> cs::Executor::execute(const std
         accessId = generateAccessId(explicitSequence);
     }
 
+    if (lane == ExecutorLane::Speculative) {
+        speculations_.watch(static_cast<general::AccessID>(accessId));
+    }
+
     ++execCount_;
 
     const auto timeBeg = std::chrono::steady_clock::now();
 
     try {
-        std::shared_lock sharedLock(sharedErrorMutex_);
-        std::lock_guard lock(callExecutorLock_);
-        origExecutor_->executeByteCode(originExecuteRes.resp, static_cast<general::AccessID>(accessId), address, smartContractBinary, methodHeader, EXECUTION_TIME, EXECUTOR_VERSION);
+        lease->executeByteCode(originExecuteRes.resp, static_cast<general::AccessID>(accessId), address, smartContractBinary, methodHeader, EXECUTION_TIME, EXECUTOR_VERSION);
     }
     catch (::apache::thrift::transport::TTransportException& x) {
-        // sets stop_ flag to true forever, replace with new instance
-        if (x.getType() == ::apache::thrift::transport::TTransportException::NOT_OPEN) {
-            recreateOriginExecutor();
-        }
+        lease.invalidate();
 
         if (x.getType() == ::apache::thrift::transport::TTransportException::TIMED_OUT) {
             originExecuteRes.resp.status.code = cs::error::TimeExpired;
@@ -928,6 +1196,8 @@ std::optional<cs::Executor::OriginExecuteResult> cs::Executor::execute(const std
         notifyError();
     }
     catch (std::exception& x) {
+        lease.invalidate();
+
         originExecuteRes.resp.status.code = cs::error::StdException;
         originExecuteRes.resp.status.message = x.what();
 
@@ -941,40 +1211,53 @@ std::optional<cs::Executor::OriginExecuteResult> cs::Executor::execute(const std
         deleteAccessId(static_cast<general::AccessID>(accessId));
     }
 
+    if (lane == ExecutorLane::Speculative) {
+        originExecuteRes.isCalledBack = speculations_.release(static_cast<general::AccessID>(accessId));
+    }
+
     originExecuteRes.acceessId = static_cast<general::AccessID>(accessId);
     return std::make_optional(std::move(originExecuteRes));
 }
 
 bool cs::Executor::connect() {
-    try {
-        executorTransport_->open();
-    }
-    catch (...) {
-        notifyError();
-    }
-
-    return executorTransport_->isOpen();
+    return connections_.connect();
 }
 
 void cs::Executor::disconnect() {
-    try {
-        executorTransport_->close();
-    }
-    catch (::apache::thrift::transport::TTransportException&) {
-        notifyError();
-    }
+    connections_.disconnect();
 }
 
 void cs::Executor::notifyError() {
-    if (isConnected()) {
-        disconnect();
-    }
-
     cvErrorConnect_.notify_one();
 }
 
-void cs::Executor::recreateOriginExecutor() {
-    std::lock_guard lock(sharedErrorMutex_);
-    disconnect();
-    origExecutor_.reset(new executor::ContractExecutorConcurrentClient(::apache::thrift::stdcxx::make_shared<apache::thrift::protocol::TBinaryProtocol>(executorTransport_)));
+cs::ExecutorConnectionPool::Settings cs::Executor::connectionPoolSettings() {
+    const auto& apiSettings = cs::ConfigHolder::instance().config()->getApiSettings();
+
+    ExecutorConnectionPool::Settings settings;
+    settings.host = apiSettings.executorHost;
+    settings.port = apiSettings.executorPort;
+    settings.sendTimeout = apiSettings.executorSendTimeout;
+    settings.receiveTimeout = apiSettings.executorReceiveTimeout;
+    settings.connections = apiSettings.executorConnections;
+    settings.limits[static_cast<size_t>(ExecutorLane::Consensus)] = 0;
+    settings.limits[static_cast<size_t>(ExecutorLane::Getter)] = apiSettings.executorGettersInFlight;
+    settings.limits[static_cast<size_t>(ExecutorLane::Compile)] = apiSettings.executorCompilesInFlight;
+    settings.limits[static_cast<size_t>(ExecutorLane::Speculative)] = apiSettings.executorSpeculativeInFlight;
+
+    return settings;
+}
+
+cs::ContractStateStore::Settings cs::Executor::statesSettings() {
+    const auto memory = cs::ConfigHolder::instance().config()->getApiSettings().executorStatesMemory;
+
+    ContractStateStore::Settings settings;
+
+    // without limit states are kept in memory only
+    if (memory != 0) {
+        settings.path = kStatesPath;
+        settings.memoryLimit = static_cast<size_t>(memory) * 1024 * 1024;
+    }
+
+    return settings;
 }
@@ -0,0 +1,168 @@
+#include <executorlanes.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+const char* cs::executorLaneName(ExecutorLane lane) {
+    switch (lane) {
+        case ExecutorLane::Consensus:
+            return "consensus";
+        case ExecutorLane::Getter:
+            return "getter";
+        case ExecutorLane::Compile:
+            return "compile";
+        case ExecutorLane::Speculative:
+            return "speculative";
+    }
+
+    return "unknown";
+}
+
+uint32_t cs::LatencyHistogram::Snapshot::percentile(double value) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    const auto rank = static_cast<uint64_t>(std::clamp(value, 0.0, 1.0) * static_cast<double>(count));
+    uint64_t accumulated = 0;
+
+    for (size_t i = 0; i < kBounds.size(); ++i) {
+        accumulated += buckets[i];
+
+        if (accumulated > rank || (accumulated == count)) {
+            return kBounds[i];
+        }
+    }
+
+    return std::numeric_limits<uint32_t>::max();
+}
+
+std::string cs::LatencyHistogram::Snapshot::toString() const {
+    std::ostringstream os;
+    os << "count " << count << ", avg " << (count ? sum / count : 0) << " ms";
+
+    for (auto value : {0.5, 0.9, 0.99}) {
+        const auto bound = percentile(value);
+        os << ", p" << static_cast<int>(value * 100) << " ";
+
+        if (bound == std::numeric_limits<uint32_t>::max()) {
+            os << "> " << kBounds.back();
+        }
+        else {
+            os << "<= " << bound;
+        }
+
+        os << " ms";
+    }
+
+    return os.str();
+}
+
+void cs::LatencyHistogram::add(std::chrono::milliseconds latency) {
+    const auto value = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+    const auto bucket = std::lower_bound(kBounds.begin(), kBounds.end(), value) - kBounds.begin();
+
+    buckets_[static_cast<size_t>(bucket)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+cs::LatencyHistogram::Snapshot cs::LatencyHistogram::snapshot() const {
+    Snapshot snapshot;
+
+    for (size_t i = 0; i < kBucketsCount; ++i) {
+        snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];
+    }
+
+    snapshot.sum = sum_.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+cs::ExecutorLanes::ExecutorLanes(size_t slots, const Limits& limits)
+: busy_(std::max<size_t>(slots, 1), false)
+, limits_(limits) {
+    // zero limit means lane may occupy all slots
+    for (auto& limit : limits_) {
+        limit = (limit == 0 ? busy_.size() : std::min(limit, busy_.size()));
+    }
+}
+
+size_t cs::ExecutorLanes::acquire(ExecutorLane lane) {
+    const auto index = static_cast<size_t>(lane);
+
+    std::unique_lock lock(mutex_);
+    ++waiting_[index];
+
+    condition_.wait(lock, [this, index] {
+        return stopped_ || isAdmissible(index);
+    });
+
+    --waiting_[index];
+
+    if (stopped_) {
+        // lanes of lower priority may wait for this one
+        condition_.notify_all();
+        return kNoSlot;
+    }
+
+    const auto slot = freeSlot();
+    busy_[slot] = true;
+    ++inFlight_[index];
+
+    return slot;
+}
+
+void cs::ExecutorLanes::release(ExecutorLane lane, size_t slot) {
+    {
+        std::lock_guard lock(mutex_);
+
+        if (slot >= busy_.size() || !busy_[slot]) {
+            return;
+        }
+
+        busy_[slot] = false;
+        --inFlight_[static_cast<size_t>(lane)];
+    }
+
+    condition_.notify_all();
+}
+
+void cs::ExecutorLanes::stop() {
+    {
+        std::lock_guard lock(mutex_);
+        stopped_ = true;
+    }
+
+    condition_.notify_all();
+}
+
+size_t cs::ExecutorLanes::inFlight(ExecutorLane lane) const {
+    std::lock_guard lock(mutex_);
+    return inFlight_[static_cast<size_t>(lane)];
+}
+
+size_t cs::ExecutorLanes::waiting(ExecutorLane lane) const {
+    std::lock_guard lock(mutex_);
+    return waiting_[static_cast<size_t>(lane)];
+}
+
+bool cs::ExecutorLanes::isAdmissible(size_t lane) const {
+    if (inFlight_[lane] >= limits_[lane] || freeSlot() == kNoSlot) {
+        return false;
+    }
+
+    // higher priority lane that can take a slot goes first
+    for (size_t higher = 0; higher < lane; ++higher) {
+        if (waiting_[higher] != 0 && inFlight_[higher] < limits_[higher]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t cs::ExecutorLanes::freeSlot() const {
+    const auto it = std::find(busy_.begin(), busy_.end(), false);
+    return it == busy_.end() ? kNoSlot : static_cast<size_t>(it - busy_.begin());
+}
@@ -0,0 +1,194 @@
+#include <executorpool.hpp>
+
+#if defined(_MSC_VER)
+#pragma warning(push, 0)
+#endif
+
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#include <lib/system/logger.hpp>
+#include <lib/system/metrics.hpp>
+
+namespace {
+cs::metrics::Histogram& callTime(cs::ExecutorLane lane) {
+    static const auto histograms = [] {
+        std::array<cs::metrics::Histogram*, cs::kExecutorLanesCount> result{};
+
+        for (size_t i = 0; i < result.size(); ++i) {
+            const auto name = cs::executorLaneName(static_cast<cs::ExecutorLane>(i));
+            result[i] = &cs::metrics::timer("cs_executor_call_seconds", "Time of executor call on leased connection", cs::metrics::label("lane", name));
+        }
+
+        return result;
+    }();
+
+    return *histograms[static_cast<size_t>(lane)];
+}
+}  // namespace
+
+cs::ExecutorConnectionPool::Lease::Lease(ExecutorConnectionPool* pool, ExecutorLane lane, size_t slot, Client* client)
+: pool_(pool)
+, lane_(lane)
+, slot_(slot)
+, client_(client)
+, start_(std::chrono::steady_clock::now()) {
+}
+
+cs::ExecutorConnectionPool::Lease::Lease(Lease&& other) noexcept
+: pool_(other.pool_)
+, lane_(other.lane_)
+, slot_(other.slot_)
+, client_(other.client_)
+, invalidated_(other.invalidated_)
+, start_(other.start_) {
+    other.pool_ = nullptr;
+    other.client_ = nullptr;
+}
+
+cs::ExecutorConnectionPool::Lease::~Lease() {
+    if (pool_) {
+        pool_->release(*this);
+    }
+}
+
+void cs::ExecutorConnectionPool::Lease::invalidate() {
+    invalidated_ = true;
+}
+
+cs::ExecutorConnectionPool::ExecutorConnectionPool(const Settings& settings)
+: lanes_(settings.connections, settings.limits) {
+    connections_.reserve(lanes_.slotsCount());
+
+    for (size_t i = 0; i < lanes_.slotsCount(); ++i) {
+        auto& connection = connections_.emplace_back(std::make_unique<Connection>());
+
+        connection->socket = ::apache::thrift::stdcxx::make_shared<::apache::thrift::transport::TSocket>(settings.host, settings.port);
+        connection->socket->setSendTimeout(settings.sendTimeout);
+        connection->socket->setRecvTimeout(settings.receiveTimeout);
+        connection->transport.reset(new ::apache::thrift::transport::TBufferedTransport(connection->socket));
+
+        recreate(*connection);
+    }
+}
+
+cs::ExecutorConnectionPool::~ExecutorConnectionPool() {
+    stop();
+    disconnect();
+}
+
+cs::ExecutorConnectionPool::Lease cs::ExecutorConnectionPool::acquire(ExecutorLane lane) {
+    const auto slot = lanes_.acquire(lane);
+
+    if (slot == ExecutorLanes::kNoSlot) {
+        return Lease(nullptr, lane, slot, nullptr);
+    }
+
+    auto& connection = *connections_[slot];
+    Client* client = nullptr;
+
+    {
+        std::lock_guard lock(connection.mutex);
+
+        if (connection.transport->isOpen() || open(connection)) {
+            client = connection.client.get();
+        }
+    }
+
+    // lease releases the slot even if connection is not opened
+    return Lease(this, lane, slot, client);
+}
+
+bool cs::ExecutorConnectionPool::connect() {
+    bool result = false;
+
+    for (auto& connection : connections_) {
+        std::lock_guard lock(connection->mutex);
+        result = (connection->transport->isOpen() || open(*connection)) || result;
+    }
+
+    return result;
+}
+
+void cs::ExecutorConnectionPool::disconnect() {
+    for (auto& connection : connections_) {
+        std::lock_guard lock(connection->mutex);
+        close(*connection);
+    }
+}
+
+bool cs::ExecutorConnectionPool::isConnected() const {
+    for (auto& connection : connections_) {
+        std::lock_guard lock(connection->mutex);
+
+        if (connection->transport->isOpen()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void cs::ExecutorConnectionPool::stop() {
+    lanes_.stop();
+
+    for (size_t i = 0; i < kExecutorLanesCount; ++i) {
+        const auto lane = static_cast<ExecutorLane>(i);
+        const auto snapshot = lanes_.latency(lane).snapshot();
+
+        if (snapshot.count) {
+            csdebug() << "Executor " << executorLaneName(lane) << " calls latency: " << snapshot.toString();
+        }
+    }
+}
+
+bool cs::ExecutorConnectionPool::open(Connection& connection) {
+    try {
+        connection.transport->open();
+    }
+    catch (...) {
+        return false;
+    }
+
+    return connection.transport->isOpen();
+}
+
+void cs::ExecutorConnectionPool::close(Connection& connection) {
+    try {
+        connection.transport->close();
+    }
+    catch (::apache::thrift::transport::TTransportException&) {
+    }
+}
+
+void cs::ExecutorConnectionPool::recreate(Connection& connection) {
+    // client sets its stop flag forever on NOT_OPEN error, so it is replaced by a new instance
+    connection.client = std::make_unique<Client>(::apache::thrift::stdcxx::make_shared<::apache::thrift::protocol::TBinaryProtocol>(connection.transport));
+}
+
+void cs::ExecutorConnectionPool::release(Lease& lease) {
+    if (lease.slot_ == ExecutorLanes::kNoSlot) {
+        return;
+    }
+
+    if (lease.client_) {
+        const auto duration = std::chrono::steady_clock::now() - lease.start_;
+
+        lanes_.latency(lease.lane_).add(std::chrono::duration_cast<std::chrono::milliseconds>(duration));
+        callTime(lease.lane_).observe(duration);
+    }
+
+    if (lease.invalidated_) {
+        auto& connection = *connections_[lease.slot_];
+        std::lock_guard lock(connection.mutex);
+
+        close(connection);
+        recreate(connection);
+    }
+
+    lanes_.release(lease.lane_, lease.slot_);
+}
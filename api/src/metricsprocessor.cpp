@@ -0,0 +1,66 @@
+#include <metricsprocessor.hpp>
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+#include <thrift/TProcessor.h>
+
+#include <lib/system/metrics.hpp>
+
+namespace {
+// method being dispatched by server thread, set only for methods of generated processor
+thread_local const char* dispatchedMethod = nullptr;
+
+// generated processor passes to event handler names of its own methods only,
+// so names sent by clients never become metrics labels
+class MethodEventHandler : public ::apache::thrift::TProcessorEventHandler {
+public:
+    void* getContext(const char* fnName, void*) override {
+        dispatchedMethod = fnName;
+        return nullptr;
+    }
+};
+
+cs::metrics::Histogram& callTimer(const std::string& method) {
+    return cs::metrics::timer("cs_api_call_seconds", "Time of public API method", cs::metrics::label("method", method));
+}
+}  // namespace
+
+cs::MetricsProcessor::MetricsProcessor(::apache::thrift::stdcxx::shared_ptr<api::APIIf> iface)
+: ::api::APIProcessor(iface) {
+    setEventHandler(::apache::thrift::stdcxx::make_shared<MethodEventHandler>());
+}
+
+bool cs::MetricsProcessor::dispatchCall(apache::thrift::protocol::TProtocol* iprot,
+                                        apache::thrift::protocol::TProtocol* oprot,
+                                        const std::string& fname, int32_t seqid, void* callContext) {
+    if (!cs::metrics::isEnabled()) {
+        return ::api::APIProcessor::dispatchCall(iprot, oprot, fname, seqid, callContext);
+    }
+
+    static auto& unknown = callTimer("unknown");
+
+    // server threads look up registry once per method, names are literals of generated code
+    thread_local std::unordered_map<const char*, cs::metrics::Histogram*> histograms;
+
+    dispatchedMethod = nullptr;
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool result = ::api::APIProcessor::dispatchCall(iprot, oprot, fname, seqid, callContext);
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    if (!dispatchedMethod) {
+        unknown.observe(duration);
+        return result;
+    }
+
+    auto& histogram = histograms[dispatchedMethod];
+
+    if (!histogram) {
+        histogram = &callTimer(fname);
+    }
+
+    histogram->observe(duration);
+    return result;
+}
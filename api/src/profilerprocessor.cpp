@@ -2,12 +2,12 @@
 #include <profiler/profiler.hpp>
 
 cs::ProfilerProcessor::ProfilerProcessor(::apache::thrift::stdcxx::shared_ptr<api::APIIf> iface)
-: ::api::APIProcessor(iface) {
+: cs::MetricsProcessor(iface) {
 }
 
 bool cs::ProfilerProcessor::dispatchCall(apache::thrift::protocol::TProtocol* iprot,
                                          apache::thrift::protocol::TProtocol* oprot,
                                          const std::string& fname, int32_t seqid, void* callContext) {
     cs::Profiler profiler("Method " + fname);
-    return ::api::APIProcessor::dispatchCall(iprot, oprot, fname, seqid, callContext);
+    return cs::MetricsProcessor::dispatchCall(iprot, oprot, fname, seqid, callContext);
 }
@@ -2,11 +2,14 @@
 
 #include <base58.h>
 
+#include <algorithm>
 #include <cctype>
 #include "apihandler.hpp"
 #include "tokens.hpp"
 #include "smartcontracts.hpp"
 
+#include <lib/system/metrics.hpp>
+
 #ifdef TOKENS_CACHE
 
 static inline bool isStringParam(const std::string& param) {
@@ -163,13 +166,36 @@ void executeAndCall(api::APIHandler* p_api, const general::Address& addr, const
         handler(getVariantAs<RetType>(result.results[0].ret_val));
 }
 
-void TokensMaster::refreshTokenState(const csdb::Address& token, const std::string& newState, bool checkBalance) {
+void TokensMaster::refreshTokenState(const csdb::Address& token, const Refresh& refresh) {
     bool present = false;
     auto byteCodeObjects = api_->getSmartByteCode(token, present);
     if (!present || byteCodeObjects.empty()) return;
 
+    // the latest state covers all changes queued since the previous refresh
+    const std::string newState = cs::SmartContracts::get_contract_state(api_->get_s_blockchain(), token);
+
+    csdb::Address deployer;
+    std::vector<csdb::Address> holders;
+
+    {
+        std::lock_guard<decltype(dataMut_)> lInt(dataMut_);
+        auto tIt = tokens_.find(token);
+        if (tIt == tokens_.end())
+            return;
+
+        deployer = tIt->second.owner;
+
+        if (refresh.full) {
+            holders.reserve(tIt->second.holders.size());
+            for (auto& h : tIt->second.holders)
+                holders.push_back(h.first);
+        }
+        else {
+            holders.assign(refresh.holders.begin(), refresh.holders.end());
+        }
+    }
+
     std::string name, symbol, totalSupply;
-    csdb::Address deployer = tokens_[token].owner;
 
     general::Address addr   = std::string((char*)token.public_key().data(), token.public_key().size());
     general::Address dpAddr = std::string((char*)deployer.public_key().data(), deployer.public_key().size());
@@ -187,60 +213,83 @@ void TokensMaster::refreshTokenState(const csdb::Address& token, const std::stri
                 if (i >= 4) break;
                 symbol.push_back((char)std::toupper(newSymb[i]));
             }
-        });  
+        });
 
-    auto& t       = tokens_[token];
-    t.name        = name;
-    t.symbol      = symbol;
-    t.totalSupply = totalSupply;
+    // balances of holders, a batch per executor call
+    executor::SmartContractBinary smartContractBinary;
+    smartContractBinary.contractAddress = addr;
+    smartContractBinary.object.byteCodeObjects = byteCodeObjects;
+    smartContractBinary.object.instance = newState;
+    smartContractBinary.stateCanModify = 0;
 
-    // balance
-    if (checkBalance) {
-        executor::ExecuteByteCodeMultipleResult result;
-        if (byteCodeObjects.empty())
-            return;
+    std::vector<std::pair<csdb::Address, std::string>> balances;
+    balances.reserve(holders.size());
 
-        executor::SmartContractBinary smartContractBinary;
-        smartContractBinary.contractAddress = addr;
-        smartContractBinary.object.byteCodeObjects = byteCodeObjects;
-        smartContractBinary.object.instance = newState;
-        smartContractBinary.stateCanModify = 0;
-
-        std::vector<csdb::Address> holders;
-        holders.reserve(t.holders.size());
-        for (auto& h : t.holders)
-            holders.push_back(h.first);
-
-        std::vector<std::vector<general::Variant>> holderKeysParams;
-        holderKeysParams.reserve(holders.size());
-        for (auto& h : holders) {
-            general::Variant var;
-            auto key = h.public_key();
-            var.__set_v_string(EncodeBase58(cs::Bytes(key.begin(), key.end())));
-            holderKeysParams.push_back(std::vector<general::Variant>(1, var));
-        }
+    size_t offset = 0;
+
+    for (const auto& holderKeysParams : balanceOfParams(holders)) {
+        const size_t count = holderKeysParams.size();
 
+        executor::ExecuteByteCodeMultipleResult result;
         api_->getExecutor().executeByteCodeMultiple(result, dpAddr, smartContractBinary, "balanceOf", holderKeysParams, 100, cs::Executor::kUseLastSequence);
 
-        if (!result.status.code && (result.results.size() == holders.size())) {
-            for (uint32_t i = 0; i < holders.size(); ++i) {
+        ++executorCalls_;
+        balances_ += count;
+
+        if (!result.status.code && result.results.size() == count) {
+            for (size_t i = 0; i < count; ++i) {
                 const auto& res = result.results[i];
-                if (!res.status.code) {
-                    bool zeroBalanceFlg = true;
-                    if (!isZeroAmount(t.holders[holders[i]].balance))
-                        zeroBalanceFlg = false;
-
-                    t.holders[holders[i]].balance = tryExtractAmount(getVariantAs<std::string>(res.ret_val));
-                    if (zeroBalanceFlg && !isZeroAmount(t.holders[holders[i]].balance))
-                        ++t.realHoldersCount;
-                    else if (!zeroBalanceFlg && isZeroAmount(t.holders[holders[i]].balance))
-                        --t.realHoldersCount;
-                }
+                if (!res.status.code)
+                    balances.emplace_back(holders[offset + i], tryExtractAmount(getVariantAs<std::string>(res.ret_val)));
             }
         }
+
+        offset += count;
+    }
+
+    {
+        std::lock_guard<decltype(dataMut_)> lInt(dataMut_);
+        auto tIt = tokens_.find(token);
+        if (tIt == tokens_.end())
+            return;
+
+        auto& t       = tIt->second;
+        t.name        = name;
+        t.symbol      = symbol;
+        t.totalSupply = totalSupply;
+
+        for (auto& [holder, balance] : balances) {
+            auto& info = t.holders[holder];
+            const bool zeroBalanceFlg = isZeroAmount(info.balance);
+
+            info.balance = std::move(balance);
+            if (zeroBalanceFlg && !isZeroAmount(info.balance))
+                ++t.realHoldersCount;
+            else if (!zeroBalanceFlg && isZeroAmount(info.balance))
+                --t.realHoldersCount;
+        }
     }
 }
 
+std::vector<std::vector<std::vector<general::Variant>>> TokensMaster::balanceOfParams(const std::vector<csdb::Address>& holders) {
+    std::vector<std::vector<std::vector<general::Variant>>> batches;
+    batches.reserve((holders.size() + kBalancesBatchSize - 1) / kBalancesBatchSize);
+
+    for (size_t i = 0; i < holders.size(); ++i) {
+        if (i % kBalancesBatchSize == 0) {
+            batches.emplace_back();
+            batches.back().reserve(std::min(kBalancesBatchSize, holders.size() - i));
+        }
+
+        general::Variant var;
+        auto key = holders[i].public_key();
+        var.__set_v_string(EncodeBase58(cs::Bytes(key.begin(), key.end())));
+        batches.back().push_back(std::vector<general::Variant>(1, var));
+    }
+
+    return batches;
+}
+
 /* Call under data lock only */
 void TokensMaster::initiateHolder(Token& token, const csdb::Address& address, const csdb::Address& holder, bool increaseTransfers /* = false*/) {
     if (increaseTransfers)
@@ -251,11 +300,171 @@ void TokensMaster::initiateHolder(Token& token, const csdb::Address& address, co
     holders_[holder].insert(address);
 }
 
-TokensMaster::TokensMaster(api::APIHandler* api)
-: api_(api) {
+TokensMaster::TokensMaster(api::APIHandler* api, Refresher refresher)
+: api_(api)
+, refresher_(std::move(refresher)) {
+    if (!refresher_) {
+        refresher_ = [this](const csdb::Address& token, const Refresh& refresh) { refreshTokenState(token, refresh); };
+    }
+
+    worker_ = std::thread(&TokensMaster::run, this);
 }
 
 TokensMaster::~TokensMaster() {
+    {
+        std::lock_guard lock(cvMut_);
+        stop_ = true;
+    }
+
+    cv_.notify_one();
+    worker_.join();
+}
+
+void TokensMaster::enqueue(const csdb::Address& token, Refresh&& refresh) {
+    {
+        std::lock_guard lock(cvMut_);
+        auto& queued = queue_[token];
+
+        if (refresh.full) {
+            queued.full = true;
+            queued.holders.clear();
+        }
+        else if (!queued.full) {
+            queued.holders.merge(refresh.holders);
+        }
+    }
+
+    cv_.notify_one();
+}
+
+void TokensMaster::refreshAll() {
+    std::vector<csdb::Address> tokens;
+
+    {
+        std::lock_guard<decltype(dataMut_)> lInt(dataMut_);
+        tokens.reserve(tokens_.size());
+        for (auto& tk : tokens_)
+            tokens.push_back(tk.first);
+    }
+
+    cslog() << "tokens are queued for loading(" << tokens.size() << ")";
+
+    for (auto& token : tokens) {
+        Refresh refresh;
+        refresh.full = true;
+        enqueue(token, std::move(refresh));
+    }
+}
+
+void TokensMaster::run() {
+    while (true) {
+        std::map<TokenId, Refresh> queue;
+
+        {
+            std::unique_lock lock(cvMut_);
+            cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+
+            // burst of changes of the same token is refreshed once
+            if (cv_.wait_for(lock, kCoalesceDelay, [this] { return stop_; }))
+                return;
+
+            queue.swap(queue_);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (auto& [token, refresh] : queue) {
+            const auto refreshStart = std::chrono::steady_clock::now();
+            refresher_(token, refresh);
+
+            ++refreshes_;
+            latency_.add(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - refreshStart));
+
+            std::lock_guard lock(cvMut_);
+            if (stop_)
+                return;
+        }
+
+        publishStatistics();
+
+        if (queue.size() > 100) {
+            cslog() << "tokens loaded(" << queue.size() << ") in "
+                    << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms";
+        }
+    }
+}
+
+TokensMaster::Statistics TokensMaster::statistics() const {
+    Statistics stat;
+
+    {
+        std::lock_guard lock(cvMut_);
+        stat.queuedTokens = queue_.size();
+        for (auto& [token, refresh] : queue_)
+            stat.queuedHolders += refresh.holders.size();
+    }
+
+    stat.refreshes = refreshes_;
+    stat.balances = balances_;
+    stat.executorCalls = executorCalls_;
+    stat.latency = latency_.snapshot();
+
+    return stat;
+}
+
+void TokensMaster::publishStatistics() {
+    if (!cs::metrics::isEnabled())
+        return;
+
+    static auto& queuedTokens = cs::metrics::gauge("cs_tokens_queued", "Tokens and holders queued for refresh", cs::metrics::label("kind", "tokens"));
+    static auto& queuedHolders = cs::metrics::gauge("cs_tokens_queued", "Tokens and holders queued for refresh", cs::metrics::label("kind", "holders"));
+    static auto& refreshes = cs::metrics::counter("cs_tokens_refreshes_total", "Tokens refreshed");
+    static auto& balances = cs::metrics::counter("cs_tokens_balances_total", "Balances of holders requested from executor");
+    static auto& executorCalls = cs::metrics::counter("cs_tokens_executor_calls_total", "Batched balanceOf calls to executor");
+
+    const auto stat = statistics();
+
+    queuedTokens.set(static_cast<int64_t>(stat.queuedTokens));
+    queuedHolders.set(static_cast<int64_t>(stat.queuedHolders));
+
+    // counters grow by what is done since the previous publish
+    refreshes.increment(stat.refreshes - published_.refreshes);
+    balances.increment(stat.balances - published_.balances);
+    executorCalls.increment(stat.executorCalls - published_.executorCalls);
+
+    published_ = stat;
+}
+
+TokensMaster::Refresh TokensMaster::refreshOf(int64_t tokenStandard, const TokenInvocationData::Params& ps) {
+    // balances may change only for holders decoded from known methods, others refresh all holders
+    Refresh refresh;
+    refresh.holders.insert(ps.initiator);
+    refresh.full = true;
+
+    if (ps.method.empty())
+        return refresh;
+
+    if (isTransfer(ps.method, ps.params)) {
+        auto trPair = getTransferData(ps.initiator, ps.method, ps.params);
+        if (trPair.first.is_valid())
+            refresh.holders.insert(trPair.first);
+        if (trPair.second.is_valid())
+            refresh.holders.insert(trPair.second);
+        refresh.full = false;
+    }
+    else if (tokenStandard == TokenStandard::CreditsExtended) {
+        csdb::Address regDude = tryGetRegisterData(ps.method, ps.params);
+        if (regDude.is_valid()) {
+            refresh.holders.insert(regDude);
+            refresh.full = false;
+        }
+    }
+    else if (ps.method == "approve" && !ps.params.empty()) {
+        refresh.holders.insert(tryExtractPublicKey(ps.params[0].v_string));
+        refresh.full = false;
+    }
+
+    return refresh;
 }
 
 void TokensMaster::updateTokenChaches(const csdb::Address& addr, const std::string& newState, const TokenInvocationData::Params& ps) {
@@ -268,25 +477,20 @@ void TokensMaster::updateTokenChaches(const csdb::Address& addr, const std::stri
     initiateHolder(tIt->second, tIt->first, ps.initiator);
     ++tIt->second.transactionsCount;
 
-    if (!ps.method.empty()) {
-        if (isTransfer(ps.method, ps.params)) {
-            ++tIt->second.transfersCount;
-            auto trPair = getTransferData(ps.initiator, ps.method, ps.params);
-            if (trPair.first.is_valid())
-                initiateHolder(tIt->second, tIt->first, trPair.first, true);
-            if (trPair.second.is_valid())
-                initiateHolder(tIt->second, tIt->first, trPair.second, true);
-        }
-        else if (tIt->second.tokenStandard == TokenStandard::CreditsExtended) {
-            csdb::Address regDude = tryGetRegisterData(ps.method, ps.params);
-            if (regDude.is_valid())
-                initiateHolder(tIt->second, tIt->first, regDude);
-        }
-        else if (ps.method == "approve") {
-            initiateHolder(tIt->second, tIt->first, tryExtractPublicKey(ps.params[0].v_string));
-        }
+    Refresh refresh = refreshOf(tIt->second.tokenStandard, ps);
+
+    if (!ps.method.empty() && isTransfer(ps.method, ps.params)) {
+        ++tIt->second.transfersCount;
+        auto trPair = getTransferData(ps.initiator, ps.method, ps.params);
+        if (trPair.first.is_valid())
+            initiateHolder(tIt->second, tIt->first, trPair.first, true);
+        if (trPair.second.is_valid())
+            initiateHolder(tIt->second, tIt->first, trPair.second, true);
     }
 
+    for (const auto& holder : refresh.holders)
+        initiateHolder(tIt->second, tIt->first, holder);
+
 #ifdef MANUAL_BALANCE
     // Balance update   
     auto refreshBalance = [&](const csdb::Address& addrFrom, const csdb::Address& addrTo = csdb::Address{}, const std::string& amount = "") {
@@ -358,7 +562,7 @@ void TokensMaster::updateTokenChaches(const csdb::Address& addr, const std::stri
         else if (ps.method.empty()) // deploy token
             refreshBalance(tokens_[addr].owner);
 #endif
-        refreshTokenState(addr, cs::SmartContracts::get_contract_state(api_->get_s_blockchain(), addr), true);
+        enqueue(addr, std::move(refresh));
     }
 }
 
@@ -431,7 +635,7 @@ std::string TokensMaster::getAmount(const api::SmartContractInvocation& sci) {
 
 #else
 
-TokensMaster::TokensMaster(api::APIHandler*) {
+TokensMaster::TokensMaster(api::APIHandler*, Refresher) {
 }
 TokensMaster::~TokensMaster() {
 }
@@ -441,6 +645,11 @@ void TokensMaster::checkNewState(const csdb::Address&, const csdb::Address&, con
 }
 void TokensMaster::loadTokenInfo(const std::function<void(const TokensMap&, const HoldersMap&)>) {
 }
+void TokensMaster::refreshAll() {
+}
+TokensMaster::Statistics TokensMaster::statistics() const {
+    return Statistics{};
+}
 bool TokensMaster::isTransfer(const std::string&, const std::vector<general::Variant>&) {
     return false;
 }
@@ -0,0 +1,235 @@
+#include <framework.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <callsqueuescheduler.hpp>
+
+#include <lib/system/console.hpp>
+#include <lib/system/structures.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kCalls = 1000000;
+constexpr size_t kBatch = 100;
+constexpr size_t kTags = 64;
+constexpr size_t kSchedules = 1000000;
+constexpr size_t kTimers = 2000;
+
+size_t sink = 0;
+
+// the former CallsQueue, every call takes a node and std::function
+class LegacyCallsQueue {
+public:
+    struct Call {
+        std::atomic<Call*> next;
+        std::function<void()> func;
+    };
+
+    void insert(std::function<void()> f) {
+        Call* newElt = new Call;
+        newElt->func = f;
+
+        Call* head = head_.load(std::memory_order_relaxed);
+        do {
+            newElt->next.store(head, std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, newElt, std::memory_order_acquire, std::memory_order_relaxed));
+    }
+
+    void callAll() {
+        Call* elt = head_.exchange(nullptr, std::memory_order_acquire);
+
+        while (elt) {
+            elt->func();
+            Call* rem = elt;
+            elt = rem->next.load(std::memory_order_relaxed);
+            delete rem;
+        }
+    }
+
+private:
+    std::atomic<Call*> head_ = {nullptr};
+};
+
+// the former CallsQueueScheduler containers, schedules sorted by time and searched by tag
+class LegacyTimers {
+public:
+    struct Context {
+        uintptr_t id;
+        Clock::time_point tp;
+        long long dt;
+        std::function<void()> proc;
+
+        bool operator==(const uintptr_t rhs) const {
+            return id == rhs;
+        }
+    };
+
+    void insert(uintptr_t id, Clock::duration wait, const std::function<void()>& proc) {
+        std::lock_guard lock(mutex_);
+        auto it = std::find(queue_.cbegin(), queue_.cend(), id);
+
+        if (it != queue_.cend()) {
+            queue_.erase(it);
+        }
+
+        queue_.insert(Context{id, Clock::now() + wait, 0, proc});
+    }
+
+    void remove(uintptr_t id) {
+        std::lock_guard lock(mutex_);
+        auto sync = sync_.find(id);
+
+        if (sync != sync_.end()) {
+            sync->second = 0;
+        }
+
+        auto it = std::find(queue_.cbegin(), queue_.cend(), id);
+
+        if (it != queue_.cend()) {
+            queue_.erase(it);
+        }
+    }
+
+private:
+    std::function<bool(const Context& lhs, const Context& rhs)> compare_ = [](const Context& lhs, const Context& rhs) { return lhs.tp < rhs.tp; };
+    std::multiset<Context, decltype(compare_)> queue_{compare_};
+    std::map<uintptr_t, uint32_t> sync_;
+    std::mutex mutex_;
+};
+
+template <typename Func>
+void measure(const std::string& title, size_t count, Func func) {
+    const auto start = Clock::now();
+    cs::Framework::execute(func, std::chrono::seconds(600));
+    const auto duration = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    cs::Console::writeLine(title, ": ", duration / count, " ns per call");
+}
+
+template <typename Queue>
+void testQueue(const std::string& title, Queue& queue) {
+    measure(title, kCalls, [&] {
+        std::array<size_t, 4> captured{1, 2, 3, 4};
+
+        for (size_t i = 0; i < kCalls / kBatch; ++i) {
+            for (size_t j = 0; j < kBatch; ++j) {
+                queue.insert([captured, j] { sink += captured[j % captured.size()]; });
+            }
+
+            queue.callAll();
+        }
+    });
+}
+
+// stage timeouts are scheduled and cancelled by the same tags every round, all of them are pending before cancel
+void testSchedules() {
+    LegacyTimers legacy;
+    CallsQueueScheduler scheduler;
+
+    std::function<void()> proc = [] { ++sink; };
+
+    measure("Legacy timers, " + std::to_string(kTags) + " tags, schedule and cancel", kSchedules, [&] {
+        for (size_t i = 0; i < kSchedules; ++i) {
+            const auto tag = i % kTags + 1;
+            legacy.insert(tag, std::chrono::milliseconds(1000 + i % 5000), proc);
+
+            if (i % kTags == kTags - 1) {
+                for (size_t j = 1; j <= kTags; ++j) {
+                    legacy.remove(j);
+                }
+            }
+        }
+    });
+
+    measure("Timer wheel, " + std::to_string(kTags) + " tags, schedule and cancel", kSchedules, [&] {
+        for (size_t i = 0; i < kSchedules; ++i) {
+            const auto tag = i % kTags + 1;
+            scheduler.InsertOnce(static_cast<uint32_t>(1000 + i % 5000), proc, false, tag);
+
+            if (i % kTags == kTags - 1) {
+                for (size_t j = 1; j <= kTags; ++j) {
+                    scheduler.Remove(j);
+                }
+            }
+        }
+    });
+
+    scheduler.Stop();
+}
+
+// how late calls are taken from CallsQueue, the consumer polls it as network executor does
+void testJitter() {
+    CallsQueueScheduler scheduler;
+    std::atomic<bool> isDone{false};
+
+    std::thread executor([&] {
+        while (!isDone.load(std::memory_order_acquire)) {
+            CallsQueue::instance().callAll();
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+
+    std::vector<int64_t> lateness;
+    std::mutex mutex;
+
+    for (size_t i = 0; i < kTimers; ++i) {
+        const auto wait = std::chrono::milliseconds(i % 200);
+        const auto expected = Clock::now() + wait;
+
+        scheduler.Insert(wait, [&, expected] {
+            std::lock_guard lock(mutex);
+            lateness.push_back(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - expected).count());
+        }, CallsQueueScheduler::Launch::once, false, i + 1);
+
+        if (i % 20 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    while (true) {
+        {
+            std::lock_guard lock(mutex);
+
+            if (lateness.size() == kTimers) {
+                break;
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    isDone = true;
+    executor.join();
+
+    std::sort(lateness.begin(), lateness.end());
+
+    cs::Console::writeLine("Timer wheel, ", kTimers, " timers: call lateness p50 ", lateness[kTimers / 2], " us, p99 ", lateness[kTimers * 99 / 100], " us, max ",
+                           lateness.back(), " us");
+    cs::Console::writeLine("Scheduler jitter: average ", scheduler.AverageJitterUs(), " us, max ", scheduler.MaxJitterUs(), " us");
+
+    scheduler.Stop();
+}
+}  // namespace
+
+int main() {
+    LegacyCallsQueue legacy;
+
+    testQueue("Legacy CallsQueue", legacy);
+    testQueue("CallsQueue", CallsQueue::instance());
+
+    testSchedules();
+    testJitter();
+
+    cs::Console::writeLine("\n", sink);
+    return 0;
+}
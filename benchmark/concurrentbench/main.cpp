@@ -0,0 +1,124 @@
+#include <framework.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <lib/system/concurrent.hpp>
+#include <lib/system/console.hpp>
+#include <lib/system/scheduler.hpp>
+
+namespace {
+constexpr size_t kThreadTasks = 10000;
+constexpr size_t kPoolTasks = 1000000;
+constexpr size_t kFanOut = 100;
+
+std::atomic<size_t> counter{0};
+
+void wait(size_t expected) {
+    while (counter.load(std::memory_order_acquire) != expected) {
+        std::this_thread::yield();
+    }
+}
+
+template <typename Func>
+void measure(const std::string& title, size_t tasks, Func func) {
+    counter = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    cs::Framework::execute(func, std::chrono::seconds(600));
+    const auto duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    cs::Console::writeLine(title, ": ", duration / tasks, " ns per task");
+}
+
+// the former Concurrent::run with watcher, every task is a thread of std::async
+void testAsync() {
+    measure("std::async", kThreadTasks, [] {
+        std::vector<std::future<void>> futures;
+        futures.reserve(kThreadTasks);
+
+        for (size_t i = 0; i < kThreadTasks; ++i) {
+            futures.push_back(std::async(std::launch::async, [] { counter.fetch_add(1, std::memory_order_release); }));
+        }
+
+        wait(kThreadTasks);
+    });
+}
+
+// the former ThreadPool
+void testAsioPool() {
+    boost::asio::thread_pool pool(cs::Scheduler::instance().workersCount());
+
+    measure("boost::asio::thread_pool, posted by one thread", kPoolTasks, [&] {
+        for (size_t i = 0; i < kPoolTasks; ++i) {
+            boost::asio::post(pool, [] { counter.fetch_add(1, std::memory_order_release); });
+        }
+
+        wait(kPoolTasks);
+    });
+
+    measure("boost::asio::thread_pool, posted by tasks", kPoolTasks, [&] {
+        for (size_t i = 0; i < kPoolTasks / kFanOut; ++i) {
+            boost::asio::post(pool, [&] {
+                for (size_t task = 0; task < kFanOut; ++task) {
+                    boost::asio::post(pool, [] { counter.fetch_add(1, std::memory_order_release); });
+                }
+            });
+        }
+
+        wait(kPoolTasks);
+    });
+
+    pool.join();
+}
+
+void testScheduler() {
+    auto& scheduler = cs::Scheduler::instance();
+
+    measure("cs::Scheduler, posted by one thread", kPoolTasks, [&] {
+        for (size_t i = 0; i < kPoolTasks; ++i) {
+            scheduler.post([] { counter.fetch_add(1, std::memory_order_release); });
+        }
+
+        wait(kPoolTasks);
+    });
+
+    // subtasks go to queue of their worker, others steal them
+    measure("cs::Scheduler, posted by tasks", kPoolTasks, [&] {
+        for (size_t i = 0; i < kPoolTasks / kFanOut; ++i) {
+            scheduler.post([&] {
+                for (size_t task = 0; task < kFanOut; ++task) {
+                    scheduler.post([] { counter.fetch_add(1, std::memory_order_release); });
+                }
+            });
+        }
+
+        wait(kPoolTasks);
+    });
+
+    measure("cs::Concurrent::run with watcher", kThreadTasks, [] {
+        for (size_t i = 0; i < kThreadTasks; ++i) {
+            auto watcher = cs::Concurrent::run(cs::RunPolicy::ThreadPolicy, [] { return counter.fetch_add(1, std::memory_order_release); });
+        }
+
+        wait(kThreadTasks);
+    });
+}
+}  // namespace
+
+int main() {
+    cs::Console::writeLine("Workers: ", cs::Scheduler::instance().workersCount());
+
+    testAsync();
+    testAsioPool();
+    testScheduler();
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <framework.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <conflictgraph.hpp>
+
+namespace {
+// stub executor answers every call after fixed delay
+constexpr std::chrono::milliseconds kExecutionTime{5};
+
+struct Item {
+    std::vector<csdb::Address> footprint;
+    size_t executions = 1;
+    bool running = false;
+};
+
+csdb::Address contract(size_t id) {
+    cs::PublicKey key{};
+    key[0] = static_cast<cs::Byte>(id);
+    key[1] = static_cast<cs::Byte>(id >> 8);
+    return csdb::Address::from_public_key(key);
+}
+
+// items target one of contractsCount contracts, every item uses another contract with usesProbability
+std::list<Item> makeQueue(size_t itemsCount, size_t contractsCount, double usesProbability) {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<size_t> contracts(0, contractsCount - 1);
+    std::uniform_int_distribution<size_t> executions(1, 3);
+    std::bernoulli_distribution uses(usesProbability);
+
+    std::list<Item> queue;
+
+    for (size_t i = 0; i < itemsCount; ++i) {
+        Item& item = queue.emplace_back();
+        item.footprint.push_back(contract(contracts(generator)));
+        item.executions = executions(generator);
+
+        if (uses(generator)) {
+            item.footprint.push_back(contract(contracts(generator)));
+        }
+    }
+
+    return queue;
+}
+
+void execute(const Item& item) {
+    // executions of one item are always sequential, they share contract state
+    for (size_t i = 0; i < item.executions; ++i) {
+        std::this_thread::sleep_for(kExecutionTime);
+    }
+}
+
+size_t runSequential(std::list<Item> queue) {
+    size_t done = 0;
+
+    for (const auto& item : queue) {
+        execute(item);
+        ++done;
+    }
+
+    return done;
+}
+
+// dispatches ready items as soon as conflicting ones complete, like SmartContracts::test_exe_queue()
+size_t runScheduled(std::list<Item> queue) {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<std::list<Item>::iterator> completed;
+    std::vector<std::thread> threads;
+    size_t done = 0;
+
+    std::unique_lock lock(mutex);
+
+    while (!queue.empty()) {
+        for (auto it : completed) {
+            queue.erase(it);
+            ++done;
+        }
+
+        completed.clear();
+
+        cs::ConflictGraph graph;
+        std::vector<std::list<Item>::iterator> items;
+
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            graph.add(it->footprint, it->running ? cs::ConflictGraph::State::Active : cs::ConflictGraph::State::Pending);
+            items.push_back(it);
+        }
+
+        for (size_t index : graph.ready()) {
+            auto it = items[index];
+            it->running = true;
+
+            threads.emplace_back([&, it] {
+                execute(*it);
+
+                std::lock_guard guard(mutex);
+                completed.push_back(it);
+                condition.notify_one();
+            });
+        }
+
+        if (!queue.empty()) {
+            condition.wait(lock, [&] { return !completed.empty(); });
+        }
+    }
+
+    lock.unlock();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return done;
+}
+
+void test(size_t itemsCount, size_t contractsCount, double usesProbability) {
+    const auto queue = makeQueue(itemsCount, contractsCount, usesProbability);
+
+    cs::Console::writeLine("\n", itemsCount, " calls to ", contractsCount, " contracts, uses probability ", usesProbability);
+
+    for (auto [title, run] : {std::make_pair("sequential", &runSequential), std::make_pair("conflict graph", &runScheduled)}) {
+        cs::Console::writeLine("Dispatch: ", title);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        cs::Framework::execute([&, run = run] {
+            return run(queue) == queue.size();
+        }, std::chrono::seconds(120), "Not all calls executed");
+
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        cs::Console::writeLine("Throughput: ", static_cast<double>(queue.size()) / seconds, " calls/s");
+    }
+}
+}  // namespace
+
+int main() {
+    test(200, 1, 0.0);
+    test(200, 16, 0.0);
+    test(200, 16, 0.3);
+    test(200, 64, 0.3);
+
+    return 0;
+}
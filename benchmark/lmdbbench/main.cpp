@@ -1,9 +1,26 @@
 #include <lmdb.hpp>
 #include <framework.hpp>
 
+#include <chrono>
+#include <string>
+
+#include <lib/system/console.hpp>
+
 #include <boost/filesystem.hpp>
 namespace fs = boost::filesystem;
 
+namespace {
+constexpr size_t kBlocks = 2000;
+constexpr size_t kAddressesPerBlock = 50;
+
+// keys of transactions index, public key and sequence
+std::string indexKey(size_t address, size_t sequence) {
+    std::string key(32, static_cast<char>(address % 251));
+    key.append(std::to_string(address)).append(":").append(std::to_string(sequence));
+    return key;
+}
+}  // namespace
+
 static void runBench(cs::Lmdb* db) {
     std::string key = "Key";
     std::string value = "Value";
@@ -33,9 +50,59 @@ static void testLmdbWithFlags() {
     testLmdb(MDB_NOSYNC | MDB_WRITEMAP | MDB_MAPASYNC);
 }
 
+// indexes blocks as transactions index and block hashes do, blocksInBatch = 0 commits every key
+static void testBlocksIndex(const std::string& title, size_t blocksInBatch) {
+    const char* path = "testdbpath";
+
+    cs::Lmdb db(path);
+    db.setMaxDbs(2);
+    db.setMapSize(cs::Lmdb::Default1GbMapSize);
+    db.open();
+
+    db.createTable("index");
+    db.createTable("hashes");
+
+    const size_t commits = db.commitsCount();
+    const auto start = std::chrono::steady_clock::now();
+
+    cs::Framework::execute([&] {
+        for (size_t sequence = 0; sequence < kBlocks; ++sequence) {
+            if (blocksInBatch && sequence % blocksInBatch == 0) {
+                db.beginBatch();
+            }
+
+            for (size_t address = 0; address < kAddressesPerBlock; ++address) {
+                db.insert(indexKey(sequence * 7 + address, sequence), sequence, "index");
+            }
+
+            db.insert(sequence, indexKey(0, sequence), "hashes");
+
+            if (blocksInBatch && (sequence + 1) % blocksInBatch == 0) {
+                db.commitBatch();
+            }
+        }
+
+        if (db.isBatchOpened()) {
+            db.commitBatch();
+        }
+    }, std::chrono::seconds(600), "Blocks index run failed");
+
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto commitsCount = db.commitsCount() - commits;
+
+    cs::Console::writeLine(title, ": ", commitsCount, " commits, ", commitsCount / seconds, " commits/sec, ", kBlocks / seconds, " blocks/sec");
+
+    db.close();
+    fs::remove_all(fs::path(path));
+}
+
 int main() {
     testLmdbDefaultFlags();
     testLmdbWithFlags();
 
+    testBlocksIndex("Commit per key", 0);
+    testBlocksIndex("Batch per block", 1);
+    testBlocksIndex("Batch per 100 blocks", 100);
+
     return 0;
 }
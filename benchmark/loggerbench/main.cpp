@@ -0,0 +1,75 @@
+#include <framework.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include <lib/system/console.hpp>
+#include <lib/system/logger.hpp>
+
+namespace {
+constexpr const char* kLogPath = "./loggerbench.log";
+
+// calls of burst fit thread ring, background thread writes them between bursts
+constexpr size_t kBursts = 200;
+constexpr size_t kCallsInBurst = 1000;
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Func>
+void measure(const std::string& title, Func func) {
+    Clock::duration total{};
+
+    cs::Framework::execute([&] {
+        for (size_t burst = 0; burst < kBursts; ++burst) {
+            const auto start = Clock::now();
+
+            for (size_t i = 0; i < kCallsInBurst; ++i) {
+                func(burst * kCallsInBurst + i);
+            }
+
+            total += Clock::now() - start;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }, std::chrono::seconds(600));
+
+    const auto ns = std::chrono::duration<double, std::nano>(total).count();
+    cs::Console::writeLine(title, ": ", ns / (kBursts * kCallsInBurst), " ns per call");
+}
+
+logging::settings settings() {
+    logging::settings settings;
+    settings["Sinks.File.Destination"] = "TextFile";
+    settings["Sinks.File.FileName"] = kLogPath;
+    settings["Sinks.File.Format"] = "[%TimeStamp%] %Severity% %Message%";
+    settings["Sinks.File.Filter"] = "%Severity% >= debug";
+
+    return settings;
+}
+}  // namespace
+
+int main() {
+    const std::string hash = "7f3a6302d680e1";
+    logger::initialize(settings());
+
+    measure("csdetails, filtered by config", [&](size_t i) { csdetails() << "NODE> round " << i << ", hash " << hash; });
+    measure("csdebug", [&](size_t i) { csdebug() << "NODE> round " << i << ", hash " << hash; });
+    measure("cslog", [&](size_t i) { cslog() << "NODE> round " << i << ", hash " << hash; });
+    measure("cswarning", [&](size_t i) { cswarning() << "NODE> round " << i << ", hash " << hash; });
+    measure("cserror", [&](size_t i) { cserror() << "NODE> round " << i << ", hash " << hash; });
+    measure("csfatal", [&](size_t i) { csfatal() << "NODE> round " << i << ", hash " << hash; });
+    measure("csdebug, eliminated from build", [&](size_t i) { csdebug(logger::None) << "NODE> round " << i << ", hash " << hash; });
+
+    // the former way, record is formatted and written by calling thread
+    measure("Boost.Log synchronous debug", [&](size_t i) {
+        BOOST_LOG_SEV(logger::getLogger(), logger::severity_level::debug) << "NODE> round " << i << ", hash " << hash;
+    });
+
+    logger::cleanup();
+
+    cs::Console::writeLine("Dropped records: ", logger::droppedRecords());
+    std::remove(kLogPath);
+
+    return 0;
+}
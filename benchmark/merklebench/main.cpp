@@ -0,0 +1,59 @@
+#include <framework.hpp>
+
+#include <string>
+#include <vector>
+
+#include <csnode/merkletree.hpp>
+
+static std::vector<cs::Hash> makeLeaves(size_t count) {
+    std::vector<cs::Hash> leaves;
+    leaves.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto data = std::to_string(i);
+        leaves.push_back(cs::MerkleTree::leafHash(reinterpret_cast<const cs::Byte*>(data.data()), data.size()));
+    }
+
+    return leaves;
+}
+
+// root of whole block, as it is computed while block is assembled
+static void testRoot(const std::vector<cs::Hash>& leaves) {
+    cs::Console::writeLine("\nMerkle root of ", leaves.size(), " leaves");
+
+    cs::Framework::execute([&] {
+        cs::MerkleTree tree;
+
+        for (const auto& leaf : leaves) {
+            tree.add(leaf);
+        }
+
+        return tree.root() != cs::Hash{};
+    });
+}
+
+// proof of the last leaf is the worst case for proof builder, size is the same for any leaf up to one hash
+static void testProof(const std::vector<cs::Hash>& leaves) {
+    const auto root = cs::MerkleTree::root(leaves);
+    cs::MerkleTree::Proof proof;
+
+    cs::Console::writeLine("\nMerkle proof of ", leaves.size(), " leaves");
+
+    cs::Framework::execute([&] {
+        proof = cs::MerkleTree::proof(leaves, leaves.size() - 1);
+        return cs::MerkleTree::verify(leaves.back(), proof, root);
+    }, std::chrono::seconds(30), "Merkle proof verification failed");
+
+    cs::Console::writeLine("Proof size: ", proof.path.size(), " hashes, ", proof.path.size() * kHashLength + 2 * sizeof(uint64_t), " bytes");
+}
+
+int main() {
+    for (size_t count : {1000, 10000, 100000}) {
+        const auto leaves = makeLeaves(count);
+
+        testRoot(leaves);
+        testProof(leaves);
+    }
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <framework.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <lib/system/console.hpp>
+#include <lib/system/metrics.hpp>
+
+namespace {
+constexpr size_t kCalls = 10'000'000;
+
+using Clock = std::chrono::steady_clock;
+
+// runs func kCalls times in every thread, prints time per call
+template <typename Func>
+void measure(const std::string& title, size_t threadsCount, Func func) {
+    std::vector<std::thread> threads;
+    Clock::duration total{};
+
+    cs::Framework::execute([&] {
+        const auto start = Clock::now();
+
+        for (size_t i = 0; i < threadsCount; ++i) {
+            threads.emplace_back([&func] {
+                for (size_t j = 0; j < kCalls; ++j) {
+                    func(j);
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        total = Clock::now() - start;
+    }, std::chrono::seconds(600));
+
+    const auto ns = std::chrono::duration<double, std::nano>(total).count();
+    cs::Console::writeLine(title, ", ", threadsCount, " threads: ", ns / kCalls, " ns per call");
+}
+
+void run(size_t threads) {
+    auto& counter = cs::metrics::counter("bench_calls_total", "Calls");
+    auto& histogram = cs::metrics::histogram("bench_values", "Values");
+    auto& timer = cs::metrics::timer("bench_call_seconds", "Calls time");
+
+    // one atomic shared by all threads, to compare with sharded counter
+    static std::atomic<uint64_t> shared{0};
+
+    cs::metrics::setEnabled(false);
+    measure("Counter, disabled", threads, [&](size_t) { counter.increment(); });
+    measure("ScopedTimer, disabled", threads, [&](size_t) { cs::metrics::ScopedTimer scoped(timer); });
+
+    cs::metrics::setEnabled(true);
+    measure("Single atomic counter", threads, [&](size_t) { shared.fetch_add(1, std::memory_order_relaxed); });
+    measure("Counter", threads, [&](size_t) { counter.increment(); });
+    measure("Histogram", threads, [&](size_t i) { histogram.observe(i); });
+    measure("ScopedTimer", threads, [&](size_t) { cs::metrics::ScopedTimer scoped(timer); });
+}
+}  // namespace
+
+int main() {
+    run(1);
+    run(std::max(2u, std::thread::hardware_concurrency()));
+
+    cs::Console::writeLine("Exposition size: ", cs::metrics::Registry::instance().exposition().size(), " bytes");
+    return 0;
+}
@@ -0,0 +1,263 @@
+#include <framework.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <csnode/publishedwallets.hpp>
+#include <lib/system/common.hpp>
+#include <lib/system/console.hpp>
+
+namespace {
+constexpr size_t kReaders = 32;
+constexpr size_t kBlockWallets = 20000;
+constexpr auto kBlockInterval = std::chrono::milliseconds(50);
+constexpr auto kDuration = std::chrono::seconds(5);
+
+// 8 ns buckets up to 64 us, then 64 us buckets up to 64 ms
+constexpr size_t kFineBuckets = 8192;
+constexpr size_t kCoarseBuckets = 1024;
+
+// keeps lookups from being optimized out
+std::atomic<size_t> sink{0};
+
+// the former read path, copy of wallet under spin lock of blockchain cache
+struct WalletData {
+    csdb::Amount balance;
+    uint64_t transactionsCount = 0;
+    csdb::TransactionID lastTransaction;
+    int64_t greatest = 0;
+    std::array<uint64_t, 16> tail{};
+};
+
+struct KeyHash {
+    size_t operator()(const cs::PublicKey& key) const {
+        size_t hash = 0;
+        std::memcpy(&hash, key.data(), sizeof(hash));
+        return hash;
+    }
+};
+
+class LockedWallets {
+public:
+    void set(const cs::PublicKey& key, uint64_t value) {
+        auto& wallet = wallets_[key];
+        wallet.balance = csdb::Amount(static_cast<int32_t>(value));
+        wallet.transactionsCount = value;
+        wallet.lastTransaction = csdb::TransactionID(value, 0);
+        wallet.greatest = static_cast<int64_t>(value);
+    }
+
+    // block is applied under the same lock readers take
+    void apply(const std::vector<cs::PublicKey>& keys, uint64_t value) {
+        std::lock_guard lock(lock_);
+
+        for (const auto& key : keys) {
+            set(key, value);
+        }
+    }
+
+    bool find(const cs::PublicKey& key, WalletData& wallet) const {
+        std::lock_guard lock(lock_);
+        auto it = wallets_.find(key);
+
+        if (it == wallets_.end()) {
+            return false;
+        }
+
+        wallet = it->second;
+        return true;
+    }
+
+private:
+    mutable cs::SpinLock lock_{ATOMIC_FLAG_INIT};
+    std::unordered_map<cs::PublicKey, WalletData, KeyHash> wallets_;
+};
+
+class PublishedWallets {
+public:
+    void set(const cs::PublicKey& key, uint64_t value) {
+        cs::PublishedWallets::Wallet wallet;
+        wallet.balance = csdb::Amount(static_cast<int32_t>(value));
+        wallet.transactionsCount = value;
+        wallet.lastInnerId = static_cast<int64_t>(value);
+        wallet.lastTransaction = csdb::TransactionID(value, 0);
+
+        wallets_.publish(key, wallet);
+    }
+
+    // block is applied to cache first, then its wallets are published one by one
+    void apply(const std::vector<cs::PublicKey>& keys, uint64_t value) {
+        for (const auto& key : keys) {
+            set(key, value);
+        }
+    }
+
+    bool find(const cs::PublicKey& key, cs::PublishedWallets::Wallet& wallet) const {
+        return wallets_.find(key, wallet);
+    }
+
+private:
+    cs::PublishedWallets wallets_;
+};
+
+class Histogram {
+public:
+    Histogram()
+    : buckets_(kFineBuckets + kCoarseBuckets + 1, 0) {
+    }
+
+    void add(uint64_t nanoseconds) {
+        const auto fine = nanoseconds / 8;
+        const auto coarse = nanoseconds / 65536;
+
+        ++buckets_[fine < kFineBuckets ? fine : kFineBuckets + std::min<uint64_t>(coarse, kCoarseBuckets)];
+        total_ += nanoseconds;
+        ++count_;
+    }
+
+    void merge(const Histogram& other) {
+        for (size_t i = 0; i < buckets_.size(); ++i) {
+            buckets_[i] += other.buckets_[i];
+        }
+
+        total_ += other.total_;
+        count_ += other.count_;
+    }
+
+    uint64_t count() const {
+        return count_;
+    }
+
+    double average() const {
+        return count_ ? static_cast<double>(total_) / count_ : 0;
+    }
+
+    // upper bound of bucket
+    uint64_t percentile(double part) const {
+        const auto limit = static_cast<uint64_t>(part * count_);
+        uint64_t passed = 0;
+
+        for (size_t i = 0; i < buckets_.size(); ++i) {
+            passed += buckets_[i];
+
+            if (passed > limit) {
+                return i < kFineBuckets ? (i + 1) * 8 : (i - kFineBuckets + 1) * 65536;
+            }
+        }
+
+        return 0;
+    }
+
+private:
+    std::vector<uint64_t> buckets_;
+    uint64_t total_ = 0;
+    uint64_t count_ = 0;
+};
+
+std::vector<cs::PublicKey> makeKeys(size_t count) {
+    std::mt19937_64 generator(1);
+    std::vector<cs::PublicKey> keys(count);
+
+    for (auto& key : keys) {
+        for (auto& byte : key) {
+            byte = static_cast<cs::Byte>(generator());
+        }
+    }
+
+    return keys;
+}
+
+template <typename Wallets, typename Wallet>
+void test(const std::string& title, const std::vector<cs::PublicKey>& keys) {
+    cs::Console::writeLine("\n", title, ", ", keys.size(), " wallets, ", kReaders, " readers, ", kBlockWallets, " wallets in block");
+
+    Wallets wallets;
+
+    cs::Framework::execute([&] {
+        for (const auto& key : keys) {
+            wallets.set(key, 0);
+        }
+    }, std::chrono::seconds(600));
+
+    std::atomic<bool> isDone{false};
+    std::vector<Histogram> histograms(kReaders);
+    std::vector<std::thread> readers;
+
+    for (size_t i = 0; i < kReaders; ++i) {
+        readers.emplace_back([&, i] {
+            std::mt19937 generator(static_cast<unsigned>(i));
+            std::uniform_int_distribution<size_t> index(0, keys.size() - 1);
+
+            auto& histogram = histograms[i];
+            Wallet wallet;
+            size_t found = 0;
+
+            while (!isDone.load(std::memory_order_relaxed)) {
+                const auto& key = keys[index(generator)];
+                const auto start = std::chrono::steady_clock::now();
+
+                found += wallets.find(key, wallet);
+
+                histogram.add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+            }
+
+            sink += found;
+        });
+    }
+
+    // blocks touch random wallets, every block changes them to its own value
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<size_t> index(0, keys.size() - 1);
+    std::vector<cs::PublicKey> block(kBlockWallets);
+
+    Histogram applies;
+    const auto finish = std::chrono::steady_clock::now() + kDuration;
+
+    for (uint64_t sequence = 1; std::chrono::steady_clock::now() < finish; ++sequence) {
+        for (auto& key : block) {
+            key = keys[index(generator)];
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        wallets.apply(block, sequence);
+        applies.add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+
+        std::this_thread::sleep_for(kBlockInterval);
+    }
+
+    isDone = true;
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    Histogram reads;
+
+    for (const auto& histogram : histograms) {
+        reads.merge(histogram);
+    }
+
+    cs::Console::writeLine("Reads: ", reads.count(), ", average ", reads.average(), " ns, p99 ", reads.percentile(0.99), " ns, p99.9 ",
+                           reads.percentile(0.999), " ns");
+    cs::Console::writeLine("Blocks: ", applies.count(), ", average apply ", applies.average() / 1000, " us");
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    const auto keys = makeKeys(count);
+
+    test<LockedWallets, WalletData>("Copy under cache lock", keys);
+    test<PublishedWallets, cs::PublishedWallets::Wallet>("Published wallets", keys);
+
+    return 0;
+}
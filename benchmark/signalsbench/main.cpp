@@ -1,5 +1,9 @@
 #include <framework.hpp>
 
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include <lib/system/signals.hpp>
 #include <lib/system/random.hpp>
 #include <lib/system/console.hpp>
@@ -37,12 +41,49 @@ class D : public C {
     }
 };
 
+// wallet updates of block as separate signals and as one batch
+using Update = std::pair<size_t, size_t>;
+
+class Updater {
+public signals:
+    cs::Signal<void(size_t, size_t)> updated;
+    cs::Signal<void(const std::vector<Update>&)> blockUpdated;
+};
+
+class Subscriber {
+public slots:
+    void onUpdated(size_t key, size_t value) {
+        std::lock_guard lock(mutex);
+        pending.insert_or_assign(key, value);
+    }
+
+    void onBlockUpdated(const std::vector<Update>& updates) {
+        std::lock_guard lock(mutex);
+
+        for (const auto& [key, value] : updates) {
+            pending.insert_or_assign(key, value);
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<size_t, size_t> pending;
+};
+
 static A a;
+static A staticSignal;
+static A lambdaSignal;
 static B b;
 static C* c = new C();
 static C* d = new D();
+static const cs::FixedSignal<void(), &B::onCalled> fixedSignal(&b);
+
+static Updater updater;
+static Subscriber subscriber;
 
 static const size_t callsCount = 100'000'000;
+static const size_t blocksCount = 10'000;
+static const size_t blockUpdatesCount = 1'000;
 static const std::function<void()> bindedFunction = std::bind(&B::onCalled, &b);
 
 static void runDirectCall() {
@@ -57,6 +98,46 @@ static void runSignalsCall() {
     }
 }
 
+static void runStaticSignalsCall() {
+    for (size_t i = 0; i < callsCount; ++i) {
+        staticSignal.called();
+    }
+}
+
+static void runLambdaSignalsCall() {
+    for (size_t i = 0; i < callsCount; ++i) {
+        lambdaSignal.called();
+    }
+}
+
+static void runFixedSignalCall() {
+    for (size_t i = 0; i < callsCount; ++i) {
+        fixedSignal();
+    }
+}
+
+static void runUpdateSignals() {
+    for (size_t i = 0; i < blocksCount; ++i) {
+        for (size_t j = 0; j < blockUpdatesCount; ++j) {
+            updater.updated(j, i);
+        }
+    }
+}
+
+static void runBlockUpdateSignals() {
+    std::vector<Update> updates;
+
+    for (size_t i = 0; i < blocksCount; ++i) {
+        updates.clear();
+
+        for (size_t j = 0; j < blockUpdatesCount; ++j) {
+            updates.emplace_back(j, i);
+        }
+
+        updater.blockUpdated(updates);
+    }
+}
+
 static void runBindedFunctionCall() {
     for (size_t i = 0; i < callsCount; ++i) {
         bindedFunction();
@@ -87,6 +168,36 @@ static void testSignals() {
     cs::Console::writeLine("");
 }
 
+static void testStaticSignals() {
+    cs::Console::writeLine("Test signal call of compile time method slot");
+    cs::Framework::execute(&runStaticSignalsCall);
+    cs::Console::writeLine("");
+}
+
+static void testLambdaSignals() {
+    cs::Console::writeLine("Test signal call of lambda slot");
+    cs::Framework::execute(&runLambdaSignalsCall);
+    cs::Console::writeLine("");
+}
+
+static void testFixedSignal() {
+    cs::Console::writeLine("Test fixed signal call");
+    cs::Framework::execute(&runFixedSignalCall);
+    cs::Console::writeLine("");
+}
+
+static void testUpdateSignals() {
+    cs::Console::writeLine("Test signal per wallet update");
+    cs::Framework::execute(&runUpdateSignals);
+    cs::Console::writeLine("");
+}
+
+static void testBlockUpdateSignals() {
+    cs::Console::writeLine("Test signal per block of wallet updates");
+    cs::Framework::execute(&runBlockUpdateSignals);
+    cs::Console::writeLine("");
+}
+
 static void testBindedFunction() {
     cs::Console::writeLine("Test std::function call");
     cs::Framework::execute(&runBindedFunctionCall);
@@ -107,12 +218,21 @@ static void testVirtualDerivedCall() {
 
 int main() {
     cs::Connector::connect(&a.called, &b, &B::onCalled);
+    cs::Connector::connect<&B::onCalled>(&staticSignal.called, &b);
+    cs::Connector::connect(&lambdaSignal.called, [] { b.onCalled(); });
+    cs::Connector::connect(&updater.updated, &subscriber, &Subscriber::onUpdated);
+    cs::Connector::connect(&updater.blockUpdated, &subscriber, &Subscriber::onBlockUpdated);
 
     testDirectCall();
     testSignals();
+    testStaticSignals();
+    testLambdaSignals();
+    testFixedSignal();
     testBindedFunction();
     testVirtualDirectCall();
     testVirtualDerivedCall();
+    testUpdateSignals();
+    testBlockUpdateSignals();
 
     delete c;
     delete d;
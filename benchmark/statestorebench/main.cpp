@@ -0,0 +1,164 @@
+#include <framework.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include <csnode/contractstatestore.hpp>
+#include <lib/system/console.hpp>
+
+namespace {
+constexpr const char* kDbPath = "./statestorebench_db";
+
+// token contract state: holders sorted by key with their balances, transfers change two balances
+// and sometimes bring a new holder, as serialized map of a token contract does
+class TokenState {
+public:
+    TokenState(size_t holders, uint32_t seed)
+    : generator_(seed) {
+        for (size_t i = 0; i < holders; ++i) {
+            addHolder();
+        }
+    }
+
+    void transfer(double newHolderProbability) {
+        std::bernoulli_distribution newHolder(newHolderProbability);
+
+        if (newHolder(generator_)) {
+            addHolder();
+        }
+
+        std::uniform_int_distribution<size_t> holder(0, records() - 1);
+
+        changeBalance(holder(generator_));
+        changeBalance(holder(generator_));
+    }
+
+    const std::string& data() const {
+        return data_;
+    }
+
+private:
+    constexpr static size_t kKeySize = 32;
+    constexpr static size_t kRecordSize = kKeySize + sizeof(uint64_t);
+
+    size_t records() const {
+        return data_.size() / kRecordSize;
+    }
+
+    void addHolder() {
+        std::string record(kRecordSize, '\0');
+
+        for (auto& byte : record) {
+            byte = static_cast<char>(generator_());
+        }
+
+        // keeps records sorted by key as ordered map does
+        size_t position = 0;
+
+        while (position < data_.size() && data_.compare(position, kKeySize, record, 0, kKeySize) < 0) {
+            position += kRecordSize;
+        }
+
+        data_.insert(position, record);
+    }
+
+    void changeBalance(size_t index) {
+        const uint64_t balance = generator_();
+        std::memcpy(&data_[index * kRecordSize + kKeySize], &balance, sizeof(balance));
+    }
+
+    std::mt19937_64 generator_;
+    std::string data_;
+};
+
+size_t directorySize(const std::string& path) {
+    size_t size = 0;
+    boost::system::error_code code;
+
+    for (boost::filesystem::recursive_directory_iterator it(path, code), end; it != end; it.increment(code)) {
+        if (boost::filesystem::is_regular_file(it->path(), code)) {
+            size += boost::filesystem::file_size(it->path(), code);
+        }
+    }
+
+    return size;
+}
+
+// keeps window of last states held as executor keeps states of running executions
+void test(size_t contracts, size_t holders, size_t transfers, size_t window, bool database) {
+    cs::Console::writeLine("\n", contracts, " contracts of ", holders, " holders, ", transfers, " transfers, window of ", window,
+                           " states", database ? ", LMDB" : ", memory");
+
+    cs::ContractStateStore::Settings settings;
+
+    if (database) {
+        settings.path = kDbPath;
+        settings.memoryLimit = 1024 * 1024;
+    }
+
+    cs::ContractStateStore store(settings);
+
+    std::vector<TokenState> states;
+    std::vector<std::deque<cs::ContractStateStore::StateId>> held(contracts);
+
+    for (size_t i = 0; i < contracts; ++i) {
+        states.emplace_back(holders, static_cast<uint32_t>(i));
+    }
+
+    size_t written = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    cs::Framework::execute([&] {
+        for (size_t i = 0; i < transfers; ++i) {
+            const auto index = i % contracts;
+            const cs::PublicKey key{static_cast<cs::Byte>(index)};
+
+            states[index].transfer(0.05);
+            written += states[index].data().size();
+
+            held[index].push_back(store.put(csdb::Address::from_public_key(key), states[index].data()));
+
+            if (held[index].size() > window) {
+                store.release(held[index].front());
+                held[index].pop_front();
+            }
+        }
+
+        // every held state must be restored as it was
+        return store.get(held.front().back()) == states.front().data();
+    }, std::chrono::seconds(300), "State is not restored");
+
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto statistics = store.statistics();
+
+    const auto kb = [](size_t bytes) {
+        return bytes / 1024;
+    };
+
+    cs::Console::writeLine("Put rate: ", static_cast<double>(transfers) / seconds, " states/s, ", static_cast<double>(written) / seconds / 1024 / 1024, " MB/s");
+    cs::Console::writeLine("Held states as strings: ", kb(statistics.logicalBytes), " KB");
+    cs::Console::writeLine("Store: ", statistics.states, " states, ", statistics.chunks, " chunks of ", kb(statistics.chunkBytes), " KB, chunk lists ",
+                           kb(statistics.recipeBytes), " KB, in memory ", kb(statistics.cachedBytes + statistics.recipeBytes), " KB");
+    cs::Console::writeLine("Full states written: ", kb(written), " KB, store chunks written: ", kb(statistics.writtenBytes), " KB");
+
+    if (database) {
+        cs::Console::writeLine("Database files: ", kb(directorySize(kDbPath)), " KB");
+    }
+}
+}  // namespace
+
+int main() {
+    test(1, 20000, 2000, 1, false);
+    test(1, 20000, 2000, 64, false);
+    test(8, 5000, 4000, 64, false);
+    test(8, 5000, 4000, 64, true);
+
+    boost::filesystem::remove_all(kDbPath);
+    return 0;
+}
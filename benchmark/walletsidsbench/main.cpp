@@ -0,0 +1,182 @@
+#include <framework.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+
+#include <unistd.h>
+
+#include <csnode/walletsids.hpp>
+#include <lib/system/console.hpp>
+
+namespace {
+constexpr const char* kFilePath = "./walletsidsbench.bin";
+constexpr size_t kLookups = 1000000;
+
+// keeps lookups from being optimized out
+volatile size_t sink = 0;
+
+using WalletId = cs::WalletsIds::WalletId;
+
+// the former layout of wallets ids, two hashed indexes over address and id
+struct Wallet {
+    csdb::Address address;
+    struct byAddress {};
+    WalletId id;
+    struct byId {};
+};
+
+using HashedWallets = boost::multi_index_container<
+    Wallet,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<boost::multi_index::tag<Wallet::byAddress>, boost::multi_index::member<Wallet, csdb::Address, &Wallet::address>>,
+        boost::multi_index::hashed_unique<boost::multi_index::tag<Wallet::byId>, boost::multi_index::member<Wallet, WalletId, &Wallet::id>>>>;
+
+// resident memory of process, heap of both layouts is measured by its growth
+size_t residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t total = 0;
+    size_t resident = 0;
+
+    statm >> total >> resident;
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+std::vector<cs::PublicKey> makeKeys(size_t count) {
+    std::mt19937_64 generator(1);
+    std::vector<cs::PublicKey> keys(count);
+
+    for (auto& key : keys) {
+        for (auto& byte : key) {
+            byte = static_cast<cs::Byte>(generator());
+        }
+    }
+
+    return keys;
+}
+
+struct Queries {
+    std::vector<csdb::Address> addresses;
+    std::vector<WalletId> ids;
+};
+
+Queries makeQueries(const std::vector<cs::PublicKey>& keys) {
+    std::mt19937 generator(2);
+    std::uniform_int_distribution<size_t> index(0, keys.size() - 1);
+
+    Queries queries;
+
+    for (size_t i = 0; i < kLookups; ++i) {
+        const auto id = index(generator);
+
+        queries.addresses.push_back(csdb::Address::from_public_key(keys[id]));
+        queries.ids.push_back(static_cast<WalletId>(id));
+    }
+
+    return queries;
+}
+
+template <typename Func>
+double nanosecondsPerCall(Func func) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < kLookups; ++i) {
+        func(i);
+    }
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kLookups;
+}
+
+void testHashed(const std::vector<cs::PublicKey>& keys, const Queries& queries) {
+    cs::Console::writeLine("\nHashed multi index of ", keys.size(), " wallets");
+
+    const auto before = residentBytes();
+    HashedWallets wallets;
+
+    cs::Framework::execute([&] {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            wallets.insert(Wallet{csdb::Address::from_public_key(keys[i]), static_cast<WalletId>(i)});
+        }
+    }, std::chrono::seconds(600));
+
+    cs::Console::writeLine("Memory per wallet: ", static_cast<double>(residentBytes() - before) / keys.size(), " bytes");
+
+    size_t found = 0;
+    const auto& byAddress = wallets.get<Wallet::byAddress>();
+    const auto& byId = wallets.get<Wallet::byId>();
+
+    const auto addressLookup = nanosecondsPerCall([&](size_t i) { found += byAddress.find(queries.addresses[i])->id; });
+    // address is returned by copy as former findaddr did
+    const auto idLookup = nanosecondsPerCall([&](size_t i) {
+        csdb::Address address;
+        address = byId.find(queries.ids[i])->address;
+        found += address.is_public_key();
+    });
+
+    sink = found;
+    cs::Console::writeLine("Address to id: ", addressLookup, " ns, id to address: ", idLookup, " ns");
+}
+
+void testTable(const std::vector<cs::PublicKey>& keys, const Queries& queries) {
+    cs::Console::writeLine("\nOpen addressing table of ", keys.size(), " wallets");
+
+    const auto before = residentBytes();
+    cs::WalletsIds ids;
+
+    cs::Framework::execute([&] {
+        WalletId id = 0;
+
+        for (const auto& key : keys) {
+            ids.normal().get(csdb::Address::from_public_key(key), id);
+        }
+    }, std::chrono::seconds(600));
+
+    cs::Console::writeLine("Memory per wallet: ", static_cast<double>(residentBytes() - before) / keys.size(), " bytes, table and arrays ",
+                           static_cast<double>(ids.memoryUsage()) / keys.size(), " bytes");
+
+    size_t found = 0;
+
+    const auto addressLookup = nanosecondsPerCall([&](size_t i) {
+        WalletId id = 0;
+        ids.normal().find(queries.addresses[i], id);
+        found += id;
+    });
+
+    const auto idLookup = nanosecondsPerCall([&](size_t i) {
+        csdb::Address address;
+        found += ids.normal().findaddr(queries.ids[i], address);
+    });
+
+    sink = found;
+    cs::Console::writeLine("Address to id: ", addressLookup, " ns, id to address: ", idLookup, " ns");
+
+    cs::Console::writeLine("Save to file");
+    cs::Framework::execute([&] { return ids.save(kFilePath); }, std::chrono::seconds(600), "Table is not saved");
+
+    cs::Console::writeLine("Load from file");
+    cs::WalletsIds loaded;
+    cs::Framework::execute([&] { return loaded.load(kFilePath) && loaded.size() == ids.size(); }, std::chrono::seconds(600), "Table is not loaded");
+
+    std::remove(kFilePath);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? std::stoul(argv[1]) : 10000000;
+
+    const auto keys = makeKeys(count);
+    const auto queries = makeQueries(keys);
+
+    // heap of hashed nodes is not returned to system, so table is measured first
+    testTable(keys, queries);
+    testHashed(keys, queries);
+
+    return 0;
+}
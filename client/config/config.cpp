@@ -40,6 +40,7 @@ const std::string BLOCK_NAME_POOL_SYNC = "pool_sync";
 const std::string BLOCK_NAME_API = "api";
 const std::string BLOCK_NAME_CONVEYER = "conveyer";
 const std::string BLOCK_NAME_EVENT_REPORTER = "event_report";
+const std::string BLOCK_NAME_METRICS = "metrics";
 
 const std::string PARAM_NAME_NODE_TYPE = "node_type";
 const std::string PARAM_NAME_BOOTSTRAP_TYPE = "bootstrap_type";
@@ -55,6 +56,7 @@ const std::string PARAM_NAME_BROADCAST_FILLING = "broadcast_filling_percents";
 const std::string PARAM_NAME_ALWAYS_EXECUTE_CONTRACTS = "always_execute_contracts";
 const std::string PARAM_NAME_MIN_COMPATIBLE_VERSION = "min_compatible_version";
 const std::string PARAM_NAME_COMPATIBLE_VERSION = "compatible_version";
+const std::string PARAM_NAME_HOT_WALLETS_CAPACITY = "hot_wallets_capacity";
 
 const std::string PARAM_NAME_CONVEYER_SEND_CACHE = "send_cache_value";
 const std::string PARAM_NAME_CONVEYER_MAX_RESENDS_SEND_CACHE = "max_resends_send_cache";
@@ -87,6 +89,12 @@ const std::string PARAM_NAME_EXECUTOR_CHECK_VERSION_DELAY = "executor_check_vers
 const std::string PARAM_NAME_EXECUTOR_MULTI_INSTANCE = "executor_multi_instance";
 const std::string PARAM_NAME_EXECUTOR_VERSION_COMMIT_MIN = "executor_commit_min";
 const std::string PARAM_NAME_EXECUTOR_VERSION_COMMIT_MAX = "executor_commit_max";
+const std::string PARAM_NAME_EXECUTOR_CONNECTIONS = "executor_connections";
+const std::string PARAM_NAME_EXECUTOR_GETTERS_IN_FLIGHT = "executor_getters_in_flight";
+const std::string PARAM_NAME_EXECUTOR_COMPILES_IN_FLIGHT = "executor_compiles_in_flight";
+const std::string PARAM_NAME_EXECUTOR_GETTER_CACHE_SIZE = "executor_getter_cache_size";
+const std::string PARAM_NAME_EXECUTOR_STATES_MEMORY = "executor_states_memory";
+const std::string PARAM_NAME_EXECUTOR_SPECULATIVE_IN_FLIGHT = "executor_speculative_in_flight";
 const std::string PARAM_NAME_JPS_COMMAND_LINE = "jps_command";
 
 const std::string PARAM_NAME_EVENTS_CONSENSUS_LIAR = "consensus_liar";
@@ -806,12 +814,16 @@ Config Config::readFromFile(const std::string& fileName) {
         if (params.count(PARAM_NAME_MIN_COMPATIBLE_VERSION) > 0) {
             result.minCompatibleVersion_ = params.get<NodeVersion>(PARAM_NAME_MIN_COMPATIBLE_VERSION);
         }
+        if (params.count(PARAM_NAME_HOT_WALLETS_CAPACITY) > 0) {
+            result.hotWalletsCapacity_ = params.get<uint64_t>(PARAM_NAME_HOT_WALLETS_CAPACITY);
+        }
 
         result.setLoggerSettings(config);
         result.readPoolSynchronizerData(config);
         result.readApiData(config);
         result.readConveyerData(config);
         result.readEventsReportData(config);
+        result.readMetricsData(config);
 
         result.good_ = true;
     }
@@ -902,6 +914,12 @@ void Config::readApiData(const boost::property_tree::ptree& config) {
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_APIEXEC_PORT, apiData_.apiexecPort);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_VERSION_COMMIT_MIN, apiData_.executorCommitMin);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_VERSION_COMMIT_MAX, apiData_.executorCommitMax);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_CONNECTIONS, apiData_.executorConnections);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_GETTERS_IN_FLIGHT, apiData_.executorGettersInFlight);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_COMPILES_IN_FLIGHT, apiData_.executorCompilesInFlight);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_GETTER_CACHE_SIZE, apiData_.executorGetterCacheSize);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_STATES_MEMORY, apiData_.executorStatesMemory);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_SPECULATIVE_IN_FLIGHT, apiData_.executorSpeculativeInFlight);
 
     if (data.count(PARAM_NAME_EXECUTOR_IP)) {
         apiData_.executorHost = data.get<std::string>(PARAM_NAME_EXECUTOR_IP);
@@ -957,6 +975,15 @@ void Config::readEventsReportData(const boost::property_tree::ptree& config) {
     checkAndSaveValue(data, BLOCK_NAME_EVENT_REPORTER, PARAM_NAME_EVENTS_BIG_BANG, eventsReport_.big_bang);
 }
 
+void Config::readMetricsData(const boost::property_tree::ptree& config) {
+    if (!config.count(BLOCK_NAME_METRICS)) {
+        return;
+    }
+
+    const boost::property_tree::ptree& data = config.get_child(BLOCK_NAME_METRICS);
+    checkAndSaveValue(data, BLOCK_NAME_METRICS, PARAM_NAME_PORT, metricsData_.port);
+}
+
 template <typename T>
 bool Config::checkAndSaveValue(const boost::property_tree::ptree& data, const std::string& block, const std::string& param, T& value) {
     if (data.count(param)) {
@@ -1025,6 +1052,12 @@ bool operator==(const ApiData& lhs, const ApiData& rhs) {
            lhs.executorMultiInstance == rhs.executorMultiInstance &&
            lhs.executorCommitMin == rhs.executorCommitMin &&
            lhs.executorCommitMax == rhs.executorCommitMax &&
+           lhs.executorConnections == rhs.executorConnections &&
+           lhs.executorGettersInFlight == rhs.executorGettersInFlight &&
+           lhs.executorCompilesInFlight == rhs.executorCompilesInFlight &&
+           lhs.executorGetterCacheSize == rhs.executorGetterCacheSize &&
+           lhs.executorStatesMemory == rhs.executorStatesMemory &&
+           lhs.executorSpeculativeInFlight == rhs.executorSpeculativeInFlight &&
            lhs.jpsCmdLine == rhs.jpsCmdLine;
 }
 
@@ -1041,6 +1074,14 @@ bool operator!=(const ConveyerData& lhs, const ConveyerData& rhs) {
     return !(lhs == rhs);
 }
 
+bool operator==(const MetricsData& lhs, const MetricsData& rhs) {
+    return lhs.port == rhs.port;
+}
+
+bool operator!=(const MetricsData& lhs, const MetricsData& rhs) {
+    return !(lhs == rhs);
+}
+
 bool operator==(const EventsReportData& lhs, const EventsReportData rhs) {
     return lhs.on == rhs.on &&
         lhs.add_to_gray_list == rhs.add_to_gray_list &&
@@ -1089,9 +1130,11 @@ bool operator==(const Config& lhs, const Config& rhs) {
         lhs.recreateIndex_ == rhs.recreateIndex_ &&
         lhs.observerWaitTime_ == rhs.observerWaitTime_ &&
         lhs.roundElapseTime_ == rhs.roundElapseTime_ &&
+        lhs.hotWalletsCapacity_ == rhs.hotWalletsCapacity_ &&
         lhs.conveyerData_ == rhs.conveyerData_ &&
         lhs.minCompatibleVersion_ == rhs.minCompatibleVersion_ &&
-        lhs.eventsReport_ == rhs.eventsReport_;
+        lhs.eventsReport_ == rhs.eventsReport_ &&
+        lhs.metricsData_ == rhs.metricsData_;
 }
 
 bool operator!=(const Config& lhs, const Config& rhs) {
@@ -86,6 +86,12 @@ struct ApiData {
     bool executorMultiInstance = false;
     int executorCommitMin = 1506;   // first commit with support of checking
     int executorCommitMax{-1};      // unlimited range on the right
+    uint16_t executorConnections = 4;        // connections to executor
+    uint16_t executorGettersInFlight = 2;    // max API getter calls at once, 0 - no limit
+    uint16_t executorCompilesInFlight = 1;   // max compile calls at once, 0 - no limit
+    uint16_t executorGetterCacheSize = 4096; // max cached getter results, 0 - cache is off
+    uint16_t executorStatesMemory = 64;      // MB of contract states chunks in memory, 0 - no limit and no database
+    uint16_t executorSpeculativeInFlight = 0; // max speculative contract calls at once, 0 - speculation is off
     std::string jpsCmdLine = "jps";
 };
 
@@ -94,6 +100,10 @@ struct ConveyerData {
     size_t maxResendsSendCache = DEFAULT_CONVEYER_MAX_RESENDS_SEND_CACHE;
 };
 
+struct MetricsData {
+    uint16_t port = 0;  // local port of Prometheus endpoint, 0 - metrics are off
+};
+
 struct EventsReportData {
     // event reports collector address
     EndpointData collector_ep;
@@ -267,6 +277,11 @@ public:
         return roundElapseTime_;
     }
 
+    // wallets kept in memory, dormant ones above it are moved to disk, 0 - all wallets in memory
+    uint64_t hotWalletsCapacity() const {
+        return hotWalletsCapacity_;
+    }
+
     double getBroadcastCoefficient() const {
         return broadcastCoefficient_;
     }
@@ -284,6 +299,10 @@ public:
         return eventsReport_;
     }
 
+    const MetricsData& getMetricsSettings() const {
+        return metricsData_;
+    }
+
 private:
     static Config readFromFile(const std::string& fileName);
 
@@ -292,6 +311,7 @@ private:
     void readApiData(const boost::property_tree::ptree& config);
     void readConveyerData(const boost::property_tree::ptree& config);
     void readEventsReportData(const boost::property_tree::ptree& config);
+    void readMetricsData(const boost::property_tree::ptree& config);
 
     bool readKeys(const std::string& pathToPk, const std::string& pathToSk, const bool encrypt);
     void showKeys(const std::string& pk58);
@@ -347,10 +367,12 @@ private:
 
     uint64_t observerWaitTime_ = DEFAULT_OBSERVER_WAIT_TIME;
     uint64_t roundElapseTime_ = DEFAULT_ROUND_ELAPSE_TIME;
+    uint64_t hotWalletsCapacity_ = 0;
 
     ConveyerData conveyerData_;
 
     EventsReportData eventsReport_;
+    MetricsData metricsData_;
 
     friend bool operator==(const Config&, const Config&);
 };
@@ -368,6 +390,9 @@ bool operator!=(const ApiData& lhs, const ApiData& rhs);
 bool operator==(const ConveyerData& lhs, const ConveyerData& rhs);
 bool operator!=(const ConveyerData& lhs, const ConveyerData& rhs);
 
+bool operator==(const MetricsData& lhs, const MetricsData& rhs);
+bool operator!=(const MetricsData& lhs, const MetricsData& rhs);
+
 bool operator==(const Config& lhs, const Config& rhs);
 bool operator!=(const Config& lhs, const Config& rhs);
 
@@ -0,0 +1,111 @@
+///
+/// Rewrites blocks of existing storage in row or columnar format and reports
+/// disk bytes per transaction and decode throughput before and after conversion.
+///
+/// Usage: csdb_converter <path to db> <row|columnar>
+///
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <csdb/database_berkeleydb.hpp>
+#include <csdb/pool.hpp>
+#include <csdb/storage.hpp>
+
+namespace {
+struct Statistics {
+    size_t blocks = 0;
+    size_t transactions = 0;
+    size_t bytes = 0;
+    std::chrono::nanoseconds decodeTime{0};
+};
+
+Statistics measure(csdb::Database& db, cs::Sequence lastSequence) {
+    Statistics statistics;
+    cs::Bytes data;
+
+    for (cs::Sequence sequence = 0; sequence <= lastSequence; ++sequence) {
+        if (!db.get(static_cast<uint32_t>(sequence), &data)) {
+            continue;
+        }
+
+        statistics.bytes += data.size();
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto pool = csdb::Pool::from_binary(std::move(data));
+        statistics.decodeTime += std::chrono::steady_clock::now() - start;
+
+        ++statistics.blocks;
+        statistics.transactions += pool.transactions_count();
+    }
+
+    return statistics;
+}
+
+void print(const char* title, const Statistics& statistics) {
+    const double seconds = std::chrono::duration<double>(statistics.decodeTime).count();
+    const double transactions = static_cast<double>(statistics.transactions == 0 ? 1 : statistics.transactions);
+
+    std::cout << title << ": " << statistics.blocks << " blocks, " << statistics.transactions << " transactions, " << statistics.bytes << " bytes\n"
+              << "  disk bytes per transaction: " << static_cast<double>(statistics.bytes) / transactions << '\n'
+              << "  decode: " << seconds << " s, " << (seconds > 0 ? static_cast<double>(statistics.bytes) / seconds / (1 << 20) : 0) << " MB/s, "
+              << (seconds > 0 ? static_cast<double>(statistics.transactions) / seconds : 0) << " transactions/s" << std::endl;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cout << "Usage: " << argv[0] << " <path to db> <row|columnar>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string path = argv[1];
+    const std::string formatName = argv[2];
+
+    if (formatName != "row" && formatName != "columnar") {
+        std::cout << "Unknown block format " << formatName << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto format = formatName == "row" ? csdb::Storage::BlockFormat::Row : csdb::Storage::BlockFormat::Columnar;
+
+    auto db = std::make_shared<csdb::DatabaseBerkeleyDB>();
+    db->open(path);
+
+    csdb::Storage storage;
+
+    if (!storage.open(csdb::Storage::OpenOptions{db, cs::kWrongSequence, format})) {
+        std::cout << "Couldn't open database at " << path << ": " << storage.last_error_message() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (storage.last_hash().is_empty()) {
+        std::cout << "Database is empty" << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    const cs::Sequence lastSequence = storage.pool_sequence(storage.last_hash());
+
+    print("Before", measure(*db, lastSequence));
+
+    csdb::Storage::OpenCallback progress = [](const csdb::Storage::OpenProgress& progress) {
+        if (progress.poolsProcessed % 1000 == 0) {
+            std::cout << '\r' << progress.poolsProcessed << std::flush;
+        }
+
+        return false;
+    };
+
+    if (!storage.convert_blocks(format, progress)) {
+        std::cout << "\nConversion failed: " << storage.last_error_message() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << '\r';
+    print("After", measure(*db, lastSequence));
+
+    return EXIT_SUCCESS;
+}
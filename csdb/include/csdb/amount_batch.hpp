@@ -0,0 +1,122 @@
+/**
+ * @file amount_batch.hpp
+ */
+
+#ifndef _CREDITS_CSDB_AMOUNT_BATCH_H_INCLUDED_
+#define _CREDITS_CSDB_AMOUNT_BATCH_H_INCLUDED_
+
+#include <cinttypes>
+#include <cstddef>
+#include <vector>
+
+#include <csdb/amount.hpp>
+
+namespace csdb {
+
+/** @brief Block-wide struct-of-arrays arithmetic over \ref Amount values.
+ *
+ * Balances, accumulated deltas and fees are stored as separate integral/fraction columns, so applying
+ * a whole block is a single pass over contiguous memory. On x86-64 kernels are built with AVX2 as well
+ * and four amounts are processed per instruction if CPU supports it, otherwise a scalar loop is used.
+ *
+ * Results are bit-identical to sequential Amount::operator+= / Amount::operator-= calls: both keep
+ * the fraction normalized into [0, AMOUNT_MAX_FRACTION), so the operations are exact modular
+ * arithmetic and the order of accumulation does not matter.
+ *
+ * Usage:
+ * \code
+ * AmountBatch batch;
+ * auto slot = batch.addWallet(wallet.balance_);
+ * batch.debit(slot, trx.amount());
+ * batch.addFee(fee);
+ * batch.apply();
+ * wallet.balance_ = batch.balance(slot);
+ * \endcode
+ */
+class AmountBatch {
+public:
+    using Slot = uint32_t;
+
+    void reserve(size_t wallets, size_t fees = 0);
+    void clear() noexcept;
+
+    /// registers wallet with its current balance, returns slot used by credit/debit
+    Slot addWallet(const Amount& balance);
+
+    size_t size() const noexcept {
+        return balanceIntegral_.size();
+    }
+
+    inline void credit(Slot slot, const Amount& value) noexcept;
+    inline void debit(Slot slot, const Amount& value) noexcept;
+
+    void addFee(const Amount& fee);
+
+    /// adds accumulated deltas to balances, sums fees and collects negative balances in one pass
+    void apply();
+
+    Amount balance(Slot slot) const noexcept {
+        return Amount(balanceIntegral_[slot], balanceFraction_[slot]);
+    }
+
+    const Amount& feeTotal() const noexcept {
+        return feeTotal_;
+    }
+
+    /// slots with negative balance after last apply()
+    const std::vector<Slot>& negative() const noexcept {
+        return negative_;
+    }
+
+    /// true if AVX2 kernels are built and supported by CPU
+    static bool isVectorized() noexcept;
+
+    // Raw column kernels, exposed for callers that already keep struct-of-arrays data.
+public:
+    /// integral[i], fraction[i] += deltaIntegral[i], deltaFraction[i]
+    static void add(int32_t* integral, uint64_t* fraction, const int32_t* deltaIntegral, const uint64_t* deltaFraction, size_t count) noexcept;
+
+    /// sum of all amounts, same as successive operator+= starting from zero
+    static Amount sum(const int32_t* integral, const uint64_t* fraction, size_t count) noexcept;
+
+    /// appends indexes of negative amounts to result
+    static void findNegative(const int32_t* integral, size_t count, std::vector<Slot>& result);
+
+    /// scalar versions of kernels, reference for vectorized ones
+    static void addScalar(int32_t* integral, uint64_t* fraction, const int32_t* deltaIntegral, const uint64_t* deltaFraction, size_t count) noexcept;
+    static Amount sumScalar(const int32_t* integral, const uint64_t* fraction, size_t count) noexcept;
+    static void findNegativeScalar(const int32_t* integral, size_t count, std::vector<Slot>& result);
+
+private:
+    std::vector<int32_t> balanceIntegral_;
+    std::vector<uint64_t> balanceFraction_;
+
+    std::vector<int32_t> deltaIntegral_;
+    std::vector<uint64_t> deltaFraction_;
+
+    std::vector<int32_t> feeIntegral_;
+    std::vector<uint64_t> feeFraction_;
+
+    Amount feeTotal_;
+    std::vector<Slot> negative_;
+};
+
+inline void AmountBatch::credit(Slot slot, const Amount& value) noexcept {
+    Amount delta(deltaIntegral_[slot], deltaFraction_[slot]);
+    delta += value;
+
+    deltaIntegral_[slot] = delta.integral();
+    deltaFraction_[slot] = delta.fraction();
+}
+
+inline void AmountBatch::debit(Slot slot, const Amount& value) noexcept {
+    Amount delta(deltaIntegral_[slot], deltaFraction_[slot]);
+    delta -= value;
+
+    deltaIntegral_[slot] = delta.integral();
+    deltaFraction_[slot] = delta.fraction();
+}
+
+}  // namespace csdb
+
+#endif  // _CREDITS_CSDB_AMOUNT_BATCH_H_INCLUDED_
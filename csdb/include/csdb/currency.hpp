@@ -26,6 +26,7 @@ public:
 
     bool is_valid() const noexcept;
     std::string to_string() const noexcept;
+    uint8_t id() const noexcept;
 
     bool operator==(const Currency& other) const noexcept;
     bool operator!=(const Currency& other) const noexcept;
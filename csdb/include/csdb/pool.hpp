@@ -68,6 +68,7 @@ public:
     size_t calcHash() const noexcept;
 
     static PoolHash calc_from_data(const cs::Bytes& data);
+    static PoolHash calc_from_data(const cs::Byte* data, size_t size);
 
 private:
     void put(::csdb::priv::obstream&) const;
@@ -242,7 +243,16 @@ public:
      * @return Бинарное представление пула, если пул находится в режиме read-only, и пустой
      *         массив в противном случае.
      */
-    cs::Bytes to_binary() const noexcept;
+    const cs::Bytes& to_binary() const noexcept;
+
+    /**
+     * @brief Columnar on-disk representation of composed pool, see Storage::BlockFormat.
+     * @return Columnar representation, empty array if pool is not composed.
+     *
+     * from_binary, meta_from_binary and hash_from_binary accept both representations,
+     * columnar one is decoded back to row representation byte to byte.
+     */
+    cs::Bytes to_columnar_binary() const;
 
     /**
      * @brief Сохранение пула в хранилище.
@@ -319,6 +329,10 @@ public:
      */
     Transaction get_last_by_target(const Address& target) const noexcept;
 
+private:
+    // replaces columnar representation by row one, row representation is left as is
+    static bool decode_if_columnar(cs::Bytes& data);
+
     friend class Storage;
 };
 
@@ -72,6 +72,12 @@ public:
         UnknownError = 255,
     };
 
+    /// On-disk representation of blocks, both formats are read, format selects how new blocks are written.
+    enum class BlockFormat : uint8_t {
+        Row,       ///< Pool::to_binary
+        Columnar,  ///< Pool::to_columnar_binary
+    };
+
 public:
     Error last_error() const;
     std::string last_error_message() const;
@@ -96,6 +102,7 @@ public:
         /// Экземпляр драйвера базы данных
         ::std::shared_ptr<Database> db;
         ::cs::Sequence newBlockchainTop = ::cs::kWrongSequence;
+        BlockFormat blockFormat = BlockFormat::Row;
     };
 
     struct OpenProgress {
@@ -136,7 +143,7 @@ public:
      * \ref last_error_message, \ref db_last_error() и \ref db_last_error_message()
      */
     bool open(const ::std::string& path_to_base = ::std::string{}, OpenCallback callback = nullptr,
-              cs::Sequence newBlockchainTop = cs::kWrongSequence);
+              cs::Sequence newBlockchainTop = cs::kWrongSequence, BlockFormat blockFormat = BlockFormat::Row);
 
     /**
      * @brief Создание хранилища по набору параметров.
@@ -205,6 +212,18 @@ public:
 
     Pool pool_remove_last();
 
+    BlockFormat block_format() const noexcept;
+
+    /**
+     * @brief Rewrites all stored blocks in given format, blocks already stored in it are skipped.
+     * @param[in] format    Target format, it becomes the format of new blocks as well.
+     * @param[in] callback  Progress callback, returns true to cancel conversion.
+     * @return true if all blocks are converted.
+     *
+     * Block hashes do not depend on format, so conversion may be interrupted and repeated.
+     */
+    bool convert_blocks(BlockFormat format, OpenCallback callback = nullptr);
+
 	/**
 	 * @brief Удаляет последний блок из хранилища без вычисления хэша блока. Используется при нарушении целостности данных,
 	 * когда из удаляемого блока нельзя получить его хэш, а само значение хэша известно из другого источника, например из кэша. Также, корректно
@@ -123,6 +123,9 @@ public:
     std::vector<uint8_t> to_byte_stream() const;
     std::vector<uint8_t> to_byte_stream_for_sig() const;
 
+    // fills caller buffer with signed content, buffer capacity is reused between calls
+    void to_byte_stream_for_sig(cs::Bytes& buffer) const;
+
     bool verify_signature(const cs::PublicKey& public_key) const;
 
     /**
@@ -158,6 +161,7 @@ public:
 
 private:
   void put(::csdb::priv::obstream&) const;
+  void put_for_sig(::csdb::priv::obstream&) const;
   bool get(::csdb::priv::ibstream&);
   friend class ::csdb::priv::obstream;
   friend class ::csdb::priv::ibstream;
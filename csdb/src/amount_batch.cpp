@@ -0,0 +1,271 @@
+#include <csdb/amount_batch.hpp>
+
+#include <algorithm>
+
+// AVX2 kernels are built for every x86-64 target and chosen at run time by CPU
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define CSDB_AMOUNT_BATCH_AVX2
+#define CSDB_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_M_X64) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#define CSDB_AMOUNT_BATCH_AVX2
+#define CSDB_TARGET_AVX2
+#endif
+
+namespace {
+constexpr size_t kLanes = 4;
+
+#ifdef CSDB_AMOUNT_BATCH_AVX2
+bool hasAvx2() noexcept {
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+
+    if (info[0] < 7) {
+        return false;
+    }
+
+    // OS must save ymm registers on context switch
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+
+    if (!osxsave || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+// kernels below return count of processed items, the rest is left to scalar loops
+
+CSDB_TARGET_AVX2 size_t addAvx2(int32_t* integral, uint64_t* fraction, const int32_t* deltaIntegral, const uint64_t* deltaFraction, size_t count) noexcept {
+    size_t i = 0;
+
+    // both fractions are below 10^18, so their sum fits into signed 64 bit lane and signed compare is safe
+    const __m256i maxFraction = _mm256_set1_epi64x(static_cast<int64_t>(csdb::Amount::AMOUNT_MAX_FRACTION));
+    const __m256i carryBound = _mm256_set1_epi64x(static_cast<int64_t>(csdb::Amount::AMOUNT_MAX_FRACTION - 1));
+    const __m256i packLow = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+    for (; i + kLanes <= count; i += kLanes) {
+        __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(fraction + i));
+        const __m256i df = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(deltaFraction + i));
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(integral + i));
+        const __m128i din = _mm_loadu_si128(reinterpret_cast<const __m128i*>(deltaIntegral + i));
+
+        f = _mm256_add_epi64(f, df);
+        const __m256i carry = _mm256_cmpgt_epi64(f, carryBound);
+        f = _mm256_sub_epi64(f, _mm256_and_si256(carry, maxFraction));
+
+        // carry lanes are all ones (-1), subtracting them increments integral part
+        const __m128i carry32 = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(carry, packLow));
+        in = _mm_sub_epi32(_mm_add_epi32(in, din), carry32);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(fraction + i), f);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(integral + i), in);
+    }
+
+    return i;
+}
+
+CSDB_TARGET_AVX2 size_t sumAvx2(const int32_t* integral, const uint64_t* fraction, size_t count, csdb::Amount& result) noexcept {
+    size_t i = 0;
+
+    if (count < kLanes) {
+        return i;
+    }
+
+    const __m256i maxFraction = _mm256_set1_epi64x(static_cast<int64_t>(csdb::Amount::AMOUNT_MAX_FRACTION));
+    const __m256i carryBound = _mm256_set1_epi64x(static_cast<int64_t>(csdb::Amount::AMOUNT_MAX_FRACTION - 1));
+    const __m256i packLow = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+    __m256i accFraction = _mm256_setzero_si256();
+    __m128i accIntegral = _mm_setzero_si128();
+
+    for (; i + kLanes <= count; i += kLanes) {
+        accFraction = _mm256_add_epi64(accFraction, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(fraction + i)));
+        accIntegral = _mm_add_epi32(accIntegral, _mm_loadu_si128(reinterpret_cast<const __m128i*>(integral + i)));
+
+        const __m256i carry = _mm256_cmpgt_epi64(accFraction, carryBound);
+        accFraction = _mm256_sub_epi64(accFraction, _mm256_and_si256(carry, maxFraction));
+        accIntegral = _mm_sub_epi32(accIntegral, _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(carry, packLow)));
+    }
+
+    alignas(32) uint64_t laneFraction[kLanes];
+    alignas(16) int32_t laneIntegral[kLanes];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(laneFraction), accFraction);
+    _mm_store_si128(reinterpret_cast<__m128i*>(laneIntegral), accIntegral);
+
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+        result += csdb::Amount(laneIntegral[lane], laneFraction[lane]);
+    }
+
+    return i;
+}
+
+CSDB_TARGET_AVX2 size_t findNegativeAvx2(const int32_t* integral, size_t count, std::vector<csdb::AmountBatch::Slot>& result) {
+    constexpr size_t kIntegralLanes = 8;
+    size_t i = 0;
+
+    for (; i + kIntegralLanes <= count; i += kIntegralLanes) {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(integral + i));
+        auto mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(in)));
+
+        while (mask != 0) {
+            unsigned bit = 0;
+            while (((mask >> bit) & 1u) == 0) {
+                ++bit;
+            }
+
+            result.push_back(static_cast<csdb::AmountBatch::Slot>(i + bit));
+            mask &= mask - 1;
+        }
+    }
+
+    return i;
+}
+#endif
+}  // namespace
+
+namespace csdb {
+
+void AmountBatch::reserve(size_t wallets, size_t fees) {
+    balanceIntegral_.reserve(wallets);
+    balanceFraction_.reserve(wallets);
+    deltaIntegral_.reserve(wallets);
+    deltaFraction_.reserve(wallets);
+
+    feeIntegral_.reserve(fees);
+    feeFraction_.reserve(fees);
+}
+
+void AmountBatch::clear() noexcept {
+    balanceIntegral_.clear();
+    balanceFraction_.clear();
+    deltaIntegral_.clear();
+    deltaFraction_.clear();
+    feeIntegral_.clear();
+    feeFraction_.clear();
+
+    feeTotal_ = Amount{};
+    negative_.clear();
+}
+
+AmountBatch::Slot AmountBatch::addWallet(const Amount& balance) {
+    const auto slot = static_cast<Slot>(balanceIntegral_.size());
+
+    balanceIntegral_.push_back(balance.integral());
+    balanceFraction_.push_back(balance.fraction());
+    deltaIntegral_.push_back(0);
+    deltaFraction_.push_back(0);
+
+    return slot;
+}
+
+void AmountBatch::addFee(const Amount& fee) {
+    feeIntegral_.push_back(fee.integral());
+    feeFraction_.push_back(fee.fraction());
+}
+
+void AmountBatch::apply() {
+    add(balanceIntegral_.data(), balanceFraction_.data(), deltaIntegral_.data(), deltaFraction_.data(), balanceIntegral_.size());
+
+    std::fill(deltaIntegral_.begin(), deltaIntegral_.end(), 0);
+    std::fill(deltaFraction_.begin(), deltaFraction_.end(), 0);
+
+    feeTotal_ = sum(feeIntegral_.data(), feeFraction_.data(), feeIntegral_.size());
+    feeIntegral_.clear();
+    feeFraction_.clear();
+
+    negative_.clear();
+    findNegative(balanceIntegral_.data(), balanceIntegral_.size(), negative_);
+}
+
+bool AmountBatch::isVectorized() noexcept {
+#ifdef CSDB_AMOUNT_BATCH_AVX2
+    static const bool vectorized = hasAvx2();
+    return vectorized;
+#else
+    return false;
+#endif
+}
+
+void AmountBatch::add(int32_t* integral, uint64_t* fraction, const int32_t* deltaIntegral, const uint64_t* deltaFraction, size_t count) noexcept {
+    size_t i = 0;
+
+#ifdef CSDB_AMOUNT_BATCH_AVX2
+    if (isVectorized()) {
+        i = addAvx2(integral, fraction, deltaIntegral, deltaFraction, count);
+    }
+#endif
+
+    addScalar(integral + i, fraction + i, deltaIntegral + i, deltaFraction + i, count - i);
+}
+
+Amount AmountBatch::sum(const int32_t* integral, const uint64_t* fraction, size_t count) noexcept {
+    Amount result;
+    size_t i = 0;
+
+#ifdef CSDB_AMOUNT_BATCH_AVX2
+    if (isVectorized()) {
+        i = sumAvx2(integral, fraction, count, result);
+    }
+#endif
+
+    result += sumScalar(integral + i, fraction + i, count - i);
+    return result;
+}
+
+void AmountBatch::findNegative(const int32_t* integral, size_t count, std::vector<Slot>& result) {
+    size_t i = 0;
+
+#ifdef CSDB_AMOUNT_BATCH_AVX2
+    if (isVectorized()) {
+        i = findNegativeAvx2(integral, count, result);
+    }
+#endif
+
+    const auto tail = result.size();
+    findNegativeScalar(integral + i, count - i, result);
+
+    for (auto it = result.begin() + static_cast<std::ptrdiff_t>(tail); it != result.end(); ++it) {
+        *it += static_cast<Slot>(i);
+    }
+}
+
+void AmountBatch::addScalar(int32_t* integral, uint64_t* fraction, const int32_t* deltaIntegral, const uint64_t* deltaFraction, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        Amount value(integral[i], fraction[i]);
+        value += Amount(deltaIntegral[i], deltaFraction[i]);
+
+        integral[i] = value.integral();
+        fraction[i] = value.fraction();
+    }
+}
+
+Amount AmountBatch::sumScalar(const int32_t* integral, const uint64_t* fraction, size_t count) noexcept {
+    Amount result;
+
+    for (size_t i = 0; i < count; ++i) {
+        result += Amount(integral[i], fraction[i]);
+    }
+
+    return result;
+}
+
+void AmountBatch::findNegativeScalar(const int32_t* integral, size_t count, std::vector<Slot>& result) {
+    // fraction is always non negative, so sign of amount is sign of its integral part
+    for (size_t i = 0; i < count; ++i) {
+        if (integral[i] < 0) {
+            result.push_back(static_cast<Slot>(i));
+        }
+    }
+}
+
+}  // namespace csdb
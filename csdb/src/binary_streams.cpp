@@ -7,18 +7,17 @@ namespace csdb {
 namespace priv {
 
 void obstream::put(const void *buf, size_t size) {
-    auto data = static_cast<const uint8_t *>(buf);
-    buffer_.insert(buffer_.end(), data, data + size);
+    write(buf, size);
 }
 
 void obstream::put(const std::string &value) {
     put(static_cast<uint32_t>(value.size()));
-    buffer_.insert(buffer_.end(), value.begin(), value.end());
+    write(value.data(), value.size());
 }
 
 void obstream::put(const cs::Bytes &value) {
     put(value.size());
-    buffer_.insert(buffer_.end(), value.begin(), value.end());
+    write(value.data(), value.size());
 }
 
 bool ibstream::get(void *buf, size_t size) {
@@ -34,34 +33,58 @@ bool ibstream::get(void *buf, size_t size) {
 }
 
 bool ibstream::get(std::string &value) {
-    uint32_t size;
-    if (!get(size)) {
+    std::string_view view;
+    if (!get_view(view)) {
+        return false;
+    }
+
+    value.assign(view.data(), view.size());
+    return true;
+}
+
+bool ibstream::get(cs::Bytes &value) {
+    cs::BytesView view;
+    if (!get_view(view)) {
         return false;
     }
+
+    value.assign(view.data(), view.data() + view.size());
+    return true;
+}
+
+bool ibstream::get_view(cs::BytesView &value, size_t size) {
     if (size > size_) {
         return false;
     }
 
-    auto data = static_cast<const char *>(data_);
-    value.assign(data, size);
+    const auto data = static_cast<const uint8_t *>(data_);
+    value = cs::BytesView(data, size);
     size_ -= size;
     data_ = static_cast<const void *>(data + size);
     return true;
 }
 
-bool ibstream::get(cs::Bytes &value) {
+bool ibstream::get_view(cs::BytesView &value) {
     size_t size;
     if (!get(size)) {
         return false;
     }
-    if (size > size_) {
+
+    return get_view(value, size);
+}
+
+bool ibstream::get_view(std::string_view &value) {
+    uint32_t size;
+    if (!get(size)) {
         return false;
     }
 
-    const auto data = static_cast<const uint8_t *>(data_);
-    value.assign(data, data + size);
-    size_ -= size;
-    data_ = static_cast<const void *>(data + size);
+    cs::BytesView view;
+    if (!get_view(view, size)) {
+        return false;
+    }
+
+    value = std::string_view(reinterpret_cast<const char *>(view.data()), view.size());
     return true;
 }
 
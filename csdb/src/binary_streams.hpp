@@ -11,6 +11,7 @@
 #include <cstring>
 #include <map>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 
@@ -23,8 +24,28 @@
 namespace csdb {
 namespace priv {
 
+///
+/// Writes either into own buffer, into caller buffer (appending to its content and reusing its capacity)
+/// or nowhere at all, only counting bytes. Counter lets to calculate exact size of serialized value
+/// and grow destination buffer once, see serialize().
+///
 class obstream {
 public:
+    obstream()
+    : buffer_(&ownBuffer_) {
+    }
+
+    explicit obstream(cs::Bytes& buffer)
+    : buffer_(&buffer) {
+    }
+
+    obstream(const obstream&) = delete;
+    obstream& operator=(const obstream&) = delete;
+
+    static obstream counter() {
+        return obstream(nullptr);
+    }
+
     void put(const void* buf, size_t size);
     void put(const std::string& value);
     void put(const cs::Bytes& value);
@@ -48,13 +69,57 @@ public:
     void put_smart(const ::std::map<K, T, C, A>& value);
 
     inline const cs::Bytes& buffer() const {
-        return buffer_;
+        return *buffer_;
+    }
+
+    // bytes put by this stream, does not include caller buffer previous content
+    inline size_t size() const noexcept {
+        return size_;
+    }
+
+    inline bool isCounter() const noexcept {
+        return buffer_ == nullptr;
     }
 
 private:
-    cs::Bytes buffer_;
+    explicit obstream(std::nullptr_t)
+    : buffer_(nullptr) {
+    }
+
+    inline void write(const void* data, size_t size) {
+        if (buffer_ != nullptr) {
+            auto bytes = static_cast<const uint8_t*>(data);
+            buffer_->insert(buffer_->end(), bytes, bytes + size);
+        }
+
+        size_ += size;
+    }
+
+    cs::Bytes ownBuffer_;
+    cs::Bytes* buffer_;
+    size_t size_ = 0;
 };
 
+///
+/// Appends serialized value to buffer, func(obstream&) is called twice:
+/// first time to count bytes, second time to write them into exactly reserved space.
+///
+template <typename Func>
+void serialize(cs::Bytes& buffer, Func func) {
+    size_t size = 0;
+
+    {
+        obstream counter = obstream::counter();
+        func(counter);
+        size = counter.size();
+    }
+
+    buffer.reserve(buffer.size() + size);
+
+    obstream os(buffer);
+    func(os);
+}
+
 class ibstream {
 public:
     ibstream(const void* data, size_t size)
@@ -72,6 +137,11 @@ public:
     bool get(std::string& value);
     bool get(cs::Bytes& value);
 
+    // views point into source data, so they are valid while source is alive
+    bool get_view(cs::BytesView& value, size_t size);
+    bool get_view(cs::BytesView& value);
+    bool get_view(std::string_view& value);
+
     template <typename T>
     typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, bool>::type get(T& value);
 
@@ -105,7 +175,7 @@ namespace priv {
 
 template <typename T>
 typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, void>::type inline obstream::put(T value) {
-    buffer_.insert(buffer_.end(), reinterpret_cast<uint8_t*>(&value), reinterpret_cast<uint8_t*>(&value) + sizeof(value));
+    write(&value, sizeof(value));
 }
 
 template <typename T>
@@ -129,7 +199,7 @@ void obstream::put(const ::std::map<K, T, C, A>& value) {
 
 template <std::size_t Size>
 void obstream::put(const cs::ByteArray<Size>& value) {
-    buffer_.insert(buffer_.end(), value.begin(), value.end());
+    write(value.data(), value.size());
 }
 
 template <class K, class T, class C, class A>
@@ -17,6 +17,10 @@ std::string Currency::to_string() const noexcept {
     return std::to_string(d->id);
 }
 
+uint8_t Currency::id() const noexcept {
+    return d->id;
+}
+
 bool Currency::operator==(const Currency &other) const noexcept {
     return d->id == other.d->id;
 }
@@ -23,6 +23,7 @@
 #include "transaction_p.hpp"
 #include "priv_crypto.hpp"
 #include "binary_streams.hpp"
+#include "pool_columnar.hpp"
 
 namespace csdb {
 
@@ -74,8 +75,12 @@ PoolHash PoolHash::from_string(const ::std::string& str) {
 }
 
 PoolHash PoolHash::calc_from_data(const cs::Bytes& data) {
+    return calc_from_data(data.data(), data.size());
+}
+
+PoolHash PoolHash::calc_from_data(const cs::Byte* data, size_t size) {
     PoolHash res;
-    res.d->value = ::csdb::priv::crypto::calc_hash(data);
+    res.d->value = ::csdb::priv::crypto::calc_hash(data, size);
     return res;
 }
 
@@ -117,7 +122,7 @@ class Pool::priv : public ::csdb::internal::shared_data {
     , storage_(std::move(storage)) {
     }
 
-    void put(::csdb::priv::obstream& os, bool doHash) const {
+    void put_header(::csdb::priv::obstream& os) const {
         os.put(version_);
         os.put(previous_hash_);
         os.put(sequence_);
@@ -126,6 +131,10 @@ class Pool::priv : public ::csdb::internal::shared_data {
         os.put(roundCost_);
 
         os.put(static_cast<uint32_t>(transactions_.size()));
+    }
+
+    void put(::csdb::priv::obstream& os, bool doHash) const {
+        put_header(os);
         for (const auto& it : transactions_) {
             os.put(it);
         }
@@ -152,7 +161,7 @@ class Pool::priv : public ::csdb::internal::shared_data {
         if (doHash) {
             return;
         }
-        const_cast<size_t&>(hashingLength_) = os.buffer().size();
+        const_cast<size_t&>(hashingLength_) = os.size();
         os.put(hashingLength_);
 
         for (const auto& it : signatures_) {
@@ -235,9 +244,7 @@ class Pool::priv : public ::csdb::internal::shared_data {
     }
 
     void updateHash() {
-        const auto begin = binary_representation_.data();
-        const auto end = begin + hashingLength_;
-        hash_ = PoolHash::calc_from_data(cs::Bytes(begin, end));
+        hash_ = PoolHash::calc_from_data(binary_representation_.data(), hashingLength_);
     }
 
     void updateHash(const cs::Bytes& data) {
@@ -459,9 +466,9 @@ class Pool::priv : public ::csdb::internal::shared_data {
     }
 
     void update_binary_representation() {
-        ::csdb::priv::obstream os;
-        put(os, false);
-        update_binary_representation(std::move(const_cast<cs::Bytes&>(os.buffer())));
+        // previous representation capacity is reused, new one is reserved at once by exact size
+        binary_representation_.clear();
+        ::csdb::priv::serialize(binary_representation_, [this](::csdb::priv::obstream& os) { put(os, false); });
     }
 
     void update_binary_representation(cs::Bytes&& bytes) {
@@ -904,7 +911,7 @@ bool Pool::compose() {
     return d.constData()->is_valid_;
 }
 
-cs::Bytes Pool::to_binary() const noexcept {
+const cs::Bytes& Pool::to_binary() const noexcept {
     return d->binary_representation_;
 }
 
@@ -912,8 +919,61 @@ uint64_t Pool::get_time() const noexcept {
     return atoll(user_field(0).value<std::string>().c_str());
 }
 
+cs::Bytes Pool::to_columnar_binary() const {
+    const priv* data = d.constData();
+
+    if (!data->is_valid_ || data->binary_representation_.empty()) {
+        return cs::Bytes();
+    }
+
+    size_t transactionsBegin = 0;
+    std::vector<size_t> transactionsSizes;
+    transactionsSizes.reserve(data->transactions_.size());
+
+    {
+        auto counter = ::csdb::priv::obstream::counter();
+        data->put_header(counter);
+        transactionsBegin = counter.size();
+
+        for (const auto& transaction : data->transactions_) {
+            const size_t offset = counter.size();
+            counter.put(transaction);
+            transactionsSizes.push_back(counter.size() - offset);
+        }
+    }
+
+    cs::Bytes result;
+
+    if (!::csdb::priv::encode_columnar(data->binary_representation_, transactionsBegin, transactionsSizes, result)) {
+        return cs::Bytes();
+    }
+
+    return result;
+}
+
+/*static*/
+bool Pool::decode_if_columnar(cs::Bytes& data) {
+    if (!::csdb::priv::is_columnar(data)) {
+        return true;
+    }
+
+    cs::Bytes row;
+
+    if (!::csdb::priv::decode_columnar(data.data(), data.size(), row)) {
+        csmeta(cswarning) << "decode columnar pool is failed";
+        return false;
+    }
+
+    data = std::move(row);
+    return true;
+}
+
 /*static*/
 PoolHash Pool::hash_from_binary(cs::Bytes&& data) {
+    if (!decode_if_columnar(data)) {
+        return PoolHash();
+    }
+
 	std::unique_ptr<priv> p{ new priv() };
 	::csdb::priv::ibstream is(data.data(), data.size());
 	if (!p->get_hashed_data(is)) {
@@ -926,6 +986,10 @@ PoolHash Pool::hash_from_binary(cs::Bytes&& data) {
 
 /*static*/
 Pool Pool::from_binary(cs::Bytes&& data) {
+    if (!decode_if_columnar(data)) {
+        return Pool();
+    }
+
     std::unique_ptr<priv> p{new priv()};
     ::csdb::priv::ibstream is(data.data(), data.size());
     if (!p->get(is)) {
@@ -937,6 +1001,10 @@ Pool Pool::from_binary(cs::Bytes&& data) {
 }
 
 Pool Pool::meta_from_binary(cs::Bytes&& data, size_t& cnt) {
+    if (!decode_if_columnar(data)) {
+        return Pool();
+    }
+
     std::unique_ptr<priv> p(new priv());
     ::csdb::priv::ibstream is(data.data(), data.size());
 
@@ -1007,9 +1075,8 @@ bool Pool::save(Storage storage) {
 }
 
 cs::Bytes Pool::to_byte_stream_for_sig() {
-    ::csdb::priv::obstream os;
-    d->put(os, true);
-    cs::Bytes result = std::move(const_cast<std::vector<uint8_t>&>(os.buffer()));
+    cs::Bytes result;
+    ::csdb::priv::serialize(result, [this](::csdb::priv::obstream& os) { d->put(os, true); });
     return result;
 }
 
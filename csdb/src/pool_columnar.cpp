@@ -0,0 +1,381 @@
+#include "pool_columnar.hpp"
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+#include <lz4.h>
+
+#include <csdb/internal/types.hpp>
+
+#include "binary_streams.hpp"
+
+namespace {
+enum Column : size_t {
+    Header,
+    InnerIds,
+    Keys,
+    Sources,
+    Targets,
+    AmountIntegrals,
+    AmountFractions,
+    MaxFees,
+    Currencies,
+    UserFieldsSizes,
+    UserFields,
+    Signatures,
+    CountedFees,
+    Trailer,
+    ColumnsCount
+};
+
+using Columns = std::array<cs::Bytes, ColumnsCount>;
+
+// flags of high part of transaction inner id, see Transaction::put
+constexpr uint32_t kSourceIsWalletId = 0x80000000;
+constexpr uint32_t kTargetIsWalletId = 0x40000000;
+
+constexpr size_t kInnerIdSize = sizeof(uint16_t) + sizeof(uint32_t);
+constexpr size_t kAddressRefSize = sizeof(uint32_t);
+constexpr size_t kFeeSize = sizeof(uint16_t);
+constexpr size_t kUserFieldsSizeSize = sizeof(uint32_t);
+
+// signature and counted fee follow user fields
+constexpr size_t kTransactionTailSize = kSignatureLength + kFeeSize;
+
+// the longest row transaction without user fields
+constexpr size_t kMaxFixedTransactionSize = kInnerIdSize + 2 * kPublicKeyLength + sizeof(int32_t) + sizeof(uint64_t) + kFeeSize +
+                                            sizeof(uint8_t) + kTransactionTailSize;
+
+template <typename T>
+void append(cs::Bytes& column, const T& value) {
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    column.insert(column.end(), bytes, bytes + sizeof(T));
+}
+
+void append(cs::Bytes& column, const cs::BytesView& view) {
+    column.insert(column.end(), view.begin(), view.end());
+}
+
+template <typename T>
+T load(const cs::Bytes& column, size_t index) {
+    T value;
+    std::memcpy(&value, column.data() + index * sizeof(T), sizeof(T));
+    return value;
+}
+
+class KeysDictionary {
+public:
+    explicit KeysDictionary(cs::Bytes& column)
+    : column_(column) {
+    }
+
+    uint32_t index(const cs::BytesView& key) {
+        cs::PublicKey publicKey;
+        std::copy(key.begin(), key.end(), publicKey.begin());
+
+        const auto [iter, isInserted] = indexes_.emplace(publicKey, static_cast<uint32_t>(indexes_.size()));
+
+        if (isInserted) {
+            append(column_, key);
+        }
+
+        return iter->second;
+    }
+
+private:
+    cs::Bytes& column_;
+    std::unordered_map<cs::PublicKey, uint32_t> indexes_;
+};
+
+bool encodeAddress(::csdb::priv::ibstream& is, bool isWalletId, KeysDictionary& keys, cs::Bytes& column) {
+    if (isWalletId) {
+        ::csdb::internal::WalletId id;
+
+        if (!is.get(id)) {
+            return false;
+        }
+
+        append(column, id);
+        return true;
+    }
+
+    cs::BytesView key;
+
+    if (!is.get_view(key, kPublicKeyLength)) {
+        return false;
+    }
+
+    append(column, keys.index(key));
+    return true;
+}
+
+bool encodeTransaction(const cs::BytesView& transaction, KeysDictionary& keys, Columns& columns) {
+    ::csdb::priv::ibstream is(transaction.data(), transaction.size());
+
+    uint16_t lo = 0;
+    uint32_t hi = 0;
+
+    if (!is.get(lo) || !is.get(hi)) {
+        return false;
+    }
+
+    append(columns[InnerIds], lo);
+    append(columns[InnerIds], hi);
+
+    if (!encodeAddress(is, (hi & kSourceIsWalletId) != 0, keys, columns[Sources]) ||
+        !encodeAddress(is, (hi & kTargetIsWalletId) != 0, keys, columns[Targets])) {
+        return false;
+    }
+
+    int32_t integral = 0;
+    uint64_t fraction = 0;
+    uint16_t maxFee = 0;
+    uint8_t currency = 0;
+
+    if (!is.get(integral) || !is.get(fraction) || !is.get(maxFee) || !is.get(currency)) {
+        return false;
+    }
+
+    append(columns[AmountIntegrals], integral);
+    append(columns[AmountFractions], fraction);
+    append(columns[MaxFees], maxFee);
+    append(columns[Currencies], currency);
+
+    if (is.size() < kTransactionTailSize) {
+        return false;
+    }
+
+    cs::BytesView userFields;
+    cs::BytesView signature;
+    uint16_t countedFee = 0;
+
+    if (!is.get_view(userFields, is.size() - kTransactionTailSize) || !is.get_view(signature, kSignatureLength) || !is.get(countedFee)) {
+        return false;
+    }
+
+    append(columns[UserFieldsSizes], static_cast<uint32_t>(userFields.size()));
+    append(columns[UserFields], userFields);
+    append(columns[Signatures], signature);
+    append(columns[CountedFees], countedFee);
+
+    return is.empty();
+}
+
+void putColumn(cs::Bytes& result, const cs::Bytes& column) {
+    const auto rawSize = static_cast<uint32_t>(column.size());
+    const size_t sizesOffset = result.size();
+
+    // sizes are written after compression, when packed size is known
+    result.resize(sizesOffset + 2 * sizeof(uint32_t) + static_cast<size_t>(LZ4_compressBound(static_cast<int>(rawSize))));
+
+    auto destination = reinterpret_cast<char*>(result.data() + sizesOffset + 2 * sizeof(uint32_t));
+    const int compressed = LZ4_compress_default(reinterpret_cast<const char*>(column.data()), destination, static_cast<int>(rawSize),
+                                                LZ4_compressBound(static_cast<int>(rawSize)));
+
+    uint32_t packedSize = 0;
+
+    if (compressed > 0 && static_cast<uint32_t>(compressed) < rawSize) {
+        packedSize = static_cast<uint32_t>(compressed);
+    }
+    else {
+        std::memcpy(destination, column.data(), rawSize);
+    }
+
+    std::memcpy(result.data() + sizesOffset, &rawSize, sizeof(rawSize));
+    std::memcpy(result.data() + sizesOffset + sizeof(rawSize), &packedSize, sizeof(packedSize));
+
+    result.resize(sizesOffset + 2 * sizeof(uint32_t) + (packedSize != 0 ? packedSize : rawSize));
+}
+
+bool getColumn(::csdb::priv::ibstream& is, cs::Bytes& column) {
+    uint32_t rawSize = 0;
+    uint32_t packedSize = 0;
+
+    if (!is.get(rawSize) || !is.get(packedSize)) {
+        return false;
+    }
+
+    cs::BytesView data;
+
+    if (!is.get_view(data, packedSize != 0 ? packedSize : rawSize)) {
+        return false;
+    }
+
+    if (packedSize == 0) {
+        column.assign(data.begin(), data.end());
+        return true;
+    }
+
+    column.resize(rawSize);
+    const int decompressed = LZ4_decompress_safe(reinterpret_cast<const char*>(data.data()), reinterpret_cast<char*>(column.data()),
+                                                 static_cast<int>(packedSize), static_cast<int>(rawSize));
+
+    return decompressed >= 0 && static_cast<uint32_t>(decompressed) == rawSize;
+}
+
+bool hasSize(const Columns& columns, Column column, size_t count, size_t width) {
+    return columns[column].size() == count * width;
+}
+
+bool decodeAddress(const Columns& columns, Column column, size_t index, bool isWalletId, cs::Bytes& row) {
+    const auto ref = load<uint32_t>(columns[column], index);
+
+    if (isWalletId) {
+        append(row, ref);
+        return true;
+    }
+
+    if (static_cast<size_t>(ref) >= columns[Keys].size() / kPublicKeyLength) {
+        return false;
+    }
+
+    const auto key = columns[Keys].data() + static_cast<size_t>(ref) * kPublicKeyLength;
+    row.insert(row.end(), key, key + kPublicKeyLength);
+
+    return true;
+}
+}  // namespace
+
+namespace csdb {
+namespace priv {
+
+bool is_columnar(const uint8_t* data, size_t size) noexcept {
+    return size >= 2 && data[0] == kColumnarMarker && data[1] == kColumnarVersion;
+}
+
+bool encode_columnar(const cs::Bytes& row, size_t transactionsBegin, const std::vector<size_t>& transactionsSizes, cs::Bytes& result) {
+    if (transactionsBegin > row.size() || transactionsSizes.size() > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+
+    const size_t count = transactionsSizes.size();
+
+    Columns columns;
+    columns[Header].assign(row.begin(), row.begin() + static_cast<std::ptrdiff_t>(transactionsBegin));
+    columns[InnerIds].reserve(count * kInnerIdSize);
+    columns[Sources].reserve(count * kAddressRefSize);
+    columns[Targets].reserve(count * kAddressRefSize);
+    columns[AmountIntegrals].reserve(count * sizeof(int32_t));
+    columns[AmountFractions].reserve(count * sizeof(uint64_t));
+    columns[MaxFees].reserve(count * kFeeSize);
+    columns[Currencies].reserve(count);
+    columns[UserFieldsSizes].reserve(count * kUserFieldsSizeSize);
+    columns[Signatures].reserve(count * kSignatureLength);
+    columns[CountedFees].reserve(count * kFeeSize);
+
+    KeysDictionary keys(columns[Keys]);
+    ibstream is(row.data() + transactionsBegin, row.size() - transactionsBegin);
+
+    for (const auto size : transactionsSizes) {
+        cs::BytesView transaction;
+
+        if (!is.get_view(transaction, size) || !encodeTransaction(transaction, keys, columns)) {
+            return false;
+        }
+    }
+
+    cs::BytesView trailer;
+    is.get_view(trailer, is.size());
+    append(columns[Trailer], trailer);
+
+    result.clear();
+    append(result, kColumnarMarker);
+    append(result, kColumnarVersion);
+    append(result, static_cast<uint32_t>(count));
+
+    for (const auto& column : columns) {
+        putColumn(result, column);
+    }
+
+    return true;
+}
+
+bool decode_columnar(const uint8_t* data, size_t size, cs::Bytes& row) {
+    if (!is_columnar(data, size)) {
+        return false;
+    }
+
+    ibstream is(data + 2, size - 2);
+
+    uint32_t value = 0;
+
+    if (!is.get(value)) {
+        return false;
+    }
+
+    const size_t count = value;
+    Columns columns;
+
+    for (auto& column : columns) {
+        if (!getColumn(is, column)) {
+            return false;
+        }
+    }
+
+    if (!is.empty()) {
+        return false;
+    }
+
+    const bool isConsistent = hasSize(columns, InnerIds, count, kInnerIdSize) && hasSize(columns, Sources, count, kAddressRefSize) &&
+                              hasSize(columns, Targets, count, kAddressRefSize) && hasSize(columns, AmountIntegrals, count, sizeof(int32_t)) &&
+                              hasSize(columns, AmountFractions, count, sizeof(uint64_t)) && hasSize(columns, MaxFees, count, kFeeSize) &&
+                              hasSize(columns, Currencies, count, sizeof(uint8_t)) &&
+                              hasSize(columns, UserFieldsSizes, count, kUserFieldsSizeSize) &&
+                              hasSize(columns, Signatures, count, kSignatureLength) && hasSize(columns, CountedFees, count, kFeeSize) &&
+                              columns[Keys].size() % kPublicKeyLength == 0;
+
+    if (!isConsistent) {
+        return false;
+    }
+
+    row.clear();
+    row.reserve(columns[Header].size() + count * kMaxFixedTransactionSize + columns[UserFields].size() + columns[Trailer].size());
+    row.insert(row.end(), columns[Header].begin(), columns[Header].end());
+
+    size_t userFieldsOffset = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto innerId = columns[InnerIds].data() + i * kInnerIdSize;
+        row.insert(row.end(), innerId, innerId + kInnerIdSize);
+
+        uint32_t hi = 0;
+        std::memcpy(&hi, innerId + sizeof(uint16_t), sizeof(hi));
+
+        if (!decodeAddress(columns, Sources, i, (hi & kSourceIsWalletId) != 0, row) ||
+            !decodeAddress(columns, Targets, i, (hi & kTargetIsWalletId) != 0, row)) {
+            return false;
+        }
+
+        append(row, load<int32_t>(columns[AmountIntegrals], i));
+        append(row, load<uint64_t>(columns[AmountFractions], i));
+        append(row, load<uint16_t>(columns[MaxFees], i));
+        append(row, load<uint8_t>(columns[Currencies], i));
+
+        const size_t userFieldsSize = load<uint32_t>(columns[UserFieldsSizes], i);
+
+        if (userFieldsOffset + userFieldsSize > columns[UserFields].size()) {
+            return false;
+        }
+
+        const auto userFields = columns[UserFields].data() + userFieldsOffset;
+        row.insert(row.end(), userFields, userFields + userFieldsSize);
+        userFieldsOffset += userFieldsSize;
+
+        const auto signature = columns[Signatures].data() + i * kSignatureLength;
+        row.insert(row.end(), signature, signature + kSignatureLength);
+
+        append(row, load<uint16_t>(columns[CountedFees], i));
+    }
+
+    if (userFieldsOffset != columns[UserFields].size()) {
+        return false;
+    }
+
+    row.insert(row.end(), columns[Trailer].begin(), columns[Trailer].end());
+    return true;
+}
+
+}  // namespace priv
+}  // namespace csdb
@@ -0,0 +1,46 @@
+/**
+ * @file pool_columnar.hpp
+ */
+
+#ifndef _CREDITS_CSDB_PRIVATE_POOL_COLUMNAR_H_INCLUDED_
+#define _CREDITS_CSDB_PRIVATE_POOL_COLUMNAR_H_INCLUDED_
+
+#include <cinttypes>
+#include <vector>
+
+#include <lib/system/common.hpp>
+
+namespace csdb {
+namespace priv {
+
+///
+/// Columnar on-disk block encoding.
+///
+/// Row representation of pool (Pool::to_binary) is split into columns: transactions inner ids,
+/// sources, targets, amounts, fees, currencies, user fields and signatures, while pool header and
+/// trailer are kept as opaque columns. Public keys of sources and targets are replaced by indexes
+/// of dictionary of unique keys. Every column is compressed by LZ4 separately.
+///
+/// Decoding restores row representation byte to byte, so pool hash does not depend on format.
+///
+/// Layout: marker, format version, transactions count (uint32_t), then for every column
+/// raw size (uint32_t), packed size (uint32_t, 0 if column is stored as is) and column data.
+///
+constexpr uint8_t kColumnarMarker = 0xff;
+constexpr uint8_t kColumnarVersion = 1;
+
+// row pool binary starts with pool version, which is never equal to marker
+bool is_columnar(const uint8_t* data, size_t size) noexcept;
+
+inline bool is_columnar(const cs::Bytes& data) noexcept {
+    return is_columnar(data.data(), data.size());
+}
+
+// transactionsBegin is offset of the first transaction in row, sizes are row sizes of transactions
+bool encode_columnar(const cs::Bytes& row, size_t transactionsBegin, const std::vector<size_t>& transactionsSizes, cs::Bytes& result);
+bool decode_columnar(const uint8_t* data, size_t size, cs::Bytes& row);
+
+}  // namespace priv
+}  // namespace csdb
+
+#endif  // _CREDITS_CSDB_PRIVATE_POOL_COLUMNAR_H_INCLUDED_
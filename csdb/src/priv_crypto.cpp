@@ -8,11 +8,15 @@ namespace csdb {
 namespace priv {
 
 cs::Bytes crypto::calc_hash(const cs::Bytes &buffer) noexcept {
+    return calc_hash(buffer.data(), buffer.size());
+}
+
+cs::Bytes crypto::calc_hash(const uint8_t *data, size_t size) noexcept {
 #ifndef CSDB_UNIT_TEST
-    cscrypto::Hash result = cscrypto::calculateHash(buffer.data(), buffer.size());
+    cscrypto::Hash result = cscrypto::calculateHash(data, size);
     return cs::Bytes(result.begin(), result.end());
 #else
-    const size_t result = std::hash<std::string>()(std::string(buffer.begin(), buffer.end()));
+    const size_t result = std::hash<std::string>()(std::string(data, data + size));
     return cs::Bytes(reinterpret_cast<const uint8_t *>(&result), reinterpret_cast<const uint8_t *>(&result) + hash_size);
 #endif
 }
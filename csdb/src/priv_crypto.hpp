@@ -26,6 +26,7 @@ struct crypto {
     static const size_t public_key_size = 20;
 #endif
     static cs::Bytes calc_hash(const cs::Bytes &buffer) noexcept;
+    static cs::Bytes calc_hash(const uint8_t *data, size_t size) noexcept;
 };
 
 }  // namespace priv
@@ -16,6 +16,7 @@
 #include <boost/multi_index/member.hpp>
 
 #include <lib/system/logger.hpp>
+#include <lib/system/metrics.hpp>
 #include <lib/system/utils.hpp>
 
 #include <csdb/address.hpp>
@@ -27,6 +28,7 @@
 #include <csdb/wallet.hpp>
 
 #include "binary_streams.hpp"
+#include "pool_columnar.hpp"
 
 using namespace boost::multi_index;
 
@@ -133,6 +135,7 @@ private:
     void write_routine();
 
     std::shared_ptr<Database> db = nullptr;
+    Storage::BlockFormat block_format = Storage::BlockFormat::Row;
     PoolHash last_hash;     // Хеш последнего пула
     size_t count_pool = 0;  // Количество пулов транзакций в хранилище (первоночально заполняется в check)
 
@@ -317,7 +320,12 @@ void Storage::priv::write_routine() {
             }
             const PoolHash hash = pool.hash();
 
-            db->put(hash.to_binary(), static_cast<uint32_t>(pool.sequence()), pool.to_binary());
+            if (block_format == Storage::BlockFormat::Columnar) {
+                db->put(hash.to_binary(), static_cast<uint32_t>(pool.sequence()), pool.to_columnar_binary());
+            }
+            else {
+                db->put(hash.to_binary(), static_cast<uint32_t>(pool.sequence()), pool.to_binary());
+            }
 
             write_queue.pop_front();
         }
@@ -392,6 +400,7 @@ bool Storage::open(const OpenOptions& opt, OpenCallback callback) {
     }
 
     d->db = opt.db;
+    d->block_format = opt.blockFormat;
 
     if (!d->db->is_open()) {
         d->set_last_error(DatabaseError, "Error open database: %s", d->db->last_error_message().c_str());
@@ -458,7 +467,7 @@ bool Storage::open(const OpenOptions& opt, OpenCallback callback) {
     return true;
 }
 
-bool Storage::open(const ::std::string& path_to_base, OpenCallback callback, cs::Sequence newBlockchainTop) {
+bool Storage::open(const ::std::string& path_to_base, OpenCallback callback, cs::Sequence newBlockchainTop, BlockFormat blockFormat) {
     ::std::string path{path_to_base};
     if (path.empty()) {
         path = ::csdb::internal::app_data_path() + "/CREDITS";
@@ -469,7 +478,7 @@ bool Storage::open(const ::std::string& path_to_base, OpenCallback callback, cs:
 
     //d->write_thread = std::thread(&Storage::priv::write_routine, d.get());
 
-    return open(OpenOptions{db, newBlockchainTop}, callback);
+    return open(OpenOptions{db, newBlockchainTop, blockFormat}, callback);
 }
 
 void Storage::close() {
@@ -503,8 +512,9 @@ bool Storage::pool_save(Pool pool) {
     }
 
     const PoolHash hash = pool.hash();
+    const cs::Bytes hashBinary = hash.to_binary();
 
-    if (d->db->get(hash.to_binary())) {
+    if (d->db->get(hashBinary)) {
         d->set_last_error(InvalidParameter, "%s: Pool already pressent [hash: %s]", funcName(), hash.to_string().c_str());
         return false;
     }
@@ -515,7 +525,13 @@ bool Storage::pool_save(Pool pool) {
         d->write_cond_var.notify_one();
       }
     */
-    d->db->put(hash.to_binary(), static_cast<uint32_t>(pool.sequence()), pool.to_binary());
+    if (d->block_format == BlockFormat::Columnar) {
+        d->db->put(hashBinary, static_cast<uint32_t>(pool.sequence()), pool.to_columnar_binary());
+    }
+    else {
+        // pool binary is passed by reference, no copy of composed block is made
+        d->db->put(hashBinary, static_cast<uint32_t>(pool.sequence()), pool.to_binary());
+    }
 
     {
         std::unique_lock<std::mutex> lock(d->data_lock);
@@ -628,11 +644,17 @@ bool Storage::write_queue_pop(Pool& res_pool) {
 }
 
 Pool Storage::pool_load(const PoolHash& hash) const {
+    static auto& loadTime = cs::metrics::timer("cs_storage_pool_load_seconds", "Time of Storage::pool_load", cs::metrics::label("key", "hash"));
+    cs::metrics::ScopedTimer timer(loadTime);
+
     size_t size;
     return pool_load_internal(hash, false, size);
 }
 
 Pool Storage::pool_load(const cs::Sequence sequence) const {
+    static auto& loadTime = cs::metrics::timer("cs_storage_pool_load_seconds", "Time of Storage::pool_load", cs::metrics::label("key", "sequence"));
+    cs::metrics::ScopedTimer timer(loadTime);
+
     if (!isOpen()) {
         d->set_last_error(NotOpen);
         return Pool{};
@@ -768,6 +790,70 @@ Pool Storage::pool_remove_last() {
     return res;
 }
 
+Storage::BlockFormat Storage::block_format() const noexcept {
+    return d->block_format;
+}
+
+bool Storage::convert_blocks(BlockFormat format, OpenCallback callback) {
+    if (!isOpen()) {
+        d->set_last_error(NotOpen);
+        return false;
+    }
+
+    d->block_format = format;
+
+    if (last_hash().is_empty()) {
+        d->set_last_error();
+        return true;
+    }
+
+    const cs::Sequence lastSequence = pool_sequence(last_hash());
+
+    if (lastSequence == std::numeric_limits<cs::Sequence>::max()) {
+        d->set_last_error(DataIntegrityError, "%s: Last pool is not found", funcName());
+        return false;
+    }
+
+    const bool toColumnar = (format == BlockFormat::Columnar);
+
+    OpenProgress progress{0};
+    cs::Bytes data;
+
+    for (cs::Sequence sequence = 0; sequence <= lastSequence; ++sequence) {
+        if (!d->db->get(static_cast<uint32_t>(sequence), &data)) {
+            continue;
+        }
+
+        if (::csdb::priv::is_columnar(data) != toColumnar) {
+            Pool pool = Pool::from_binary(std::move(data));
+
+            if (!pool.is_valid()) {
+                d->set_last_error(DataIntegrityError, "%s: Error decoding pool [sequence: %llu]", funcName(),
+                                  static_cast<unsigned long long>(sequence));
+                return false;
+            }
+
+            const bool isWritten = toColumnar ? d->db->put(pool.hash().to_binary(), static_cast<uint32_t>(sequence), pool.to_columnar_binary())
+                                              : d->db->put(pool.hash().to_binary(), static_cast<uint32_t>(sequence), pool.to_binary());
+
+            if (!isWritten) {
+                d->set_last_error(DatabaseError);
+                return false;
+            }
+        }
+
+        ++progress.poolsProcessed;
+
+        if (callback && callback(progress)) {
+            d->set_last_error(UserCancelled);
+            return false;
+        }
+    }
+
+    d->set_last_error();
+    return true;
+}
+
 bool Storage::pool_remove_last_repair(cs::Sequence test_sequence, const csdb::PoolHash& test_hash) {
 	if (!isOpen()) {
 		d->set_last_error(NotOpen);
@@ -223,9 +223,9 @@ cs::Bytes Transaction::to_binary() {
     if (!is_valid()) {
         return cs::Bytes();
     }
-    ::csdb::priv::obstream os;
-    put(os);
-    return os.buffer();
+    cs::Bytes result;
+    ::csdb::priv::serialize(result, [this](::csdb::priv::obstream& os) { put(os); });
+    return result;
 }
 
 Transaction Transaction::from_binary(const cs::Bytes& data) {
@@ -251,18 +251,29 @@ Transaction Transaction::from_byte_stream(const char* data, size_t m_size) {
 }
 
 std::vector<uint8_t> Transaction::to_byte_stream() const {
-    ::csdb::priv::obstream os;
-    put(os);
-    return os.buffer();
+    cs::Bytes result;
+    ::csdb::priv::serialize(result, [this](::csdb::priv::obstream& os) { put(os); });
+    return result;
 }
 
 bool Transaction::verify_signature(const cs::PublicKey& public_key) const {
-    const auto byteStream = to_byte_stream_for_sig();
+    thread_local cs::Bytes byteStream;
+    to_byte_stream_for_sig(byteStream);
     return cscrypto::verifySignature(signature().data(), public_key.data(), byteStream.data(), byteStream.size());
 }
 
 std::vector<uint8_t> Transaction::to_byte_stream_for_sig() const {
-    ::csdb::priv::obstream os;
+    cs::Bytes result;
+    to_byte_stream_for_sig(result);
+    return result;
+}
+
+void Transaction::to_byte_stream_for_sig(cs::Bytes& buffer) const {
+    buffer.clear();
+    ::csdb::priv::serialize(buffer, [this](::csdb::priv::obstream& os) { put_for_sig(os); });
+}
+
+void Transaction::put_for_sig(::csdb::priv::obstream& os) const {
     const priv* data = d.constData();
     uint8_t innerID[6];
     {
@@ -288,16 +299,13 @@ std::vector<uint8_t> Transaction::to_byte_stream_for_sig() const {
     os.put(data->max_fee_);
     os.put(data->currency_);
 
-    decltype(data->user_fields_) custom_user_fields(data->user_fields_.lower_bound(0), data->user_fields_.end());
-    if (custom_user_fields.size()) {
-        os.put_smart(custom_user_fields);
-        auto buf = os.buffer();
-        return buf;
-    }
-    else {
-        uint8_t num_user_fields = 0;
-        os.put(num_user_fields);
-        return os.buffer();
+    // same layout as put_smart of custom fields map, but without copying it
+    const auto custom_begin = data->user_fields_.lower_bound(0);
+    const auto custom_end = data->user_fields_.end();
+    os.put(static_cast<uint8_t>(std::distance(custom_begin, custom_end)));
+
+    for (auto it = custom_begin; it != custom_end; ++it) {
+        os.put_for_sig(it->second);
     }
 }
 
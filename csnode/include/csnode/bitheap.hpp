@@ -93,6 +93,21 @@ public:
             return 1 + bits_.count();
     }
 
+    // raw state, heap is restored from it exactly
+    T greatest() const {
+        return greatest_;
+    }
+
+    const std::bitset<BitSize>& bits() const {
+        return bits_;
+    }
+
+    void assign(T greatest, const std::bitset<BitSize>& bits) {
+        greatest_ = greatest;
+        bits_ = bits;
+        isValueSet_ = true;
+    }
+
 private:
     T greatest_;
     uint8_t isValueSet_;
@@ -19,6 +19,7 @@
 
 #include <csdb/internal/types.hpp>
 #include <csnode/nodecore.hpp>
+#include <csnode/merkletree.hpp>
 #include <csnode/multiwallets.hpp>
 #include <csnode/walletsids.hpp>
 #include <roundpackage.hpp>
@@ -33,6 +34,7 @@ class BlockHashes;
 class WalletsIds;
 class Fee;
 class TransactionsIndex;
+class ContractStatesIndex;
 class TransactionsPacket;
 
 /** @brief   The new block signal emits when finalizeBlock() occurs just before recordBlock() */
@@ -58,7 +60,7 @@ public:
     };
 
     explicit BlockChain(csdb::Address genesisAddress, csdb::Address startAddress,
-                        bool recreateIndex = false);
+                        bool recreateIndex = false, size_t hotWalletsCapacity = 0);
     ~BlockChain();
 
     bool init(const std::string& path,
@@ -201,24 +203,30 @@ public signals:
 
 public slots:
 
-    // subscription is placed in SmartContracts constructor
+    // subscription is placed in SmartContracts constructor, slots are called outside of block apply
     void onPayableContractReplenish(const csdb::Transaction& starter) {
         this->walletsCacheUpdater_->invokeReplenishPayableContract(starter, false /*inverse*/);
+        this->walletsCacheUpdater_->flushUpdates();
     }
     void onContractTimeout(const csdb::Transaction& starter) {
         this->walletsCacheUpdater_->rollbackExceededTimeoutContract(starter, csdb::Amount(0), false /*inverse*/);
+        this->walletsCacheUpdater_->flushUpdates();
     }
     void onContractEmittedAccepted(const csdb::Transaction& emitted, const csdb::Transaction& starter) {
         this->walletsCacheUpdater_->smartSourceTransactionReleased(emitted, starter, false /*inverse*/);
+        this->walletsCacheUpdater_->flushUpdates();
     }
     void rollbackPayableContractReplenish(const csdb::Transaction& starter) {
         this->walletsCacheUpdater_->invokeReplenishPayableContract(starter, true /*inverse*/);
+        this->walletsCacheUpdater_->flushUpdates();
     }
     void rollbackContractTimeout(const csdb::Transaction& starter) {
         this->walletsCacheUpdater_->rollbackExceededTimeoutContract(starter, csdb::Amount(0), true /*inverse*/);
+        this->walletsCacheUpdater_->flushUpdates();
     }
     void rollbackContractEmittedAccepted(const csdb::Transaction& emitted, const csdb::Transaction& starter) {
         this->walletsCacheUpdater_->smartSourceTransactionReleased(emitted, starter, true /*inverse*/);
+        this->walletsCacheUpdater_->flushUpdates();
     }
 
 public:
@@ -229,6 +237,10 @@ public:
     csdb::Pool loadBlock(const cs::Sequence sequence) const;
     csdb::Pool loadBlockMeta(const csdb::PoolHash&, size_t& cnt) const;
     csdb::Transaction loadTransaction(const csdb::TransactionID&) const;
+
+    // builds merkle inclusion proof of transaction, root is taken from block if it is stored there
+    bool getTransactionProof(const csdb::TransactionID&, cs::Hash& leaf, cs::MerkleTree::Proof& proof, cs::Hash& root) const;
+
     void iterateOverWallets(const std::function<bool(const cs::PublicKey&, const cs::WalletsCache::WalletData&)>);
     csdb::Pool getLastBlock() const {
         return loadBlock(getLastSeq());
@@ -248,6 +260,8 @@ public:
     bool findWalletData(WalletId id, WalletData& wallData) const;
     bool findWalletData(const csdb::Address&, WalletData& wallData) const;
     bool findWalletId(const WalletAddress& address, WalletId& id) const;
+    // wallet as of the last applied block, hot wallet of public key address is read without cache lock
+    bool findPublishedWallet(const csdb::Address& address, cs::PublishedWallets::Wallet& wallet) const;
     // wallet transactions: pools cache + db search
     void getTransactions(Transactions& transactions, csdb::Address address, uint64_t offset, uint64_t limit);
 
@@ -262,6 +276,9 @@ public:
     csdb::TransactionID getLastTransaction(const csdb::Address&) const;
     cs::Sequence getPreviousPoolSeq(const csdb::Address&, cs::Sequence) const;
 
+    // the last transaction updated state of contract at sequence or before it, invalid if there is no one
+    csdb::TransactionID getStateTransaction(const csdb::Address& contract, cs::Sequence sequence) const;
+
     std::pair<cs::Sequence, uint32_t> getLastNonEmptyBlock();
     std::pair<cs::Sequence, uint32_t> getPreviousNonEmptyBlock(cs::Sequence);
     uint64_t getTransactionsCount() const {
@@ -322,6 +339,7 @@ private:
 
     std::unique_ptr<cs::BlockHashes> blockHashes_;
     std::unique_ptr<cs::TransactionsIndex> trxIndex_;
+    std::unique_ptr<cs::ContractStatesIndex> statesIndex_;
 
     const csdb::Address genesisAddress_;
     const csdb::Address startAddress_;
@@ -31,14 +31,18 @@ public:
     bool remove(cs::Sequence);
     bool remove(const csdb::PoolHash& hash);
 
+    // keeps updates in one transaction until the outermost commitBatch, used while blocks are read from db
+    void beginBatch();
+    void commitBatch();
+
 private slots:
     void onDbFailed(const cs::LmdbException& exception);
 
 private:
     void initialization();
 
-    cs::Lmdb seqDb_;
-    cs::Lmdb hashDb_;
+    // tables of sequences and hashes share environment, so block is written in one transaction
+    cs::Lmdb db_;
 };
 }  // namespace cs
 
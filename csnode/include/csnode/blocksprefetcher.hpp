@@ -0,0 +1,65 @@
+#ifndef BLOCKSPREFETCHER_HPP
+#define BLOCKSPREFETCHER_HPP
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+
+#include <csdb/pool.hpp>
+#include <lib/system/common.hpp>
+
+namespace cs {
+
+///
+/// Read-ahead over a chain of blocks linked by previous sequences (as in transactions index).
+///
+/// Up to window links of chain are resolved ahead of the consumer and blocks are loaded
+/// and decoded in thread pool. If block is requested before worker started to load it,
+/// consumer loads it by itself, so prefetching never makes iteration slower than
+/// synchronous one. Destruction cancels all not started loads and waits for started ones.
+///
+class BlocksPrefetcher {
+public:
+    // returns previous sequence of chain or kWrongSequence at the end of chain
+    using Resolver = std::function<Sequence(Sequence)>;
+    using Loader = std::function<csdb::Pool(Sequence)>;
+
+    constexpr static size_t kDefaultWindow = 4;
+
+    BlocksPrefetcher(Resolver resolver, Loader loader, size_t window = kDefaultWindow);
+    ~BlocksPrefetcher();
+
+    BlocksPrefetcher(const BlocksPrefetcher&) = delete;
+    BlocksPrefetcher& operator=(const BlocksPrefetcher&) = delete;
+
+    // drops prefetched blocks and starts new chain from previous link of sequence
+    void reset(Sequence sequence);
+
+    // returns next block of chain, invalid pool at the end of chain
+    csdb::Pool next();
+
+    // cancels not started loads, next() returns invalid pool until reset
+    void cancel();
+
+    size_t window() const {
+        return window_;
+    }
+
+private:
+    struct Slot;
+
+    void fill();
+    void launch(const std::shared_ptr<Slot>& slot);
+
+    Resolver resolver_;
+    Loader loader_;
+    size_t window_;
+
+    std::deque<std::shared_ptr<Slot>> slots_;
+    Sequence lastResolved_;
+    bool chainEnded_;
+};
+
+} // namespace cs
+#endif // BLOCKSPREFETCHER_HPP
@@ -126,6 +126,17 @@ private:
     static constexpr csdb::Amount zeroBalance_ = 0;
 };
 
+///
+/// @brief check merkle root of transactions if block contains it
+///
+class MerkleRootValidator : public ValidationPlugin {
+public:
+    MerkleRootValidator(BlockValidator& bv)
+    : ValidationPlugin(bv) {
+    }
+    ErrorType validateBlock(const csdb::Pool&) override;
+};
+
 class TransactionsChecker : public ValidationPlugin {
 public:
     TransactionsChecker(BlockValidator& bv)
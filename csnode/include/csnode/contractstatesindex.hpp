@@ -0,0 +1,65 @@
+#ifndef CONTRACTSTATESINDEX_HPP
+#define CONTRACTSTATESINDEX_HPP
+
+#include <memory>
+#include <string>
+
+#include <csdb/address.hpp>
+#include <csdb/transaction.hpp>
+#include <lib/system/common.hpp>
+#include <lib/system/mmappedfile.hpp>
+#include <lmdb.hpp>
+
+class BlockChain;
+
+namespace csdb {
+class Pool;
+}  // namespace csdb
+
+namespace cs {
+///
+/// Persistent index of contract states by blocks.
+///
+/// Every block updating state of contract adds key of contract public key and block sequence
+/// to database, value is index of the last new state transaction of contract in block. Keys of
+/// one contract are ordered by sequence, so the state actual at any sequence is found by one seek.
+/// Index is kept next to transactions index and is rebuilt the same way if it is behind database.
+///
+class ContractStatesIndex {
+public:
+    ContractStatesIndex(BlockChain& blockchain, const std::string& path, bool recreate = false);
+
+    void update(const csdb::Pool& pool);
+    void close();
+
+    // the last transaction updated state of contract at sequence or before it, invalid if there is no one
+    csdb::TransactionID getStateTransaction(const csdb::Address& contract, Sequence sequence) const;
+
+public slots:
+    void onStartReadFromDb(Sequence lastWrittenSequence);
+    void onReadFromDb(const csdb::Pool& pool);
+    void onDbReadFinished();
+    void onRemoveBlock(const csdb::Pool& pool);
+
+private slots:
+    void onDbFailed(const LmdbException& exception);
+
+private:
+    void init();
+    void reset();
+
+    void updateFromNextBlock(const csdb::Pool& pool);
+    void updateLastIndexed();
+
+    static bool hasToRecreate(const std::string& path, Sequence& lastIndexed);
+
+    BlockChain& blockchain_;
+    const std::string rootPath_;
+    std::unique_ptr<Lmdb> db_;
+    Sequence lastIndexed_ = kWrongSequence;
+    bool recreate_;
+    MMappedFileWrap<FileSink> lastIndexedFile_;
+};
+}  // namespace cs
+
+#endif  // CONTRACTSTATESINDEX_HPP
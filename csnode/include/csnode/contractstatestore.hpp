@@ -0,0 +1,142 @@
+#ifndef CONTRACTSTATESTORE_HPP
+#define CONTRACTSTATESTORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <csdb/address.hpp>
+#include <lib/system/common.hpp>
+
+namespace cs {
+class Lmdb;
+class LmdbException;
+
+///
+/// Deduplicated store of contract states.
+///
+/// State is split into chunks by content, so a local change of state keeps all other chunks,
+/// and every chunk is stored once by its hash. State itself is a list of chunk hashes encoded
+/// as a delta against the previous state of the same contract, each kMaxDeltaDepth-th state of
+/// contract is stored in full to keep reads cheap. A base state lives while its deltas live.
+///
+/// Without database path all chunks are kept in memory. With it chunks are written to LMDB and
+/// memory keeps only the least recently used ones within the limit. Database is a cache and is
+/// recreated on start.
+///
+class ContractStateStore {
+public:
+    using StateId = cs::Hash;
+
+    struct Settings {
+        std::string path;                           // chunks database, empty - memory only
+        size_t memoryLimit = 64 * 1024 * 1024;      // bytes of chunks in memory if database is used
+    };
+
+    struct Statistics {
+        size_t states = 0;          // unique stored states
+        size_t logicalBytes = 0;    // size of all held states as if each was stored as string
+        size_t chunks = 0;          // unique chunks
+        size_t chunkBytes = 0;      // size of unique chunks
+        size_t cachedBytes = 0;     // size of chunks in memory
+        size_t recipeBytes = 0;     // size of chunk lists and deltas
+        size_t writtenBytes = 0;    // size of all chunks ever added
+    };
+
+    constexpr static size_t kMinChunkSize = 512;
+    constexpr static size_t kAverageChunkSize = 2048;
+    constexpr static size_t kMaxChunkSize = 8192;
+    constexpr static size_t kMaxDeltaDepth = 16;
+
+    ContractStateStore();
+    explicit ContractStateStore(const Settings& settings);
+    ~ContractStateStore();
+
+    ContractStateStore(const ContractStateStore&) = delete;
+    ContractStateStore& operator=(const ContractStateStore&) = delete;
+
+    // stores state as the next one of contract, returned id is held until release
+    StateId put(const csdb::Address& contract, const std::string& state);
+
+    // one more holder of stored state
+    void acquire(const StateId& id);
+    void release(const StateId& id);
+
+    std::optional<std::string> get(const StateId& id);
+
+    Statistics statistics() const;
+
+    // content defined chunking, returns lengths of consecutive chunks of data
+    static std::vector<size_t> split(const char* data, size_t size);
+
+private:
+    // run of chunks copied from base state or taken from fresh hashes
+    struct Span {
+        constexpr static uint32_t kFresh = std::numeric_limits<uint32_t>::max();
+
+        uint32_t from;
+        uint32_t count;
+    };
+
+    struct Recipe {
+        size_t size = 0;
+        size_t depth = 0;
+        std::optional<StateId> base;
+
+        // full list of chunks if there is no base
+        std::vector<Span> spans;
+        std::vector<cs::Hash> fresh;
+
+        size_t holders = 0;
+        size_t dependents = 0;
+    };
+
+    struct Chunk {
+        size_t refs = 0;
+        size_t size = 0;
+        std::string data;
+        bool cached = false;
+        std::list<cs::Hash>::iterator position;
+    };
+
+    std::vector<cs::Hash> resolve(const Recipe& recipe) const;
+
+    // fills recipe by delta of chunks against base, returns false if delta is not smaller than full list
+    static bool encode(Recipe& recipe, const std::vector<cs::Hash>& base, const std::vector<cs::Hash>& chunks);
+    static size_t recipeBytes(const Recipe& recipe);
+
+    void addChunk(const cs::Hash& hash, const char* data, size_t size);
+    void releaseChunk(const cs::Hash& hash);
+    const std::string* loadChunk(const cs::Hash& hash);
+    void cache(Chunk& chunk, const cs::Hash& hash, std::string&& data);
+    void evict();
+
+    // removes state without holders and dependents, then its base if it is not needed anymore
+    void collect(StateId id);
+
+    void onDbFailed(const LmdbException& exception);
+
+    Settings settings_;
+    std::unique_ptr<Lmdb> db_;
+
+    mutable std::mutex mutex_;
+
+    std::map<StateId, Recipe> recipes_;
+    std::map<cs::Hash, Chunk> chunks_;
+    std::map<csdb::Address, StateId> last_;
+
+    // cached chunks, most recently used first
+    std::list<cs::Hash> order_;
+
+    Statistics statistics_;
+};
+}  // namespace cs
+
+#endif  // CONTRACTSTATESTORE_HPP
@@ -16,6 +16,7 @@ class Transaction;
 
 namespace cs {
 using PacketFlushSignal = cs::Signal<void(const cs::TransactionsPacket&)>;
+using PacketAddSignal = cs::Signal<void(const cs::TransactionsPacket&)>;
 using StatesSignal = cs::Signal<void(const std::vector<csdb::Transaction>&)>;
 using RoundChangeSignal = cs::Signal<void(cs::RoundNumber)>;
 
@@ -308,6 +309,7 @@ public:
 
 public signals:
     cs::PacketFlushSignal packetFlushed;
+    cs::PacketAddSignal packetAdded;
     cs::StatesSignal statesCreated;
     cs::RoundChangeSignal roundChanged;
 
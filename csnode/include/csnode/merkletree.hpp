@@ -0,0 +1,72 @@
+#ifndef MERKLETREE_HPP
+#define MERKLETREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <csdb/user_field.hpp>
+#include <lib/system/common.hpp>
+
+namespace csdb {
+class Pool;
+class Transaction;
+} // namespace csdb
+
+namespace cs {
+
+// pool user field to store merkle root of block transactions
+constexpr csdb::user_field_id_t kMerkleRootUserFieldId = 1;
+
+///
+/// Merkle tree over block transactions, layout and domain separation follow RFC 6962:
+/// leaf = H(0x00 || data), node = H(0x01 || left || right), the left subtree of n leaves
+/// is the largest power of two less than n.
+///
+/// Tree is built incrementally, only roots of complete subtrees are kept (O(log n) memory),
+/// so transactions can be added one by one while block is assembled.
+///
+class MerkleTree {
+public:
+    struct Proof {
+        uint64_t index = 0;
+        uint64_t leavesCount = 0;
+        std::vector<cs::Hash> path;
+    };
+
+    void add(const cs::Hash& leaf);
+    void add(const csdb::Transaction& transaction);
+    void clear();
+
+    cs::Hash root() const;
+
+    size_t size() const {
+        return count_;
+    }
+
+    // leaf is built from signed transaction content and its signature,
+    // so it does not depend on block sequence and transaction index
+    static cs::Hash leafHash(const csdb::Transaction& transaction);
+    static cs::Hash leafHash(const cs::Byte* data, size_t size);
+    static cs::Hash nodeHash(const cs::Hash& left, const cs::Hash& right);
+
+    static std::vector<cs::Hash> leaves(const csdb::Pool& pool);
+    static cs::Hash root(const std::vector<cs::Hash>& leaves);
+
+    // returns inclusion proof of leaves[index], proof with empty leavesCount if index is out of range
+    static Proof proof(const std::vector<cs::Hash>& leaves, size_t index);
+    static bool verify(const cs::Hash& leaf, const Proof& proof, const cs::Hash& root);
+
+    // root stored in pool user field, returns false if pool has no root
+    static bool storedRoot(const csdb::Pool& pool, cs::Hash& root);
+
+private:
+    static cs::Hash rangeRoot(const std::vector<cs::Hash>& leaves, size_t begin, size_t end);
+
+    // roots of complete subtrees, from the biggest to the smallest one
+    std::vector<cs::Hash> peaks_;
+    size_t count_ = 0;
+};
+} // namespace cs
+
+#endif // MERKLETREE_HPP
@@ -0,0 +1,43 @@
+#ifndef METRICSEXPORTER_HPP
+#define METRICSEXPORTER_HPP
+
+#include <cstdint>
+#include <thread>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+namespace cs {
+///
+/// Serves metrics registry in Prometheus text format on GET /metrics.
+///
+/// Listens on loopback only and answers on its own thread, one request per connection.
+///
+class MetricsExporter {
+public:
+    explicit MetricsExporter(uint16_t port);
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // returns false if port can not be listened
+    bool start();
+    void stop();
+
+    uint16_t port() const {
+        return port_;
+    }
+
+private:
+    void accept();
+
+    uint16_t port_;
+
+    boost::asio::io_context context_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    std::thread thread_;
+};
+}  // namespace cs
+
+#endif  // METRICSEXPORTER_HPP
@@ -1,12 +1,17 @@
 #ifndef MULTIWALLETS_HPP
 #define MULTIWALLETS_HPP
 
+#include <algorithm>
+#include <iterator>
 #include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/multi_index/identity.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index_container.hpp>
-#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/ranked_index.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 
 #include <csnode/walletscache.hpp>
@@ -14,6 +19,12 @@
 using namespace boost::multi_index;
 
 namespace cs {
+///
+/// Wallets ranked by balance, transactions count and create time for paging.
+///
+/// Updates from block apply are only collected, readers apply them before reading,
+/// so paging never holds the block apply thread.
+///
 class MultiWallets {
 public:
     struct InternalData {
@@ -51,68 +62,83 @@ public:
 
     template<Tags tag>
     std::vector<InternalData> iterate(int64_t offset, int64_t limit, Order order = Order::Greater) const {
-        cs::Lock lock(mutex_);
+        flush();
+
+        cs::SharedLock lock(mutex_);
         auto& bucket = indexes_.get<tag>();
+        const auto size = static_cast<int64_t>(bucket.size());
 
-        if (static_cast<int64_t>(bucket.size()) < offset || limit == 0) {
+        if (offset < 0 || size < offset || limit <= 0) {
             return {};
         }
 
-        auto capacity = std::min(static_cast<int64_t>(bucket.size()) - offset, limit);
-        return (order == Order::Greater) ? shadowIterate<Order::Greater>(bucket, offset, limit, capacity) :
-                                           shadowIterate<Order::Less>(bucket, offset, limit, capacity);
-    }
-
-public slots:
-    void onDbReadFinished(const std::unordered_map<PublicKey, WalletsCache::WalletData>& data);
-    void onWalletCacheUpdated(const PublicKey& key, const WalletsCache::WalletData& data);
-
-protected:
-    InternalData map(const PublicKey& key, const WalletsCache::WalletData& data);
+        const auto capacity = static_cast<size_t>(std::min(size - offset, limit));
 
-    template <Order order, typename Bucket>
-    std::vector<InternalData> shadowIterate(Bucket& bucket, int64_t offset, int64_t limit, int64_t capacity) const {
         std::vector<InternalData> result;
-        result.reserve(static_cast<size_t>(capacity));
-
-        auto [begin, end] = rangeOrder<order>(bucket);
-        std::advance(begin, offset);
+        result.reserve(capacity);
 
-        for (; begin != end; ++begin) {
-            result.push_back(*begin);
-
-            if (result.size() == static_cast<size_t>(limit)) {
-                break;
-            }
+        // ranked index seeks position in logarithmic time
+        if (order == Order::Greater) {
+            std::copy_n(bucket.nth(static_cast<size_t>(offset)), capacity, std::back_inserter(result));
+        }
+        else {
+            std::copy_n(std::make_reverse_iterator(bucket.nth(static_cast<size_t>(size - offset))), capacity, std::back_inserter(result));
         }
 
         return result;
     }
 
-    template<Order order, typename Bucket>
-    constexpr auto rangeOrder(Bucket& bucket) const {
-        if constexpr(order == Order::Greater) {
-            return std::make_pair(bucket.begin(), bucket.end());
-        }
-        else {
-            return std::make_pair(bucket.rbegin(), bucket.rend());
+    // position of wallet in ranking from zero, nothing if wallet is unknown
+    template<Tags tag>
+    std::optional<size_t> rank(const PublicKey& key, Order order = Order::Greater) const {
+        flush();
+
+        cs::SharedLock lock(mutex_);
+        auto& byKey = indexes_.get<Tags::ByPublicKey>();
+
+        if (auto iter = byKey.find(key); iter != byKey.end()) {
+            auto& bucket = indexes_.get<tag>();
+            const auto position = bucket.rank(indexes_.project<tag>(iter));
+
+            return order == Order::Greater ? position : bucket.size() - 1 - position;
         }
+
+        return std::nullopt;
     }
 
+public slots:
+    void onDbReadFinished(const std::unordered_map<PublicKey, WalletsCache::WalletData>& data);
+
+    // does not wait for readers, update is applied before the next read
+    void onWalletCacheUpdated(const PublicKey& key, const WalletsCache::WalletData& data);
+
+    // the same for all wallets changed by block, pending updates are locked once
+    void onWalletsCacheUpdated(const WalletsUpdates& updates);
+
+protected:
+    InternalData map(const PublicKey& key, const WalletsCache::WalletData& data);
+
+    // applies pending updates, readers see indexes as of their last flush
+    void flush() const;
+
 private:
     using Container = boost::multi_index_container<InternalData,
                         indexed_by<
                             hashed_unique<member<InternalData, PublicKey, &InternalData::key>>,
-                            ordered_non_unique<member<InternalData, csdb::Amount, &InternalData::balance>, std::greater<csdb::Amount>>,
-                            ordered_non_unique<member<InternalData, uint64_t, &InternalData::transactionsCount>, std::greater<uint64_t>>
+                            ranked_non_unique<member<InternalData, csdb::Amount, &InternalData::balance>, std::greater<csdb::Amount>>,
+                            ranked_non_unique<member<InternalData, uint64_t, &InternalData::transactionsCount>, std::greater<uint64_t>>
 #ifdef MONITOR_NODE
                             ,
-                            ordered_non_unique<member<InternalData, uint64_t, &InternalData::createTime>, std::greater<uint64_t>>
+                            ranked_non_unique<member<InternalData, uint64_t, &InternalData::createTime>, std::greater<uint64_t>>
 #endif
                         >
                       >;
-    mutable std::mutex mutex_;
-    Container indexes_;
+    mutable cs::SharedMutex mutex_;
+    mutable Container indexes_;
+
+    // the last update of every wallet since the last flush
+    mutable std::mutex pendingMutex_;
+    mutable std::unordered_map<PublicKey, InternalData> pending_;
 };
 }
 
@@ -29,6 +29,7 @@ class SolverCore;
 namespace cs {
 class PoolSynchronizer;
 class BlockValidator;
+class MetricsExporter;
 }  // namespace cs
 
 namespace cs::config {
@@ -199,6 +200,11 @@ public:
     void sendStateReply(const cs::PublicKey& respondent, const csdb::Address& contract_abs_addr, const cs::Bytes& data);
     void getStateReply(const uint8_t*, const std::size_t, const cs::RoundNumber, const cs::PublicKey& sender);
 
+    // merkle inclusion proof of transaction
+    void sendTransactionProofRequest(const cs::PublicKey& target, const csdb::TransactionID& id);
+    void getTransactionProofRequest(const uint8_t*, const std::size_t, const cs::RoundNumber, const cs::PublicKey& sender);
+    void getTransactionProofReply(const uint8_t*, const std::size_t, const cs::RoundNumber, const cs::PublicKey& sender);
+
     // syncro get functions
     void getBlockRequest(const uint8_t*, const size_t, const cs::PublicKey& sender);
     void getBlockReply(const uint8_t*, const size_t);
@@ -288,6 +294,9 @@ public:
     // args: [failed list, restart list]
     using RejectedSmartContractsSignal = cs::Signal<void(const std::vector<RefExecution>&)>;
 
+    // args: [transaction id, leaf hash, merkle root, is proof valid]
+    using TransactionProofSignal = cs::Signal<void(const csdb::TransactionID&, const cs::Hash&, const cs::Hash&, bool)>;
+
     bool alwaysExecuteContracts() {
         return alwaysExecuteContracts_;
     }
@@ -300,6 +309,7 @@ public signals:
     SmartsSignal<cs::StageThreeSmarts> gotSmartStageThree;
     SmartStageRequestSignal receivedSmartStageRequest;
     RejectedSmartContractsSignal gotRejectedContracts;
+    TransactionProofSignal gotTransactionProof;
 
     inline static StopSignal stopRequested;
 
@@ -416,6 +426,9 @@ private:
     static const size_t maxPacketRequestSize_ = 1000;
     static const int64_t maxPingSynchroDelay_ = 30000;
 
+    // transaction proofs are built from stored blocks, one sender can ask few of them per round
+    static const size_t maxProofRequestsPerRound_ = 16;
+
     // serialization/deserialization entities
     cs::IPackStream istream_;
     cs::OPackStream ostream_;
@@ -475,6 +488,7 @@ private:
     cs::Bytes lastTrustedMask_;
 
     std::unique_ptr<cs::BlockValidator> blockValidator_;
+    std::unique_ptr<cs::MetricsExporter> metricsExporter_;
     std::vector<cs::RoundPackage> roundPackageCache_;
 
     cs::RoundPackage currentRoundPackage_;
@@ -482,6 +496,8 @@ private:
     bool lastBlockRemoved_ = false;
     std::map<cs::RoundNumber, uint8_t> receivedBangs;
     std::map<cs::PublicKey, size_t> blackListCounter_;
+    std::map<cs::PublicKey, size_t> proofRequests_;
+    cs::RoundNumber proofRequestsRound_ = 0;
     size_t lastRoundPackageTime_ = 0;
 
     bool alwaysExecuteContracts_ = false;
@@ -0,0 +1,118 @@
+#ifndef PUBLISHED_WALLETS_HPP
+#define PUBLISHED_WALLETS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <csdb/amount.hpp>
+#include <csdb/transaction.hpp>
+#include <lib/system/common.hpp>
+
+namespace cs {
+
+///
+/// Balances of wallets for readers outside of consensus.
+///
+/// Wallets cache publishes wallets changed by block after it is applied, readers take them
+/// without any lock. Each record, its key included, is guarded by its own sequence counter:
+/// writer makes it odd while record changes, reader repeats read if counter was odd or changed.
+/// Records never move and are not freed, erased record is reused by the next new wallet, so
+/// records take as much memory as the most wallets published at once. Table of record pointers
+/// is rebuilt on growth or when removed cells fill it, the old one is freed once no reader is inside.
+///
+/// Only one thread publishes, any thread reads.
+///
+class PublishedWallets {
+public:
+    struct Wallet {
+        csdb::Amount balance;
+        uint64_t transactionsCount = 0;
+        int64_t lastInnerId = 0;                // the greatest inner id of transactions tail, 0 if tail is empty
+        csdb::TransactionID lastTransaction;
+    };
+
+    PublishedWallets();
+    ~PublishedWallets();
+
+    PublishedWallets(const PublishedWallets&) = delete;
+    PublishedWallets& operator=(const PublishedWallets&) = delete;
+
+    // writer
+    void publish(const PublicKey& key, const Wallet& wallet);
+    void erase(const PublicKey& key);
+
+    // reader, returns false if wallet is not published
+    bool find(const PublicKey& key, Wallet& wallet) const;
+
+    size_t size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    // records of published and erased wallets, writer only
+    size_t recordsCount() const {
+        return records_.size();
+    }
+
+private:
+    enum Word : size_t {
+        Exists,
+        Integral,
+        Fraction,
+        TransactionsCount,
+        LastInnerId,
+        LastSequence,
+        LastIndex,
+        WordsCount
+    };
+
+    constexpr static size_t kKeyWords = sizeof(PublicKey) / sizeof(uint64_t);
+    using KeyWords = std::array<uint64_t, kKeyWords>;
+
+    struct Record {
+        std::atomic<uint64_t> version{0};
+        std::array<std::atomic<uint64_t>, kKeyWords> key{};
+        std::array<std::atomic<uint64_t>, WordsCount> words{};
+    };
+
+    struct Table {
+        explicit Table(size_t capacity);
+
+        size_t mask;
+        std::unique_ptr<std::atomic<Record*>[]> cells;
+    };
+
+    static KeyWords toWords(const PublicKey& key);
+
+    size_t bucket(const KeyWords& key, const Table& table) const;
+    Record* lookup(const KeyWords& key, const Table& table, size_t* slot = nullptr) const;
+
+    void write(Record& record, const KeyWords& key, const std::array<uint64_t, WordsCount>& words);
+    void insert(Record& record, const KeyWords& key, Table& table);
+    void rebuild();
+    void reclaim();
+
+    std::deque<Record> records_;
+    std::vector<Record*> free_;
+
+    // cell of erased record, probes go past it
+    Record removed_;
+
+    std::unique_ptr<Table> current_;
+    std::atomic<Table*> table_;
+    size_t used_ = 0;
+
+    // replaced tables are freed when no reader may walk them
+    std::vector<std::unique_ptr<Table>> retired_;
+    mutable std::atomic<size_t> readers_{0};
+
+    std::atomic<size_t> size_{0};
+    uint64_t seed_;
+};
+
+}  // namespace cs
+
+#endif  // PUBLISHED_WALLETS_HPP
@@ -42,8 +42,10 @@ private:
     void init();
     void reset();
 
+    // writes go to batch opened by caller, last indexed is stored after its commit
     void updateFromNextBlock(const csdb::Pool&);
     void updateLastIndexed();
+    void commitReplayBatch();
 
     static bool hasToRecreate(const std::string&, cs::Sequence&);
 
@@ -58,6 +60,7 @@ private:
     MMappedFileWrap<FileSink> lastIndexedFile_;
 
     std::map<csdb::Address, cs::Sequence> lapoos_;
+    size_t replayedBlocks_ = 0;
 };
 } // namespace cs
 #endif // TRANSACTIONSINDEX_HPP
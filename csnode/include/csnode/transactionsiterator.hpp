@@ -1,18 +1,30 @@
 #ifndef CSNODE_TRANSACTIONS_ITERATOR_HPP
 #define CSNODE_TRANSACTIONS_ITERATOR_HPP
 
+#include <memory>
+
 #include <csdb/address.hpp>
 #include <csdb/pool.hpp>
 #include <csdb/transaction.hpp>
 
+#include <csnode/blocksprefetcher.hpp>
+
 class BlockChain;
 
 namespace cs {
 
 class TransactionsIterator {
 public:
+    // previous blocks of address are resolved from transactions index and loaded
+    // in thread pool ahead of iteration, not more than window blocks at once
+    struct ReadAhead {
+        size_t window = BlocksPrefetcher::kDefaultWindow;
+    };
+
     TransactionsIterator(const BlockChain&, const csdb::Address&);
+    TransactionsIterator(const BlockChain&, const csdb::Address&, ReadAhead);
     TransactionsIterator(const BlockChain&, const csdb::Address&, const csdb::Pool&);
+    ~TransactionsIterator();
 
     void next();
     bool isValid() const;
@@ -30,12 +42,15 @@ public:
 
 private:
     void setFromTransId(const csdb::TransactionID&);
+    csdb::Pool loadPreviousPool();
 
     const BlockChain& bc_;
 
     csdb::Address addr_;
     csdb::Pool lapoo_;
     std::vector<csdb::Transaction>::const_reverse_iterator it_;
+
+    std::unique_ptr<BlocksPrefetcher> prefetcher_;
 };
 
 } // namespace cs
@@ -36,6 +36,7 @@ public:  // Static interface
     /// @return hash
     ///
     static TransactionsPacketHash calcFromData(const cs::Bytes& data);
+    static TransactionsPacketHash calcFromData(const cs::Byte* data, size_t size);
 
 public:  // Interface
     TransactionsPacketHash() = default;
@@ -122,6 +123,12 @@ public:  // Interface
     ///
     cs::Bytes toBinary(Serialization options = Serialization::All) const noexcept;
 
+    ///
+    /// @brief Writes transactions packet binary representation to caller buffer.
+    /// @param buffer is cleared, its capacity is reused, so buffer can be kept between calls
+    ///
+    void toBinary(cs::Bytes& buffer, Serialization options = Serialization::All) const noexcept;
+
     ///
     /// @brief Generates hash
     /// @return True if hash generated successed
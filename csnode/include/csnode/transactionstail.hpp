@@ -10,6 +10,7 @@ class TransactionsTail {
 public:
     static constexpr size_t BitSize = 1024;
     using TransactionId = int64_t;
+    using Heap = BitHeap<TransactionId, BitSize>;
 
 public:
     bool empty() const {
@@ -54,8 +55,15 @@ public:
         return os.str();
     }
 
+    const Heap& heap() const {
+        return heap_;
+    }
+
+    void restore(const Heap& heap) {
+        heap_ = heap;
+    }
+
 private:
-    using Heap = BitHeap<TransactionId, BitSize>;
     Heap heap_;
 };
 
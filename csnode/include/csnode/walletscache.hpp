@@ -1,17 +1,23 @@
 #ifndef WALLETS_CACHE_HPP
 #define WALLETS_CACHE_HPP
 
+#include <deque>
+#include <functional>
 #include <list>
 #include <memory>
+#include <optional>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <cscrypto/cscrypto.hpp>
 #include <csdb/address.hpp>
 #include <csdb/amount.hpp>
+#include <csdb/amount_batch.hpp>
 #include <csdb/pool.hpp>
 #include <csdb/transaction.hpp>
 #include <csnode/nodecore.hpp>
+#include <csnode/publishedwallets.hpp>
 #include <csnode/transactionstail.hpp>
 
 #include <lib/system/common.hpp>
@@ -26,11 +32,40 @@ class Transaction;
 
 namespace cs {
 
+class Lmdb;
+class LmdbException;
 class WalletsIds;
 
+///
+/// Balances and transaction tails of wallets.
+///
+/// With cold store settings recently active wallets are kept in memory and dormant ones are
+/// packed to LMDB when memory holds more than hotCapacity wallets. Wallets are moved to the
+/// cold store in batches after a block is applied, so references taken while a block is applied
+/// stay valid, and are moved back on update. Reading a cold wallet does not move it back.
+/// Packed wallet keeps the whole transactions tail, so validation result does not depend on
+/// where wallet is. Database is a cache and is recreated on start.
+///
+/// Wallets touched by each of the last kJournalDepth applied blocks are copied before their
+/// first change, so removal of such block restores them exactly, transactions tails included.
+/// Removal of older block inverse applies it and rebuilds tails and last transactions of its
+/// wallets from the chain, so every node gets the same wallets whether block was journaled or not.
+/// After block is applied or removed its wallets are published for readers outside of consensus.
+/// Only wallets in memory are published, and nothing is published until blocks are read from
+/// database, readers look for other wallets in the cache itself.
+///
 class WalletsCache {
 public:
-    WalletsCache(WalletsIds& walletsIds);
+    struct Settings {
+        std::string coldPath;       // database of dormant wallets, empty - all wallets are in memory
+        size_t hotCapacity = 0;     // wallets in memory before dormant ones are moved to database
+    };
+
+    constexpr static size_t kJournalDepth = 16;
+
+    explicit WalletsCache(WalletsIds& walletsIds);
+    WalletsCache(WalletsIds& walletsIds, const Settings& settings);
+    ~WalletsCache();
 
     WalletsCache(const WalletsCache&) = delete;
     WalletsCache& operator=(const WalletsCache&) = delete;
@@ -63,11 +98,75 @@ public:
 #endif
 
     uint64_t getCount() const {
+        return wallets_.size() + coldCount_;
+    }
+
+    // wallets in memory
+    size_t getHotCount() const {
         return wallets_.size();
     }
 
+    // hot wallets as of the last applied block, read without lock
+    const PublishedWallets& published() const {
+        return published_;
+    }
+
+    static PublishedWallets::Wallet toPublished(const WalletData& wallet);
+
+    // packed record of wallet and back, exact for transactions tail
+    static cs::Bytes pack(const WalletData& wallet);
+    static bool unpack(const char* data, size_t size, WalletData& wallet);
+
 private:
+    // cold wallet or nullptr, returned wallet is a copy valid until the next call in this thread
+    const WalletData* findCold(const PublicKey& key) const;
+
+    // moves cold wallet to memory, nullptr if wallet is not in the cold store
+    WalletData* promote(const PublicKey& key);
+
+    // moves the least recently active wallets to the cold store if memory holds too many
+    void evictDormant();
+
+    void iterateOverColdWallets(const std::function<bool(const PublicKey&, const WalletData&)>& func) const;
+
+    // removes wallet from memory and cold store
+    void erase(const PublicKey& key);
+
+    // journal of applied blocks
+    void beginVersion(cs::Sequence sequence);
+    void endVersion();
+    void remember(const PublicKey& key, const WalletData* wallet);
+
+    // wallet is about to be changed by block
+    void touch(const PublicKey& key, const WalletData* wallet);
+    void publish(const PublicKey& key, const WalletData& wallet);
+    void publishTouched();
+
+    // restores wallets changed by removed block, returns keys of restored ones or nullopt if block is not journaled
+    std::optional<std::vector<PublicKey>> rollback(cs::Sequence sequence);
+
+    void onColdFailed(const LmdbException& exception);
+
     WalletsIds& walletsIds_;
+    Settings settings_;
+
+    std::unique_ptr<Lmdb> cold_;
+    size_t coldCount_ = 0;
+    bool coldFailed_ = false;
+
+    // wallets before block, nullopt if block created wallet
+    struct Version {
+        cs::Sequence sequence;
+        std::unordered_map<PublicKey, std::optional<WalletData>> before;
+    };
+
+    // blocks read from database are not journaled, wallets are published once after them
+    bool isDbRead_ = false;
+    std::deque<Version> journal_;
+    Version* version_ = nullptr;
+
+    PublishedWallets published_;
+    std::vector<PublicKey> touched_;
 
     std::list<csdb::TransactionID> smartPayableTransactions_;
     std::map< csdb::Address, std::list<csdb::TransactionID> > canceledSmarts_;
@@ -78,7 +177,9 @@ private:
 #endif
 };
 
-using WalletUpdateSignal = cs::Signal<void(const PublicKey&, const WalletsCache::WalletData&)>;
+// wallets changed by block, every wallet is listed once
+using WalletsUpdates = std::vector<std::pair<PublicKey, const WalletsCache::WalletData*>>;
+using WalletsUpdateSignal = cs::Signal<void(const WalletsUpdates&)>;
 using FinishedUpdateFromDB = cs::Signal<void(const std::unordered_map<PublicKey, WalletsCache::WalletData>&)>;
 
 class WalletsCache::Updater {
@@ -105,14 +206,24 @@ public:
 
     void updateLastTransactions(const std::vector<std::pair<PublicKey, csdb::TransactionID>>&);
 
+    // reports wallets changed outside of block apply to subscribers and readers
+    void flushUpdates();
+
     PublicKey toPublicKey(const csdb::Address&) const;
 
-    void onStopReadingFromDB() const {
-      emit updateFromDBFinishedEvent(data_.wallets_);
+    void onStopReadingFromDB() const;
+
+    // transactions of address in blocks before sequence, the latest first, until visitor returns false
+    using TransactionVisitor = std::function<bool(const csdb::Transaction&)>;
+    using History = std::function<void(const csdb::Address&, cs::Sequence, const TransactionVisitor&)>;
+
+    // replaces walk through transactions index of blockchain
+    void setHistory(History history) {
+        history_ = std::move(history);
     }
 
 public signals:
-    WalletUpdateSignal walletUpdateEvent;
+    WalletsUpdateSignal walletsUpdateEvent;
     FinishedUpdateFromDB updateFromDBFinishedEvent;
 
 private:
@@ -126,6 +237,9 @@ private:
                             bool inverse);
     void loadTrxForTarget(const csdb::Transaction& tr, bool inverse);
 
+    // rebuilds transactions tails and last transactions of wallets of removed block from the chain
+    void restoreFromChain(const csdb::Pool& pool, const BlockChain& blockchain);
+
     void fundConfidantsWalletsWithFee(const csdb::Amount& totalFee,
                                       const cs::ConfidantsKeys& confidants,
                                       const std::vector<uint8_t>& realTrusted,
@@ -144,15 +258,26 @@ private:
 
 #ifdef MONITOR_NODE
     bool setWalletTime(const PublicKey& address, const uint64_t& p_timeStamp);
+
+    // changed wallets are collected and emitted once per block
+    void markUpdated(const PublicKey& key);
+    void emitUpdated();
 #endif
 
     WalletsCache& data_;
+    csdb::AmountBatch feeBatch_;
+    History history_;
+
+#ifdef MONITOR_NODE
+    std::vector<PublicKey> updated_;
+    WalletsUpdates updates_;
+#endif
 };
 
 inline const WalletsCache::WalletData* WalletsCache::Updater::findWallet(const PublicKey& key) const {
     auto it = data_.wallets_.find(key);
     if (it == data_.wallets_.end()) {
-        return nullptr;
+        return data_.findCold(key);
     }
     return &(it->second);
 }
@@ -162,11 +287,19 @@ inline const WalletsCache::WalletData* WalletsCache::Updater::findWallet(const c
 }
 
 inline WalletsCache::WalletData& WalletsCache::Updater::getWalletData(const PublicKey& key) {
+    auto it = data_.wallets_.find(key);
+    auto wallet = it != data_.wallets_.end() ? &it->second : data_.promote(key);
+    if (data_.isDbRead_) {
+        data_.touch(key, wallet);
+    }
+    if (wallet != nullptr) {
+        return *wallet;
+    }
     return data_.wallets_[key];
 }
 
 inline WalletsCache::WalletData& WalletsCache::Updater::getWalletData(const csdb::Address& addr) {
-    return data_.wallets_[toPublicKey(addr)];
+    return getWalletData(toPublicKey(addr));
 }
 
 inline double WalletsCache::Updater::load(const csdb::Transaction& t, const BlockChain& bc, bool inverse) {
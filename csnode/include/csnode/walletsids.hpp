@@ -1,20 +1,26 @@
 #ifndef WALLET_IDS_HPP
 #define WALLET_IDS_HPP
 
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <string>
 #include <type_traits>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <utility>
+#include <vector>
 
 #include <csdb/address.hpp>
 #include <csdb/internal/types.hpp>
 
-using namespace boost::multi_index;
-
 namespace cs {
 
+///
+/// Ids of wallets by their public keys and back.
+///
+/// Public keys are kept once in open addressing table with linear probing, ids are given
+/// sequentially, so slot of wallet by id is found in dense array. Table has the same layout
+/// in memory and in file, so it is saved and loaded by mapping without rehashing.
+///
 class WalletsIds {
 public:
     using WalletId = csdb::internal::WalletId;
@@ -35,7 +41,6 @@ public:
 
     private:
         WalletsIds& norm_;
-        WalletId nextIdSpecial_;
         static constexpr uint32_t maskSpecial_ = (1u << 31);
         static constexpr WalletId noSpecial_ = 0;
 
@@ -81,30 +86,64 @@ public:
         return *norm_;
     }
 
+    // count of normal and special ids
+    size_t size() const {
+        return size_;
+    }
+
+    // bytes of table and id arrays
+    size_t memoryUsage() const;
+
+    // writes table to file as it is kept in memory
+    bool save(const std::string& path) const;
+
+    // replaces all ids by saved ones, keeps current ids if file is missing or damaged
+    bool load(const std::string& path);
+
 private:
-    struct Wallet {
-        WalletAddress address; struct byAddress {};
-        WalletId id;  struct byId {};
+    static constexpr WalletId kNoId = std::numeric_limits<WalletId>::max();
+    static constexpr uint32_t kNoSlot = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t kMinCapacity = 1024;
+
+    // empty slot has kNoId, kNoId itself is never given
+    struct Slot {
+        cs::PublicKey key;
+        WalletId id;
     };
 
-    using Data = multi_index_container<
-        Wallet,
-        indexed_by<
-            hashed_unique<
-                tag<Wallet::byAddress>, member<
-                    Wallet, WalletAddress, &Wallet::address
-                >
-            >,
-            hashed_unique<
-                tag<Wallet::byId>, member<
-                    Wallet, WalletId, &Wallet::id
-                >
-            >
-        >
-    >;
-
-    Data data_;
+    static_assert(std::is_trivially_copyable_v<Slot>, "Slots are copied to file as is");
+
+    size_t bucket(const cs::PublicKey& key) const;
+
+    // slot of key or empty slot where key should be inserted
+    size_t probe(const cs::PublicKey& key) const;
+
+    // returns slot of key and true if key was inserted with id
+    std::pair<size_t, bool> emplace(const cs::PublicKey& key, WalletId id);
+    void erase(size_t slot);
+    void grow();
+
+    const Slot* slotById(WalletId id) const;
+    std::vector<uint32_t>& positions(WalletId id);
+
+    // slot of id is changed
+    void place(size_t slot);
+    void displace(WalletId id);
+
+    void rebuildPositions();
+
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+
+    // random per table, saved with it
+    uint64_t seed_;
+
+    // slots by normal ids and by special ids without special mask
+    std::vector<uint32_t> normalSlots_;
+    std::vector<uint32_t> specialSlots_;
+
     WalletId nextId_;
+    WalletId nextIdSpecial_;
     std::unique_ptr<Special> special_;
     std::unique_ptr<Normal> norm_;
 };
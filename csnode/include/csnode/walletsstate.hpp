@@ -13,6 +13,13 @@ namespace cs {
 class WalletsCache;
 class WalletsIds;
 
+///
+/// Wallets as validated transactions of round change them.
+///
+/// Layer of changed wallets over the wallets cache. Wallet is copied from the cache on the first
+/// access in round, the next round drops all changes at once by version, and entries are reused
+/// instead of being freed and allocated again each round.
+///
 class WalletsState {
 public:
     using WalletAddress = csdb::Address;
@@ -29,11 +36,26 @@ public:
     explicit WalletsState(const WalletsCache::Updater& cacheUpd) : wallCache_(cacheUpd) {}
     WalletData& getData(const WalletAddress& address);
 
-    void updateFromSource() { storage_.clear(); }
+    // drops changes of round, wallets are copied from the cache again
+    void updateFromSource();
+
+    // wallets accessed in current round
+    size_t size() const {
+        return touched_;
+    }
 
 private:
+    struct Entry {
+        uint64_t version = 0;
+        WalletData data;
+    };
+
     const WalletsCache::Updater& wallCache_;
-    std::unordered_map<PublicKey, WalletData> storage_;
+    std::unordered_map<PublicKey, Entry> storage_;
+
+    // entries of other versions are stale
+    uint64_t version_ = 1;
+    size_t touched_ = 0;
 };
 }  // namespace cs
 #endif // WALLETS_STATE_HPP
@@ -2,6 +2,7 @@
 #include <csdb/currency.hpp>
 #include <lib/system/hash.hpp>
 #include <lib/system/logger.hpp>
+#include <lib/system/metrics.hpp>
 #include <lib/system/utils.hpp>
 #include <limits>
 
@@ -13,6 +14,7 @@
 #include <csnode/nodeutils.hpp>
 #include <csnode/node.hpp>
 #include <csnode/transactionsindex.hpp>
+#include <csnode/contractstatesindex.hpp>
 #include <csnode/transactionsiterator.hpp>
 #include <solver/smartcontracts.hpp>
 
@@ -23,37 +25,43 @@ namespace fs = boost::filesystem;
 
 namespace {
 const char* cachesPath = "./caches";
+constexpr cs::Sequence kBlocksInHashesBatch = 1000;
 } // namespace
 
-BlockChain::BlockChain(csdb::Address genesisAddress, csdb::Address startAddress, bool recreateIndex)
+BlockChain::BlockChain(csdb::Address genesisAddress, csdb::Address startAddress, bool recreateIndex, size_t hotWalletsCapacity)
 : good_(false)
 , dbLock_()
 , genesisAddress_(genesisAddress)
 , startAddress_(startAddress)
 , walletIds_(new WalletsIds)
-, walletsCacheStorage_(new WalletsCache(*walletIds_))
 , multiWallets_(new MultiWallets())
 , cacheMutex_() {
     createCachesPath();
 
+    walletsCacheStorage_ = std::make_unique<WalletsCache>(*walletIds_, WalletsCache::Settings{std::string(cachesPath) + "/coldwallets", hotWalletsCapacity});
+
     walletsCacheUpdater_ = walletsCacheStorage_->createUpdater();
     blockHashes_ = std::make_unique<cs::BlockHashes>(cachesPath);
     trxIndex_ = std::make_unique<cs::TransactionsIndex>(*this, cachesPath, recreateIndex);
+    statesIndex_ = std::make_unique<cs::ContractStatesIndex>(*this, cachesPath, recreateIndex);
 
     cs::Connector::connect(&storage_.readingStartedEvent(), trxIndex_.get(), &TransactionsIndex::onStartReadFromDb);
+    cs::Connector::connect(&storage_.readingStartedEvent(), statesIndex_.get(), &ContractStatesIndex::onStartReadFromDb);
     cs::Connector::connect(&storage_.readingStartedEvent(), this, &BlockChain::onStartReadFromDB);
 
     // the order of two following calls matters
-    cs::Connector::connect(&storage_.readBlockEvent(), trxIndex_.get(), &TransactionsIndex::onReadFromDb);
-    cs::Connector::connect(&storage_.readBlockEvent(), this, &BlockChain::onReadFromDB);
+    cs::Connector::connect<&TransactionsIndex::onReadFromDb>(&storage_.readBlockEvent(), trxIndex_.get());
+    cs::Connector::connect<&ContractStatesIndex::onReadFromDb>(&storage_.readBlockEvent(), statesIndex_.get());
+    cs::Connector::connect<&BlockChain::onReadFromDB>(&storage_.readBlockEvent(), this);
 
     cs::Connector::connect(&storage_.readingStoppedEvent(), trxIndex_.get(), &TransactionsIndex::onDbReadFinished);
+    cs::Connector::connect(&storage_.readingStoppedEvent(), statesIndex_.get(), &ContractStatesIndex::onDbReadFinished);
     cs::Connector::connect(&storage_.readingStoppedEvent(), walletsCacheUpdater_.get(), &WalletsCache::Updater::onStopReadingFromDB);
 
 #ifdef MONITOR_NODE
     cs::Connector::connect(&walletsCacheUpdater_->updateFromDBFinishedEvent, multiWallets_.get(), &MultiWallets::onDbReadFinished);
     cs::Connector::connect(&walletsCacheUpdater_->updateFromDBFinishedEvent, [this] (const auto&) {
-        cs::Connector::connect(&walletsCacheUpdater_->walletUpdateEvent, multiWallets_.get(), &MultiWallets::onWalletCacheUpdated);
+        cs::Connector::connect<&MultiWallets::onWalletsCacheUpdated>(&walletsCacheUpdater_->walletsUpdateEvent, multiWallets_.get());
     });
 #endif
 }
@@ -62,6 +70,7 @@ BlockChain::~BlockChain() {}
 
 bool BlockChain::init(const std::string& path, cs::Sequence newBlockchainTop) {
     cs::Connector::connect(&this->removeBlockEvent, trxIndex_.get(), &TransactionsIndex::onRemoveBlock);
+    cs::Connector::connect(&this->removeBlockEvent, statesIndex_.get(), &ContractStatesIndex::onRemoveBlock);
 
     cslog() << "Trying to open DB...";
 
@@ -75,7 +84,12 @@ bool BlockChain::init(const std::string& path, cs::Sequence newBlockchainTop) {
         return false;
     };
 
-    if (!storage_.open(path, progress, newBlockchainTop)) {
+    // hashes of read blocks are written in batches
+    blockHashes_->beginBatch();
+    const bool isOpened = storage_.open(path, progress, newBlockchainTop);
+    blockHashes_->commitBatch();
+
+    if (!isOpened) {
         cserror() << "Couldn't open database at " << path;
         return false;
     }
@@ -139,6 +153,10 @@ void BlockChain::onReadFromDB(csdb::Pool block, bool* shouldStop) {
             cserror() << "Blockchain: blockHashes_->onReadBlock(block) failed on block #" << block.sequence();
             *shouldStop = true;
         }
+        if (blockSeq % kBlocksInHashesBatch == 0) {
+            blockHashes_->commitBatch();
+            blockHashes_->beginBatch();
+        }
         updateNonEmptyBlocks(block);
         walletsCacheUpdater_->loadNextBlock(block, block.confidants(), *this);
     }
@@ -324,6 +342,26 @@ csdb::Transaction BlockChain::loadTransaction(const csdb::TransactionID& transId
     return transaction;
 }
 
+bool BlockChain::getTransactionProof(const csdb::TransactionID& transId, cs::Hash& leaf, cs::MerkleTree::Proof& proof, cs::Hash& root) const {
+    csdb::Pool pool = loadBlock(transId.pool_seq());
+
+    if (!pool.is_valid() || transId.index() >= pool.transactions_count()) {
+        return false;
+    }
+
+    const auto leaves = cs::MerkleTree::leaves(pool);
+    const auto index = static_cast<size_t>(transId.index());
+
+    leaf = leaves[index];
+    proof = cs::MerkleTree::proof(leaves, index);
+
+    if (!cs::MerkleTree::storedRoot(pool, root)) {
+        root = cs::MerkleTree::root(leaves);
+    }
+
+    return cs::MerkleTree::verify(leaf, proof, root);
+}
+
 void BlockChain::removeLastBlock() {
     if (blocksToBeRemoved_ == 0) {
         csmeta(csdebug) << "There are no blocks, allowed to be removed";
@@ -537,6 +575,7 @@ bool BlockChain::finalizeBlock(csdb::Pool& pool, bool isTrusted, cs::PublicKeys
     // pool signatures check: end
 
     trxIndex_->update(pool);
+    statesIndex_->update(pool);
     updateNonEmptyBlocks(pool);
 
     if (!updateFromNextBlock(pool)) {
@@ -594,7 +633,13 @@ uint64_t BlockChain::getWalletsCountWithBalance() {
 }
 
 void BlockChain::getTransactions(Transactions& transactions, csdb::Address address, uint64_t offset, uint64_t limit) {
-    for (auto trIt = cs::TransactionsIterator(*this, address); trIt.isValid(); trIt.next()) {
+    // every block of address history contains at least one of its transactions
+    cs::TransactionsIterator::ReadAhead readAhead;
+    if (limit != 0 && offset < readAhead.window && limit < readAhead.window - offset) {
+        readAhead.window = static_cast<size_t>(offset + limit);
+    }
+
+    for (auto trIt = cs::TransactionsIterator(*this, address, readAhead); trIt.isValid(); trIt.next()) {
         if (offset > 0) {
             --offset;
             continue;
@@ -720,6 +765,7 @@ void BlockChain::close() {
     cs::Connector::disconnect(&storage_.readBlockEvent(), this, &BlockChain::onReadFromDB);
     blockHashes_->close();
     trxIndex_->close();
+    statesIndex_->close();
 }
 
 bool BlockChain::getTransaction(const csdb::Address& addr, const int64_t& innerId, csdb::Transaction& result) const {
@@ -809,6 +855,33 @@ bool BlockChain::findWalletData(const csdb::Address& address, WalletData& wallDa
     return false;
 }
 
+bool BlockChain::findPublishedWallet(const csdb::Address& address, cs::PublishedWallets::Wallet& wallet) const {
+    csdb::Address pubKey = address;
+
+    if (!address.is_public_key()) {
+        std::lock_guard lock(cacheMutex_);
+        pubKey = getAddressByType(address, AddressType::PublicKey);
+    }
+
+    if (!pubKey.is_public_key()) {
+        return false;
+    }
+
+    if (walletsCacheStorage_->published().find(pubKey.public_key(), wallet)) {
+        return true;
+    }
+
+    // dormant wallets are not published, as well as all wallets while blocks are read from database
+    WalletData wallData;
+
+    if (!findWalletData(pubKey, wallData)) {
+        return false;
+    }
+
+    wallet = cs::WalletsCache::toPublished(wallData);
+    return true;
+}
+
 bool BlockChain::findWalletData(WalletId id, WalletData& wallData) const {
     std::lock_guard lock(cacheMutex_);
     return findWalletData_Unsafe(id, wallData);
@@ -1014,6 +1087,10 @@ bool BlockChain::updateLastBlock(cs::RoundPackage& rPackage, const csdb::Pool& p
     for (auto& it : poolFrom.transactions()) {
         tmpPool.add_transaction(it);
     }
+    // merkle root and other fields are kept, timestamp is taken from round package
+    for (const auto id : poolFrom.user_field_ids()) {
+        tmpPool.add_user_field(id, poolFrom.user_field(id));
+    }
     tmpPool.add_user_field(0, rPackage.poolMetaInfo().timestamp);
     for (auto& it : poolFrom.smartSignatures()) {
         tmpPool.add_smart_signature(it);
@@ -1061,6 +1138,9 @@ bool BlockChain::deferredBlockExchange(cs::RoundPackage& rPackage, const csdb::P
 }
 
 bool BlockChain::storeBlock(csdb::Pool& pool, bool bySync) {
+    static auto& storeTime = cs::metrics::timer("cs_blockchain_store_block_seconds", "Time of BlockChain::storeBlock");
+    cs::metrics::ScopedTimer timer(storeTime);
+
     const auto lastSequence = getLastSeq();
     const auto poolSequence = pool.sequence();
     csdebug() << csfunc() << "last #" << lastSequence << ", pool #" << poolSequence;
@@ -1349,6 +1429,10 @@ csdb::TransactionID BlockChain::getLastTransaction(const csdb::Address& addr) co
     return wallDataPtr->lastTransaction_;
 }
 
+csdb::TransactionID BlockChain::getStateTransaction(const csdb::Address& contract, cs::Sequence sequence) const {
+    return statesIndex_->getStateTransaction(contract, sequence);
+}
+
 cs::Sequence BlockChain::getPreviousPoolSeq(const csdb::Address& addr, cs::Sequence ps) const {
     auto prev_seq = trxIndex_->getPrevTransBlock(addr, ps);
 
@@ -3,30 +3,34 @@
 #include <conveyer.hpp>
 #include <cstring>
 
+#include <csdb/internal/utils.hpp>
 #include <lib/system/logger.hpp>
 
+static const char* dbPath = "/blockhashesdb";
+static const char* seqTable = "seq";
+static const char* hashTable = "hash";
+
+// former separate databases, hashes are restored from blocks on start
 static const char* seqPath = "/seqdb";
 static const char* hashPath = "/hashdb";
 
 namespace cs {
 BlockHashes::BlockHashes(const std::string& path)
-: seqDb_(path + seqPath)
-, hashDb_(path + hashPath) {
+: db_(path + dbPath) {
+    csdb::internal::path_remove(path + seqPath);
+    csdb::internal::path_remove(path + hashPath);
+
     initialization();
 }
 
 void BlockHashes::close() {
-    if (seqDb_.isOpen()) {
-        seqDb_.close();
-    }
-
-    if (hashDb_.isOpen()) {
-        hashDb_.close();
+    if (db_.isOpen()) {
+        db_.close();
     }
 }
 
 size_t BlockHashes::size() const {
-    return seqDb_.size();
+    return db_.size(seqTable);
 }
 
 bool BlockHashes::update(const csdb::Pool& block) {
@@ -39,27 +43,28 @@ bool BlockHashes::update(const csdb::Pool& block) {
         return true;
     }
 
-    seqDb_.insert(seq, hash.to_binary());
-    hashDb_.insert(hash.to_binary(), seq);
+    Lmdb::Batch batch(db_);
+    db_.insert(seq, hash.to_binary(), seqTable);
+    db_.insert(hash.to_binary(), seq, hashTable);
 
     return true;
 }
 
 csdb::PoolHash BlockHashes::find(cs::Sequence seq) const {
-    if (seqDb_.size() == 0 || !seqDb_.isKeyExists(seq)) {
+    if (!db_.isKeyExists(seq, seqTable)) {
         return csdb::PoolHash{};
     }
 
-    auto value = seqDb_.value<cs::Bytes>(seq);
+    auto value = db_.value<cs::Bytes>(seq, seqTable);
     return csdb::PoolHash::from_binary(std::move(value));
 }
 
 cs::Sequence BlockHashes::find(const csdb::PoolHash& hash) const {
-    if (hash.is_empty() || hashDb_.size() == 0 || !hashDb_.isKeyExists(hash.to_binary())) {
+    if (hash.is_empty() || !db_.isKeyExists(hash.to_binary(), hashTable)) {
         return cs::kWrongSequence;
     }
 
-    return hashDb_.value<cs::Sequence>(hash.to_binary());
+    return db_.value<cs::Sequence>(hash.to_binary(), hashTable);
 }
 
 bool BlockHashes::remove(cs::Sequence sequence) {
@@ -67,8 +72,9 @@ bool BlockHashes::remove(cs::Sequence sequence) {
     if (hash.is_empty()) {
         return false;
     }
-    seqDb_.remove(sequence);
-    hashDb_.remove(hash.to_binary());
+    Lmdb::Batch batch(db_);
+    db_.remove(sequence, seqTable);
+    db_.remove(hash.to_binary(), hashTable);
     return true;
 }
 
@@ -77,23 +83,32 @@ bool BlockHashes::remove(const csdb::PoolHash& hash) {
     if (sequence == kWrongSequence) {
         return false;
     }
-    seqDb_.remove(sequence);
-    hashDb_.remove(hash.to_binary());
+    Lmdb::Batch batch(db_);
+    db_.remove(sequence, seqTable);
+    db_.remove(hash.to_binary(), hashTable);
     return true;
 }
 
+void BlockHashes::beginBatch() {
+    db_.beginBatch();
+}
+
+void BlockHashes::commitBatch() {
+    db_.commitBatch();
+}
+
 void BlockHashes::onDbFailed(const LmdbException& exception) {
     cswarning() << csfunc() << ", block hashes database exception: " << exception.what();
 }
 
 void BlockHashes::initialization() {
-    cs::Connector::connect(&seqDb_.failed, this, &BlockHashes::onDbFailed);
-    cs::Connector::connect(&hashDb_.failed, this, &BlockHashes::onDbFailed);
+    cs::Connector::connect(&db_.failed, this, &BlockHashes::onDbFailed);
 
-    seqDb_.setMapSize(cs::Lmdb::Default1GbMapSize);
-    hashDb_.setMapSize(cs::Lmdb::Default1GbMapSize);
+    db_.setMaxDbs(2);
+    db_.setMapSize(cs::Lmdb::Default1GbMapSize);
+    db_.open();
 
-    seqDb_.open();
-    hashDb_.open();
+    db_.createTable(seqTable);
+    db_.createTable(hashTable);
 }
 }  // namespace cs
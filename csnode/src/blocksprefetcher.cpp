@@ -0,0 +1,148 @@
+#include <csnode/blocksprefetcher.hpp>
+
+#include <condition_variable>
+#include <mutex>
+
+#include <lib/system/concurrent.hpp>
+
+namespace cs {
+
+struct BlocksPrefetcher::Slot {
+    enum class State {
+        Pending,
+        Loading,
+        Done,
+        Cancelled
+    };
+
+    explicit Slot(Sequence seq)
+    : sequence(seq) {
+    }
+
+    // moves pending slot to loading state, returns false if slot is already taken
+    bool start() {
+        std::lock_guard lock(mutex);
+
+        if (state != State::Pending) {
+            return false;
+        }
+
+        state = State::Loading;
+        return true;
+    }
+
+    void finish(csdb::Pool&& loaded) {
+        {
+            std::lock_guard lock(mutex);
+            pool = std::move(loaded);
+            state = State::Done;
+        }
+
+        condition.notify_all();
+    }
+
+    void cancel() {
+        std::unique_lock lock(mutex);
+
+        if (state == State::Pending) {
+            state = State::Cancelled;
+            return;
+        }
+
+        condition.wait(lock, [this] { return state != State::Loading; });
+    }
+
+    csdb::Pool take(const Loader& loader) {
+        if (start()) {
+            auto loaded = loader(sequence);
+            std::lock_guard lock(mutex);
+            state = State::Done;
+            return loaded;
+        }
+
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [this] { return state != State::Loading; });
+
+        return state == State::Done ? std::move(pool) : csdb::Pool{};
+    }
+
+    const Sequence sequence;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    State state = State::Pending;
+    csdb::Pool pool;
+};
+
+BlocksPrefetcher::BlocksPrefetcher(Resolver resolver, Loader loader, size_t window)
+: resolver_(std::move(resolver))
+, loader_(std::move(loader))
+, window_(window == 0 ? 1 : window)
+, lastResolved_(kWrongSequence)
+, chainEnded_(true) {
+}
+
+BlocksPrefetcher::~BlocksPrefetcher() {
+    cancel();
+}
+
+void BlocksPrefetcher::reset(Sequence sequence) {
+    cancel();
+
+    lastResolved_ = sequence;
+    chainEnded_ = (sequence == kWrongSequence);
+
+    fill();
+}
+
+csdb::Pool BlocksPrefetcher::next() {
+    fill();
+
+    if (slots_.empty()) {
+        return csdb::Pool{};
+    }
+
+    auto slot = std::move(slots_.front());
+    slots_.pop_front();
+
+    // keep window full while the consumer processes the block
+    fill();
+
+    return slot->take(loader_);
+}
+
+void BlocksPrefetcher::cancel() {
+    for (auto& slot : slots_) {
+        slot->cancel();
+    }
+
+    slots_.clear();
+    chainEnded_ = true;
+}
+
+void BlocksPrefetcher::fill() {
+    while (!chainEnded_ && slots_.size() < window_) {
+        const auto sequence = resolver_(lastResolved_);
+
+        if (sequence == kWrongSequence) {
+            chainEnded_ = true;
+            break;
+        }
+
+        lastResolved_ = sequence;
+        slots_.push_back(std::make_shared<Slot>(sequence));
+
+        launch(slots_.back());
+    }
+}
+
+void BlocksPrefetcher::launch(const std::shared_ptr<Slot>& slot) {
+    // task must not touch prefetcher, it may be already destroyed when task is started
+    cs::Concurrent::run([slot, loader = loader_] {
+        if (slot->start()) {
+            slot->finish(loader(slot->sequence));
+        }
+    });
+}
+
+} // namespace cs
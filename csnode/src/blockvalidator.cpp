@@ -20,6 +20,7 @@ BlockValidator::BlockValidator(Node& node)
     plugins_.insert(std::make_pair(balances, std::make_unique<BalanceChecker>(*this)));
     plugins_.insert(std::make_pair(transactionsSignatures, std::make_unique<TransactionsChecker>(*this)));
     plugins_.insert(std::make_pair(smartStates, std::make_unique<SmartStateValidator>(*this)));
+    plugins_.insert(std::make_pair(merkleRoot, std::make_unique<MerkleRootValidator>(*this)));
     /*HL99dwfM3YPQnauN1djBvVLZNbC3b1FHwe5vPv8pDZ1y - 0xAAE*/
     /*CSa4DTfTcenryQAifiPKVpY9jzWshYY11g3mXQR6B7rJ - dAp*/
     /*8Vr9JA4AessnxVthGjp2ae7YLWQPU7jMvWYiPZA6vpDH - -253CS*/
@@ -10,6 +10,7 @@
 #include <lib/system/common.hpp>
 #include <csnode/walletsstate.hpp>
 #include <csnode/walletscache.hpp>
+#include <csnode/merkletree.hpp>
 #include <csdb/amount_commission.hpp>
 #include <csdb/pool.hpp>
 #include <cscrypto/cscrypto.hpp>
@@ -150,10 +151,8 @@ bool SmartStateValidator::checkNewState(const csdb::Transaction& t) {
 ValidationPlugin::ErrorType HashValidator::validateBlock(const csdb::Pool& block) {
   auto prevHash = block.previous_hash();
   auto& prevBlock = getPrevBlock();
-  auto data = prevBlock.to_binary();
-  auto countedPrevHash = csdb::PoolHash::calc_from_data(cs::Bytes(data.data(),
-                                                          data.data() +
-                                                          prevBlock.hashingLength()));
+  const auto& data = prevBlock.to_binary();
+  auto countedPrevHash = csdb::PoolHash::calc_from_data(data.data(), prevBlock.hashingLength());
   if (prevHash != countedPrevHash) {
     csfatal() << kLogPrefix << ": prev pool's (" << prevBlock.sequence()
               << ") hash != real prev pool's hash";
@@ -162,6 +161,19 @@ ValidationPlugin::ErrorType HashValidator::validateBlock(const csdb::Pool& block
   return ErrorType::noError;
 }
 
+ValidationPlugin::ErrorType MerkleRootValidator::validateBlock(const csdb::Pool& block) {
+  cs::Hash storedRoot;
+  if (!MerkleTree::storedRoot(block, storedRoot)) {
+    return ErrorType::noError;
+  }
+
+  if (MerkleTree::root(MerkleTree::leaves(block)) != storedRoot) {
+    cserror() << kLogPrefix << "Block with sequence " << block.sequence() << " has invalid merkle root";
+    return ErrorType::error;
+  }
+  return ErrorType::noError;
+}
+
 ValidationPlugin::ErrorType BlockNumValidator::validateBlock(const csdb::Pool& block) {
   auto& prevBlock = getPrevBlock();
   if (block.sequence() - prevBlock.sequence() != kGapBtwNeighbourBlocks) {
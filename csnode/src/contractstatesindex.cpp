@@ -0,0 +1,176 @@
+#include <csnode/contractstatesindex.hpp>
+
+#include <algorithm>
+#include <map>
+
+#include <boost/filesystem.hpp>
+
+#include <csdb/internal/utils.hpp>
+#include <csdb/pool.hpp>
+#include <csnode/blockchain.hpp>
+#include <lib/system/logger.hpp>
+#include <solver/smartcontracts.hpp>
+
+namespace {
+constexpr const char* kDbPath = "/statesindexdb";
+constexpr const char* kLastIndexedPath = "/last_states_indexed";
+
+// big endian sequence keeps keys of contract in order of blocks
+cs::Bytes makeKey(const cs::PublicKey& key, cs::Sequence sequence) {
+    cs::Bytes result(key.begin(), key.end());
+    result.resize(key.size() + sizeof(sequence));
+
+    for (size_t i = 0; i < sizeof(sequence); ++i) {
+        result[key.size() + i] = static_cast<cs::Byte>(sequence >> (8 * (sizeof(sequence) - 1 - i)));
+    }
+
+    return result;
+}
+
+cs::Sequence keySequence(const cs::Bytes& key) {
+    cs::Sequence sequence = 0;
+
+    for (size_t i = key.size() - sizeof(sequence); i < key.size(); ++i) {
+        sequence = (sequence << 8) | key[i];
+    }
+
+    return sequence;
+}
+}  // namespace
+
+namespace cs {
+ContractStatesIndex::ContractStatesIndex(BlockChain& blockchain, const std::string& path, bool recreate)
+: blockchain_(blockchain)
+, rootPath_(path)
+, db_(std::make_unique<Lmdb>(path + kDbPath))
+, recreate_(recreate ? true : hasToRecreate(path + kLastIndexedPath, lastIndexed_))
+, lastIndexedFile_(path + kLastIndexedPath, sizeof(Sequence)) {
+    init();
+}
+
+void ContractStatesIndex::update(const csdb::Pool& pool) {
+    updateFromNextBlock(pool);
+}
+
+void ContractStatesIndex::close() {
+    if (db_->isOpen()) {
+        db_->close();
+    }
+}
+
+csdb::TransactionID ContractStatesIndex::getStateTransaction(const csdb::Address& contract, Sequence sequence) const {
+    const auto address = blockchain_.getAddressByType(contract, BlockChain::AddressType::PublicKey);
+
+    if (!address.is_valid()) {
+        return csdb::TransactionID{};
+    }
+
+    const auto& publicKey = address.public_key();
+    const auto [key, index] = db_->floor<cs::Bytes, Sequence>(makeKey(publicKey, sequence));
+
+    // floor key may belong to previous contract in order
+    if (key.size() != publicKey.size() + sizeof(Sequence) || !std::equal(publicKey.begin(), publicKey.end(), key.begin())) {
+        return csdb::TransactionID{};
+    }
+
+    return csdb::TransactionID(keySequence(key), index);
+}
+
+void ContractStatesIndex::onStartReadFromDb(Sequence lastWrittenSequence) {
+    if (!recreate_ && lastIndexed_ != lastWrittenSequence) {
+        recreate_ = true;
+    }
+}
+
+void ContractStatesIndex::onReadFromDb(const csdb::Pool& pool) {
+    if (pool.sequence() == 0 && recreate_) {
+        reset();
+        init();
+    }
+
+    if (recreate_ || lastIndexed_ < pool.sequence()) {
+        updateFromNextBlock(pool);
+    }
+}
+
+void ContractStatesIndex::onDbReadFinished() {
+    if (recreate_) {
+        recreate_ = false;
+        cslog() << "Recreated contract states index 0 -> " << lastIndexed_;
+    }
+
+    updateLastIndexed();
+}
+
+void ContractStatesIndex::onRemoveBlock(const csdb::Pool& pool) {
+    for (const auto& transaction : pool.transactions()) {
+        if (SmartContracts::is_state_updated(transaction)) {
+            const auto address = blockchain_.getAddressByType(transaction.target(), BlockChain::AddressType::PublicKey);
+            db_->remove(makeKey(address.public_key(), pool.sequence()));
+        }
+    }
+
+    lastIndexed_ = pool.sequence() - 1;
+    updateLastIndexed();
+}
+
+void ContractStatesIndex::updateFromNextBlock(const csdb::Pool& pool) {
+    // the last new state of contract in block is actual after it
+    std::map<PublicKey, Sequence> states;
+    const auto& transactions = pool.transactions();
+
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        if (SmartContracts::is_state_updated(transactions[i])) {
+            const auto address = blockchain_.getAddressByType(transactions[i].target(), BlockChain::AddressType::PublicKey);
+            states[address.public_key()] = static_cast<Sequence>(i);
+        }
+    }
+
+    for (const auto& [key, index] : states) {
+        db_->insert(makeKey(key, pool.sequence()), index);
+    }
+
+    lastIndexed_ = pool.sequence();
+    updateLastIndexed();
+}
+
+void ContractStatesIndex::updateLastIndexed() {
+    if (auto ptr = lastIndexedFile_.data<Sequence>(); ptr) {
+        *ptr = lastIndexed_;
+    }
+}
+
+bool ContractStatesIndex::hasToRecreate(const std::string& path, Sequence& lastIndexed) {
+    if (!boost::filesystem::is_regular_file(boost::filesystem::path(path))) {
+        return true;
+    }
+
+    MMappedFileWrap<FileSource> file(path, sizeof(Sequence), false);
+
+    if (!file.isOpen()) {
+        return true;
+    }
+
+    lastIndexed = *(file.data<const Sequence>());
+    return lastIndexed == kWrongSequence;
+}
+
+void ContractStatesIndex::onDbFailed(const LmdbException& exception) {
+    cswarning() << csfunc() << ", contract states index database exception " << exception.what();
+}
+
+void ContractStatesIndex::init() {
+    Connector::connect(&db_->failed, this, &ContractStatesIndex::onDbFailed);
+
+    db_->setMapSize(Lmdb::Default1GbMapSize);
+    db_->open();
+}
+
+void ContractStatesIndex::reset() {
+    Connector::disconnect(&db_->failed, this, &ContractStatesIndex::onDbFailed);
+    db_->close();
+    db_.reset(nullptr);
+    csdb::internal::path_remove(rootPath_ + kDbPath);
+    db_ = std::make_unique<Lmdb>(rootPath_ + kDbPath);
+}
+}  // namespace cs
@@ -0,0 +1,448 @@
+#include <csnode/contractstatestore.hpp>
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+#include <csdb/internal/utils.hpp>
+#include <lib/system/hash.hpp>
+#include <lib/system/logger.hpp>
+#include <lmdb.hpp>
+
+namespace {
+// gear hash table of pseudo random values, chunk boundaries must not change between runs
+constexpr std::array<uint64_t, 256> makeGear() {
+    std::array<uint64_t, 256> table{};
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    for (auto& value : table) {
+        // splitmix64
+        seed += 0x9E3779B97F4A7C15ULL;
+
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        value = z ^ (z >> 31);
+    }
+
+    return table;
+}
+
+constexpr auto kGear = makeGear();
+
+// normalized chunking: boundary is harder to find before average size and easier after it
+constexpr uint64_t kMaskSmall = ~(std::numeric_limits<uint64_t>::max() >> 13);
+constexpr uint64_t kMaskLarge = ~(std::numeric_limits<uint64_t>::max() >> 9);
+}  // namespace
+
+namespace cs {
+ContractStateStore::ContractStateStore()
+: ContractStateStore(Settings{}) {
+}
+
+ContractStateStore::ContractStateStore(const Settings& settings)
+: settings_(settings) {
+    if (settings_.path.empty()) {
+        return;
+    }
+
+    // states are restored from blocks on start, so database is always new
+    csdb::internal::path_remove(settings_.path);
+
+    db_ = std::make_unique<Lmdb>(settings_.path);
+    Connector::connect(&db_->failed, this, &ContractStateStore::onDbFailed);
+
+    db_->setMapSize(Lmdb::Default1GbMapSize);
+    db_->open();
+}
+
+ContractStateStore::~ContractStateStore() {
+    if (db_ && db_->isOpen()) {
+        db_->close();
+    }
+}
+
+ContractStateStore::StateId ContractStateStore::put(const csdb::Address& contract, const std::string& state) {
+    const StateId id = generateHash(state.data(), state.size());
+
+    std::lock_guard lock(mutex_);
+    statistics_.logicalBytes += state.size();
+
+    if (auto it = recipes_.find(id); it != recipes_.end()) {
+        ++it->second.holders;
+        last_[contract] = id;
+
+        return id;
+    }
+
+    const auto lengths = split(state.data(), state.size());
+
+    std::vector<cs::Hash> chunks;
+    std::vector<size_t> offsets;
+
+    chunks.reserve(lengths.size());
+    offsets.reserve(lengths.size());
+
+    size_t offset = 0;
+
+    for (auto length : lengths) {
+        chunks.push_back(generateHash(state.data() + offset, length));
+        offsets.push_back(offset);
+        offset += length;
+    }
+
+    Recipe recipe;
+    recipe.size = state.size();
+    recipe.holders = 1;
+
+    if (auto last = last_.find(contract); last != last_.end()) {
+        if (auto base = recipes_.find(last->second); base != recipes_.end() && base->second.depth + 1 < kMaxDeltaDepth) {
+            if (encode(recipe, resolve(base->second), chunks)) {
+                recipe.base = base->first;
+                recipe.depth = base->second.depth + 1;
+
+                ++base->second.dependents;
+            }
+        }
+    }
+
+    if (!recipe.base.has_value()) {
+        recipe.spans.clear();
+        recipe.fresh = chunks;
+    }
+
+    // recipe keeps chunks of its own only, copied ones are kept by base
+    auto add = [&](size_t index) {
+        addChunk(chunks[index], state.data() + offsets[index], lengths[index]);
+    };
+
+    if (!recipe.base.has_value()) {
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            add(i);
+        }
+    }
+    else {
+        size_t index = 0;
+
+        for (const auto& span : recipe.spans) {
+            if (span.from == Span::kFresh) {
+                for (size_t i = 0; i < span.count; ++i) {
+                    add(index + i);
+                }
+            }
+
+            index += span.count;
+        }
+    }
+
+    statistics_.recipeBytes += recipeBytes(recipe);
+    recipes_.emplace(id, std::move(recipe));
+    last_[contract] = id;
+
+    evict();
+    return id;
+}
+
+void ContractStateStore::acquire(const StateId& id) {
+    std::lock_guard lock(mutex_);
+
+    if (auto it = recipes_.find(id); it != recipes_.end()) {
+        ++it->second.holders;
+        statistics_.logicalBytes += it->second.size;
+    }
+}
+
+void ContractStateStore::release(const StateId& id) {
+    std::lock_guard lock(mutex_);
+
+    auto it = recipes_.find(id);
+
+    if (it == recipes_.end() || it->second.holders == 0) {
+        return;
+    }
+
+    --it->second.holders;
+    statistics_.logicalBytes -= it->second.size;
+
+    collect(id);
+}
+
+std::optional<std::string> ContractStateStore::get(const StateId& id) {
+    std::lock_guard lock(mutex_);
+
+    auto it = recipes_.find(id);
+
+    if (it == recipes_.end()) {
+        return std::nullopt;
+    }
+
+    std::string state;
+    state.reserve(it->second.size);
+
+    for (const auto& hash : resolve(it->second)) {
+        const auto chunk = loadChunk(hash);
+
+        if (!chunk) {
+            cserror() << "Contract state store: chunk of state is not found";
+            return std::nullopt;
+        }
+
+        state.append(*chunk);
+    }
+
+    evict();
+    return std::make_optional(std::move(state));
+}
+
+ContractStateStore::Statistics ContractStateStore::statistics() const {
+    std::lock_guard lock(mutex_);
+
+    auto statistics = statistics_;
+    statistics.states = recipes_.size();
+    statistics.chunks = chunks_.size();
+
+    return statistics;
+}
+
+std::vector<size_t> ContractStateStore::split(const char* data, size_t size) {
+    std::vector<size_t> lengths;
+    lengths.reserve(size / kAverageChunkSize + 1);
+
+    auto bytes = reinterpret_cast<const uint8_t*>(data);
+
+    while (size > 0) {
+        if (size <= kMinChunkSize) {
+            lengths.push_back(size);
+            break;
+        }
+
+        const size_t last = std::min(size, kMaxChunkSize);
+        const size_t normal = std::min(last, kAverageChunkSize);
+
+        size_t length = kMinChunkSize;
+        uint64_t hash = 0;
+
+        for (; length < normal; ++length) {
+            hash = (hash << 1) + kGear[bytes[length]];
+
+            if ((hash & kMaskSmall) == 0) {
+                break;
+            }
+        }
+
+        if (length == normal) {
+            for (; length < last; ++length) {
+                hash = (hash << 1) + kGear[bytes[length]];
+
+                if ((hash & kMaskLarge) == 0) {
+                    break;
+                }
+            }
+        }
+
+        length = std::min(length + 1, last);
+
+        lengths.push_back(length);
+        bytes += length;
+        size -= length;
+    }
+
+    return lengths;
+}
+
+std::vector<cs::Hash> ContractStateStore::resolve(const Recipe& recipe) const {
+    if (!recipe.base.has_value()) {
+        return recipe.fresh;
+    }
+
+    const auto base = resolve(recipes_.at(recipe.base.value()));
+
+    std::vector<cs::Hash> chunks;
+    auto fresh = recipe.fresh.begin();
+
+    for (const auto& span : recipe.spans) {
+        if (span.from == Span::kFresh) {
+            chunks.insert(chunks.end(), fresh, fresh + span.count);
+            fresh += span.count;
+        }
+        else {
+            chunks.insert(chunks.end(), base.begin() + span.from, base.begin() + span.from + span.count);
+        }
+    }
+
+    return chunks;
+}
+
+bool ContractStateStore::encode(Recipe& recipe, const std::vector<cs::Hash>& base, const std::vector<cs::Hash>& chunks) {
+    std::map<cs::Hash, uint32_t> positions;
+
+    for (size_t i = 0; i < base.size(); ++i) {
+        positions.emplace(base[i], static_cast<uint32_t>(i));
+    }
+
+    for (size_t i = 0; i < chunks.size();) {
+        auto it = positions.find(chunks[i]);
+
+        if (it == positions.end()) {
+            if (recipe.spans.empty() || recipe.spans.back().from != Span::kFresh) {
+                recipe.spans.push_back(Span{Span::kFresh, 0});
+            }
+
+            ++recipe.spans.back().count;
+            recipe.fresh.push_back(chunks[i]);
+            ++i;
+
+            continue;
+        }
+
+        const auto from = it->second;
+        uint32_t count = 1;
+
+        while (i + count < chunks.size() && from + count < base.size() && chunks[i + count] == base[from + count]) {
+            ++count;
+        }
+
+        recipe.spans.push_back(Span{from, count});
+        i += count;
+    }
+
+    return recipeBytes(recipe) < chunks.size() * sizeof(cs::Hash);
+}
+
+size_t ContractStateStore::recipeBytes(const Recipe& recipe) {
+    return recipe.spans.size() * sizeof(Span) + recipe.fresh.size() * sizeof(cs::Hash);
+}
+
+void ContractStateStore::addChunk(const cs::Hash& hash, const char* data, size_t size) {
+    auto [it, inserted] = chunks_.try_emplace(hash);
+    Chunk& chunk = it->second;
+
+    ++chunk.refs;
+
+    if (!inserted) {
+        return;
+    }
+
+    chunk.size = size;
+    statistics_.chunkBytes += size;
+    statistics_.writtenBytes += size;
+
+    if (db_) {
+        db_->insert(hash, std::string_view(data, size));
+    }
+
+    cache(chunk, hash, std::string(data, size));
+}
+
+void ContractStateStore::releaseChunk(const cs::Hash& hash) {
+    auto it = chunks_.find(hash);
+
+    if (it == chunks_.end() || --it->second.refs != 0) {
+        return;
+    }
+
+    Chunk& chunk = it->second;
+
+    if (chunk.cached) {
+        order_.erase(chunk.position);
+        statistics_.cachedBytes -= chunk.size;
+    }
+
+    if (db_) {
+        db_->remove(hash);
+    }
+
+    statistics_.chunkBytes -= chunk.size;
+    chunks_.erase(it);
+}
+
+const std::string* ContractStateStore::loadChunk(const cs::Hash& hash) {
+    auto it = chunks_.find(hash);
+
+    if (it == chunks_.end()) {
+        return nullptr;
+    }
+
+    Chunk& chunk = it->second;
+
+    if (chunk.cached) {
+        order_.splice(order_.begin(), order_, chunk.position);
+        return &chunk.data;
+    }
+
+    if (!db_) {
+        return nullptr;
+    }
+
+    auto data = db_->value<std::string>(hash);
+
+    if (data.size() != chunk.size) {
+        return nullptr;
+    }
+
+    cache(chunk, hash, std::move(data));
+    return &chunk.data;
+}
+
+void ContractStateStore::cache(Chunk& chunk, const cs::Hash& hash, std::string&& data) {
+    chunk.data = std::move(data);
+    chunk.cached = true;
+
+    order_.push_front(hash);
+    chunk.position = order_.begin();
+
+    statistics_.cachedBytes += chunk.size;
+}
+
+void ContractStateStore::evict() {
+    // without database memory is the only storage
+    if (!db_) {
+        return;
+    }
+
+    while (statistics_.cachedBytes > settings_.memoryLimit && !order_.empty()) {
+        Chunk& chunk = chunks_.at(order_.back());
+
+        std::string().swap(chunk.data);
+        chunk.cached = false;
+
+        statistics_.cachedBytes -= chunk.size;
+        order_.pop_back();
+    }
+}
+
+void ContractStateStore::collect(StateId id) {
+    while (true) {
+        auto it = recipes_.find(id);
+
+        if (it == recipes_.end() || it->second.holders != 0 || it->second.dependents != 0) {
+            return;
+        }
+
+        Recipe& recipe = it->second;
+
+        for (const auto& hash : recipe.fresh) {
+            releaseChunk(hash);
+        }
+
+        statistics_.recipeBytes -= recipeBytes(recipe);
+
+        const auto base = recipe.base;
+        recipes_.erase(it);
+
+        if (!base.has_value()) {
+            return;
+        }
+
+        if (auto baseIt = recipes_.find(base.value()); baseIt != recipes_.end()) {
+            --baseIt->second.dependents;
+        }
+
+        id = base.value();
+    }
+}
+
+void ContractStateStore::onDbFailed(const LmdbException& exception) {
+    cswarning() << csfunc() << ", contract states database exception " << exception.what();
+}
+}  // namespace cs
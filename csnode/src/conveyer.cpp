@@ -7,8 +7,10 @@
 
 #include <csnode/configholder.hpp>
 #include <csnode/datastream.hpp>
+#include <csnode/merkletree.hpp>
 #include <csnode/sendcachedata.hpp>
 
+#include <solver/consensus.hpp>
 #include <solver/smartcontracts.hpp>
 
 #include <lib/system/hash.hpp>
@@ -128,14 +130,19 @@ void cs::ConveyerBase::addSeparatePacket(const cs::TransactionsPacket& packet) {
 
 void cs::ConveyerBase::addTransactionsPacket(const cs::TransactionsPacket& packet) {
     cs::TransactionsPacketHash hash = packet.hash();
-    cs::Lock lock(sharedMutex_);
 
-    if (!isPacketAtCache(packet)) {
+    {
+        cs::Lock lock(sharedMutex_);
+
+        if (isPacketAtCache(packet)) {
+            csdebug() << csname() << "Same hash already exists at table: " << hash.toString();
+            return;
+        }
+
         pimpl_->packetsTable.emplace(std::move(hash), packet);
     }
-    else {
-        csdebug() << csname() << "Same hash already exists at table: " << hash.toString();
-    }
+
+    emit packetAdded(packet);
 }
 
 const cs::TransactionsPacketTable& cs::ConveyerBase::transactionsPacketTable() const {
@@ -500,6 +507,7 @@ std::optional<csdb::Pool> cs::ConveyerBase::applyCharacteristic(const cs::PoolMe
     const cs::Bytes& mask = characteristic.mask;
     cs::TransactionsPacket invalidTransactions;
     std::vector<csdb::Transaction> stateTransactions;
+    cs::MerkleTree merkleTree;
 
     bool isStateRejected = false;
 
@@ -557,6 +565,10 @@ std::optional<csdb::Pool> cs::ConveyerBase::applyCharacteristic(const cs::PoolMe
             if (maskIndex < mask.size()) {
                 if (mask[maskIndex] != 0u) {
                     newPool.add_transaction(transaction);
+
+                    if constexpr (Consensus::MerkleRootInBlocks) {
+                        merkleTree.add(transaction);
+                    }
                 }
                 else {
                     invalidTransactions.addTransaction(transaction);
@@ -600,6 +612,11 @@ std::optional<csdb::Pool> cs::ConveyerBase::applyCharacteristic(const cs::PoolMe
     newPool.add_real_trusted(cs::Utils::maskToBits(metaPoolInfo.realTrustedMask));
     newPool.set_previous_hash(metaPoolInfo.previousHash);
 
+    if constexpr (Consensus::MerkleRootInBlocks) {
+        const cs::Hash root = merkleTree.root();
+        newPool.add_user_field(cs::kMerkleRootUserFieldId, std::string(root.begin(), root.end()));
+    }
+
     csmeta(csdetails) << "done";
 
     if (!stateTransactions.empty()) {
@@ -0,0 +1,210 @@
+#include <csnode/merkletree.hpp>
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+#include <csdb/pool.hpp>
+#include <csdb/transaction.hpp>
+
+namespace {
+constexpr cs::Byte kLeafPrefix = 0x00;
+constexpr cs::Byte kNodePrefix = 0x01;
+
+size_t largestPowerOfTwoLessThan(size_t value) {
+    size_t result = 1;
+
+    while ((result << 1) < value) {
+        result <<= 1;
+    }
+
+    return result;
+}
+} // namespace
+
+namespace cs {
+
+void MerkleTree::add(const cs::Hash& leaf) {
+    cs::Hash node = leaf;
+
+    // every set low bit of current count means complete subtree of that height to merge with
+    for (size_t count = count_; (count & 1) != 0; count >>= 1) {
+        node = nodeHash(peaks_.back(), node);
+        peaks_.pop_back();
+    }
+
+    peaks_.push_back(node);
+    ++count_;
+}
+
+void MerkleTree::add(const csdb::Transaction& transaction) {
+    add(leafHash(transaction));
+}
+
+void MerkleTree::clear() {
+    peaks_.clear();
+    count_ = 0;
+}
+
+cs::Hash MerkleTree::root() const {
+    if (peaks_.empty()) {
+        return cscrypto::calculateHash(nullptr, 0);
+    }
+
+    cs::Hash result = peaks_.back();
+
+    for (auto it = std::next(peaks_.rbegin()); it != peaks_.rend(); ++it) {
+        result = nodeHash(*it, result);
+    }
+
+    return result;
+}
+
+cs::Hash MerkleTree::leafHash(const csdb::Transaction& transaction) {
+    cs::Bytes data;
+    data.push_back(kLeafPrefix);
+
+    const auto content = transaction.to_byte_stream_for_sig();
+    data.insert(data.end(), content.begin(), content.end());
+
+    const auto& signature = transaction.signature();
+    data.insert(data.end(), signature.begin(), signature.end());
+
+    return cscrypto::calculateHash(data.data(), data.size());
+}
+
+cs::Hash MerkleTree::leafHash(const cs::Byte* data, size_t size) {
+    cs::Bytes bytes;
+    bytes.reserve(size + 1);
+    bytes.push_back(kLeafPrefix);
+    bytes.insert(bytes.end(), data, data + size);
+
+    return cscrypto::calculateHash(bytes.data(), bytes.size());
+}
+
+cs::Hash MerkleTree::nodeHash(const cs::Hash& left, const cs::Hash& right) {
+    std::array<cs::Byte, 1 + 2 * kHashLength> data;
+    data[0] = kNodePrefix;
+
+    auto iter = std::copy(left.begin(), left.end(), data.begin() + 1);
+    std::copy(right.begin(), right.end(), iter);
+
+    return cscrypto::calculateHash(data.data(), data.size());
+}
+
+std::vector<cs::Hash> MerkleTree::leaves(const csdb::Pool& pool) {
+    const auto& transactions = pool.transactions();
+
+    std::vector<cs::Hash> result;
+    result.reserve(transactions.size());
+
+    for (const auto& transaction : transactions) {
+        result.push_back(leafHash(transaction));
+    }
+
+    return result;
+}
+
+cs::Hash MerkleTree::root(const std::vector<cs::Hash>& leaves) {
+    MerkleTree tree;
+
+    for (const auto& leaf : leaves) {
+        tree.add(leaf);
+    }
+
+    return tree.root();
+}
+
+MerkleTree::Proof MerkleTree::proof(const std::vector<cs::Hash>& leaves, size_t index) {
+    Proof result;
+
+    if (index >= leaves.size()) {
+        return result;
+    }
+
+    result.index = index;
+    result.leavesCount = leaves.size();
+
+    // RFC 6962 PATH(m, D[begin:end]), siblings are collected from the top and reversed at the end
+    size_t begin = 0;
+    size_t end = leaves.size();
+
+    while (end - begin > 1) {
+        const size_t split = begin + largestPowerOfTwoLessThan(end - begin);
+
+        if (index < split) {
+            result.path.push_back(rangeRoot(leaves, split, end));
+            end = split;
+        }
+        else {
+            result.path.push_back(rangeRoot(leaves, begin, split));
+            begin = split;
+        }
+    }
+
+    std::reverse(result.path.begin(), result.path.end());
+    return result;
+}
+
+bool MerkleTree::verify(const cs::Hash& leaf, const Proof& proof, const cs::Hash& root) {
+    if (proof.index >= proof.leavesCount) {
+        return false;
+    }
+
+    // RFC 9162, 2.1.3.2. Verifying an Inclusion Proof
+    uint64_t fn = proof.index;
+    uint64_t sn = proof.leavesCount - 1;
+    cs::Hash result = leaf;
+
+    for (const auto& sibling : proof.path) {
+        if (sn == 0) {
+            return false;
+        }
+
+        if ((fn & 1) != 0 || fn == sn) {
+            result = nodeHash(sibling, result);
+
+            while ((fn & 1) == 0 && fn != 0) {
+                fn >>= 1;
+                sn >>= 1;
+            }
+        }
+        else {
+            result = nodeHash(result, sibling);
+        }
+
+        fn >>= 1;
+        sn >>= 1;
+    }
+
+    return sn == 0 && result == root;
+}
+
+bool MerkleTree::storedRoot(const csdb::Pool& pool, cs::Hash& root) {
+    const auto field = pool.user_field(kMerkleRootUserFieldId);
+
+    if (!field.is_valid() || field.type() != csdb::UserField::String) {
+        return false;
+    }
+
+    const auto value = field.value<std::string>();
+
+    if (value.size() != root.size()) {
+        return false;
+    }
+
+    std::copy(value.begin(), value.end(), root.begin());
+    return true;
+}
+
+cs::Hash MerkleTree::rangeRoot(const std::vector<cs::Hash>& leaves, size_t begin, size_t end) {
+    MerkleTree tree;
+
+    for (size_t i = begin; i < end; ++i) {
+        tree.add(leaves[i]);
+    }
+
+    return tree.root();
+}
+
+} // namespace cs
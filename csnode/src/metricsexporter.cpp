@@ -0,0 +1,138 @@
+#include <csnode/metricsexporter.hpp>
+
+#include <memory>
+#include <string>
+
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <lib/system/logger.hpp>
+#include <lib/system/metrics.hpp>
+
+namespace {
+constexpr size_t kMaxRequestSize = 8 * 1024;
+
+class Session : public std::enable_shared_from_this<Session> {
+public:
+    explicit Session(boost::asio::ip::tcp::socket socket)
+    : socket_(std::move(socket))
+    , request_(kMaxRequestSize) {
+    }
+
+    void start() {
+        auto self = shared_from_this();
+
+        boost::asio::async_read_until(socket_, request_, "\r\n\r\n", [self](const boost::system::error_code& error, size_t) {
+            if (!error) {
+                self->respond();
+            }
+        });
+    }
+
+private:
+    void respond() {
+        std::istream stream(&request_);
+        std::string method;
+        std::string target;
+        stream >> method >> target;
+
+        if (method != "GET") {
+            response_ = makeResponse("405 Method Not Allowed", "text/plain", "Method not allowed\n");
+        }
+        else if (target != "/metrics") {
+            response_ = makeResponse("404 Not Found", "text/plain", "Not found\n");
+        }
+        else {
+            response_ = makeResponse("200 OK", "text/plain; version=0.0.4", cs::metrics::Registry::instance().exposition());
+        }
+
+        auto self = shared_from_this();
+
+        boost::asio::async_write(socket_, boost::asio::buffer(response_), [self](const boost::system::error_code&, size_t) {
+            boost::system::error_code ignored;
+            self->socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+        });
+    }
+
+    static std::string makeResponse(const char* status, const char* contentType, const std::string& body) {
+        std::string result = std::string("HTTP/1.1 ") + status + "\r\n";
+        result += std::string("Content-Type: ") + contentType + "\r\n";
+        result += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+        result += "Connection: close\r\n\r\n";
+        result += body;
+
+        return result;
+    }
+
+    boost::asio::ip::tcp::socket socket_;
+    boost::asio::streambuf request_;
+    std::string response_;
+};
+}  // namespace
+
+cs::MetricsExporter::MetricsExporter(uint16_t port)
+: port_(port)
+, acceptor_(context_) {
+}
+
+cs::MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool cs::MetricsExporter::start() {
+    const boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), port_);
+    boost::system::error_code error;
+
+    acceptor_.open(endpoint.protocol(), error);
+
+    if (!error) {
+        acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), error);
+        acceptor_.bind(endpoint, error);
+    }
+
+    if (!error) {
+        acceptor_.listen(boost::asio::socket_base::max_listen_connections, error);
+    }
+
+    if (error) {
+        cserror() << "Metrics: can not listen port " << port_ << ", " << error.message();
+        return false;
+    }
+
+    port_ = acceptor_.local_endpoint().port();
+    accept();
+
+    thread_ = std::thread([this] {
+        context_.run();
+    });
+
+    cslog() << "Metrics are served on 127.0.0.1:" << port_ << "/metrics";
+    return true;
+}
+
+void cs::MetricsExporter::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    context_.stop();
+    thread_.join();
+
+    boost::system::error_code ignored;
+    acceptor_.close(ignored);
+}
+
+void cs::MetricsExporter::accept() {
+    acceptor_.async_accept([this](const boost::system::error_code& error, boost::asio::ip::tcp::socket socket) {
+        if (error == boost::asio::error::operation_aborted) {
+            return;
+        }
+
+        if (!error) {
+            std::make_shared<Session>(std::move(socket))->start();
+        }
+
+        accept();
+    });
+}
@@ -1,26 +1,30 @@
 #include "csnode/multiwallets.hpp"
 
 bool cs::MultiWallets::contains(const cs::PublicKey& key) const {
-    cs::Lock lock(mutex_);
+    flush();
+    cs::SharedLock lock(mutex_);
 
     auto& byKey = indexes_.get<Tags::ByPublicKey>();
     return byKey.find(key) != byKey.end();
 }
 
 size_t cs::MultiWallets::size() const {
-    cs::Lock lock(mutex_);
+    flush();
+    cs::SharedLock lock(mutex_);
     return indexes_.size();
 }
 
 csdb::Amount cs::MultiWallets::balance(const cs::PublicKey& key) const {
-    cs::Lock lock(mutex_);
+    flush();
+    cs::SharedLock lock(mutex_);
 
     auto& keys = indexes_.get<Tags::ByPublicKey>();
     return keys.find(key)->balance;
 }
 
 uint64_t cs::MultiWallets::transactionsCount(const cs::PublicKey& key) const {
-    cs::Lock lock(mutex_);
+    flush();
+    cs::SharedLock lock(mutex_);
 
     auto& keys = indexes_.get<Tags::ByPublicKey>();
     return keys.find(key)->transactionsCount;
@@ -28,7 +32,8 @@ uint64_t cs::MultiWallets::transactionsCount(const cs::PublicKey& key) const {
 
 #ifdef MONITOR_NODE
 uint64_t cs::MultiWallets::createTime(const cs::PublicKey& key) const {
-    cs::Lock lock(mutex_);
+    flush();
+    cs::SharedLock lock(mutex_);
 
     auto& keys = indexes_.get<Tags::ByPublicKey>();
     return keys.find(key)->createTime;
@@ -47,14 +52,58 @@ void cs::MultiWallets::onDbReadFinished(const std::unordered_map<cs::PublicKey,
 void cs::MultiWallets::onWalletCacheUpdated(const cs::PublicKey& key, const cs::WalletsCache::WalletData& data) {
     auto mapped = map(key, data);
 
+    cs::Lock lock(pendingMutex_);
+    pending_.insert_or_assign(key, std::move(mapped));
+}
+
+void cs::MultiWallets::onWalletsCacheUpdated(const cs::WalletsUpdates& updates) {
+    std::vector<InternalData> mapped;
+    mapped.reserve(updates.size());
+
+    for (const auto& [key, data] : updates) {
+        mapped.push_back(map(key, *data));
+    }
+
+    cs::Lock lock(pendingMutex_);
+
+    for (auto& wallet : mapped) {
+        auto key = wallet.key;
+        pending_.insert_or_assign(key, std::move(wallet));
+    }
+}
+
+void cs::MultiWallets::flush() const {
+    {
+        cs::Lock pendingLock(pendingMutex_);
+
+        if (pending_.empty()) {
+            return;
+        }
+    }
+
+    // updates are taken under exclusive lock, so batches of concurrent readers are applied in order
     cs::Lock lock(mutex_);
-    auto& byKey = indexes_.get<Tags::ByPublicKey>();
+    std::unordered_map<PublicKey, InternalData> pending;
 
-    if (auto iter = byKey.find(key); iter != byKey.end()) {
-        byKey.replace(iter, mapped);
+    {
+        cs::Lock pendingLock(pendingMutex_);
+
+        if (pending_.empty()) {
+            return;
+        }
+
+        pending.swap(pending_);
     }
-    else {
-        indexes_.insert(mapped);
+
+    auto& byKey = indexes_.get<Tags::ByPublicKey>();
+
+    for (auto& [key, mapped] : pending) {
+        if (auto iter = byKey.find(key); iter != byKey.end()) {
+            byKey.replace(iter, mapped);
+        }
+        else {
+            indexes_.insert(std::move(mapped));
+        }
     }
 }
 
@@ -18,8 +18,10 @@
 #include <csnode/roundpackage.hpp>
 #include <csnode/configholder.hpp>
 #include <csnode/eventreport.hpp>
+#include <csnode/metricsexporter.hpp>
 
 #include <lib/system/logger.hpp>
+#include <lib/system/metrics.hpp>
 #include <lib/system/progressbar.hpp>
 #include <lib/system/signals.hpp>
 #include <lib/system/utils.hpp>
@@ -44,7 +46,7 @@ const csdb::Address Node::startAddress_ = csdb::Address::from_string("0000000000
 Node::Node(cs::config::Observer& observer)
 : nodeIdKey_(cs::ConfigHolder::instance().config()->getMyPublicKey())
 , nodeIdPrivate_(cs::ConfigHolder::instance().config()->getMyPrivateKey())
-, blockChain_(genesisAddress_, startAddress_, cs::ConfigHolder::instance().config()->recreateIndex())
+, blockChain_(genesisAddress_, startAddress_, cs::ConfigHolder::instance().config()->recreateIndex(), cs::ConfigHolder::instance().config()->hotWalletsCapacity())
 , ostream_(&packStreamAllocator_, nodeIdKey_)
 , stat_()
 , blockValidator_(std::make_unique<cs::BlockValidator>(*this))
@@ -68,13 +70,13 @@ Node::Node(cs::config::Observer& observer)
         return;
     }
 
-    cs::Connector::connect(&blockChain_.readBlockEvent(), &stat_, &cs::RoundStat::onReadBlock);
-    cs::Connector::connect(&blockChain_.storeBlockEvent, &stat_, &cs::RoundStat::onStoreBlock);
-    cs::Connector::connect(&blockChain_.storeBlockEvent, &executor, &cs::Executor::onBlockStored);
-    cs::Connector::connect(&blockChain_.readBlockEvent(), &executor, &cs::Executor::onReadBlock);
+    cs::Connector::connect<&cs::RoundStat::onReadBlock>(&blockChain_.readBlockEvent(), &stat_);
+    cs::Connector::connect<&cs::RoundStat::onStoreBlock>(&blockChain_.storeBlockEvent, &stat_);
+    cs::Connector::connect<&cs::Executor::onBlockStored>(&blockChain_.storeBlockEvent, &executor);
+    cs::Connector::connect<&cs::Executor::onReadBlock>(&blockChain_.readBlockEvent(), &executor);
     cs::Connector::connect(&transport_->pingReceived, this, &Node::onPingReceived);
     cs::Connector::connect(&transport_->pingReceived, &stat_, &cs::RoundStat::onPingReceived);
-    cs::Connector::connect(&blockChain_.readBlockEvent(), this, &Node::validateBlock);
+    cs::Connector::connect<&Node::validateBlock>(&blockChain_.readBlockEvent(), this);
 
     setupNextMessageBehaviour();
 
@@ -93,6 +95,13 @@ Node::~Node() {
 }
 
 bool Node::init() {
+    if (const auto port = cs::ConfigHolder::instance().config()->getMetricsSettings().port; port != 0) {
+        cs::metrics::setEnabled(true);
+
+        metricsExporter_ = std::make_unique<cs::MetricsExporter>(port);
+        metricsExporter_->start();
+    }
+
 #ifdef NODE_API
     std::cout << "Init API... ";
 
@@ -100,8 +109,8 @@ bool Node::init() {
 
     std::cout << "Done\n";
 
-    cs::Connector::connect(&blockChain_.readBlockEvent(), api_.get(), &csconnector::connector::onReadFromDB);
-    cs::Connector::connect(&blockChain_.storeBlockEvent, api_.get(), &csconnector::connector::onStoreBlock);
+    cs::Connector::connect<&csconnector::connector::onReadFromDB>(&blockChain_.readBlockEvent(), api_.get());
+    cs::Connector::connect<&csconnector::connector::onStoreBlock>(&blockChain_.storeBlockEvent, api_.get());
     cs::Connector::connect(&blockChain_.startReadingBlocksEvent(), api_.get(), &csconnector::connector::onMaxBlocksCount);
 
 #endif  // NODE_API
@@ -179,6 +188,11 @@ void Node::stop() {
 
     observer_.stop();
     cswarning() << "[CONFIG OBSERVER STOPPED]";
+
+    if (metricsExporter_) {
+        metricsExporter_->stop();
+        cswarning() << "[METRICS EXPORTER STOPPED]";
+    }
 }
 
 void Node::initCurrentRP() {
@@ -1213,6 +1227,106 @@ void Node::getStateReply(const uint8_t* data, const std::size_t size, const cs::
     solver_->smart_contracts().net_update_contract_state(abs_addr, contract_data);
 }
 
+void Node::sendTransactionProofRequest(const cs::PublicKey& target, const csdb::TransactionID& id) {
+    csmeta(csdebug) << FormatRef(id.pool_seq(), static_cast<size_t>(id.index())) << " to "
+        << cs::Utils::byteStreamToHex(target.data(), target.size());
+
+    sendDirect(target, MsgTypes::TransactionProofRequest, cs::Conveyer::instance().currentRoundNumber(), id.pool_seq(), id.index());
+}
+
+void Node::getTransactionProofRequest(const uint8_t* data, const std::size_t size, const cs::RoundNumber rNum, const cs::PublicKey& sender) {
+    csunused(rNum);
+
+    istream_.init(data, size);
+    cs::Sequence sequence = 0;
+    cs::Sequence index = 0;
+    istream_ >> sequence >> index;
+
+    if (!istream_.good() || !istream_.end()) {
+        cserror() << "NODE> Bad TransactionProofRequest packet format";
+        return;
+    }
+
+    csmeta(csdebug) << FormatRef(sequence, static_cast<size_t>(index)) << " from "
+        << cs::Utils::byteStreamToHex(sender.data(), sender.size());
+
+    const auto round = cs::Conveyer::instance().currentRoundNumber();
+
+    if (round != proofRequestsRound_) {
+        proofRequests_.clear();
+        proofRequestsRound_ = round;
+    }
+
+    if (++proofRequests_[sender] > maxProofRequestsPerRound_) {
+        csdebug() << "NODE> Too many TransactionProofRequests in round from "
+            << cs::Utils::byteStreamToHex(sender.data(), sender.size()) << ", ignore";
+        return;
+    }
+
+    cs::Hash leaf;
+    cs::Hash root;
+    cs::MerkleTree::Proof proof;
+
+    if (!blockChain_.getTransactionProof(csdb::TransactionID(sequence, index), leaf, proof, root)) {
+        csdebug() << "NODE> Can not build proof for " << FormatRef(sequence, static_cast<size_t>(index));
+        return;
+    }
+
+    cs::Bytes proofBytes;
+    cs::DataStream stream(proofBytes);
+    stream << proof.leavesCount << proof.path;
+
+    sendDirect(sender, MsgTypes::TransactionProofReply, cs::Conveyer::instance().currentRoundNumber(), sequence, index, leaf, root, proofBytes);
+}
+
+void Node::getTransactionProofReply(const uint8_t* data, const std::size_t size, const cs::RoundNumber rNum, const cs::PublicKey& sender) {
+    csunused(rNum);
+
+    istream_.init(data, size);
+    cs::Sequence sequence = 0;
+    cs::Sequence index = 0;
+    cs::Hash leaf;
+    cs::Hash root;
+    cs::Bytes proofBytes;
+    istream_ >> sequence >> index >> leaf >> root >> proofBytes;
+
+    if (!istream_.good() || !istream_.end()) {
+        cserror() << "NODE> Bad TransactionProofReply packet format";
+        return;
+    }
+
+    cs::MerkleTree::Proof proof;
+    proof.index = index;
+
+    cs::DataStream stream(proofBytes.data(), proofBytes.size());
+    stream >> proof.leavesCount >> proof.path;
+
+    if (!stream.isValid()) {
+        cserror() << "NODE> Bad TransactionProofReply proof format";
+        return;
+    }
+
+    // root and leaf of peer are trusted only if they are the same as of own block
+    cs::Hash trustedLeaf;
+    cs::Hash trustedRoot;
+    cs::MerkleTree::Proof ownProof;
+
+    if (!blockChain_.getTransactionProof(csdb::TransactionID(sequence, index), trustedLeaf, ownProof, trustedRoot)) {
+        csmeta(csdebug) << FormatRef(sequence, static_cast<size_t>(index)) << " from "
+            << cs::Utils::byteStreamToHex(sender.data(), sender.size()) << ", proof is not verifiable, no own block";
+
+        emit gotTransactionProof(csdb::TransactionID(sequence, index), leaf, root, false);
+        return;
+    }
+
+    const bool isValid = leaf == trustedLeaf && root == trustedRoot && cs::MerkleTree::verify(leaf, proof, root);
+
+    csmeta(csdebug) << FormatRef(sequence, static_cast<size_t>(index)) << " from "
+        << cs::Utils::byteStreamToHex(sender.data(), sender.size()) << ", proof is " << (isValid ? "valid" : "invalid");
+
+    emit gotTransactionProof(csdb::TransactionID(sequence, index), leaf, root, isValid);
+}
+
 cs::ConfidantsKeys Node::retriveSmartConfidants(const cs::Sequence startSmartRoundNumber) const {
     csmeta(csdebug);
 
@@ -1576,6 +1690,8 @@ Node::MessageActions Node::chooseMessageAction(const cs::RoundNumber rNum, const
         case MsgTypes::StateReply:
         case MsgTypes::BlockAlarm:
         case MsgTypes::EventReport:
+        case MsgTypes::TransactionProofRequest:
+        case MsgTypes::TransactionProofReply:
             return MessageActions::Process;
 
         default:
@@ -3649,6 +3765,7 @@ void Node::validateBlock(csdb::Pool block, bool* shouldStop) {
     }
     if (!blockValidator_->validateBlock(block,
         cs::BlockValidator::ValidationLevel::hashIntergrity
+            | cs::BlockValidator::ValidationLevel::merkleRoot
             /*| cs::BlockValidator::ValidationLevel::smartStates*/
             /*| cs::BlockValidator::ValidationLevel::accountBalance*/,
         cs::BlockValidator::SeverityLevel::onlyFatalErrors)) {
@@ -0,0 +1,274 @@
+#include <csnode/publishedwallets.hpp>
+
+#include <cstring>
+#include <limits>
+#include <random>
+
+namespace {
+constexpr size_t kMinCapacity = 1024;
+constexpr uint64_t kNoIndex = std::numeric_limits<uint64_t>::max();
+}  // namespace
+
+namespace cs {
+
+PublishedWallets::Table::Table(size_t capacity)
+: mask(capacity - 1)
+, cells(new std::atomic<Record*>[capacity]) {
+    for (size_t i = 0; i < capacity; ++i) {
+        cells[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+PublishedWallets::PublishedWallets()
+: current_(std::make_unique<Table>(kMinCapacity))
+, table_(current_.get())
+, seed_((static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}()) {
+}
+
+PublishedWallets::~PublishedWallets() = default;
+
+void PublishedWallets::publish(const PublicKey& key, const Wallet& wallet) {
+    reclaim();
+
+    const auto& lastTransaction = wallet.lastTransaction;
+    const bool hasLastTransaction = lastTransaction.is_valid();
+
+    const std::array<uint64_t, WordsCount> words{
+        1,
+        static_cast<uint64_t>(static_cast<int64_t>(wallet.balance.integral())),
+        wallet.balance.fraction(),
+        wallet.transactionsCount,
+        static_cast<uint64_t>(wallet.lastInnerId),
+        hasLastTransaction ? lastTransaction.pool_seq() : kNoIndex,
+        hasLastTransaction ? lastTransaction.index() : kNoIndex
+    };
+
+    const auto keyWords = toWords(key);
+
+    if (auto record = lookup(keyWords, *current_)) {
+        write(*record, keyWords, words);
+        return;
+    }
+
+    Record* record = nullptr;
+
+    if (free_.empty()) {
+        record = &records_.emplace_back();
+    }
+    else {
+        record = free_.back();
+        free_.pop_back();
+    }
+
+    // late readers of erased wallet may still hold record, they see key changed
+    write(*record, keyWords, words);
+
+    // load factor of used cells is kept below 1/2, probes of readers are short
+    if ((used_ + 1) * 2 > current_->mask + 1) {
+        rebuild();
+    }
+    else {
+        insert(*record, keyWords, *current_);
+    }
+
+    size_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PublishedWallets::erase(const PublicKey& key) {
+    reclaim();
+
+    const auto keyWords = toWords(key);
+    size_t slot = 0;
+    auto record = lookup(keyWords, *current_, &slot);
+
+    if (record == nullptr) {
+        return;
+    }
+
+    std::array<uint64_t, WordsCount> words{};
+    write(*record, keyWords, words);
+
+    // cell is not emptied, probes of other keys may pass it
+    current_->cells[slot].store(&removed_, std::memory_order_release);
+    free_.push_back(record);
+
+    size_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool PublishedWallets::find(const PublicKey& key, Wallet& wallet) const {
+    // writer frees replaced tables only when no reader is inside
+    readers_.fetch_add(1);
+
+    const auto keyWords = toWords(key);
+    KeyWords recordKey;
+    std::array<uint64_t, WordsCount> words{};
+
+    do {
+        auto record = lookup(keyWords, *table_.load());
+
+        if (record == nullptr) {
+            words[Exists] = 0;
+            break;
+        }
+
+        uint64_t version = 0;
+
+        do {
+            version = record->version.load(std::memory_order_acquire);
+
+            if (version & 1) {
+                continue;
+            }
+
+            for (size_t i = 0; i < kKeyWords; ++i) {
+                recordKey[i] = record->key[i].load(std::memory_order_relaxed);
+            }
+
+            for (size_t i = 0; i < WordsCount; ++i) {
+                words[i] = record->words[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((version & 1) || record->version.load(std::memory_order_relaxed) != version);
+
+        // record was erased and reused by other wallet, table is searched again
+    } while (recordKey != keyWords);
+
+    readers_.fetch_sub(1);
+
+    if (words[Exists] == 0) {
+        return false;
+    }
+
+    wallet.balance = csdb::Amount(static_cast<int32_t>(static_cast<int64_t>(words[Integral])), words[Fraction]);
+    wallet.transactionsCount = words[TransactionsCount];
+    wallet.lastInnerId = static_cast<int64_t>(words[LastInnerId]);
+    wallet.lastTransaction = words[LastSequence] == kNoIndex ? csdb::TransactionID() : csdb::TransactionID(words[LastSequence], words[LastIndex]);
+
+    return true;
+}
+
+PublishedWallets::KeyWords PublishedWallets::toWords(const PublicKey& key) {
+    KeyWords words;
+    std::memcpy(words.data(), key.data(), sizeof(words));
+    return words;
+}
+
+size_t PublishedWallets::bucket(const KeyWords& key, const Table& table) const {
+    // public keys are uniform, seed keeps crafted ones from collecting in one bucket
+    uint64_t hash = key[0];
+
+    hash ^= seed_;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    hash ^= hash >> 31;
+
+    return static_cast<size_t>(hash) & table.mask;
+}
+
+PublishedWallets::Record* PublishedWallets::lookup(const KeyWords& key, const Table& table, size_t* slot) const {
+    for (size_t i = bucket(key, table);; i = (i + 1) & table.mask) {
+        auto record = table.cells[i].load(std::memory_order_acquire);
+
+        if (record == nullptr) {
+            return nullptr;
+        }
+
+        if (record == &removed_) {
+            continue;
+        }
+
+        // reader checks key once more under record version
+        bool isEqual = true;
+
+        for (size_t word = 0; word < kKeyWords && isEqual; ++word) {
+            isEqual = record->key[word].load(std::memory_order_relaxed) == key[word];
+        }
+
+        if (isEqual) {
+            if (slot != nullptr) {
+                *slot = i;
+            }
+
+            return record;
+        }
+    }
+}
+
+void PublishedWallets::write(Record& record, const KeyWords& key, const std::array<uint64_t, WordsCount>& words) {
+    const auto version = record.version.load(std::memory_order_relaxed);
+
+    record.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < kKeyWords; ++i) {
+        record.key[i].store(key[i], std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < WordsCount; ++i) {
+        record.words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    record.version.store(version + 2, std::memory_order_release);
+}
+
+void PublishedWallets::insert(Record& record, const KeyWords& key, Table& table) {
+    size_t slot = bucket(key, table);
+
+    for (auto cell = table.cells[slot].load(std::memory_order_relaxed); cell != nullptr && cell != &removed_;
+         cell = table.cells[slot].load(std::memory_order_relaxed)) {
+        slot = (slot + 1) & table.mask;
+    }
+
+    if (table.cells[slot].load(std::memory_order_relaxed) == nullptr) {
+        ++used_;
+    }
+
+    // record is complete before readers can see it
+    table.cells[slot].store(&record, std::memory_order_release);
+}
+
+void PublishedWallets::rebuild() {
+    size_t live = 0;
+
+    for (const auto& record : records_) {
+        live += record.words[Exists].load(std::memory_order_relaxed) != 0;
+    }
+
+    // table full of removed cells is rebuilt in place, full of records is doubled
+    size_t capacity = current_->mask + 1;
+
+    while ((live + 1) * 4 > capacity) {
+        capacity *= 2;
+    }
+
+    auto table = std::make_unique<Table>(capacity);
+    used_ = 0;
+
+    for (auto& record : records_) {
+        if (record.words[Exists].load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+
+        KeyWords key;
+
+        for (size_t i = 0; i < kKeyWords; ++i) {
+            key[i] = record.key[i].load(std::memory_order_relaxed);
+        }
+
+        insert(record, key, *table);
+    }
+
+    table_.store(table.get());
+    retired_.push_back(std::move(current_));
+    current_ = std::move(table);
+}
+
+void PublishedWallets::reclaim() {
+    // reader increments counter before it takes table, so zero after replace means no one walks old tables
+    if (!retired_.empty() && readers_.load() == 0) {
+        retired_.clear();
+    }
+}
+
+}  // namespace cs
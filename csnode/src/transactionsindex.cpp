@@ -17,6 +17,9 @@ namespace {
 constexpr const char* kDbPath = "/indexdb";
 constexpr const char* kLastIndexedPath =  "/last_indexed";
 
+// blocks read from db are indexed in one transaction per batch
+constexpr size_t kBlocksInReplayBatch = 1000;
+
 auto getTrxIndexKey(const cs::PublicKey& _pubKey, cs::Sequence _seq) {
     cs::Bytes ret(_pubKey.begin(), _pubKey.end());
     ret.resize(ret.size() + sizeof(_seq));
@@ -51,11 +54,21 @@ void TransactionsIndex::onReadFromDb(const csdb::Pool& _pool) {
     }
 
     if (recreate_ || lastIndexedPool_ < _pool.sequence()) {
+        if (!db_->isBatchOpened()) {
+            db_->beginBatch();
+        }
+
         updateFromNextBlock(_pool);
+
+        if (++replayedBlocks_ % kBlocksInReplayBatch == 0) {
+            commitReplayBatch();
+        }
     }
 }
 
 void TransactionsIndex::onDbReadFinished() {
+    commitReplayBatch();
+
     if (recreate_) {
         recreate_ = false;
         lapoos_.clear();
@@ -93,9 +106,13 @@ void TransactionsIndex::onRemoveBlock(const csdb::Pool& _pool) {
         }
     };
 
-    for (const auto& t : _pool.transactions()) {
-        lbd(t.source(), lastIndexedPool_);
-        lbd(t.target(), lastIndexedPool_);
+    {
+        Lmdb::Batch batch(*db_);
+
+        for (const auto& t : _pool.transactions()) {
+            lbd(t.source(), lastIndexedPool_);
+            lbd(t.target(), lastIndexedPool_);
+        }
     }
     --lastIndexedPool_;
     updateLastIndexed();
@@ -106,7 +123,12 @@ void TransactionsIndex::onRemoveBlock(const csdb::Pool& _pool) {
 }
 
 void TransactionsIndex::update(const csdb::Pool& _pool) {
-    updateFromNextBlock(_pool);
+    {
+        Lmdb::Batch batch(*db_);
+        updateFromNextBlock(_pool);
+    }
+
+    updateLastIndexed();
 }
 
 void TransactionsIndex::invalidate() {
@@ -160,8 +182,15 @@ void TransactionsIndex::updateFromNextBlock(const csdb::Pool& _pool) {
         lbd(tr.target());
     }
 
+    // stored by caller after batch is commited
     lastIndexedPool_ = _pool.sequence();
-    updateLastIndexed();
+}
+
+void TransactionsIndex::commitReplayBatch() {
+    if (db_->isBatchOpened()) {
+        db_->commitBatch();
+        updateLastIndexed();
+    }
 }
 
 void TransactionsIndex::setPrevTransBlock(const PublicKey& _pubKey, cs::Sequence _curr, cs::Sequence _prev) {
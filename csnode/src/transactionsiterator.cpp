@@ -12,6 +12,23 @@ TransactionsIterator::TransactionsIterator(const BlockChain& bc,
     setFromTransId(bc_.getLastTransaction(addr));
 }
 
+TransactionsIterator::TransactionsIterator(const BlockChain& bc, const csdb::Address& addr, ReadAhead readAhead)
+    : TransactionsIterator(bc, addr) {
+    if (!lapoo_.is_valid()) {
+        return;
+    }
+
+    const BlockChain& blockChain = bc_;
+    const csdb::Address address = addr_;
+
+    prefetcher_ = std::make_unique<BlocksPrefetcher>(
+        [&blockChain, address](Sequence sequence) { return blockChain.getPreviousPoolSeq(address, sequence); },
+        [&blockChain](Sequence sequence) { return blockChain.loadBlock(sequence); },
+        readAhead.window);
+
+    prefetcher_->reset(lapoo_.sequence());
+}
+
 TransactionsIterator::TransactionsIterator(const BlockChain& bc, const csdb::Address& addr, const csdb::Pool& pool)
     : bc_(bc),
       addr_(bc_.getAddressByType(addr, BlockChain::AddressType::PublicKey)),
@@ -26,6 +43,8 @@ TransactionsIterator::TransactionsIterator(const BlockChain& bc, const csdb::Add
     }
 }
 
+TransactionsIterator::~TransactionsIterator() = default;
+
 
 void TransactionsIterator::setFromTransId(const csdb::TransactionID& lTrans) {
     if (lTrans.is_valid()) {
@@ -38,6 +57,14 @@ void TransactionsIterator::setFromTransId(const csdb::TransactionID& lTrans) {
     }
 }
 
+csdb::Pool TransactionsIterator::loadPreviousPool() {
+    if (prefetcher_) {
+        return prefetcher_->next();
+    }
+
+    return bc_.loadBlock(bc_.getPreviousPoolSeq(addr_, lapoo_.sequence()));
+}
+
 bool TransactionsIterator::isValid() const {
     return lapoo_.is_valid();
 }
@@ -53,8 +80,7 @@ void TransactionsIterator::next() {
     if (it_ == lapoo_.transactions().rend()) {
     // no more transactions in lapoo_ with addr_
     // load previous pool from blockchain
-        auto ps = bc_.getPreviousPoolSeq(addr_, lapoo_.sequence());
-        lapoo_ = bc_.loadBlock(ps);
+        lapoo_ = loadPreviousPool();
 
         while (lapoo_.is_valid() && !lapoo_.transactions_count()) {
         // case of inconsistent index.db
@@ -62,8 +88,7 @@ void TransactionsIterator::next() {
                       << "Empty pool in transactions index detected: "
                       << "sequence is " << lapoo_.sequence()
                       << " , address is " << addr_.to_string();
-            ps = bc_.getPreviousPoolSeq(addr_, lapoo_.sequence());
-            lapoo_ = bc_.loadBlock(ps);
+            lapoo_ = loadPreviousPool();
         }
 
         if (lapoo_.is_valid()) {
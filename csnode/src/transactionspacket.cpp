@@ -49,8 +49,12 @@ TransactionsPacketHash TransactionsPacketHash::fromBinary(cs::Bytes&& data) {
 }
 
 TransactionsPacketHash TransactionsPacketHash::calcFromData(const cs::Bytes& data) {
+    return calcFromData(data.data(), data.size());
+}
+
+TransactionsPacketHash TransactionsPacketHash::calcFromData(const cs::Byte* data, size_t size) {
     TransactionsPacketHash resHash;
-    resHash.bytes_ = ::csdb::priv::crypto::calc_hash(data);
+    resHash.bytes_ = ::csdb::priv::crypto::calc_hash(data, size);
     return resHash;
 }
 
@@ -134,16 +138,24 @@ TransactionsPacket& TransactionsPacket::operator=(const TransactionsPacket& pack
 //
 
 cs::Bytes TransactionsPacket::toBinary(Serialization options) const noexcept {
-    ::csdb::priv::obstream os;
-    put(os, options);
-    return os.buffer();
+    cs::Bytes result;
+    toBinary(result, options);
+    return result;
+}
+
+void TransactionsPacket::toBinary(cs::Bytes& buffer, Serialization options) const noexcept {
+    buffer.clear();
+    ::csdb::priv::serialize(buffer, [this, options](::csdb::priv::obstream& os) { put(os, options); });
 }
 
 bool TransactionsPacket::makeHash() {
     bool isEmpty = isHashEmpty();
 
     if (isEmpty) {
-        hash_ = TransactionsPacketHash::calcFromData(toBinary(Serialization::Transactions));
+        // packets are hashed at conveyer rate, so serialization buffer lives as long as thread
+        thread_local cs::Bytes buffer;
+        toBinary(buffer, Serialization::Transactions);
+        hash_ = TransactionsPacketHash::calcFromData(buffer.data(), buffer.size());
     }
 
     return isEmpty;
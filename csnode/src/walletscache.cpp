@@ -1,10 +1,16 @@
 #include <algorithm>
+#include <set>
+#include <string_view>
 
 #include <blockchain.hpp>
 #include <csdb/amount_commission.hpp>
+#include <csdb/internal/utils.hpp>
+#include <csnode/datastream.hpp>
+#include <csnode/transactionsiterator.hpp>
 #include <csnode/walletscache.hpp>
 #include <csnode/walletsids.hpp>
 #include <lib/system/logger.hpp>
+#include <lmdb.hpp>
 #include <solver/smartcontracts.hpp>
 
 namespace {
@@ -22,11 +28,371 @@ inline int32_t getRealTrustedNum(const std::vector<uint8_t>& realTrusted) {
 }
 
 const char* kLogPrefix = "WalletsCache: ";
+
+// flags of packed wallet
+const uint8_t kHasLastTransaction = 1;
+const uint8_t kHasTail = 2;
+const uint8_t kFullTail = 4;
+
+using TailBits = std::bitset<cs::TransactionsTail::BitSize>;
+const size_t kTailWords = cs::TransactionsTail::BitSize / 64;
+
+// ordinary tail has all inner ids below the greatest one, it is packed as count of them
+size_t tailRun(const TailBits& bits) {
+    size_t run = 0;
+
+    while (run < bits.size() && bits.test(run)) {
+        ++run;
+    }
+
+    return run;
+}
+
+cs::Sequence lastActivity(const cs::WalletsCache::WalletData& wallet) {
+    return wallet.lastTransaction_.is_valid() ? wallet.lastTransaction_.pool_seq() : 0;
+}
 }  // namespace
 
 namespace cs {
 
-WalletsCache::WalletsCache(WalletsIds& walletsIds) : walletsIds_(walletsIds) {}
+WalletsCache::WalletsCache(WalletsIds& walletsIds)
+: WalletsCache(walletsIds, Settings{}) {
+}
+
+WalletsCache::WalletsCache(WalletsIds& walletsIds, const Settings& settings)
+: walletsIds_(walletsIds)
+, settings_(settings) {
+    if (settings_.coldPath.empty() || settings_.hotCapacity == 0) {
+        return;
+    }
+
+    // wallets are restored from blocks on start, so database is always new
+    csdb::internal::path_remove(settings_.coldPath);
+
+    cold_ = std::make_unique<Lmdb>(settings_.coldPath);
+    Connector::connect(&cold_->failed, this, &WalletsCache::onColdFailed);
+
+    cold_->setMapSize(Lmdb::Default1GbMapSize);
+    cold_->setIncreaseSize(Lmdb::Default1GbMapSize);
+    cold_->open();
+}
+
+WalletsCache::~WalletsCache() {
+    if (cold_ && cold_->isOpen()) {
+        cold_->close();
+    }
+}
+
+cs::Bytes WalletsCache::pack(const WalletData& wallet) {
+    cs::Bytes bytes;
+    cs::DataStream stream(bytes);
+
+    const auto& heap = wallet.trxTail_.heap();
+    const auto run = tailRun(heap.bits());
+    const bool isFullTail = heap.bits().count() != run;
+
+    uint8_t flags = 0;
+    flags |= wallet.lastTransaction_.is_valid() ? kHasLastTransaction : 0;
+    flags |= heap.empty() ? 0 : kHasTail;
+    flags |= isFullTail ? kFullTail : 0;
+
+    stream << flags << wallet.balance_.integral() << wallet.balance_.fraction() << wallet.transNum_;
+
+    if (flags & kHasLastTransaction) {
+        stream << wallet.lastTransaction_.pool_seq() << wallet.lastTransaction_.index();
+    }
+
+    if (flags & kHasTail) {
+        stream << heap.greatest();
+
+        if (isFullTail) {
+            for (size_t word = 0; word < kTailWords; ++word) {
+                uint64_t value = 0;
+
+                for (size_t bit = 0; bit < 64; ++bit) {
+                    value |= static_cast<uint64_t>(heap.bits().test(word * 64 + bit)) << bit;
+                }
+
+                stream << value;
+            }
+        }
+        else {
+            stream << static_cast<uint16_t>(run);
+        }
+    }
+
+#ifdef MONITOR_NODE
+    stream << wallet.createTime_;
+#endif
+
+    return bytes;
+}
+
+bool WalletsCache::unpack(const char* data, size_t size, WalletData& wallet) {
+    cs::DataStream stream(data, size);
+
+    uint8_t flags = 0;
+    int32_t integral = 0;
+    uint64_t fraction = 0;
+
+    stream >> flags >> integral >> fraction >> wallet.transNum_;
+    wallet.balance_ = csdb::Amount(integral, fraction);
+
+    wallet.lastTransaction_ = csdb::TransactionID();
+
+    if (flags & kHasLastTransaction) {
+        cs::Sequence sequence = 0;
+        cs::Sequence index = 0;
+
+        stream >> sequence >> index;
+        wallet.lastTransaction_ = csdb::TransactionID(sequence, index);
+    }
+
+    wallet.trxTail_ = TransactionsTail{};
+
+    if (flags & kHasTail) {
+        TransactionsTail::TransactionId greatest = 0;
+        TailBits bits;
+
+        stream >> greatest;
+
+        if (flags & kFullTail) {
+            for (size_t word = 0; word < kTailWords; ++word) {
+                uint64_t value = 0;
+                stream >> value;
+
+                bits |= TailBits(value) << (word * 64);
+            }
+        }
+        else {
+            uint16_t run = 0;
+            stream >> run;
+
+            if (run > bits.size()) {
+                return false;
+            }
+
+            bits.set();
+            bits >>= bits.size() - run;
+        }
+
+        TransactionsTail::Heap heap;
+        heap.assign(greatest, bits);
+        wallet.trxTail_.restore(heap);
+    }
+
+#ifdef MONITOR_NODE
+    stream >> wallet.createTime_;
+#endif
+
+    return stream.isValid();
+}
+
+const WalletsCache::WalletData* WalletsCache::findCold(const PublicKey& key) const {
+    if (!cold_ || coldCount_ == 0) {
+        return nullptr;
+    }
+
+    const auto record = cold_->value<cs::Bytes>(key);
+
+    if (record.empty()) {
+        return nullptr;
+    }
+
+    // readers copy wallet at once, so one buffer per thread is enough
+    thread_local WalletData wallet;
+
+    if (!unpack(reinterpret_cast<const char*>(record.data()), record.size(), wallet)) {
+        cserror() << kLogPrefix << "cold wallet " << EncodeBase58(cs::Bytes(key.begin(), key.end())) << " is damaged";
+        return nullptr;
+    }
+
+    return &wallet;
+}
+
+WalletsCache::WalletData* WalletsCache::promote(const PublicKey& key) {
+    if (!cold_ || coldCount_ == 0) {
+        return nullptr;
+    }
+
+    const auto record = cold_->value<cs::Bytes>(key);
+
+    if (record.empty()) {
+        return nullptr;
+    }
+
+    WalletData wallet;
+
+    if (!unpack(reinterpret_cast<const char*>(record.data()), record.size(), wallet)) {
+        cserror() << kLogPrefix << "cold wallet " << EncodeBase58(cs::Bytes(key.begin(), key.end())) << " is damaged";
+        return nullptr;
+    }
+
+    cold_->remove(key);
+    --coldCount_;
+
+    return &(wallets_[key] = std::move(wallet));
+}
+
+void WalletsCache::evictDormant() {
+    if (!cold_ || coldFailed_ || wallets_.size() <= settings_.hotCapacity) {
+        return;
+    }
+
+    // batch down to 90% of capacity, so hot wallets are sorted rarely
+    const size_t count = wallets_.size() - (settings_.hotCapacity - settings_.hotCapacity / 10);
+
+    std::vector<std::pair<cs::Sequence, const PublicKey*>> activity;
+    activity.reserve(wallets_.size());
+
+    for (const auto& [key, wallet] : wallets_) {
+        activity.emplace_back(lastActivity(wallet), &key);
+    }
+
+    std::nth_element(activity.begin(), activity.begin() + static_cast<std::ptrdiff_t>(count - 1), activity.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    {
+        Lmdb::Batch batch(*cold_);
+
+        // failed write drops batch transaction, the next insert would open and commit a new one
+        for (size_t i = 0; i < count && !coldFailed_; ++i) {
+            cold_->insert(*activity[i].second, pack(wallets_.find(*activity[i].second)->second));
+        }
+    }
+
+    // wallets stay in memory if they are not written
+    if (coldFailed_) {
+        cserror() << kLogPrefix << "cold store failed, all wallets are kept in memory from now";
+        return;
+    }
+
+    // readers miss wallet in published ones after it is written to store, so they find it there
+    for (size_t i = 0; i < count; ++i) {
+        // key is copied as it lives in erased node
+        const PublicKey key = *activity[i].second;
+        wallets_.erase(key);
+        published_.erase(key);
+    }
+
+    coldCount_ += count;
+
+    csdebug() << kLogPrefix << count << " dormant wallets moved to cold store, " << wallets_.size() << " in memory, " << coldCount_ << " in store";
+}
+
+void WalletsCache::iterateOverColdWallets(const std::function<bool(const PublicKey&, const WalletData&)>& func) const {
+    if (!cold_ || coldCount_ == 0) {
+        return;
+    }
+
+    WalletData wallet;
+
+    cold_->forEach<PublicKey, std::string_view>([&](const PublicKey& key, std::string_view record) {
+        if (!unpack(record.data(), record.size(), wallet)) {
+            cserror() << kLogPrefix << "cold wallet " << EncodeBase58(cs::Bytes(key.begin(), key.end())) << " is damaged";
+            return true;
+        }
+
+        return func(key, wallet);
+    });
+}
+
+void WalletsCache::erase(const PublicKey& key) {
+    if (wallets_.erase(key) == 0 && promote(key) != nullptr) {
+        wallets_.erase(key);
+    }
+}
+
+void WalletsCache::beginVersion(cs::Sequence sequence) {
+    if (!isDbRead_) {
+        return;
+    }
+
+    if (journal_.size() == kJournalDepth) {
+        journal_.pop_front();
+    }
+
+    journal_.push_back(Version{sequence, {}});
+    version_ = &journal_.back();
+}
+
+void WalletsCache::endVersion() {
+    version_ = nullptr;
+}
+
+void WalletsCache::remember(const PublicKey& key, const WalletData* wallet) {
+    // only the first change of wallet by block is copied
+    auto [it, inserted] = version_->before.try_emplace(key);
+
+    if (inserted && wallet != nullptr) {
+        it->second = *wallet;
+    }
+}
+
+void WalletsCache::touch(const PublicKey& key, const WalletData* wallet) {
+    if (version_ != nullptr) {
+        remember(key, wallet);
+    }
+
+    touched_.push_back(key);
+}
+
+PublishedWallets::Wallet WalletsCache::toPublished(const WalletData& wallet) {
+    const auto& tail = wallet.trxTail_;
+    return PublishedWallets::Wallet{wallet.balance_, wallet.transNum_, tail.empty() ? 0 : tail.getLastTransactionId(), wallet.lastTransaction_};
+}
+
+void WalletsCache::publish(const PublicKey& key, const WalletData& wallet) {
+    published_.publish(key, toPublished(wallet));
+}
+
+void WalletsCache::publishTouched() {
+    // touched wallets are in memory until eviction after block, cold ones are read from store
+    for (const auto& key : touched_) {
+        if (auto it = wallets_.find(key); it != wallets_.end()) {
+            publish(key, it->second);
+        }
+        else {
+            published_.erase(key);
+        }
+    }
+
+    touched_.clear();
+}
+
+std::optional<std::vector<PublicKey>> WalletsCache::rollback(cs::Sequence sequence) {
+    // block was applied before journal or journal is behind
+    if (journal_.empty() || journal_.back().sequence != sequence) {
+        journal_.clear();
+        return std::nullopt;
+    }
+
+    std::vector<PublicKey> restored;
+
+    for (auto& [key, wallet] : journal_.back().before) {
+        touched_.push_back(key);
+
+        if (!wallet.has_value()) {
+            erase(key);
+            continue;
+        }
+
+        if (wallets_.find(key) == wallets_.end()) {
+            promote(key);
+        }
+
+        wallets_[key] = std::move(wallet.value());
+        restored.push_back(key);
+    }
+
+    journal_.pop_back();
+    return restored;
+}
+
+void WalletsCache::onColdFailed(const LmdbException& exception) {
+    coldFailed_ = true;
+    cswarning() << csfunc() << ", cold wallets database exception " << exception.what();
+}
 
 std::unique_ptr<WalletsCache::Updater> WalletsCache::createUpdater() {
     return std::make_unique<Updater>(*this);
@@ -34,6 +400,30 @@ std::unique_ptr<WalletsCache::Updater> WalletsCache::createUpdater() {
 
 WalletsCache::Updater::Updater(WalletsCache& data) : data_(data) {}
 
+void WalletsCache::Updater::onStopReadingFromDB() const {
+    data_.isDbRead_ = true;
+
+    for (const auto& [key, wallet] : data_.wallets_) {
+        data_.publish(key, wallet);
+    }
+
+#ifdef MONITOR_NODE
+    // subscribers expect all wallets, dormant ones are read back for them
+    if (data_.coldCount_ != 0) {
+        auto wallets = data_.wallets_;
+
+        data_.iterateOverColdWallets([&](const PublicKey& key, const WalletData& wallet) {
+            wallets.emplace(key, wallet);
+            return true;
+        });
+
+        emit updateFromDBFinishedEvent(wallets);
+        return;
+    }
+#endif
+    emit updateFromDBFinishedEvent(data_.wallets_);
+}
+
 PublicKey WalletsCache::Updater::toPublicKey(const csdb::Address& addr) const {
     csdb::Address res;
     if (addr.is_public_key() || !data_.walletsIds_.normal().findaddr(addr.wallet_id(), res)) {
@@ -46,17 +436,25 @@ void WalletsCache::Updater::loadNextBlock(csdb::Pool& pool,
                                           const cs::ConfidantsKeys& confidants,
                                           const BlockChain& blockchain,
                                           bool inverse /* = false */) {
+    if (!inverse) {
+        data_.beginVersion(pool.sequence());
+    }
+
     auto& transactions = pool.transactions();
-    csdb::Amount totalAmountOfCountedFee = 0;
+    feeBatch_.clear();
+    feeBatch_.reserve(0, transactions.size());
 
     for (auto itTrx = transactions.begin(); itTrx != transactions.end(); ++itTrx) {
         itTrx->set_time(pool.get_time());
-        totalAmountOfCountedFee += load(*itTrx, blockchain, inverse);
+        feeBatch_.addFee(csdb::Amount(load(*itTrx, blockchain, inverse)));
         if (SmartContracts::is_new_state(*itTrx)) {
             fundConfidantsWalletsWithExecFee(*itTrx, blockchain, inverse);
         }
     }
 
+    feeBatch_.apply();
+    const csdb::Amount& totalAmountOfCountedFee = feeBatch_.feeTotal();
+
     if (totalAmountOfCountedFee > csdb::Amount(0)) {
         fundConfidantsWalletsWithFee(totalAmountOfCountedFee, confidants,
                                      cs::Utils::bitsToMask(pool.numberTrusted(),
@@ -86,6 +484,102 @@ void WalletsCache::Updater::loadNextBlock(csdb::Pool& pool,
     auto timeStamp = atoll(pool.user_field(0).value<std::string>().c_str());
     setWalletTime(wrWall, timeStamp);
 #endif
+
+    if (!inverse) {
+        data_.endVersion();
+    }
+    else {
+#ifdef MONITOR_NODE
+        // rollback may erase wallets created by block, they are reported as inverse applied
+        emitUpdated();
+#endif
+        // inverse apply restores balances only, journal restores wallets as they were
+        if (const auto restored = data_.rollback(pool.sequence()); restored.has_value()) {
+#ifdef MONITOR_NODE
+            for (const auto& key : restored.value()) {
+                markUpdated(key);
+            }
+#endif
+        }
+        else {
+            restoreFromChain(pool, blockchain);
+        }
+    }
+
+    flushUpdates();
+    data_.evictDormant();
+}
+
+void WalletsCache::Updater::restoreFromChain(const csdb::Pool& pool, const BlockChain& blockchain) {
+    auto history = history_;
+
+    if (!history) {
+        history = [&blockchain, &pool](const csdb::Address& address, cs::Sequence sequence, const TransactionVisitor& visitor) {
+            for (TransactionsIterator it(blockchain, address, pool); it.isValid(); it.next()) {
+                if (it->id().pool_seq() < sequence && !visitor(*it)) {
+                    break;
+                }
+            }
+        };
+    }
+
+    std::set<PublicKey> restored;
+
+    for (const auto& transaction : pool.transactions()) {
+        for (const auto& address : {transaction.source(), transaction.target()}) {
+            const auto key = toPublicKey(address);
+
+            if (!restored.insert(key).second) {
+                continue;
+            }
+
+            // every transaction puts its inner id to the tail of its source
+            std::vector<TransactionsTail::TransactionId> ids;
+            TransactionsTail::TransactionId greatest = 0;
+            std::optional<csdb::TransactionID> last;
+
+            history(address, pool.sequence(), [&](const csdb::Transaction& previous) {
+                if (!last.has_value()) {
+                    last = previous.id();
+                }
+
+                if (toPublicKey(previous.source()) != key) {
+                    return true;
+                }
+
+                const auto id = previous.innerID();
+
+                // transaction is accepted only if its id is within tail of all before it,
+                // so transactions before this one are out of tail
+                if (!ids.empty() && id + static_cast<TransactionsTail::TransactionId>(2 * TransactionsTail::BitSize) < greatest) {
+                    return false;
+                }
+
+                ids.push_back(id);
+                greatest = std::max(greatest, id);
+                return true;
+            });
+
+            auto& wallet = getWalletData(key);
+            wallet.trxTail_ = TransactionsTail{};
+
+            for (const auto id : ids) {
+                wallet.trxTail_.push(id);
+            }
+
+            wallet.lastTransaction_ = last.value_or(csdb::TransactionID());
+#ifdef MONITOR_NODE
+            markUpdated(key);
+#endif
+        }
+    }
+}
+
+void WalletsCache::Updater::flushUpdates() {
+#ifdef MONITOR_NODE
+    emitUpdated();
+#endif
+    data_.publishTouched();
 }
 
 void WalletsCache::Updater::invokeReplenishPayableContract(const csdb::Transaction& transaction, bool inverse /* = false */) {
@@ -111,11 +605,11 @@ void WalletsCache::Updater::invokeReplenishPayableContract(const csdb::Transacti
             sourceWallData.balance_ += csdb::Amount(transaction.max_fee().to_double());
         }
 #ifdef MONITOR_NODE
-        emit walletUpdateEvent(toPublicKey(transaction.source()), sourceWallData);
+        markUpdated(toPublicKey(transaction.source()));
 #endif
     }
 #ifdef MONITOR_NODE
-    emit walletUpdateEvent(toPublicKey(transaction.target()), wallData);
+    markUpdated(toPublicKey(transaction.target()));
 #endif
 }
 
@@ -136,8 +630,8 @@ void WalletsCache::Updater::smartSourceTransactionReleased(const csdb::Transacti
         initWallData.balance_ += countedFee;
     }
 #ifdef MONITOR_NODE
-    emit walletUpdateEvent(toPublicKey(smartSourceTrx.source()), smartWallData);
-    emit walletUpdateEvent(toPublicKey(initTrx.source()), initWallData);
+    markUpdated(toPublicKey(smartSourceTrx.source()));
+    markUpdated(toPublicKey(initTrx.source()));
 #endif
 }
 
@@ -187,16 +681,46 @@ void WalletsCache::Updater::rollbackExceededTimeoutContract(const csdb::Transact
         }
     }
 #ifdef MONITOR_NODE
-    emit walletUpdateEvent(toPublicKey(transaction.source()), wallData);
+    markUpdated(toPublicKey(transaction.source()));
 #endif
 }
 
 #ifdef MONITOR_NODE
+void WalletsCache::Updater::markUpdated(const PublicKey& key) {
+    updated_.push_back(key);
+}
+
+void WalletsCache::Updater::emitUpdated() {
+    if (updated_.empty()) {
+        return;
+    }
+
+    // wallet may change many times by block, subscribers get its final state once
+    std::sort(updated_.begin(), updated_.end());
+    updated_.erase(std::unique(updated_.begin(), updated_.end()), updated_.end());
+
+    updates_.clear();
+
+    for (const auto& key : updated_) {
+        if (auto it = data_.wallets_.find(key); it != data_.wallets_.end()) {
+            updates_.emplace_back(key, &it->second);
+        }
+    }
+
+    updated_.clear();
+
+    emit walletsUpdateEvent(updates_);
+}
+
 bool WalletsCache::Updater::setWalletTime(const PublicKey& address, const uint64_t& p_timeStamp) {
     auto it = data_.wallets_.find(address);
-    if (it != data_.wallets_.end()) {
-        it->second.createTime_ = p_timeStamp;
-        emit walletUpdateEvent(it->first, it->second);
+    auto wallet = it != data_.wallets_.end() ? &it->second : data_.promote(address);
+    if (wallet != nullptr) {
+        if (data_.isDbRead_) {
+            data_.touch(address, wallet);
+        }
+        wallet->createTime_ = p_timeStamp;
+        markUpdated(address);
         return true;
     }
     return false;
@@ -243,7 +767,7 @@ void WalletsCache::Updater::fundConfidantsWalletsWithFee(const csdb::Amount& tot
                 feeToEachConfidant = totalFee - payedFee;
             }
 #ifdef MONITOR_NODE
-            emit walletUpdateEvent(confidants[i], walletData);
+            markUpdated(confidants[i]);
 #endif
         }
     }
@@ -287,7 +811,7 @@ void WalletsCache::Updater::fundConfidantsWalletsWithExecFee(const csdb::Transac
                 feeToEachConfidant = transaction.user_field(trx_uf::new_state::Fee).value<csdb::Amount>() - payedFee;
             }
 #ifdef MONITOR_NODE
-            emit walletUpdateEvent(confidants[i], walletData);
+            markUpdated(confidants[i]);
 #endif
         }
     }
@@ -385,7 +909,7 @@ double WalletsCache::Updater::loadTrxForSource(const csdb::Transaction& tr,
 		    --wallData_s.transNum_;
         }
 #ifdef MONITOR_NODE
-        emit walletUpdateEvent(toPublicKey(tr.source()), wallData_s);
+        markUpdated(toPublicKey(tr.source()));
 #endif
     }
     else {
@@ -420,7 +944,7 @@ double WalletsCache::Updater::loadTrxForSource(const csdb::Transaction& tr,
     }
 
 #ifdef MONITOR_NODE
-    emit walletUpdateEvent(toPublicKey(wallAddress), wallData);
+    markUpdated(toPublicKey(wallAddress));
 #endif
     return tr.counted_fee().to_double();
 }
@@ -502,8 +1026,8 @@ void WalletsCache::Updater::checkSmartWaitingForMoney(const csdb::Transaction& i
             auto& wallData = getWalletData(initTransaction.target());
             wallData.balance_ -= initTransaction.amount();
 #ifdef MONITOR_NODE
-            emit walletUpdateEvent(toPublicKey(initTransaction.source()), wallDataIniter);
-            emit walletUpdateEvent(toPublicKey(initTransaction.target()), wallData);
+            markUpdated(toPublicKey(initTransaction.source()));
+            markUpdated(toPublicKey(initTransaction.target()));
 #endif
         }
     }
@@ -518,8 +1042,8 @@ void WalletsCache::Updater::checkSmartWaitingForMoney(const csdb::Transaction& i
         auto& wallData = getWalletData(initTransaction.target());
         wallData.balance_ += initTransaction.amount();
 #ifdef MONITOR_NODE
-        emit walletUpdateEvent(toPublicKey(initTransaction.source()), wallDataIniter);
-        emit walletUpdateEvent(toPublicKey(initTransaction.target()), wallData);
+        markUpdated(toPublicKey(initTransaction.source()));
+        markUpdated(toPublicKey(initTransaction.target()));
 #endif
     }
 }
@@ -542,28 +1066,38 @@ void WalletsCache::Updater::loadTrxForTarget(const csdb::Transaction& tr, bool i
         else --wallData.transNum_;
     }
 #ifdef MONITOR_NODE
-    emit walletUpdateEvent(toPublicKey(tr.target()), wallData);
+    markUpdated(toPublicKey(tr.target()));
 #endif
 }
 
 void WalletsCache::Updater::updateLastTransactions(const std::vector<std::pair<PublicKey, csdb::TransactionID>>& updates) {
     for (const auto& u : updates) {
         auto it = data_.wallets_.find(u.first);
-        if (it != data_.wallets_.end()) {
-            it->second.lastTransaction_ = u.second;
+        auto wallet = it != data_.wallets_.end() ? &it->second : data_.promote(u.first);
+        if (wallet != nullptr) {
+            wallet->lastTransaction_ = u.second;
+            if (data_.isDbRead_) {
+                data_.publish(u.first, *wallet);
+            }
 #ifdef MONITOR_NODE
-            emit walletUpdateEvent(it->first, it->second);
+            markUpdated(u.first);
 #endif
         }
     }
+
+#ifdef MONITOR_NODE
+    emitUpdated();
+#endif
 }
 
 void WalletsCache::iterateOverWallets(const std::function<bool(const PublicKey&, const WalletData&)> func) {
     for (const auto& wallet : wallets_) {
         if (!func(wallet.first, wallet.second)) {
-            break;
+            return;
         }
     }
+
+    iterateOverColdWallets(func);
 }
 
 #ifdef MONITOR_NODE
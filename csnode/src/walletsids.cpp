@@ -1,18 +1,246 @@
 #include <csnode/walletsids.hpp>
 #include <lib/system/logger.hpp>
+#include <lib/system/mmappedfile.hpp>
 #include <lib/system/utils.hpp>
+
+#include <algorithm>
+#include <cstring>
 #include <limits>
+#include <random>
+
+#include <boost/filesystem.hpp>
 
 using namespace std;
 
+namespace {
+constexpr uint32_t kFileMagic = 0x57494453;  // "WIDS"
+constexpr uint32_t kFileVersion = 1;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t seed;
+    uint64_t capacity;
+    uint64_t size;
+    uint32_t nextId;
+    uint32_t nextIdSpecial;
+};
+}  // namespace
+
 namespace cs {
 
 WalletsIds::WalletsIds()
-: nextId_(0) {
+: slots_(kMinCapacity, Slot{cs::PublicKey{}, kNoId})
+, seed_((static_cast<uint64_t>(random_device{}()) << 32) | random_device{}())
+, nextId_(0)
+, nextIdSpecial_(Special::makeSpecial(0)) {
     special_.reset(new Special(*this));
     norm_.reset(new Normal(*this));
 }
 
+size_t WalletsIds::memoryUsage() const {
+    return slots_.capacity() * sizeof(Slot) + (normalSlots_.capacity() + specialSlots_.capacity()) * sizeof(uint32_t);
+}
+
+bool WalletsIds::save(const std::string& path) const {
+    const size_t fileSize = sizeof(FileHeader) + slots_.size() * sizeof(Slot);
+    MMappedFileWrap<FileSink> file(path, fileSize);
+
+    auto data = file.data<char>();
+
+    if (data == nullptr) {
+        cserror() << "Wallets ids can not be saved to " << path;
+        return false;
+    }
+
+    const FileHeader header{kFileMagic, kFileVersion, seed_, slots_.size(), size_, nextId_, nextIdSpecial_};
+
+    std::memcpy(data, &header, sizeof(header));
+    std::memcpy(data + sizeof(header), slots_.data(), slots_.size() * sizeof(Slot));
+
+    return true;
+}
+
+bool WalletsIds::load(const std::string& path) {
+    boost::system::error_code code;
+    const auto fileSize = boost::filesystem::file_size(path, code);
+
+    if (code || fileSize < sizeof(FileHeader)) {
+        return false;
+    }
+
+    MMappedFileWrap<FileSource> file(path, fileSize, false);
+    auto data = file.data<const char>();
+
+    if (data == nullptr) {
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    const bool isPowerOfTwo = header.capacity != 0 && (header.capacity & (header.capacity - 1)) == 0;
+
+    if (header.magic != kFileMagic || header.version != kFileVersion || !isPowerOfTwo || header.capacity >= kNoSlot || header.size >= header.capacity ||
+        fileSize != sizeof(FileHeader) + header.capacity * sizeof(Slot)) {
+        cswarning() << "Wallets ids file " << path << " is damaged";
+        return false;
+    }
+
+    auto begin = reinterpret_cast<const Slot*>(data + sizeof(FileHeader));
+
+    // probe stops at empty slot only, so size is checked by slots and not taken from header
+    const auto occupied = std::count_if(begin, begin + header.capacity, [](const Slot& slot) { return slot.id != kNoId; });
+
+    if (static_cast<uint64_t>(occupied) != header.size) {
+        cswarning() << "Wallets ids file " << path << " is damaged, " << occupied << " slots are occupied of " << header.size;
+        return false;
+    }
+
+    slots_.assign(begin, begin + header.capacity);
+    size_ = header.size;
+    seed_ = header.seed;
+    nextId_ = header.nextId;
+    nextIdSpecial_ = header.nextIdSpecial;
+
+    rebuildPositions();
+    return true;
+}
+
+size_t WalletsIds::bucket(const cs::PublicKey& key) const {
+    // public keys are uniform, seed keeps crafted ones from collecting in one bucket
+    uint64_t hash = 0;
+    std::memcpy(&hash, key.data(), sizeof(hash));
+
+    hash ^= seed_;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    hash ^= hash >> 31;
+
+    return static_cast<size_t>(hash) & (slots_.size() - 1);
+}
+
+size_t WalletsIds::probe(const cs::PublicKey& key) const {
+    const size_t mask = slots_.size() - 1;
+    size_t slot = bucket(key);
+
+    while (slots_[slot].id != kNoId && slots_[slot].key != key) {
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+std::pair<size_t, bool> WalletsIds::emplace(const cs::PublicKey& key, WalletId id) {
+    // load factor is kept below 3/4
+    if ((size_ + 1) * 4 > slots_.size() * 3) {
+        grow();
+    }
+
+    const size_t slot = probe(key);
+
+    if (slots_[slot].id != kNoId) {
+        return std::make_pair(slot, false);
+    }
+
+    // id is given to another key
+    if (slotById(id) != nullptr) {
+        return std::make_pair(kNoSlot, false);
+    }
+
+    slots_[slot] = Slot{key, id};
+    ++size_;
+
+    place(slot);
+    return std::make_pair(slot, true);
+}
+
+void WalletsIds::erase(size_t slot) {
+    const size_t mask = slots_.size() - 1;
+
+    displace(slots_[slot].id);
+
+    // backward shift keeps probe sequences without tombstones
+    size_t hole = slot;
+
+    for (size_t current = (slot + 1) & mask; slots_[current].id != kNoId; current = (current + 1) & mask) {
+        const size_t home = bucket(slots_[current].key);
+
+        if (((current - home) & mask) >= ((current - hole) & mask)) {
+            slots_[hole] = slots_[current];
+            place(hole);
+            hole = current;
+        }
+    }
+
+    slots_[hole].id = kNoId;
+    --size_;
+}
+
+void WalletsIds::grow() {
+    std::vector<Slot> old(slots_.size() * 2, Slot{cs::PublicKey{}, kNoId});
+    old.swap(slots_);
+
+    for (const auto& slot : old) {
+        if (slot.id != kNoId) {
+            slots_[probe(slot.key)] = slot;
+        }
+    }
+
+    rebuildPositions();
+}
+
+const WalletsIds::Slot* WalletsIds::slotById(WalletId id) const {
+    const auto& slots = Special::isSpecial(id) ? specialSlots_ : normalSlots_;
+    const auto index = Special::makeNormal(id);
+
+    if (index >= slots.size() || slots[index] == kNoSlot) {
+        return nullptr;
+    }
+
+    return &slots_[slots[index]];
+}
+
+std::vector<uint32_t>& WalletsIds::positions(WalletId id) {
+    return Special::isSpecial(id) ? specialSlots_ : normalSlots_;
+}
+
+void WalletsIds::place(size_t slot) {
+    const auto id = slots_[slot].id;
+    const auto index = Special::makeNormal(id);
+    auto& slots = positions(id);
+
+    if (index >= slots.size()) {
+        slots.resize(index + 1, kNoSlot);
+    }
+
+    slots[index] = static_cast<uint32_t>(slot);
+}
+
+void WalletsIds::displace(WalletId id) {
+    const auto index = Special::makeNormal(id);
+    auto& slots = positions(id);
+
+    if (index < slots.size()) {
+        slots[index] = kNoSlot;
+    }
+
+    while (!slots.empty() && slots.back() == kNoSlot) {
+        slots.pop_back();
+    }
+}
+
+void WalletsIds::rebuildPositions() {
+    normalSlots_.clear();
+    specialSlots_.clear();
+
+    for (size_t i = 0; i < slots_.size(); ++i) {
+        if (slots_[i].id != kNoId) {
+            place(i);
+        }
+    }
+}
+
 WalletsIds::Normal::Normal(WalletsIds& norm)
 : norm_(norm) {
 }
@@ -25,14 +253,14 @@ bool WalletsIds::Normal::insert(const WalletAddress& address, WalletId id) {
         return false;
     }
     else if (address.is_public_key()) {
-        auto res = norm_.data_.insert({address, id});
-        if (res.second && id >= norm_.nextId_) {
+        const bool inserted = norm_.emplace(address.public_key(), id).second;
+        if (inserted && id >= norm_.nextId_) {
             if (id >= numeric_limits<WalletId>::max() / 2)
                 throw runtime_error("idNormal >= numeric_limits<WalletId>::max() / 2");
 
             norm_.nextId_ = id + 1;
         }
-        return res.second;
+        return inserted;
     }
     cserror() << "Wrong address";
     return false;
@@ -44,12 +272,11 @@ bool WalletsIds::Normal::find(const WalletAddress& address, WalletId& id) const
         return true;
     }
     else if (address.is_public_key()) {
-        const auto &index = norm_.data_.get<Wallet::byAddress>();
-        auto it = index.find(address);
-        if (it == index.end()) {
+        const auto& slot = norm_.slots_[norm_.probe(address.public_key())];
+        if (slot.id == kNoId) {
             return false;
         }
-        id = (*it).id;
+        id = slot.id;
         return true;
     }
     cserror() << "Wrong address";
@@ -57,13 +284,12 @@ bool WalletsIds::Normal::find(const WalletAddress& address, WalletId& id) const
 }
 
 bool WalletsIds::Normal::findaddr(const WalletId& id, WalletAddress& address) const {
-    const auto &index = norm_.data_.get<Wallet::byId>();
-    auto it = index.find(id);
-    if (it == index.end()) {
+    const auto slot = norm_.slotById(id);
+    if (slot == nullptr) {
         cserror() << "Wrong WalletId";
         return false;
     }
-    address = (*it).address;
+    address = WalletAddress::from_public_key(slot->key);
     return true;
 }
 
@@ -73,14 +299,18 @@ bool WalletsIds::Normal::get(const WalletAddress& address, WalletId& id) {
         return false;
     }
     else if (address.is_public_key()) {
-        auto res = norm_.data_.insert({address, norm_.nextId_});
-        if (res.second) {
+        const auto [slot, inserted] = norm_.emplace(address.public_key(), norm_.nextId_);
+        if (slot == kNoSlot) {
+            cserror() << "Wallet id " << norm_.nextId_ << " is already given";
+            return false;
+        }
+        if (inserted) {
             if (norm_.nextId_ >= numeric_limits<WalletId>::max() / 2)
                 throw runtime_error("nextId_ >= numeric_limits<WalletId>::max() / 2");
             ++norm_.nextId_;
         }
-        id = (*res.first).id;
-        return res.second;
+        id = norm_.slots_[slot].id;
+        return inserted;
     }
     cserror() << "Wrong address";
     return false;
@@ -92,10 +322,9 @@ bool WalletsIds::Normal::remove(const WalletAddress& address) {
         return false;
     }
 
-    const auto &index = norm_.data_.get<Wallet::byAddress>();
-    auto it = index.find(address);
-    if (it != index.end()) {
-        norm_.data_.erase(it);
+    const auto slot = norm_.probe(address.public_key());
+    if (norm_.slots_[slot].id != kNoId) {
+        norm_.erase(slot);
         if (norm_.nextId_ > 0) {
             --norm_.nextId_;
         }
@@ -116,8 +345,7 @@ bool WalletsIds::Special::isSpecial(WalletId id) {
 }
 
 WalletsIds::Special::Special(WalletsIds& norm)
-: norm_(norm)
-, nextIdSpecial_(makeSpecial(0)) {
+: norm_(norm) {
 }
 
 bool WalletsIds::Special::insertNormal(const WalletAddress& address, WalletId idNormal, WalletId& idSpecial) {
@@ -130,19 +358,20 @@ bool WalletsIds::Special::insertNormal(const WalletAddress& address, WalletId id
         return false;
     }
     else if (address.is_public_key()) {
-        auto res = norm_.data_.insert({address, idNormal});
-
-        const bool isInserted = res.second;
-        auto& value = (*res.first).id;
+        const auto [slot, isInserted] = norm_.emplace(address.public_key(), idNormal);
+        if (slot == kNoSlot) {
+            return false;
+        }
+        auto& value = norm_.slots_[slot].id;
 
         if (!isInserted) {
-            if (!isSpecial(value)) {
+            if (!isSpecial(value) || norm_.slotById(idNormal) != nullptr) {
                 return false;
             }
             idSpecial = value;
-            auto &index = norm_.data_.get<Wallet::byId>();
-            auto it = norm_.data_.project<Wallet::byId>(res.first);
-            index.modify(it, [=](Wallet& wallet) { wallet.id = idNormal; });
+            norm_.displace(value);
+            value = idNormal;
+            norm_.place(slot);
         }
 
         if (idNormal >= norm_.nextId_) {
@@ -163,13 +392,19 @@ bool WalletsIds::Special::findAnyOrInsertSpecial(const WalletAddress& address, W
         return true;
     }
     else if (address.is_public_key()) {
-        auto res = norm_.data_.insert({address, nextIdSpecial_});
-        if (res.second) {
-            if (nextIdSpecial_ == numeric_limits<WalletId>::max())
-                throw runtime_error("nextIdSpecial_ == numeric_limits<WalletId>::max()");
-            ++nextIdSpecial_;
+        // the last id marks empty slots
+        if (norm_.nextIdSpecial_ == numeric_limits<WalletId>::max())
+            throw runtime_error("nextIdSpecial_ == numeric_limits<WalletId>::max()");
+
+        const auto [slot, inserted] = norm_.emplace(address.public_key(), norm_.nextIdSpecial_);
+        if (slot == kNoSlot) {
+            cserror() << "Wallet id " << norm_.nextIdSpecial_ << " is already given";
+            return false;
+        }
+        if (inserted) {
+            ++norm_.nextIdSpecial_;
         }
-        id = (*res.first).id;
+        id = norm_.slots_[slot].id;
         return true;
     }
     cserror() << "Wrong address";
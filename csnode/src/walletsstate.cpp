@@ -1,26 +1,43 @@
 #include <csnode/walletsstate.hpp>
 
+#include <algorithm>
+
+namespace {
+// stale entries kept for reuse are limited by wallets of the last round
+constexpr size_t kMaxStaleFactor = 4;
+constexpr size_t kMinKept = 1024;
+}  // namespace
+
 namespace cs {
 
 WalletsState::WalletData& WalletsState::getData(const WalletAddress& address) {
     auto pubKey = wallCache_.toPublicKey(address);
-    auto it = storage_.find(pubKey);
-    if (it != storage_.end()) {
-        return it->second;
+    auto& entry = storage_[pubKey];
+
+    if (entry.version == version_) {
+        return entry.data;
+    }
+
+    entry.version = version_;
+    ++touched_;
+
+    auto walletPtr = wallCache_.findWallet(pubKey);
+    if (walletPtr) {
+        entry.data = WalletData{noInd_, walletPtr->balance_, walletPtr->trxTail_};
     }
     else {
-        auto walletPtr = wallCache_.findWallet(address);
-        if (walletPtr) {
-            auto res = storage_.insert(std::make_pair(pubKey,
-                                                      WalletData{noInd_,
-                                                                 walletPtr->balance_,
-                                                                 walletPtr->trxTail_}));
-            return res.first->second;
-        }
-        else {
-            auto res = storage_.insert(std::make_pair(pubKey, WalletData{noInd_}));
-            return res.first->second;
-        }
+        entry.data = WalletData{noInd_};
     }
+
+    return entry.data;
+}
+
+void WalletsState::updateFromSource() {
+    if (storage_.size() > kMaxStaleFactor * std::max(touched_, kMinKept)) {
+        storage_.clear();
+    }
+
+    touched_ = 0;
+    ++version_;
 }
 }  // namespace cs
@@ -7,19 +7,19 @@
 #include <future>
 #include <list>
 #include <memory>
+#include <optional>
 #include <thread>
+#include <tuple>
 #include <type_traits>
 #include <unordered_set>
 
 #include <lib/system/cache.hpp>
 #include <lib/system/common.hpp>
 #include <lib/system/logger.hpp>
+#include <lib/system/scheduler.hpp>
 #include <lib/system/signals.hpp>
 #include <lib/system/structures.hpp>
 
-#include <boost/asio/post.hpp>
-#include <boost/asio/thread_pool.hpp>
-
 namespace cs {
 enum class RunPolicy : cs::Byte {
     CallQueuePolicy,
@@ -38,17 +38,16 @@ enum class WatcherState : cs::Byte {
 };
 
 // aliasing
-using Threads = boost::asio::thread_pool;
+using Threads = cs::Scheduler;
 
-// returns instance of boost thread pool
+// returns instance of scheduler, the same one runs concurrent tasks
 class ThreadPool {
 public:
     ThreadPool() = delete;
     ~ThreadPool() = default;
 
     static Threads& instance() noexcept {
-        static Threads threadPool(std::thread::hardware_concurrency());
-        return threadPool;
+        return Scheduler::instance();
     }
 };
 
@@ -70,11 +69,11 @@ private:
     }
 
     template <typename Func>
-    static void execute(Func&& function) {
-        auto& threadPool = ThreadPool::instance();
-        boost::asio::post(threadPool, std::forward<Func>(function));
+    static void execute(Func&& function, cs::TaskPriority priority = cs::TaskPriority::Normal) {
+        ThreadPool::instance().post(std::forward<Func>(function), priority);
     }
 
+    // own thread for blocking entities, they would hold worker of thread pool
     template <typename Func>
     static void run(Func&& function) {
         try {
@@ -107,9 +106,7 @@ public:
 
 protected:
     FutureBase() {
-        ++producedId;
-
-        id_ = producedId;
+        id_ = ++producedId;
         state_ = WatcherState::Idle;
         policy_ = RunPolicy::ThreadPolicy;
     }
@@ -117,16 +114,15 @@ protected:
     FutureBase(FutureBase&) = delete;
     ~FutureBase() = default;
 
-    explicit FutureBase(const RunPolicy policy, Future<Result>&& future)
+    explicit FutureBase(const RunPolicy policy)
     : FutureBase() {
-        future_ = std::move(future);
         policy_ = policy;
+        state_ = WatcherState::Running;
     }
 
     FutureBase(FutureBase&& watcher) noexcept
-    : future_(std::move(watcher.future_))
-    , policy_(watcher.policy_)
-    , state_(watcher.state_)
+    : policy_(watcher.policy_)
+    , state_(watcher.state_.load())
     , id_(watcher.id_) {
     }
 
@@ -135,8 +131,8 @@ protected:
             cserror() << csname() << "Trying to use operator= in watcher running state";
         }
 
-        future_ = std::move(watcher.future_);
         policy_ = watcher.policy_;
+        state_ = watcher.state_.load();
         id_ = watcher.id_;
 
         return *this;
@@ -156,33 +152,30 @@ public:
 protected:
     using CompletedSignal = cs::Signal<void(Id)>;
 
-    Future<Result> future_;
     RunPolicy policy_;
-    WatcherState state_ = WatcherState::Idle;
+    std::atomic<WatcherState> state_ = WatcherState::Idle;
     Id id_;
 
-    inline static Id producedId = 0;
+    inline static std::atomic<Id> producedId = 0;
     constexpr static std::chrono::milliseconds kAwaiterTime{10};
 
     void setCompletedState() {
-        future_ = Future<Result>();
         state_ = WatcherState::Compeleted;
-
         emit completed(id_);
     }
 
-    template <typename Func>
-    void callSignal(Func&& func) {
-        Worker::execute(policy_, std::forward<Func>(func));
-    }
-
-    template <typename Awaiter>
-    void await(const Awaiter& awaiter) {
-        if (cs::Connector::callbacks(&awaiter) != 0) {
+    // clients connect to watcher after run returns, short execution gives them some time
+    // by delayed task instead of sleeping worker
+    template <typename Signal, typename Func>
+    void dispatch(const Signal& signal, Func&& func) {
+        if (cs::Connector::callbacks(&signal) != 0) {
+            Worker::execute(policy_, std::forward<Func>(func));
             return;
         }
 
-        std::this_thread::sleep_for(kAwaiterTime);
+        ThreadPool::instance().postAfter(kAwaiterTime, [policy = policy_, func = std::forward<Func>(func)]() mutable {
+            Worker::execute(policy, std::move(func));
+        });
     }
 
 protected signals:
@@ -195,13 +188,14 @@ protected signals:
 // and generate signal when finished
 template <typename Result>
 class FutureWatcher : public FutureBase<Result> {
+    friend class Concurrent;
+
 public:
     using FinishSignal = cs::Signal<void(const Result&)>;
     using FailedSignal = cs::Signal<void()>;
 
-    explicit FutureWatcher(RunPolicy policy, Future<Result>&& future)
-    : FutureBase<Result>(policy, std::move(future)) {
-        watch();
+    explicit FutureWatcher(RunPolicy policy)
+    : FutureBase<Result>(policy) {
     }
 
     FutureWatcher() = default;
@@ -210,38 +204,27 @@ public:
 
     FutureWatcher& operator=(FutureWatcher&& watcher) {
         FutureBase<Result>::operator=(std::move(watcher));
-
-        watch();
         return *this;
     }
 
 protected:
     using Super = FutureBase<Result>;
 
-    void watch() {
-        auto closure = [=] {
-            try {
-                Result result = Super::future_.get();
-
-                auto lambda = [this, res = std::move(result)]() {
-                    Super::await(finished);
-                    emit finished(std::move(res));
-
-                    Super::setCompletedState();
-                };
-
-                Super::callSignal(std::bind(std::move(lambda)));
-            }
-            catch (std::exception& e) {
-                Super::await(failed);
+    // called by scheduler worker after execution
+    void finish(Result&& result) {
+        Super::dispatch(finished, [this, res = std::move(result)] {
+            emit finished(res);
+            Super::setCompletedState();
+        });
+    }
 
-                cserror() << "Concurrent execution with " << typeid(Result).name() << " failed, " << e.what();
-                emit failed();
-            }
-        };
+    void fail(const std::exception& exception) {
+        cserror() << "Concurrent execution with " << typeid(Result).name() << " failed, " << exception.what();
 
-        Super::state_ = WatcherState::Running;
-        Worker::run(std::move(closure));
+        Super::dispatch(failed, [this] {
+            emit failed();
+            Super::setCompletedState();
+        });
     }
 
 public signals:
@@ -251,13 +234,14 @@ public signals:
 
 template <>
 class FutureWatcher<void> : public FutureBase<void> {
+    friend class Concurrent;
+
 public:
     using FinishSignal = cs::Signal<void()>;
     using FailedSignal = cs::Signal<void()>;
 
-    explicit FutureWatcher(RunPolicy policy, Future<void>&& future)
-    : FutureBase<void>(policy, std::move(future)) {
-        watch();
+    explicit FutureWatcher(RunPolicy policy)
+    : FutureBase<void>(policy) {
     }
 
     FutureWatcher() = default;
@@ -266,38 +250,26 @@ public:
 
     FutureWatcher& operator=(FutureWatcher&& watcher) noexcept {
         FutureBase<void>::operator=(std::move(watcher));
-
-        watch();
         return *this;
     }
 
 protected:
     using Super = FutureBase<void>;
 
-    void watch() {
-        auto closure = [=] {
-            try {
-                Super::future_.get();
-
-                auto signal = [=] {
-                    Super::await(finished);
-                    emit finished();
-
-                    Super::setCompletedState();
-                };
-
-                Super::callSignal(std::move(signal));
-            }
-            catch (std::exception& e) {
-                Super::await(failed);
+    void finish() {
+        Super::dispatch(finished, [this] {
+            emit finished();
+            Super::setCompletedState();
+        });
+    }
 
-                cserror() << "Concurrent execution with void result failed, " << e.what();
-                emit failed();
-            }
-        };
+    void fail(const std::exception& exception) {
+        cserror() << "Concurrent execution with void result failed, " << exception.what();
 
-        Super::state_ = WatcherState::Running;
-        Worker::run(std::move(closure));
+        Super::dispatch(failed, [this] {
+            emit failed();
+            Super::setCompletedState();
+        });
     }
 
 public signals:
@@ -314,11 +286,67 @@ class Concurrent {
     using Executions = std::list<T>;
 
 public:
-    // runs function in another thread, returns future watcher
+    // runs function in thread pool, returns future watcher
     // than generates finished signal by run policy
     // you should not store watcher, it does by run method, just use finished/failed signal to subscribe
     template <typename Func, typename... Args>
     static FutureWatcherPtr<std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>> run(RunPolicy policy, Func&& function, Args&&... args) {
+        return start(policy, ConcurrentPolicy::ThreadPool, std::forward<Func>(function), std::forward<Args>(args)...);
+    }
+
+    // runs function by concurrent policy, returns future watcher,
+    // blocking functions take ConcurrentPolicy::Thread not to hold workers of thread pool
+    template <typename Func, typename... Args>
+    static FutureWatcherPtr<std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>> run(RunPolicy policy, ConcurrentPolicy concurrency, Func&& function,
+                                                                                                  Args&&... args) {
+        return start(policy, concurrency, std::forward<Func>(function), std::forward<Args>(args)...);
+    }
+
+    // runs function entity in thread pool
+    template <typename Func>
+    static void run(Func&& function) {
+        Worker::execute(std::forward<Func>(function));
+    }
+
+    // runs function entity in thread pool, tasks of higher priority are taken first
+    template <typename Func>
+    static void run(Func&& function, cs::TaskPriority priority) {
+        Worker::execute(std::forward<Func>(function), priority);
+    }
+
+    // runs function entity by concurrent policy
+    template <typename Func>
+    static void run(Func&& function, cs::ConcurrentPolicy policy) {
+        if (policy == cs::ConcurrentPolicy::ThreadPool) {
+            Worker::execute(std::forward<Func>(function));
+        }
+        else {
+            Worker::run(std::forward<Func>(function));
+        }
+    }
+
+    // runs non-binded function in thread pool
+    template <typename Func, typename... Args>
+    static void run(Func&& func, Args&&... args) {
+        Concurrent::run(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
+    }
+
+    // calls std::function after ms time by delayed task of thread pool
+    static void runAfter(const std::chrono::milliseconds& ms, cs::RunPolicy policy, std::function<void()> callBack) {
+        ThreadPool::instance().postAfter(ms, [policy, callBack = std::move(callBack)]() mutable {
+            Worker::execute(policy, std::move(callBack));
+        });
+    }
+
+    template <typename Func>
+    static void execute(cs::RunPolicy policy, Func&& function) {
+        Worker::execute(policy, std::forward<Func>(function));
+    }
+
+private:
+    template <typename Func, typename... Args>
+    static FutureWatcherPtr<std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>> start(RunPolicy policy, ConcurrentPolicy concurrency, Func&& function,
+                                                                                                    Args&&... args) {
         using ReturnType = std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>;
         using WatcherType = FutureWatcher<ReturnType>;
 
@@ -326,8 +354,7 @@ public:
         static Executions<FutureWatcherPtr<ReturnType>> executions;
         using ExecutionsIterator = typename decltype(executions)::iterator;
 
-        // run async and store it at executions
-        auto watcher = std::make_shared<WatcherType>(policy, std::async(std::launch::async, std::forward<Func>(function), std::forward<Args>(args)...));
+        auto watcher = std::make_shared<WatcherType>(policy);
 
         {
             cs::Lock lock(executionsMutex_);
@@ -351,47 +378,48 @@ public:
             }
         });
 
-        return watcher;
-    }
-
-    // runs function entity in thread pool
-    template <typename Func>
-    static void run(Func&& function) {
-        Worker::execute(std::forward<Func>(function));
-    }
+        // function and arguments are copied as std::async does
+        auto task = [watcher, func = std::forward<Func>(function), arguments = std::tuple<std::decay_t<Args>...>(std::forward<Args>(args)...)]() mutable {
+            invoke(*watcher, std::move(func), std::move(arguments));
+        };
 
-    // runs function entity by concurrent policy
-    template <typename Func>
-    static void run(Func&& function, cs::ConcurrentPolicy policy) {
-        if (policy == cs::ConcurrentPolicy::ThreadPool) {
-            Worker::execute(std::forward<Func>(function));
+        if (concurrency == ConcurrentPolicy::ThreadPool) {
+            Worker::execute(std::move(task));
         }
         else {
-            Worker::run(std::forward<Func>(function));
+            Worker::run(std::move(task));
         }
-    }
 
-    // runs non-binded function in thread pool
-    template <typename Func, typename... Args>
-    static void run(Func&& func, Args&&... args) {
-        Concurrent::run(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
+        return watcher;
     }
 
-    // calls std::function after ms time in another thread
-    static void runAfter(const std::chrono::milliseconds& ms, cs::RunPolicy policy, std::function<void()> callBack) {
-        auto timePoint = std::chrono::steady_clock::now() + ms;
-        Worker::run(std::bind(&Concurrent::runAfterHelper, timePoint, policy, std::move(callBack)));
-    }
+    template <typename Result, typename Func, typename Arguments>
+    static void invoke(FutureWatcher<Result>& watcher, Func&& func, Arguments&& arguments) {
+        if constexpr (std::is_void_v<Result>) {
+            try {
+                std::apply(std::forward<Func>(func), std::forward<Arguments>(arguments));
+            }
+            catch (const std::exception& exception) {
+                watcher.fail(exception);
+                return;
+            }
 
-    template <typename Func>
-    static void execute(cs::RunPolicy policy, Func&& function) {
-        Worker::execute(policy, std::forward<Func>(function));
-    }
+            watcher.finish();
+        }
+        else {
+            // slots called by finish are not a part of execution
+            std::optional<Result> result;
 
-private:
-    static void runAfterHelper(const std::chrono::steady_clock::time_point& timePoint, cs::RunPolicy policy, std::function<void()> callBack) {
-        std::this_thread::sleep_until(timePoint);
-        Worker::execute(policy, std::move(callBack));
+            try {
+                result.emplace(std::apply(std::forward<Func>(func), std::forward<Arguments>(arguments)));
+            }
+            catch (const std::exception& exception) {
+                watcher.fail(exception);
+                return;
+            }
+
+            watcher.finish(std::move(*result));
+        }
     }
 
     inline static std::mutex executionsMutex_;
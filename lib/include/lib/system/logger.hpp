@@ -2,13 +2,25 @@
 #define LOGGER_HPP
 
 #include <boost/log/expressions/keyword.hpp>  // include prior trivial.hpp for "Severity" attribute support in config Filter=
+#include <boost/date_time/posix_time/ptime.hpp>
+#include <boost/log/attributes/current_thread_id.hpp>
+#include <boost/log/attributes/mutable_constant.hpp>
 #include <boost/log/sources/global_logger_storage.hpp>
 #include <boost/log/sources/severity_channel_logger.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/log/utility/manipulators/dump.hpp>
 #include <boost/log/utility/setup/settings.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 /*
  * \brief Just a syntax shugar over Boost::Log v2.
@@ -25,16 +37,29 @@
  * Configuration ini example:
  * [Core]
  * Filter="%Severity% >= info"
+ *
+ * After initialize() records are not passed to Boost::Log by logging thread. Arguments of record are copied raw
+ * (numbers, strings) to ring buffer of the thread and are formatted and written to sinks by background thread,
+ * records are dropped and counted if ring is full. Arguments of other types and all after them are formatted at
+ * call site. Records below CS_LOG_MIN_SEVERITY (or minSeverity of channel) are eliminated from build.
  */
 
 namespace logging = boost::log;
 
+// the lowest severity of records compiled in, may be defined by build
+#ifndef CS_LOG_MIN_SEVERITY
+#define CS_LOG_MIN_SEVERITY trace
+#endif
+
 namespace logger {
 using severity_level = logging::trivial::severity_level;
 
 void initialize(const logging::settings& settings);
 void cleanup();
 
+// returns count of records dropped on overflow of thread rings
+uint64_t droppedRecords();
+
 template <typename T = logging::trivial::logger>
 inline auto& getLogger() {
     return T::get();
@@ -52,21 +77,247 @@ constexpr bool useLogger<None>() {
     return false;
 }
 
+// channel may be specialized to compile in less records than the others
+template <typename T = logging::trivial::logger>
+constexpr severity_level minSeverity() {
+    return severity_level::CS_LOG_MIN_SEVERITY;
+}
+
 BOOST_LOG_INLINE_GLOBAL_LOGGER_CTOR_ARGS(File, logging::sources::severity_channel_logger_mt<severity_level>, (logging::keywords::channel = "file"))
 BOOST_LOG_INLINE_GLOBAL_LOGGER_CTOR_ARGS(EventLogger, logging::sources::severity_channel_logger_mt<logging::trivial::severity_level>, (logging::keywords::channel = "Event"))
+
+namespace detail {
+using ThreadId = logging::attributes::current_thread_id::value_type;
+
+// time and thread of record call site
+struct Stamp {
+    int64_t time;
+    ThreadId thread;
+};
+
+using WriteFunc = void (*)(severity_level, const Stamp&, const std::string&);
+
+enum class ArgType : uint8_t {
+    Signed,
+    Unsigned,
+    Double,
+    Bool,
+    Char,
+    Pointer,
+    String
+};
+
+// record is written as header and typed arguments
+struct Header {
+    WriteFunc write;
+    int64_t time;
+    severity_level level;
+};
+
+// arguments of record being logged by thread
+struct Buffer {
+    std::vector<uint8_t> bytes;
+    std::ostringstream stream;
+    bool isFormatted = false;
+};
+
+// nested records (logged while arguments are evaluated) take the next buffer of thread
+Buffer& acquireBuffer();
+
+// passes record to thread ring or, if backend is not started, writes it at once, and releases buffer
+void commit(Buffer& buffer);
+
+// Boost::Log filters are checked once per initialize() for each level of channel
+uint64_t filtersGeneration();
+
+// TimeStamp and ThreadID of call site replace the ones of background thread
+class StampAttributes {
+public:
+    template <typename Logger>
+    explicit StampAttributes(Logger& logger) {
+        logger.add_attribute("TimeStamp", timeStamp_);
+        logger.add_attribute("ThreadID", threadId_);
+    }
+
+    void set(const Stamp& stamp);
+
+    std::mutex mutex;
+
+private:
+    logging::attributes::mutable_constant<boost::posix_time::ptime> timeStamp_{boost::posix_time::ptime{}};
+    logging::attributes::mutable_constant<ThreadId> threadId_{ThreadId{}};
+};
+
+template <typename T>
+constexpr bool isCharType() {
+    return std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>;
+}
+}  // namespace detail
+
+///
+/// Record of channel T, arguments are captured by operator<< and record is committed at destruction.
+///
+template <typename T = logging::trivial::logger>
+class Record {
+public:
+    constexpr static bool isEnabled(severity_level level) {
+        return useLogger<T>() && level >= minSeverity<T>();
+    }
+
+    // returns true if Boost::Log filters pass records of level
+    static bool isOn(severity_level level);
+
+    explicit Record(severity_level level)
+    : buffer_(detail::acquireBuffer()) {
+        const detail::Header header{&Record::write, std::chrono::system_clock::now().time_since_epoch().count(), level};
+        put(&header, sizeof(header));
+    }
+
+    ~Record() {
+        if (buffer_.isFormatted) {
+            putString(buffer_.stream.str());
+        }
+
+        detail::commit(buffer_);
+    }
+
+    Record(const Record&) = delete;
+    Record& operator=(const Record&) = delete;
+
+    template <typename Arg>
+    Record& operator<<(const Arg& arg) {
+        using Type = std::decay_t<Arg>;
+
+        if (buffer_.isFormatted) {
+            buffer_.stream << arg;
+        }
+        else if constexpr (std::is_same_v<Type, bool>) {
+            putValue(detail::ArgType::Bool, arg);
+        }
+        else if constexpr (detail::isCharType<Type>()) {
+            putValue(detail::ArgType::Char, static_cast<char>(arg));
+        }
+        else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type> && sizeof(Type) <= sizeof(int64_t)) {
+            putValue(detail::ArgType::Signed, static_cast<int64_t>(arg));
+        }
+        else if constexpr (std::is_integral_v<Type> && std::is_unsigned_v<Type> && sizeof(Type) <= sizeof(uint64_t) && !std::is_same_v<Type, wchar_t> &&
+                           !std::is_same_v<Type, char16_t> && !std::is_same_v<Type, char32_t>) {
+            putValue(detail::ArgType::Unsigned, static_cast<uint64_t>(arg));
+        }
+        else if constexpr (std::is_same_v<Type, float> || std::is_same_v<Type, double>) {
+            putValue(detail::ArgType::Double, static_cast<double>(arg));
+        }
+        else if constexpr (std::is_same_v<Type, const void*> || std::is_same_v<Type, void*>) {
+            putValue(detail::ArgType::Pointer, reinterpret_cast<uintptr_t>(arg));
+        }
+        else if constexpr (std::is_same_v<Type, const char*> || std::is_same_v<Type, char*>) {
+            const char* str = arg;
+            putString(str ? std::string_view(str) : std::string_view());
+        }
+        else if constexpr (std::is_same_v<Type, std::string> || std::is_same_v<Type, std::string_view>) {
+            putString(arg);
+        }
+        else {
+            // the rest of record is formatted here, so manipulators apply to following arguments
+            format() << arg;
+        }
+
+        return *this;
+    }
+
+    Record& operator<<(std::ostream& (*manipulator)(std::ostream&)) {
+        format() << manipulator;
+        return *this;
+    }
+
+    Record& operator<<(std::ios_base& (*manipulator)(std::ios_base&)) {
+        format() << manipulator;
+        return *this;
+    }
+
+    // writes formatted record to Boost::Log
+    static void write(severity_level level, const detail::Stamp& stamp, const std::string& text);
+
+private:
+    void put(const void* data, size_t size) {
+        const auto bytes = static_cast<const uint8_t*>(data);
+        buffer_.bytes.insert(buffer_.bytes.end(), bytes, bytes + size);
+    }
+
+    template <typename Value>
+    void putValue(detail::ArgType type, const Value& value) {
+        put(&type, sizeof(type));
+        put(&value, sizeof(value));
+    }
+
+    void putString(std::string_view str) {
+        const auto type = detail::ArgType::String;
+        const auto size = static_cast<uint32_t>(str.size());
+
+        put(&type, sizeof(type));
+        put(&size, sizeof(size));
+        put(str.data(), str.size());
+    }
+
+    std::ostringstream& format() {
+        if (!buffer_.isFormatted) {
+            static const std::ios defaults(nullptr);
+
+            buffer_.stream.str(std::string{});
+            buffer_.stream.clear();
+            buffer_.stream.copyfmt(defaults);
+            buffer_.isFormatted = true;
+        }
+
+        return buffer_.stream;
+    }
+
+    detail::Buffer& buffer_;
+};
+
+template <typename T>
+bool Record<T>::isOn(severity_level level) {
+    // generation of filters in high bits, levels passed by them in low byte
+    static std::atomic<uint64_t> state{0};
+
+    const uint64_t generation = detail::filtersGeneration();
+    uint64_t current = state.load(std::memory_order_relaxed);
+
+    if ((current >> 8) != generation) {
+        uint64_t levels = 0;
+
+        for (int i = severity_level::trace; i <= severity_level::fatal; ++i) {
+            if (getLogger<T>().open_record(logging::keywords::severity = static_cast<severity_level>(i))) {
+                levels |= uint64_t(1) << i;
+            }
+        }
+
+        current = (generation << 8) | levels;
+        state.store(current, std::memory_order_relaxed);
+    }
+
+    return current & (uint64_t(1) << level);
+}
+
+template <typename T>
+void Record<T>::write(severity_level level, const detail::Stamp& stamp, const std::string& text) {
+    static detail::StampAttributes attributes(getLogger<T>());
+
+    std::lock_guard lock(attributes.mutex);
+    attributes.set(stamp);
+
+    BOOST_LOG_SEV(getLogger<T>(), level) << text;
+}
 }  // namespace logger
 
-#define LOG_SEV(level, ...)               \
-    if (!logger::useLogger<__VA_ARGS__>()) \
-        ;                                  \
-    else                                   \
-        BOOST_LOG_SEV(logger::getLogger<__VA_ARGS__>(), logger::severity_level::level)
-
-#define cstrace(...)                       \
-    if (!logger::useLogger<__VA_ARGS__>()) \
-        ;                                  \
-    else                                   \
-        BOOST_LOG_SEV(logger::getLogger<__VA_ARGS__>(), logger::severity_level::trace) << __FILE__ << ":" << __func__ << ":" << __LINE__ << " "
+#define LOG_SEV(level, ...)                                                              \
+    if (!logger::Record<__VA_ARGS__>::isEnabled(logger::severity_level::level) ||      \
+        !logger::Record<__VA_ARGS__>::isOn(logger::severity_level::level))             \
+        ;                                                                                \
+    else                                                                                 \
+        logger::Record<__VA_ARGS__>(logger::severity_level::level)
+
+#define cstrace(...) LOG_SEV(trace, __VA_ARGS__) << __FILE__ << ":" << __func__ << ":" << __LINE__ << " "
 
 // set Filter="%Severity% >= trace" in config to view this level messages:
 #define csdetails(...) LOG_SEV(trace, __VA_ARGS__)
@@ -0,0 +1,297 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <lib/system/cache.hpp>
+
+// define CS_METRICS_DISABLED to compile all the metrics updates out
+namespace cs::metrics {
+enum class Type {
+    Counter,
+    Gauge,
+    Summary
+};
+
+constexpr size_t kShardsCount = 8;
+
+namespace detail {
+inline std::atomic<bool> enabled{false};
+
+size_t nextShard();
+
+// shard of calling thread, threads are spread over shards round robin
+inline size_t shardIndex() {
+    thread_local const size_t index = nextShard();
+    return index;
+}
+}  // namespace detail
+
+#ifdef CS_METRICS_DISABLED
+constexpr bool isEnabled() {
+    return false;
+}
+#else
+inline bool isEnabled() {
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+#endif
+
+// metrics are not updated until enabled
+void setEnabled(bool enabled);
+
+// returns label in Prometheus format, key="value" with escaped value
+std::string label(const std::string& key, const std::string& value);
+
+class Metric {
+public:
+    Metric(Type type, const std::string& name, const std::string& labels)
+    : type_(type)
+    , name_(name)
+    , labels_(labels) {
+    }
+
+    virtual ~Metric() = default;
+
+    Type type() const {
+        return type_;
+    }
+
+    const std::string& name() const {
+        return name_;
+    }
+
+    const std::string& labels() const {
+        return labels_;
+    }
+
+    // writes samples in Prometheus text format
+    virtual void write(std::string& out) const = 0;
+
+private:
+    const Type type_;
+    const std::string name_;
+    const std::string labels_;
+};
+
+///
+/// Monotonic counter, every thread adds to its own cache line.
+///
+class Counter : public Metric {
+public:
+    Counter(const std::string& name, const std::string& labels)
+    : Metric(Type::Counter, name, labels) {
+    }
+
+    void increment(uint64_t value = 1) {
+        if (isEnabled()) {
+            shards_[detail::shardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t value() const;
+    void write(std::string& out) const override;
+
+private:
+    struct Shard {
+        __cacheline_aligned std::atomic<uint64_t> value{0};
+    };
+
+    std::array<Shard, kShardsCount> shards_;
+};
+
+class Gauge : public Metric {
+public:
+    Gauge(const std::string& name, const std::string& labels)
+    : Metric(Type::Gauge, name, labels) {
+    }
+
+    void set(int64_t value) {
+        if (isEnabled()) {
+            value_.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    void add(int64_t value) {
+        if (isEnabled()) {
+            value_.fetch_add(value, std::memory_order_relaxed);
+        }
+    }
+
+    int64_t value() const {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+    void write(std::string& out) const override;
+
+private:
+    std::atomic<int64_t> value_{0};
+};
+
+///
+/// HDR histogram of unsigned values with log-linear buckets: every power of two range is
+/// split into 8 sub-buckets, so quantiles are estimated within 12.5% for any magnitude.
+/// Exported as summary with quantiles, values are multiplied by scale on export.
+///
+class Histogram : public Metric {
+public:
+    static constexpr unsigned kSubBucketBits = 3;
+    static constexpr size_t kSubBuckets = size_t(1) << kSubBucketBits;
+    static constexpr size_t kBucketsCount = kSubBuckets + (64 - kSubBucketBits) * kSubBuckets;
+
+    struct Snapshot {
+        std::array<uint64_t, kBucketsCount> buckets{};
+        uint64_t count = 0;
+        uint64_t sum = 0;
+
+        // estimated value of quantile from [0, 1], not scaled
+        double quantile(double value) const;
+    };
+
+    Histogram(const std::string& name, const std::string& labels, double scale)
+    : Metric(Type::Summary, name, labels)
+    , scale_(scale) {
+    }
+
+    void observe(uint64_t value) {
+        if (isEnabled()) {
+            auto& shard = shards_[detail::shardIndex()];
+            shard.buckets[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+            shard.sum.fetch_add(value, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename Rep, typename Period>
+    void observe(std::chrono::duration<Rep, Period> duration) {
+        const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        observe(static_cast<uint64_t>(nanoseconds > 0 ? nanoseconds : 0));
+    }
+
+    static size_t bucket(uint64_t value) {
+        if (value < kSubBuckets) {
+            return static_cast<size_t>(value);
+        }
+
+        const unsigned shift = highestBit(value) - kSubBucketBits;
+        return kSubBuckets + shift * kSubBuckets + static_cast<size_t>((value >> shift) & (kSubBuckets - 1));
+    }
+
+    // the lowest value of bucket
+    static uint64_t lowerBound(size_t bucket);
+
+    Snapshot snapshot() const;
+    void write(std::string& out) const override;
+
+private:
+    static unsigned highestBit(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index = 0;
+        _BitScanReverse64(&index, value);
+        return static_cast<unsigned>(index);
+#else
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+    }
+
+    struct Shard {
+        __cacheline_aligned std::array<std::atomic<uint64_t>, kBucketsCount> buckets{};
+        std::atomic<uint64_t> sum{0};
+    };
+
+    const double scale_;
+    std::array<Shard, kShardsCount> shards_;
+};
+
+///
+/// Process wide set of metrics.
+///
+/// Metrics are created once and never removed, so references are cached by callers
+/// (usually as function local statics) and updated without any lock.
+/// Registration and export take the registry mutex.
+///
+class Registry {
+public:
+    static Registry& instance();
+
+    // returns existing metric of the same name and labels
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = std::string{});
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = std::string{});
+    Histogram& histogram(const std::string& name, const std::string& help, const std::string& labels = std::string{}, double scale = 1.0);
+
+    // all metrics in Prometheus text exposition format
+    std::string exposition() const;
+
+private:
+    struct Family {
+        std::string name;
+        std::string help;
+        Type type;
+        std::vector<const Metric*> metrics;
+    };
+
+    template <typename T, typename... Args>
+    T& add(Type type, const std::string& name, const std::string& help, const std::string& labels, Args&&... args);
+
+    mutable std::mutex mutex_;
+    std::deque<std::unique_ptr<Metric>> metrics_;
+    std::unordered_map<std::string, Metric*> index_;
+    std::vector<Family> families_;
+};
+
+inline Counter& counter(const std::string& name, const std::string& help, const std::string& labels = std::string{}) {
+    return Registry::instance().counter(name, help, labels);
+}
+
+inline Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = std::string{}) {
+    return Registry::instance().gauge(name, help, labels);
+}
+
+inline Histogram& histogram(const std::string& name, const std::string& help, const std::string& labels = std::string{}) {
+    return Registry::instance().histogram(name, help, labels);
+}
+
+// histogram of durations in nanoseconds exported in seconds
+inline Histogram& timer(const std::string& name, const std::string& help, const std::string& labels = std::string{}) {
+    return Registry::instance().histogram(name, help, labels, 1e-9);
+}
+
+// measures scope duration, the clock is not read while metrics are disabled
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& histogram)
+    : histogram_(isEnabled() ? &histogram : nullptr) {
+        if (histogram_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedTimer() {
+        if (histogram_) {
+            histogram_->observe(std::chrono::steady_clock::now() - start_);
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram* histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+}  // namespace cs::metrics
+
+#endif  // METRICS_HPP
@@ -0,0 +1,147 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <lib/system/common.hpp>
+
+namespace cs {
+enum class TaskPriority : cs::Byte {
+    High,
+    Normal,
+    Low
+};
+
+// move only callable, tasks may own futures, sockets and other not copyable entities
+class Task {
+public:
+    Task() = default;
+
+    template <typename Func, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Func>, Task>>>
+    Task(Func&& func)
+    : callable_(std::make_unique<Callable<std::decay_t<Func>>>(std::forward<Func>(func))) {
+    }
+
+    Task(Task&&) noexcept = default;
+    Task& operator=(Task&&) noexcept = default;
+
+    void operator()() {
+        callable_->call();
+    }
+
+    explicit operator bool() const noexcept {
+        return static_cast<bool>(callable_);
+    }
+
+private:
+    struct Base {
+        virtual ~Base() = default;
+        virtual void call() = 0;
+    };
+
+    template <typename Func>
+    struct Callable : Base {
+        template <typename F>
+        explicit Callable(F&& f)
+        : func(std::forward<F>(f)) {
+        }
+
+        void call() override {
+            func();
+        }
+
+        Func func;
+    };
+
+    std::unique_ptr<Base> callable_;
+};
+
+///
+/// Pool of workers with own queue each.
+///
+/// Task posted from a worker goes to its own queue, task posted from other thread goes to the worker
+/// by affinity hint or by turn. Worker takes tasks of own queue in order of posting and steals
+/// tasks of other workers when its queue is empty, tasks of higher priority are taken first.
+/// Workers without tasks sleep until a task is posted or a delayed task is due.
+///
+/// Tasks must not block for long, blocking loops run in own threads (see ConcurrentPolicy::Thread).
+///
+class Scheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    constexpr static size_t kNoAffinity = std::numeric_limits<size_t>::max();
+
+    explicit Scheduler(size_t workersCount);
+    ~Scheduler();
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    // scheduler of Concurrent and ThreadPool
+    static Scheduler& instance();
+
+    // affinity is a hint, the same hint takes the same worker while it is not stolen from
+    void post(Task task, TaskPriority priority = TaskPriority::Normal, size_t affinity = kNoAffinity);
+    void postAfter(std::chrono::milliseconds delay, Task task, TaskPriority priority = TaskPriority::Normal);
+
+    size_t workersCount() const noexcept {
+        return queues_.size();
+    }
+
+    // returns index of current worker or kNoAffinity if called outside of this scheduler
+    size_t currentWorker() const noexcept;
+
+private:
+    constexpr static size_t kPriorities = 3;
+
+    struct Queue {
+        cs::SpinLock lock{ATOMIC_FLAG_INIT};
+        std::array<std::deque<Task>, kPriorities> tasks;
+    };
+
+    struct Delayed {
+        Task task;
+        TaskPriority priority;
+    };
+
+    void push(size_t index, Task&& task, TaskPriority priority);
+    void wake();
+
+    bool take(size_t index, Task& task);
+    bool steal(size_t index, size_t priority, Task& task);
+
+    // moves due delayed tasks to queues
+    void release();
+
+    void work(size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> idle_{0};
+    std::atomic<size_t> turn_{0};
+    std::atomic<bool> isWaking_{false};
+    std::atomic<bool> isStopped_{false};
+
+    // sleeping workers and delayed tasks
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::multimap<Clock::time_point, Delayed> delayed_;
+    std::atomic<Clock::rep> nearest_;
+};
+}  // namespace cs
+
+#endif  // SCHEDULER_HPP
@@ -1,8 +1,12 @@
 #ifndef SIGNALS_HPP
 #define SIGNALS_HPP
 
-#include <functional>
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <tuple>
+#include <utility>
 
 #include <lib/system/common.hpp>
 #include <lib/system/reflection.hpp>
@@ -29,6 +33,46 @@ public:
     template <typename Object>
     static void disconnect(const ISignal* signal, const Object& object);
 };
+
+template <typename T>
+struct GetArguments : GetArguments<decltype(&T::operator())> {};
+
+template <typename T, typename... Args>
+struct GetArguments<T (*)(Args...)> : std::integral_constant<unsigned, sizeof...(Args)> {};
+
+template <typename T, typename C, typename... Args>
+struct GetArguments<T (C::*)(Args...)> : std::integral_constant<unsigned, sizeof...(Args)> {};
+
+template <typename T, typename C, typename... Args>
+struct GetArguments<T (C::*)(Args...) const> : std::integral_constant<unsigned, sizeof...(Args)> {};
+
+template <typename T>
+struct MethodClass;
+
+template <typename T, typename C, typename... Args>
+struct MethodClass<T (C::*)(Args...)> {
+    using type = C;
+};
+
+template <typename T, typename C, typename... Args>
+struct MethodClass<T (C::*)(Args...) const> {
+    using type = const C;
+};
+
+// enough for any member function pointer representation
+using MethodStorage = std::array<unsigned char, 4 * sizeof(void*)>;
+
+// address of id is unique for every method pointer type
+template <typename Method>
+struct MethodType {
+    static constexpr char id = 0;
+};
+
+// calls method with the first of signal arguments, slot may take less arguments than signal
+template <typename Return, typename Object, typename Method, typename Tuple, size_t... Indexes>
+inline Return invokeMethod(Object* object, Method method, Tuple&& args, std::index_sequence<Indexes...>) {
+    return static_cast<Return>((object->*method)(std::get<Indexes>(std::forward<Tuple>(args))...));
+}
 }  // namespace cshelper
 
 class IConnectable {
@@ -60,7 +104,23 @@ class Signal<Return(InArgs...)> : public ISignal {
 public:
     using Argument = std::function<Return(InArgs...)>;
     using Signature = Return(InArgs...);
-    using Slots = std::vector<std::pair<ObjectPointer, Argument>>;
+
+    ///
+    /// Connected slot. Object methods are called by typed invoker without std::function,
+    /// any other callable is kept as function.
+    ///
+    struct Slot {
+        using Invoker = Return (*)(const Slot&, InArgs...);
+
+        ObjectPointer object = nullptr;
+        void* target = nullptr;
+        Invoker invoker = nullptr;
+        const void* methodType = nullptr;
+        cshelper::MethodStorage method{};
+        Argument function;
+    };
+
+    using Slots = std::vector<Slot>;
 
     ///
     /// @brief Generates signal.
@@ -68,10 +128,13 @@ public:
     ///
     template <typename... Args>
     inline void operator()(Args&&... args) const {
-        for ([[maybe_unused]] auto& [obj, func] : slots_) {
-            csunused(obj);
-            if (func) {
-                func(std::forward<Args>(args)...);
+        // every slot gets the same arguments, so they are never moved from
+        for (const auto& slot : slots_) {
+            if (slot.invoker) {
+                slot.invoker(slot, args...);
+            }
+            else if (slot.function) {
+                slot.function(args...);
             }
         }
     }
@@ -106,10 +169,63 @@ private:
             return *this;
         }
 
-        slots_.push_back(std::make_pair(obj, std::move(arg)));
+        Slot slot;
+        slot.object = obj;
+        slot.function = std::move(arg);
+
+        slots_.push_back(std::move(slot));
+        return *this;
+    }
+
+    // adds object method as slot
+    template <typename Object, typename Method>
+    auto& add(Object* object, Method method, ObjectPointer obj) {
+        return addMethod(object, method, &invoke<Object, Method>, obj);
+    }
+
+    // adds object method known at compile time, invoker calls it directly
+    template <auto Method, typename Object>
+    auto& add(Object* object, ObjectPointer obj) {
+        return addMethod(object, Method, &invokeStatic<Object, Method>, obj);
+    }
+
+    template <typename Object, typename Method>
+    auto& addMethod(Object* object, Method method, typename Slot::Invoker invoker, ObjectPointer obj) {
+        static_assert(sizeof(Method) <= sizeof(cshelper::MethodStorage), "Unsupported method pointer size");
+
+        Slot slot;
+        slot.object = obj;
+        slot.target = const_cast<void*>(static_cast<const void*>(object));
+        slot.invoker = invoker;
+        slot.methodType = &cshelper::MethodType<Method>::id;
+        std::memcpy(slot.method.data(), &method, sizeof(Method));
+
+        slots_.push_back(std::move(slot));
         return *this;
     }
 
+    template <typename Object, typename Method>
+    static Return invoke(const Slot& slot, InArgs... args) {
+        Method method;
+        std::memcpy(&method, slot.method.data(), sizeof(Method));
+
+        return cshelper::invokeMethod<Return>(static_cast<Object*>(slot.target), method, std::forward_as_tuple(std::forward<InArgs>(args)...),
+                                              std::make_index_sequence<cshelper::GetArguments<Method>::value>());
+    }
+
+    template <typename Object, auto Method>
+    static Return invokeStatic(const Slot& slot, InArgs... args) {
+        return cshelper::invokeMethod<Return>(static_cast<Object*>(slot.target), Method, std::forward_as_tuple(std::forward<InArgs>(args)...),
+                                              std::make_index_sequence<cshelper::GetArguments<decltype(Method)>::value>());
+    }
+
+    // checks that slot calls method of object, however it was connected
+    template <typename Object, typename Method>
+    static bool isMethod(const Slot& slot, Object* object, Method method) {
+        return slot.methodType == &cshelper::MethodType<Method>::id && slot.target == static_cast<const void*>(object) &&
+               std::memcmp(slot.method.data(), &method, sizeof(Method)) == 0;
+    }
+
     // clears all signal slots
     auto& operator=(void* ptr) {
         if (ptr == nullptr) {
@@ -133,7 +249,7 @@ private:
 
     virtual void drop(void* object) override final {
         for (auto iterator = slots_.begin(); iterator != slots_.end();) {
-            if (iterator->first == ObjectPointer(object)) {
+            if (iterator->object == ObjectPointer(object)) {
                 iterator = slots_.erase(iterator);
             }
             else {
@@ -159,7 +275,7 @@ class Signal<std::function<T>> : public ISignal {
 public:
     using Argument = std::function<T>;
     using Signature = T;
-    using Slots = std::vector<std::pair<ObjectPointer, Argument>>;
+    using Slots = typename Signal<T>::Slots;
 
     ///
     /// @brief Generates signal.
@@ -196,6 +312,23 @@ private:
         return *this;
     }
 
+    template <typename Object, typename Method>
+    auto& add(Object* object, Method method, ObjectPointer obj) {
+        signal_.add(object, method, obj);
+        return *this;
+    }
+
+    template <auto Method, typename Object>
+    auto& add(Object* object, ObjectPointer obj) {
+        signal_.template add<Method>(object, obj);
+        return *this;
+    }
+
+    template <typename Object, typename Method>
+    static bool isMethod(const typename Signal<T>::Slot& slot, Object* object, Method method) {
+        return Signal<T>::isMethod(slot, object, method);
+    }
+
     // clears all slots
     auto& operator=(void* ptr) {
         signal_ = ptr;
@@ -222,19 +355,39 @@ private:
     friend class Connector;
 };
 
-namespace cshelper {
-template <typename T>
-struct GetArguments : GetArguments<decltype(&T::operator())> {};
+///
+/// Signal with slots fixed at compile time.
+///
+/// Emission is a sequence of direct method calls, so it is inlined like a plain call.
+/// Objects are bound at construction and are not disconnected, they must outlive signal.
+///
+template <typename T, auto... Methods>
+class FixedSignal;
 
-template <typename T, typename... Args>
-struct GetArguments<T (*)(Args...)> : std::integral_constant<unsigned, sizeof...(Args)> {};
+template <typename... InArgs, auto... Methods>
+class FixedSignal<void(InArgs...), Methods...> {
+public:
+    using Signature = void(InArgs...);
 
-template <typename T, typename C, typename... Args>
-struct GetArguments<T (C::*)(Args...)> : std::integral_constant<unsigned, sizeof...(Args)> {};
+    explicit FixedSignal(typename cshelper::MethodClass<decltype(Methods)>::type*... objects)
+    : objects_(objects...) {
+    }
 
-template <typename T, typename C, typename... Args>
-struct GetArguments<T (C::*)(Args...) const> : std::integral_constant<unsigned, sizeof...(Args)> {};
+    inline void operator()(InArgs... args) const {
+        call(std::index_sequence_for<decltype(Methods)...>(), args...);
+    }
 
+private:
+    template <size_t... Indexes, typename... Args>
+    inline void call(std::index_sequence<Indexes...>, Args&... args) const {
+        (cshelper::invokeMethod<void>(std::get<Indexes>(objects_), Methods, std::forward_as_tuple(args...),
+                                      std::make_index_sequence<cshelper::GetArguments<decltype(Methods)>::value>()), ...);
+    }
+
+    std::tuple<typename cshelper::MethodClass<decltype(Methods)>::type*...> objects_;
+};
+
+namespace cshelper {
 // bindings
 template <int>
 class CheckArgs {
@@ -393,11 +546,30 @@ public:
     ///
     template <template <typename> typename Signal, typename T, typename Object, typename Slot>
     static void connect(const Signal<T>* signal, const Object& slotObj, Slot&& slot) {
-        constexpr int size = cshelper::GetArguments<Slot>();
-
         cs::Lock lock(mutex_);
         auto obj = cs::Connector::checkConnection(static_cast<const ISignal*>(signal), slotObj, std::is_base_of<IConnectable, std::remove_pointer_t<Object>>());
-        const_cast<Signal<T>*>(signal)->add(cshelper::CheckArgs<size>().connect(slotObj, std::forward<Slot>(slot)), obj);
+
+        // methods of plain object pointers are called directly, others are bound
+        if constexpr (std::is_pointer_v<Object> && std::is_member_function_pointer_v<std::decay_t<Slot>>) {
+            const_cast<Signal<T>*>(signal)->add(slotObj, std::decay_t<Slot>(slot), obj);
+        }
+        else {
+            constexpr int size = cshelper::GetArguments<Slot>();
+            const_cast<Signal<T>*>(signal)->add(cshelper::CheckArgs<size>().connect(slotObj, std::forward<Slot>(slot)), obj);
+        }
+    }
+
+    ///
+    /// @brief Connects signal with object method known at compile time,
+    /// so method is called without indirection and may be inlined into dispatch.
+    /// @param signal Any const signal pointer.
+    /// @param slotObj Pointer to slot object.
+    ///
+    template <auto Method, template <typename> typename Signal, typename T, typename Object>
+    static void connect(const Signal<T>* signal, Object* slotObj) {
+        cs::Lock lock(mutex_);
+        auto obj = cs::Connector::checkConnection(static_cast<const ISignal*>(signal), slotObj, std::is_base_of<IConnectable, Object>());
+        const_cast<Signal<T>*>(signal)->template add<Method>(slotObj, obj);
     }
 
     ///
@@ -435,22 +607,27 @@ public:
             return false;
         }
 
-        constexpr int size = cshelper::GetArguments<Slot>();
-        std::function<T> binder = cshelper::CheckArgs<size>().connect(slotObj, std::forward<Slot>(slot));
-
         cs::Lock lock(mutex_);
         auto& content = const_cast<Signal<T>*>(signal)->content();
-        auto iterator = std::find_if(content.begin(), content.end(), [&](const auto& pair) {
-            auto& [object, function] = pair;
+        auto iterator = content.end();
+
+        if constexpr (std::is_pointer_v<Object> && std::is_member_function_pointer_v<std::decay_t<Slot>>) {
+            iterator = std::find_if(content.begin(), content.end(), [&](const auto& s) {
+                return Signal<T>::isMethod(s, slotObj, std::decay_t<Slot>(slot));
+            });
+        }
+        else {
+            constexpr int size = cshelper::GetArguments<Slot>();
+            typename Signal<T>::Argument binder = cshelper::CheckArgs<size>().connect(slotObj, std::forward<Slot>(slot));
 
-            if (object) {
-                if (object == (slotObj)) {
-                    return function.target_type().hash_code() == binder.target_type().hash_code();
+            iterator = std::find_if(content.begin(), content.end(), [&](const auto& s) {
+                if (s.object && s.object == (slotObj) && s.function) {
+                    return s.function.target_type().hash_code() == binder.target_type().hash_code();
                 }
-            }
 
-            return false;
-        });
+                return false;
+            });
+        }
 
         if (iterator != content.end()) {
             content.erase(iterator);
@@ -469,11 +646,9 @@ public:
     static bool disconnect(const Signal<T>* signal, typename Signal<T>::Argument slot) {
         cs::Lock lock(mutex_);
         auto& content = const_cast<Signal<T>*>(signal)->content();
-        auto iterator = std::find_if(content.begin(), content.end(), [&](const auto& pair) {
-            auto& [object, function] = pair;
-
-            if (!object) {
-                return function.target_type().hash_code() == slot.target_type().hash_code();
+        auto iterator = std::find_if(content.begin(), content.end(), [&](const auto& s) {
+            if (!s.object && s.function) {
+                return s.function.target_type().hash_code() == slot.target_type().hash_code();
             }
 
             return false;
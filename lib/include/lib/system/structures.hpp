@@ -5,9 +5,13 @@
 #include <cstdlib>
 #include <cstring>
 #include <functional>
+#include <mutex>
+#include <new>
+#include <type_traits>
 
 #include "allocators.hpp"
 #include "cache.hpp"
+#include "common.hpp"
 
 /* Containers */
 template <typename BufferType>
@@ -324,66 +328,123 @@ private:
     Element** buckets_;
 };
 
+///
+/// Calls deferred to the thread calling callAll, the latest inserted call is made first.
+///
+/// Calls are kept in pooled nodes and callables up to kCallSize bytes are stored in node itself,
+/// so insert does not allocate once the pool has grown to the usual number of pending calls.
+///
 class CallsQueue {
 public:
-    struct Call {
-        __cacheline_aligned std::atomic<Call*> next;
-        std::function<void()> func;
-    };
+    constexpr static size_t kCallSize = 64;
 
     static CallsQueue& instance() {
         static CallsQueue inst;
         return inst;
     }
 
+    ~CallsQueue();
+
     // Called from a single thread
     inline void callAll();
-    inline void insert(std::function<void()>);
+
+    template <typename Func>
+    void insert(Func&& func);
 
 private:
-    CallsQueue() {
-    }
+    struct Call {
+        Call* next = nullptr;
+        void (*invoke)(Call&) = nullptr;
+        void (*destroy)(Call&) = nullptr;
+        alignas(std::max_align_t) cs::Byte storage[kCallSize];
+    };
+
+    CallsQueue() = default;
+
+    inline Call* acquire();
+    inline void recycle(Call* first, Call* last);
+
     __cacheline_aligned std::atomic<Call*> head_ = {nullptr};
+
+    cs::SpinLock poolLock_{ATOMIC_FLAG_INIT};
+    Call* pool_ = nullptr;
 };
 
-inline void CallsQueue::callAll() {
-    Call* startHead = head_.load(std::memory_order_relaxed);
+inline CallsQueue::~CallsQueue() {
+    for (Call* call = head_.load(std::memory_order_acquire); call;) {
+        Call* next = call->next;
+        call->destroy(*call);
+        delete call;
+        call = next;
+    }
+
+    for (Call* call = pool_; call;) {
+        Call* next = call->next;
+        delete call;
+        call = next;
+    }
+}
 
-    if (!startHead) {
+inline void CallsQueue::callAll() {
+    if (!head_.load(std::memory_order_relaxed)) {
         return;
     }
 
-    Call* newHead = startHead;
-    head_.compare_exchange_strong(newHead, nullptr, std::memory_order_relaxed, std::memory_order_relaxed);
-    Call* elt = startHead;
+    // calls are pushed to front, so the newest one is made first
+    Call* first = head_.exchange(nullptr, std::memory_order_acquire);
+    Call* last = first;
 
-    do {
-        elt->func();
-        Call* rem = elt;
-        elt = rem->next.load(std::memory_order_relaxed);
-        delete rem;
-    } while (elt);
-
-    if (newHead != startHead) {
-        do {
-            Call* next = newHead->next.load(std::memory_order_relaxed);
-            if (next == startHead)
-                break;
-            newHead = next;
-        } while (true);
-
-        newHead->next.store(nullptr, std::memory_order_relaxed);
+    for (Call* call = first; call; call = call->next) {
+        call->invoke(*call);
+        call->destroy(*call);
+        last = call;
     }
+
+    recycle(first, last);
 }
 
-inline void CallsQueue::insert(std::function<void()> f) {
-    Call* newElt = new Call;
-    newElt->func = f;
+template <typename Func>
+void CallsQueue::insert(Func&& func) {
+    using Type = std::decay_t<Func>;
+    Call* call = acquire();
+
+    if constexpr (sizeof(Type) <= kCallSize && alignof(Type) <= alignof(std::max_align_t)) {
+        new (call->storage) Type(std::forward<Func>(func));
+        call->invoke = [](Call& target) { (*std::launder(reinterpret_cast<Type*>(target.storage)))(); };
+        call->destroy = [](Call& target) { std::launder(reinterpret_cast<Type*>(target.storage))->~Type(); };
+    }
+    else {
+        // big callables are rare, they take own allocation
+        new (call->storage) Type*(new Type(std::forward<Func>(func)));
+        call->invoke = [](Call& target) { (**std::launder(reinterpret_cast<Type**>(target.storage)))(); };
+        call->destroy = [](Call& target) { delete *std::launder(reinterpret_cast<Type**>(target.storage)); };
+    }
 
     Call* head = head_.load(std::memory_order_relaxed);
+
     do {
-        newElt->next.store(head, std::memory_order_relaxed);
-    } while (!head_.compare_exchange_weak(head, newElt, std::memory_order_acquire, std::memory_order_relaxed));
+        call->next = head;
+    } while (!head_.compare_exchange_weak(head, call, std::memory_order_release, std::memory_order_relaxed));
+}
+
+inline CallsQueue::Call* CallsQueue::acquire() {
+    {
+        std::lock_guard lock(poolLock_);
+
+        if (pool_) {
+            Call* call = pool_;
+            pool_ = call->next;
+            return call;
+        }
+    }
+
+    return new Call;
+}
+
+inline void CallsQueue::recycle(Call* first, Call* last) {
+    std::lock_guard lock(poolLock_);
+    last->next = pool_;
+    pool_ = first;
 }
 
 template <size_t Length>
@@ -1,11 +1,326 @@
 #include <lib/system/logger.hpp>
 
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <thread>
+
+#include <boost/date_time/c_local_time_adjustor.hpp>
+#include <boost/date_time/posix_time/conversion.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/log/core.hpp>
+#include <boost/log/detail/thread_id.hpp>
 #include <boost/log/utility/setup/common_attributes.hpp>
 #include <boost/log/utility/setup/filter_parser.hpp>
 #include <boost/log/utility/setup/formatter_parser.hpp>
 #include <boost/log/utility/setup/from_settings.hpp>
 
+#include <lib/system/cache.hpp>
+
+namespace {
+constexpr size_t kRingSize = 256 * 1024;
+constexpr auto kIdleWait = std::chrono::milliseconds(5);
+
+std::atomic<uint64_t> filtersGeneration{1};
+std::atomic<uint64_t> droppedCount{0};
+
+///
+/// Records of one thread, single producer and single consumer.
+///
+class Ring {
+public:
+    explicit Ring(const logger::detail::ThreadId& thread)
+    : thread_(thread)
+    , data_(kRingSize) {
+    }
+
+    const logger::detail::ThreadId& thread() const {
+        return thread_;
+    }
+
+    // called by thread of ring
+    bool push(const std::vector<uint8_t>& record) {
+        const auto size = static_cast<uint32_t>(record.size());
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+
+        if (kRingSize - (tail - head) < sizeof(size) + size) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        write(tail, &size, sizeof(size));
+        write(tail + sizeof(size), record.data(), size);
+
+        tail_.store(tail + sizeof(size) + size, std::memory_order_release);
+        return true;
+    }
+
+    // called by background thread, returns false if ring is empty
+    template <typename Func>
+    bool pop(std::vector<uint8_t>& record, Func func) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+
+        if (head == tail) {
+            return false;
+        }
+
+        while (head != tail) {
+            uint32_t size = 0;
+            read(head, &size, sizeof(size));
+
+            record.resize(size);
+            read(head + sizeof(size), record.data(), size);
+
+            head += sizeof(size) + size;
+            func(record);
+        }
+
+        head_.store(head, std::memory_order_release);
+        return true;
+    }
+
+    uint64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    // drops reported by background thread
+    uint64_t reported = 0;
+
+    // thread of ring is finished, ring is removed when it is drained
+    std::atomic<bool> isClosed{false};
+
+private:
+    void write(size_t position, const void* data, size_t size) {
+        const size_t offset = position % kRingSize;
+        const size_t first = std::min(size, kRingSize - offset);
+
+        std::memcpy(data_.data() + offset, data, first);
+        std::memcpy(data_.data(), static_cast<const uint8_t*>(data) + first, size - first);
+    }
+
+    void read(size_t position, void* data, size_t size) const {
+        const size_t offset = position % kRingSize;
+        const size_t first = std::min(size, kRingSize - offset);
+
+        std::memcpy(data, data_.data() + offset, first);
+        std::memcpy(static_cast<uint8_t*>(data) + first, data_.data(), size - first);
+    }
+
+    const logger::detail::ThreadId thread_;
+    std::vector<uint8_t> data_;
+
+    __cacheline_aligned std::atomic<size_t> head_{0};
+    __cacheline_aligned std::atomic<size_t> tail_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+// formats record and passes it to Boost::Log
+void emitRecord(const std::vector<uint8_t>& record, const logger::detail::ThreadId& thread, std::ostringstream& stream) {
+    using logger::detail::ArgType;
+
+    logger::detail::Header header;
+    std::memcpy(&header, record.data(), sizeof(header));
+
+    static const std::ios defaults(nullptr);
+
+    stream.str(std::string{});
+    stream.clear();
+    stream.copyfmt(defaults);
+
+    const uint8_t* data = record.data() + sizeof(header);
+    const uint8_t* end = record.data() + record.size();
+
+    auto get = [&data](auto& value) {
+        std::memcpy(&value, data, sizeof(value));
+        data += sizeof(value);
+    };
+
+    while (data < end) {
+        ArgType type;
+        get(type);
+
+        switch (type) {
+            case ArgType::Signed: {
+                int64_t value;
+                get(value);
+                stream << value;
+                break;
+            }
+            case ArgType::Unsigned: {
+                uint64_t value;
+                get(value);
+                stream << value;
+                break;
+            }
+            case ArgType::Double: {
+                double value;
+                get(value);
+                stream << value;
+                break;
+            }
+            case ArgType::Bool: {
+                bool value;
+                get(value);
+                stream << value;
+                break;
+            }
+            case ArgType::Char: {
+                char value;
+                get(value);
+                stream << value;
+                break;
+            }
+            case ArgType::Pointer: {
+                uintptr_t value;
+                get(value);
+                stream << reinterpret_cast<const void*>(value);
+                break;
+            }
+            case ArgType::String: {
+                uint32_t size;
+                get(size);
+                stream.write(reinterpret_cast<const char*>(data), size);
+                data += size;
+                break;
+            }
+        }
+    }
+
+    header.write(header.level, logger::detail::Stamp{header.time, thread}, stream.str());
+}
+
+///
+/// Background thread writing records of all thread rings.
+///
+class Backend {
+public:
+    static Backend& instance() {
+        static Backend backend;
+        return backend;
+    }
+
+    ~Backend() {
+        stop();
+    }
+
+    bool isRunning() const {
+        return isRunning_.load(std::memory_order_acquire);
+    }
+
+    void start() {
+        std::lock_guard lock(mutex_);
+
+        if (isRunning()) {
+            return;
+        }
+
+        isStopped_ = false;
+        isRunning_.store(true, std::memory_order_release);
+        worker_ = std::thread(&Backend::run, this);
+    }
+
+    // writes all queued records
+    void stop() {
+        {
+            std::lock_guard lock(mutex_);
+
+            if (!isRunning()) {
+                return;
+            }
+
+            isRunning_.store(false, std::memory_order_release);
+            isStopped_ = true;
+        }
+
+        condition_.notify_one();
+        worker_.join();
+
+        std::lock_guard lock(mutex_);
+        drain();
+    }
+
+    std::shared_ptr<Ring> registerRing() {
+        auto ring = std::make_shared<Ring>(logging::aux::this_thread::get_id());
+
+        std::lock_guard lock(mutex_);
+        rings_.push_back(ring);
+
+        return ring;
+    }
+
+private:
+    void run() {
+        std::unique_lock lock(mutex_);
+
+        while (!isStopped_) {
+            if (!drain()) {
+                condition_.wait_for(lock, kIdleWait);
+            }
+        }
+    }
+
+    // called under mutex_, rings are registered once per thread
+    bool drain() {
+        bool isDrained = false;
+
+        for (auto it = rings_.begin(); it != rings_.end();) {
+            auto& ring = **it;
+            const bool isClosed = ring.isClosed.load(std::memory_order_acquire);
+
+            isDrained |= ring.pop(record_, [&](const std::vector<uint8_t>& record) { emitRecord(record, ring.thread(), stream_); });
+
+            if (const auto count = ring.dropped(); count != ring.reported) {
+                logger::Record<>::write(logger::severity_level::warning, stamp(ring), std::to_string(count - ring.reported) + " log records dropped on overflow");
+                ring.reported = count;
+            }
+
+            it = isClosed ? rings_.erase(it) : it + 1;
+        }
+
+        return isDrained;
+    }
+
+    static logger::detail::Stamp stamp(const Ring& ring) {
+        return logger::detail::Stamp{std::chrono::system_clock::now().time_since_epoch().count(), ring.thread()};
+    }
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::thread worker_;
+
+    std::atomic<bool> isRunning_{false};
+    bool isStopped_ = false;
+
+    std::vector<std::shared_ptr<Ring>> rings_;
+
+    // used by background thread only
+    std::vector<uint8_t> record_;
+    std::ostringstream stream_;
+};
+
+// ring of thread is closed when thread exits
+struct RingHolder {
+    ~RingHolder() {
+        if (ring) {
+            ring->isClosed.store(true, std::memory_order_release);
+        }
+    }
+
+    std::shared_ptr<Ring> ring;
+};
+
+struct Buffers {
+    std::vector<std::unique_ptr<logger::detail::Buffer>> buffers;
+    size_t depth = 0;
+};
+
+thread_local Buffers buffers;
+thread_local RingHolder ringHolder;
+}  // namespace
+
 namespace logger {
 void initialize(const logging::settings& settings) {
     logging::add_common_attributes();
@@ -16,9 +331,66 @@ void initialize(const logging::settings& settings) {
     logging::register_simple_filter_factory<severity_level>(logging::trivial::tag::severity::get_name());
 
     logging::init_from_settings(settings);
+
+    filtersGeneration.fetch_add(1, std::memory_order_relaxed);
+    Backend::instance().start();
 }
 
 void cleanup() {
+    Backend::instance().stop();
     logging::core::get()->remove_all_sinks();
+
+    filtersGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t droppedRecords() {
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+namespace detail {
+Buffer& acquireBuffer() {
+    if (buffers.depth == buffers.buffers.size()) {
+        buffers.buffers.push_back(std::make_unique<Buffer>());
+    }
+
+    Buffer& buffer = *buffers.buffers[buffers.depth++];
+    buffer.bytes.clear();
+    buffer.isFormatted = false;
+
+    return buffer;
+}
+
+void commit(Buffer& buffer) {
+    if (Backend::instance().isRunning()) {
+        if (!ringHolder.ring) {
+            ringHolder.ring = Backend::instance().registerRing();
+        }
+
+        ringHolder.ring->push(buffer.bytes);
+    }
+    else {
+        thread_local std::ostringstream stream;
+        emitRecord(buffer.bytes, logging::aux::this_thread::get_id(), stream);
+    }
+
+    --buffers.depth;
+}
+
+uint64_t filtersGeneration() {
+    return ::filtersGeneration.load(std::memory_order_relaxed);
+}
+
+void StampAttributes::set(const Stamp& stamp) {
+    using namespace boost::posix_time;
+
+    const auto duration = std::chrono::system_clock::duration(stamp.time);
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration);
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(duration - seconds);
+
+    const ptime utc = from_time_t(static_cast<std::time_t>(seconds.count())) + microseconds(micros.count());
+
+    timeStamp_.set(boost::date_time::c_local_adjustor<ptime>::utc_to_local(utc));
+    threadId_.set(stamp.thread);
 }
+}  // namespace detail
 }  // namespace logger
@@ -0,0 +1,252 @@
+#include <lib/system/metrics.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+std::atomic<size_t> shardsCounter{0};
+
+const char* typeName(cs::metrics::Type type) {
+    switch (type) {
+        case cs::metrics::Type::Counter:
+            return "counter";
+        case cs::metrics::Type::Gauge:
+            return "gauge";
+        case cs::metrics::Type::Summary:
+            return "summary";
+    }
+
+    return "untyped";
+}
+
+std::string formatDouble(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    return buffer;
+}
+
+// name{labels,extra} value
+void writeSample(std::string& out, const std::string& name, const std::string& labels, const std::string& extra, const std::string& value) {
+    out += name;
+
+    if (!labels.empty() || !extra.empty()) {
+        out += '{';
+        out += labels;
+
+        if (!labels.empty() && !extra.empty()) {
+            out += ',';
+        }
+
+        out += extra;
+        out += '}';
+    }
+
+    out += ' ';
+    out += value;
+    out += '\n';
+}
+
+// help text may not contain line breaks
+std::string escapeHelp(const std::string& help) {
+    std::string result;
+    result.reserve(help.size());
+
+    for (const char c : help) {
+        if (c == '\\') {
+            result += "\\\\";
+        }
+        else if (c == '\n') {
+            result += "\\n";
+        }
+        else {
+            result += c;
+        }
+    }
+
+    return result;
+}
+}  // namespace
+
+namespace cs::metrics {
+namespace detail {
+size_t nextShard() {
+    return shardsCounter.fetch_add(1, std::memory_order_relaxed) % kShardsCount;
+}
+}  // namespace detail
+
+void setEnabled(bool enabled) {
+    detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::string label(const std::string& key, const std::string& value) {
+    std::string result = key + "=\"";
+
+    for (const char c : value) {
+        if (c == '\\' || c == '"') {
+            result += '\\';
+            result += c;
+        }
+        else if (c == '\n') {
+            result += "\\n";
+        }
+        else {
+            result += c;
+        }
+    }
+
+    result += '"';
+    return result;
+}
+
+uint64_t Counter::value() const {
+    uint64_t result = 0;
+
+    for (const auto& shard : shards_) {
+        result += shard.value.load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+void Counter::write(std::string& out) const {
+    writeSample(out, name(), labels(), std::string{}, std::to_string(value()));
+}
+
+void Gauge::write(std::string& out) const {
+    writeSample(out, name(), labels(), std::string{}, std::to_string(value()));
+}
+
+double Histogram::Snapshot::quantile(double value) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    const auto rank = static_cast<uint64_t>(std::ceil(std::clamp(value, 0.0, 1.0) * static_cast<double>(count)));
+    uint64_t accumulated = 0;
+
+    for (size_t i = 0; i < kBucketsCount; ++i) {
+        accumulated += buckets[i];
+
+        if (accumulated >= std::max<uint64_t>(rank, 1)) {
+            if (i < kSubBuckets) {
+                return static_cast<double>(i);
+            }
+
+            // middle of bucket
+            const double lower = static_cast<double>(lowerBound(i));
+            const double upper = (i + 1 < kBucketsCount) ? static_cast<double>(lowerBound(i + 1)) : std::ldexp(1.0, 64);
+
+            return (lower + upper - 1) / 2;
+        }
+    }
+
+    return static_cast<double>(lowerBound(kBucketsCount - 1));
+}
+
+uint64_t Histogram::lowerBound(size_t bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+
+    const size_t shift = (bucket - kSubBuckets) / kSubBuckets;
+    const size_t subBucket = (bucket - kSubBuckets) % kSubBuckets;
+
+    return static_cast<uint64_t>(kSubBuckets + subBucket) << shift;
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot result;
+
+    for (const auto& shard : shards_) {
+        for (size_t i = 0; i < kBucketsCount; ++i) {
+            const auto value = shard.buckets[i].load(std::memory_order_relaxed);
+            result.buckets[i] += value;
+            result.count += value;
+        }
+
+        result.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+void Histogram::write(std::string& out) const {
+    static const std::array<std::pair<double, const char*>, 4> quantiles = {{{0.5, "0.5"}, {0.9, "0.9"}, {0.99, "0.99"}, {0.999, "0.999"}}};
+
+    const auto values = snapshot();
+
+    for (const auto& [quantile, text] : quantiles) {
+        writeSample(out, name(), labels(), label("quantile", text), formatDouble(values.quantile(quantile) * scale_));
+    }
+
+    writeSample(out, name() + "_sum", labels(), std::string{}, formatDouble(static_cast<double>(values.sum) * scale_));
+    writeSample(out, name() + "_count", labels(), std::string{}, std::to_string(values.count));
+}
+
+Registry& Registry::instance() {
+    static Registry registry;
+    return registry;
+}
+
+Counter& Registry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    return add<Counter>(Type::Counter, name, help, labels);
+}
+
+Gauge& Registry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    return add<Gauge>(Type::Gauge, name, help, labels);
+}
+
+Histogram& Registry::histogram(const std::string& name, const std::string& help, const std::string& labels, double scale) {
+    return add<Histogram>(Type::Summary, name, help, labels, scale);
+}
+
+template <typename T, typename... Args>
+T& Registry::add(Type type, const std::string& name, const std::string& help, const std::string& labels, Args&&... args) {
+    std::lock_guard lock(mutex_);
+
+    const std::string key = name + '{' + labels + '}';
+
+    if (auto it = index_.find(key); it != index_.end()) {
+        if (it->second->type() != type) {
+            throw std::invalid_argument("Metric " + key + " is already registered with another type");
+        }
+
+        return static_cast<T&>(*it->second);
+    }
+
+    auto family = std::find_if(families_.begin(), families_.end(), [&](const Family& f) { return f.name == name; });
+
+    if (family == families_.end()) {
+        families_.push_back(Family{name, help, type, {}});
+        family = families_.end() - 1;
+    }
+    else if (family->type != type) {
+        throw std::invalid_argument("Metric " + name + " is already registered with another type");
+    }
+
+    auto& metric = metrics_.emplace_back(std::make_unique<T>(name, labels, std::forward<Args>(args)...));
+
+    index_.emplace(key, metric.get());
+    family->metrics.push_back(metric.get());
+
+    return static_cast<T&>(*metric);
+}
+
+std::string Registry::exposition() const {
+    std::string result;
+    std::lock_guard lock(mutex_);
+
+    for (const auto& family : families_) {
+        result += "# HELP " + family.name + ' ' + escapeHelp(family.help) + '\n';
+        result += "# TYPE " + family.name + ' ' + typeName(family.type) + '\n';
+
+        for (const auto metric : family.metrics) {
+            metric->write(result);
+        }
+    }
+
+    return result;
+}
+}  // namespace cs::metrics
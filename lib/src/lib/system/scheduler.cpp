@@ -0,0 +1,228 @@
+#include "lib/system/scheduler.hpp"
+
+#include <algorithm>
+
+#include <lib/system/logger.hpp>
+
+namespace {
+// tasks still sleep sometimes, a few more workers than cores keep cores busy
+constexpr unsigned kMinWorkersCount = 4;
+constexpr auto kNoDelayed = std::numeric_limits<cs::Scheduler::Clock::rep>::max();
+
+thread_local const cs::Scheduler* currentScheduler = nullptr;
+thread_local size_t currentIndex = cs::Scheduler::kNoAffinity;
+}  // namespace
+
+cs::Scheduler::Scheduler(size_t workersCount)
+: nearest_(kNoDelayed) {
+    workersCount = std::max<size_t>(workersCount, 1);
+
+    for (size_t i = 0; i < workersCount; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    for (size_t i = 0; i < workersCount; ++i) {
+        threads_.emplace_back(&Scheduler::work, this, i);
+    }
+}
+
+cs::Scheduler::~Scheduler() {
+    {
+        std::lock_guard lock(mutex_);
+        isStopped_ = true;
+    }
+
+    condition_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+cs::Scheduler& cs::Scheduler::instance() {
+    static Scheduler scheduler(std::max(std::thread::hardware_concurrency(), kMinWorkersCount));
+    return scheduler;
+}
+
+void cs::Scheduler::post(Task task, TaskPriority priority, size_t affinity) {
+    size_t index = 0;
+
+    if (affinity != kNoAffinity) {
+        index = affinity % queues_.size();
+    }
+    else if (currentScheduler == this) {
+        index = currentIndex;
+    }
+    else {
+        index = turn_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    }
+
+    push(index, std::move(task), priority);
+}
+
+void cs::Scheduler::postAfter(std::chrono::milliseconds delay, Task task, TaskPriority priority) {
+    const auto time = Clock::now() + delay;
+
+    {
+        std::lock_guard lock(mutex_);
+        delayed_.emplace(time, Delayed{std::move(task), priority});
+        nearest_.store(delayed_.begin()->first.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    // sleeping worker takes new deadline
+    condition_.notify_one();
+}
+
+size_t cs::Scheduler::currentWorker() const noexcept {
+    return currentScheduler == this ? currentIndex : kNoAffinity;
+}
+
+void cs::Scheduler::push(size_t index, Task&& task, TaskPriority priority) {
+    auto& queue = *queues_[index];
+
+    {
+        std::lock_guard lock(queue.lock);
+        queue.tasks[static_cast<size_t>(priority)].push_back(std::move(task));
+    }
+
+    pending_.fetch_add(1);
+    wake();
+}
+
+void cs::Scheduler::wake() {
+    // pending counter is changed before idle one is read, worker changes them in reverse order
+    if (idle_.load() == 0) {
+        return;
+    }
+
+    // woken worker wakes the next one if tasks are left, so posts do not notify each
+    if (isWaking_.exchange(true)) {
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+    }
+
+    condition_.notify_one();
+}
+
+bool cs::Scheduler::take(size_t index, Task& task) {
+    if (pending_.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    auto& queue = *queues_[index];
+
+    for (size_t priority = 0; priority < kPriorities; ++priority) {
+        {
+            std::lock_guard lock(queue.lock);
+            auto& tasks = queue.tasks[priority];
+
+            if (!tasks.empty()) {
+                task = std::move(tasks.front());
+                tasks.pop_front();
+
+                pending_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        if (steal(index, priority, task)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool cs::Scheduler::steal(size_t index, size_t priority, Task& task) {
+    for (size_t i = 1; i < queues_.size(); ++i) {
+        auto& queue = *queues_[(index + i) % queues_.size()];
+
+        // owner takes from front, thief takes the latest task from back
+        std::lock_guard lock(queue.lock);
+        auto& tasks = queue.tasks[priority];
+
+        if (!tasks.empty()) {
+            task = std::move(tasks.back());
+            tasks.pop_back();
+
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void cs::Scheduler::release() {
+    std::vector<Delayed> due;
+
+    {
+        std::lock_guard lock(mutex_);
+        const auto now = Clock::now();
+
+        while (!delayed_.empty() && delayed_.begin()->first <= now) {
+            due.push_back(std::move(delayed_.begin()->second));
+            delayed_.erase(delayed_.begin());
+        }
+
+        nearest_.store(delayed_.empty() ? kNoDelayed : delayed_.begin()->first.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    for (auto& delayed : due) {
+        push(turn_.fetch_add(1, std::memory_order_relaxed) % queues_.size(), std::move(delayed.task), delayed.priority);
+    }
+}
+
+void cs::Scheduler::work(size_t index) {
+    currentScheduler = this;
+    currentIndex = index;
+
+    Task task;
+
+    while (!isStopped_.load(std::memory_order_relaxed)) {
+        if (nearest_.load(std::memory_order_relaxed) <= Clock::now().time_since_epoch().count()) {
+            release();
+        }
+
+        if (take(index, task)) {
+            if (pending_.load(std::memory_order_relaxed) != 0) {
+                wake();
+            }
+
+            try {
+                task();
+            }
+            catch (const std::exception& exception) {
+                cserror() << "Scheduler task failed, " << exception.what();
+            }
+            catch (...) {
+                cserror() << "Scheduler task failed";
+            }
+
+            task = Task{};
+            continue;
+        }
+
+        std::unique_lock lock(mutex_);
+        idle_.fetch_add(1);
+
+        // waking flag may be left by notification nobody waited for
+        isWaking_ = false;
+
+        if (!isStopped_ && pending_.load() == 0) {
+            // any wake up goes to the next round, delayed tasks are released there
+            if (delayed_.empty()) {
+                condition_.wait(lock);
+            }
+            else {
+                condition_.wait_until(lock, delayed_.begin()->first);
+            }
+        }
+
+        idle_.fetch_sub(1);
+        isWaking_ = false;
+    }
+}
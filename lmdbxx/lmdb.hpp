@@ -1,10 +1,13 @@
 #ifndef LMDBXX_HPP
 #define LMDBXX_HPP
 
+#include <atomic>
 #include <cassert>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 
 #include <lmdbexception.hpp>
 
@@ -61,6 +64,9 @@ public:
     }
 
     void close() {
+        // writes of not finished batch are kept
+        commitBatchTransaction();
+
         env_->close();
         isOpen_ = false;
     }
@@ -137,7 +143,7 @@ public:
     // name - table name at current path, nullptr if only one table exist
     size_t size(const char* name = nullptr) const {
         try {
-            auto transaction = lmdb::txn::begin(*env_, nullptr, MDB_RDONLY);
+            auto transaction = begin(MDB_RDONLY);
             auto dbi = lmdb::dbi::open(transaction, name);
 
             return dbi.size(transaction);
@@ -154,6 +160,74 @@ public:
         return size() == 0;
     }
 
+    // creates named table if it does not exist yet,
+    // environment must be opened with enough max dbs
+    void createTable(const char* name) {
+        checkWrite();
+
+        try {
+            auto transaction = begin();
+            lmdb::dbi::open(transaction, name, MDB_CREATE);
+            transaction.commit();
+        }
+        catch(const lmdb::error& error) {
+            failWrite(error);
+        }
+    }
+
+    /// batches
+
+    // opens write batch: all reads and writes of the calling thread go to one transaction until
+    // the outermost commitBatch, nested batches join the opened one. Batch spans all tables of environment.
+    // Transaction of batch is committed early if it may outgrow free space of map, on write error
+    // not committed writes of batch are lost and failed signal is generated
+    void beginBatch() {
+        assert(batchDepth_ == 0 || batchThread_ == std::this_thread::get_id());
+
+        if (batchDepth_++ == 0) {
+            batchThread_.store(std::this_thread::get_id(), std::memory_order_release);
+        }
+    }
+
+    // commits batch if it is the outermost one
+    void commitBatch() {
+        assert(batchDepth_ != 0);
+
+        if (--batchDepth_ == 0) {
+            commitBatchTransaction();
+            batchThread_.store(std::thread::id{}, std::memory_order_release);
+        }
+    }
+
+    // returns true if batch is opened by the calling thread, safe to call from any thread
+    bool isBatchOpened() const {
+        return batchDepth_.load(std::memory_order_acquire) != 0 && batchThread_.load(std::memory_order_acquire) == std::this_thread::get_id();
+    }
+
+    // returns count of commited transactions
+    size_t commitsCount() const {
+        return commitsCount_;
+    }
+
+    // scoped write batch
+    class Batch {
+    public:
+        explicit Batch(Lmdb& db)
+        : db_(db) {
+            db_.beginBatch();
+        }
+
+        ~Batch() {
+            db_.commitBatch();
+        }
+
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+    private:
+        Lmdb& db_;
+    };
+
     /// transactions
 
     // inserts pair of key/value to database as byte stream,
@@ -162,11 +236,11 @@ public:
     void insert(const char* keyData, std::size_t keySize, const char* valueData, std::size_t valueSize,
                 const char* name = nullptr,
                 const unsigned int flags = lmdb::dbi::default_put_flags) {
-        checkMapSize();
+        checkWrite();
 
         try {
-            auto transaction = lmdb::txn::begin(*env_);
-            auto dbi = lmdb::dbi::open(transaction, name);
+            auto transaction = begin();
+            auto dbi = lmdb::dbi::open(transaction, name, name ? MDB_CREATE : lmdb::dbi::default_flags);
 
             lmdb::val key(reinterpret_cast<const void*>(keyData), keySize);
             lmdb::val value(reinterpret_cast<const void*>(valueData), valueSize);
@@ -174,10 +248,13 @@ public:
             dbi.put(transaction, key, value, flags);
             transaction.commit();
 
+            // in batch key is commited with transaction of batch
             emit commited(keyData, keySize);
+
+            checkBatchSize();
         }
         catch(const lmdb::error& error) {
-            raise(error);
+            failWrite(error);
         }
     }
 
@@ -198,10 +275,10 @@ public:
     // name - table name at current path, nullptr if only one table exist
     bool remove(const char* data, size_t size, const char* name = nullptr,
                 const unsigned int flags = lmdb::dbi::default_flags) {
-        checkMapSize();
+        checkWrite();
 
         try {
-            auto transaction = lmdb::txn::begin(*env_, nullptr);
+            auto transaction = begin();
             auto dbi = lmdb::dbi::open(transaction, name, flags);
 
             lmdb::val key(reinterpret_cast<const void*>(data), size);
@@ -210,12 +287,14 @@ public:
             if (result) {
                 transaction.commit();
                 emit removed(data, size);
+
+                checkBatchSize();
             }
 
             return result;
         }
         catch(const lmdb::error& error) {
-            raise(error);
+            failWrite(error);
         }
 
         return false;
@@ -232,7 +311,7 @@ public:
     // name - table name at current path
     bool isKeyExists(const char* data, size_t size, const char* name = nullptr) const {
         try {
-            auto transaction = lmdb::txn::begin(*env_, nullptr, MDB_RDONLY);
+            auto transaction = begin(MDB_RDONLY);
             auto dbi = lmdb::dbi::open(transaction, name);
             auto cursor = lmdb::cursor::open(transaction, dbi);
 
@@ -256,7 +335,7 @@ public:
     template<typename T>
     T value(const char* data, size_t size, const char* name = nullptr) const {
         try {
-            auto transaction = lmdb::txn::begin(*env_, nullptr, MDB_RDONLY);
+            auto transaction = begin(MDB_RDONLY);
             auto dbi = lmdb::dbi::open(transaction, name);
             auto cursor = lmdb::cursor::open(transaction, dbi);
 
@@ -279,16 +358,16 @@ public:
     // returns and cast to any result with interator consturctor,
     // any key with data/size methods
     template<typename T, typename Key>
-    T value(const Key& key) const {
+    T value(const Key& key, const char* name = nullptr) const {
         decltype(auto) k = cast(key);
-        return value<T>(reinterpret_cast<const char*>(k.data()), k.size());
+        return value<T>(reinterpret_cast<const char*>(k.data()), k.size(), name);
     }
 
     // returns last pair of key/value inserted to database
     template<typename Key, typename Value>
     std::pair<Key, Value> last(const char* name = nullptr) const {
         try {
-            auto transaction = lmdb::txn::begin(*env_, nullptr, MDB_RDONLY);
+            auto transaction = begin(MDB_RDONLY);
             auto dbi = lmdb::dbi::open(transaction, name);
             auto cursor = lmdb::cursor::open(transaction, dbi);
 
@@ -308,6 +387,65 @@ public:
         return std::make_pair<Key, Value>(Key{}, Value{});
     }
 
+    // returns pair of the greatest key not greater than searched one and its value,
+    // default constructed pair if there is no such key
+    template<typename Key, typename Value, typename SearchKey>
+    std::pair<Key, Value> floor(const SearchKey& searchKey, const char* name = nullptr) const {
+        try {
+            auto transaction = begin(MDB_RDONLY);
+            auto dbi = lmdb::dbi::open(transaction, name);
+            auto cursor = lmdb::cursor::open(transaction, dbi);
+
+            decltype(auto) k = cast(searchKey);
+            const std::string_view searched(reinterpret_cast<const char*>(k.data()), k.size());
+
+            lmdb::val key(reinterpret_cast<const void*>(searched.data()), searched.size());
+            lmdb::val value;
+
+            // the least key not less than searched one, or the last key if all keys are less
+            auto result = cursor.get(key, value, MDB_SET_RANGE);
+
+            if (!result) {
+                result = cursor.get(key, value, MDB_LAST);
+            }
+            else if (std::string_view(key.data(), key.size()) != searched) {
+                result = cursor.get(key, value, MDB_PREV);
+            }
+
+            if (result) {
+                return std::make_pair<Key, Value>(createResult<Key>(key), createResult<Value>(value));
+            }
+        }
+        catch (lmdb::error& error) {
+            raise(error);
+        }
+
+        return std::make_pair<Key, Value>(Key{}, Value{});
+    }
+
+    // calls func with each pair of key/value in order of keys until it returns false,
+    // std::string_view results point to database memory valid during the call only
+    template<typename Key, typename Value, typename Func>
+    void forEach(Func func, const char* name = nullptr) const {
+        try {
+            auto transaction = begin(MDB_RDONLY);
+            auto dbi = lmdb::dbi::open(transaction, name);
+            auto cursor = lmdb::cursor::open(transaction, dbi);
+
+            lmdb::val key;
+            lmdb::val value;
+
+            for (auto result = cursor.get(key, value, MDB_FIRST); result; result = cursor.get(key, value, MDB_NEXT)) {
+                if (!func(createResult<Key>(key), createResult<Value>(value))) {
+                    break;
+                }
+            }
+        }
+        catch (lmdb::error& error) {
+            raise(error);
+        }
+    }
+
 protected:
     void flushImpl(bool force) {
         try {
@@ -323,6 +461,97 @@ protected:
         emit failed(LmdbException(error));
     }
 
+    // transaction of one operation or borrowed write transaction of batch
+    class Transaction {
+    public:
+        Transaction(lmdb::txn&& transaction, size_t& commits)
+        : own_(std::move(transaction))
+        , handle_(own_->handle())
+        , commits_(&commits) {
+        }
+
+        explicit Transaction(MDB_txn* batch)
+        : handle_(batch) {
+        }
+
+        operator MDB_txn*() const {
+            return handle_;
+        }
+
+        // transaction of batch is commited by commitBatch
+        void commit() {
+            if (own_) {
+                own_->commit();
+                ++(*commits_);
+            }
+        }
+
+    private:
+        std::optional<lmdb::txn> own_;
+        MDB_txn* handle_;
+        size_t* commits_ = nullptr;
+    };
+
+    // reads of batch see its not commited writes, so they use transaction of batch if it is started
+    Transaction begin(const unsigned int flags = 0) const {
+        if (isBatchOpened() && (batchTransaction_ || !(flags & MDB_RDONLY))) {
+            if (!batchTransaction_) {
+                batchTransaction_.emplace(lmdb::txn::begin(*env_));
+                batchWrites_ = 0;
+            }
+
+            return Transaction(batchTransaction_->handle());
+        }
+
+        return Transaction(lmdb::txn::begin(*env_, nullptr, flags), commitsCount_);
+    }
+
+    // map size can be changed only while there is no opened transaction
+    void checkWrite() {
+        if (!isBatchOpened() || !batchTransaction_) {
+            checkMapSize();
+        }
+    }
+
+    void failWrite(const lmdb::error& error) {
+        if (isBatchOpened()) {
+            batchTransaction_.reset();
+        }
+
+        raise(error);
+    }
+
+    // batch transaction dirties pages of tree path and a leaf or two per write, it is commited before
+    // they may reach free space left by checkMapSize (with reserve for commit) and map is grown for the next one
+    void checkBatchSize() {
+        if (!isBatchOpened() || !batchTransaction_) {
+            return;
+        }
+
+        const auto metaStats = stats();
+        const size_t pages = metaStats.ms_depth + 2 * (++batchWrites_);
+
+        if (pages * metaStats.ms_psize >= increaseSize_ / 4) {
+            commitBatchTransaction();
+        }
+    }
+
+    void commitBatchTransaction() {
+        if (!batchTransaction_) {
+            return;
+        }
+
+        try {
+            batchTransaction_->commit();
+            ++commitsCount_;
+        }
+        catch(const lmdb::error& error) {
+            raise(error);
+        }
+
+        batchTransaction_.reset();
+    }
+
     template<typename T, typename = std::enable_if_t<(std::is_integral_v<T> || std::is_floating_point_v<T>)>>
     auto cast(const T& value) const {
 #ifndef __APPLE__
@@ -459,6 +688,14 @@ private:
     unsigned int flags_;
     size_t increaseSize_ = DefaultIncreaseSize;
 
+    // written by batch owner, read by readers of any thread
+    std::atomic<size_t> batchDepth_{0};
+    std::atomic<std::thread::id> batchThread_{};
+
+    mutable std::optional<lmdb::txn> batchTransaction_;
+    mutable size_t batchWrites_ = 0;
+    mutable size_t commitsCount_ = 0;
+
 public signals:
 
     // generates when data is written to drive
@@ -0,0 +1,119 @@
+#ifndef INBOUNDQUEUE_HPP
+#define INBOUNDQUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include <lib/system/structures.hpp>
+
+#include "pacmans.hpp"
+
+// classes of inbound packets in order of priority
+enum class MessageClass : uint8_t {
+    Consensus,      // stages, round tables, hashes, smart contracts consensus
+    Network,        // registration, pings, starter commands
+    Common,
+    Transactions,   // transactions packets and their requests
+    Sync,           // blocks requests and replies
+    Count
+};
+
+///
+/// Bounded queue of inbound packets between network processor and consensus executor.
+///
+/// Network processor classifies packets and puts them to queue of their class, packet is dropped
+/// if its class queue is full. Executor takes packets of the highest class first, unless a packet
+/// of lower class waits longer than kMaxWait, then the oldest of such packets is taken.
+///
+/// One thread pushes, one thread processes.
+///
+class InboundQueue {
+public:
+    using Clock = std::chrono::high_resolution_clock;
+
+    constexpr static size_t kClassesCount = static_cast<size_t>(MessageClass::Count);
+    constexpr static std::chrono::milliseconds kMaxWait{1000};
+
+    struct Stats {
+        uint64_t processed = 0;
+        uint64_t dropped = 0;
+        uint64_t totalWaitUs = 0;     // from receiving by socket to processing
+        uint64_t maxWaitUs = 0;
+    };
+
+    MessageClass classify(const Packet& pack);
+
+    // returns false and leaves task if packet is dropped
+    bool push(TaskPtr<IPacMan>& task, MessageClass messageClass);
+
+    // waits for packet up to timeout, returns false if there is no packet
+    template <typename Func>
+    bool process(std::chrono::milliseconds timeout, Func&& func);
+
+    void stop();
+
+    size_t size() const {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    Stats stats(MessageClass messageClass) const;
+
+    static const char* classToString(MessageClass messageClass);
+
+private:
+    struct Counters {
+        std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> totalWaitUs{0};
+        std::atomic<uint64_t> maxWaitUs{0};
+    };
+
+    bool wait(std::chrono::milliseconds timeout);
+    size_t choose();
+    void account(size_t index, Clock::time_point received);
+
+    std::array<IPacMan, kClassesCount> queues_;
+    std::array<Counters, kClassesCount> counters_;
+
+    std::atomic<size_t> size_{0};
+    std::atomic<bool> isWaiting_{false};
+    bool isStopped_ = false;
+
+    // executor thread only
+    size_t turn_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+
+    // the first fragment carries message type, class of the others is taken by header hash
+    FixedHashMap<cs::Hash, uint8_t, uint32_t, 16384> fragmentClasses_;
+};
+
+template <typename Func>
+bool InboundQueue::process(std::chrono::milliseconds timeout, Func&& func) {
+    if (!wait(timeout)) {
+        return false;
+    }
+
+    const auto index = choose();
+    bool isEmpty = false;
+
+    auto task = queues_[index].getNextTask(isEmpty);
+
+    if (isEmpty) {
+        return false;
+    }
+
+    size_.fetch_sub(1, std::memory_order_acq_rel);
+    account(index, task->timestamp);
+
+    func(task);
+    task.release();
+
+    return true;
+}
+
+#endif  // INBOUNDQUEUE_HPP
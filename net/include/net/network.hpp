@@ -8,6 +8,7 @@
 #include <boost/asio.hpp>
 
 #include <lib/system/cache.hpp>
+#include "inboundqueue.hpp"
 #include "pacmans.hpp"
 
 using io_context = boost::asio::io_context;
@@ -49,6 +50,7 @@ private:
     void readerRoutine();
     void writerRoutine();
     void processorRoutine();
+    void executorRoutine();
     inline void processTask(TaskPtr<IPacMan>&);
 
     ip::udp::socket* getSocketInThread(const bool, const EndpointData&, std::atomic<ThreadStatus>&, const bool useIPv6);
@@ -57,6 +59,7 @@ private:
     bool stopReaderRoutine = false;
     bool stopWriterRoutine = false;
     bool stopProcessorRoutine = false;
+    bool stopExecutorRoutine = false;
 
     io_context context_;
     ip::udp::resolver resolver_;
@@ -64,6 +67,9 @@ private:
     IPacMan iPacMan_;
     OPacMan oPacMan_;
 
+    // processor thread classifies packets, executor thread handles them by priority
+    InboundQueue inboundQueue_;
+
     Transport* transport_;
 
     FixedHashMap<cs::Hash, uint32_t, uint32_t, MaxRememberPackets> packetMap_;
@@ -79,6 +85,7 @@ private:
     std::thread readerThread_;
     std::thread writerThread_;
     std::thread processorThread_;
+    std::thread executorThread_;
 
     PacketCollector collector_;
 #ifdef __linux__
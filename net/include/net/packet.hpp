@@ -12,6 +12,7 @@
 
 #include <lz4.h>
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -87,6 +88,8 @@ enum MsgTypes : uint8_t {
     EmptyRoundPack,
     BlockAlarm,
     EventReport,
+    TransactionProofRequest,
+    TransactionProofReply,
     NodeStopRequest = 255
 };
 
@@ -393,6 +396,9 @@ private:
 
     cs::Hash headerHash_;
 
+    // arrival of the first fragment, set while metrics are enabled
+    std::chrono::steady_clock::time_point started_;
+
     mutable RegionPtr fullData_;
 
     friend class PacketCollector;
@@ -64,6 +64,9 @@ public:
     Task& allocNext();
     void enQueueLast();
 
+    // puts task received by other pacman
+    void enQueue(Task&& task);
+
     TaskPtr<IPacMan> getNextTask(bool& is_empty);
 
     using TaskIterator = std::list<Task>::iterator;
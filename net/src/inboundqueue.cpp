@@ -0,0 +1,204 @@
+#include "inboundqueue.hpp"
+
+namespace {
+// packet takes a region of Packet::MaxSize, so every class keeps up to 16 MB
+constexpr std::array<size_t, InboundQueue::kClassesCount> kCapacities = {16384, 4096, 4096, 16384, 16384};
+
+// lower class packet that waits too long takes every kAgedTurn turn of executor
+constexpr size_t kAgedTurn = 4;
+}  // namespace
+
+MessageClass InboundQueue::classify(const Packet& pack) {
+    // broken packets are cheap, they are rejected by processor at once
+    if (pack.size() <= pack.getHeadersLength() || pack.isNetwork()) {
+        return MessageClass::Network;
+    }
+
+    if (pack.isFragmented() && pack.getFragmentId() != 0) {
+        const auto stored = fragmentClasses_.tryStore(pack.getHeaderHash());
+        return stored != 0 ? static_cast<MessageClass>(stored - 1) : MessageClass::Common;
+    }
+
+    MessageClass result = MessageClass::Common;
+
+    switch (pack.getType()) {
+        case MsgTypes::RoundTableSS:
+        case MsgTypes::NewBlock:
+        case MsgTypes::BlockHash:
+        case MsgTypes::FirstStage:
+        case MsgTypes::SecondStage:
+        case MsgTypes::ThirdStage:
+        case MsgTypes::FirstStageRequest:
+        case MsgTypes::SecondStageRequest:
+        case MsgTypes::ThirdStageRequest:
+        case MsgTypes::RoundTableRequest:
+        case MsgTypes::RoundTableReply:
+        case MsgTypes::NewCharacteristic:
+        case MsgTypes::WriterNotification:
+        case MsgTypes::FirstSmartStage:
+        case MsgTypes::SecondSmartStage:
+        case MsgTypes::RoundTable:
+        case MsgTypes::ThirdSmartStage:
+        case MsgTypes::SmartFirstStageRequest:
+        case MsgTypes::SmartSecondStageRequest:
+        case MsgTypes::SmartThirdStageRequest:
+        case MsgTypes::HashReply:
+        case MsgTypes::RejectedContracts:
+        case MsgTypes::RoundPackRequest:
+        case MsgTypes::BigBang:
+        case MsgTypes::EmptyRoundPack:
+        case MsgTypes::BlockAlarm:
+        case MsgTypes::NodeStopRequest:
+            result = MessageClass::Consensus;
+            break;
+
+        case MsgTypes::Transactions:
+        case MsgTypes::FirstTransaction:
+        case MsgTypes::TransactionPacket:
+        case MsgTypes::TransactionsPacketRequest:
+        case MsgTypes::TransactionsPacketReply:
+            result = MessageClass::Transactions;
+            break;
+
+        case MsgTypes::BlockRequest:
+        case MsgTypes::RequestedBlock:
+        case MsgTypes::StateRequest:
+        case MsgTypes::StateReply:
+            result = MessageClass::Sync;
+            break;
+
+        default:
+            break;
+    }
+
+    if (pack.isFragmented()) {
+        fragmentClasses_.tryStore(pack.getHeaderHash()) = static_cast<uint8_t>(static_cast<uint8_t>(result) + 1);
+    }
+
+    return result;
+}
+
+bool InboundQueue::push(TaskPtr<IPacMan>& task, MessageClass messageClass) {
+    const auto index = static_cast<size_t>(messageClass);
+    auto& queue = queues_[index];
+
+    if (queue.getSize() >= kCapacities[index]) {
+        counters_[index].dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // packet shares region with task, so it is not copied
+    queue.enQueue(IPacMan::Task{task->sender, task->size, task->pack, task->timestamp});
+
+    // size is changed before waiting flag is read, executor changes them in reverse order
+    size_.fetch_add(1);
+
+    if (isWaiting_.load()) {
+        {
+            std::lock_guard lock(mutex_);
+        }
+
+        condition_.notify_one();
+    }
+
+    return true;
+}
+
+void InboundQueue::stop() {
+    {
+        std::lock_guard lock(mutex_);
+        isStopped_ = true;
+    }
+
+    condition_.notify_all();
+}
+
+InboundQueue::Stats InboundQueue::stats(MessageClass messageClass) const {
+    const auto& counters = counters_[static_cast<size_t>(messageClass)];
+
+    Stats result;
+    result.processed = counters.processed.load(std::memory_order_relaxed);
+    result.dropped = counters.dropped.load(std::memory_order_relaxed);
+    result.totalWaitUs = counters.totalWaitUs.load(std::memory_order_relaxed);
+    result.maxWaitUs = counters.maxWaitUs.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+const char* InboundQueue::classToString(MessageClass messageClass) {
+    switch (messageClass) {
+        case MessageClass::Consensus:
+            return "consensus";
+        case MessageClass::Network:
+            return "network";
+        case MessageClass::Common:
+            return "common";
+        case MessageClass::Transactions:
+            return "transactions";
+        case MessageClass::Sync:
+            return "sync";
+        default:
+            return "unknown";
+    }
+}
+
+bool InboundQueue::wait(std::chrono::milliseconds timeout) {
+    if (size_.load() != 0) {
+        return true;
+    }
+
+    std::unique_lock lock(mutex_);
+    isWaiting_.store(true);
+
+    condition_.wait_for(lock, timeout, [this] {
+        return isStopped_ || size_.load() != 0;
+    });
+
+    isWaiting_.store(false);
+    return size_.load() != 0;
+}
+
+size_t InboundQueue::choose() {
+    const auto now = Clock::now();
+
+    size_t first = kClassesCount;
+    size_t aged = kClassesCount;
+    auto oldest = Clock::time_point::max();
+
+    for (size_t i = 0; i < kClassesCount; ++i) {
+        bool isEmpty = false;
+
+        // head is only looked at, it stays in queue
+        auto head = queues_[i].getNextTask(isEmpty);
+
+        if (isEmpty) {
+            continue;
+        }
+
+        if (first == kClassesCount) {
+            first = i;
+        }
+        else if (now - head->timestamp > kMaxWait && head->timestamp < oldest) {
+            aged = i;
+            oldest = head->timestamp;
+        }
+    }
+
+    if (aged != kClassesCount && ++turn_ % kAgedTurn == 0) {
+        return aged;
+    }
+
+    return first != kClassesCount ? first : 0;
+}
+
+void InboundQueue::account(size_t index, Clock::time_point received) {
+    auto& counters = counters_[index];
+    const auto waitUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - received).count());
+
+    counters.processed.fetch_add(1, std::memory_order_relaxed);
+    counters.totalWaitUs.fetch_add(waitUs, std::memory_order_relaxed);
+
+    if (waitUs > counters.maxWaitUs.load(std::memory_order_relaxed)) {
+        counters.maxWaitUs.store(waitUs, std::memory_order_relaxed);
+    }
+}
@@ -1,5 +1,6 @@
 /* Send blaming letters to @yrtimd */
 #include <chrono>
+#include <lib/system/metrics.hpp>
 #include <lib/system/utils.hpp>
 #include <net/logger.hpp>
 #include <thread>
@@ -38,6 +39,22 @@ static std::atomic<std::chrono::time_point<std::chrono::high_resolution_clock>>
     last_processed_time{std::chrono::high_resolution_clock::now()};
 const double lag_limit = 1000.;
 
+namespace {
+struct NetMetrics {
+    cs::metrics::Counter& rxPackets = cs::metrics::counter("cs_net_packets_total", "UDP packets", cs::metrics::label("direction", "rx"));
+    cs::metrics::Counter& txPackets = cs::metrics::counter("cs_net_packets_total", "UDP packets", cs::metrics::label("direction", "tx"));
+    cs::metrics::Counter& rxBytes = cs::metrics::counter("cs_net_bytes_total", "UDP datagram bytes", cs::metrics::label("direction", "rx"));
+    cs::metrics::Counter& txBytes = cs::metrics::counter("cs_net_bytes_total", "UDP datagram bytes", cs::metrics::label("direction", "tx"));
+    cs::metrics::Counter& rejected = cs::metrics::counter("cs_net_packets_rejected_total", "Received packets dropped as malformed");
+    cs::metrics::Histogram& processTime = cs::metrics::timer("cs_net_packet_process_seconds", "Time of processing of received packet");
+};
+
+NetMetrics& netMetrics() {
+    static NetMetrics metrics;
+    return metrics;
+}
+}  // namespace
+
 static ip::udp::socket bindSocket(io_context& context, Network* net, const EndpointData& data, bool ipv6 = true) {
     try {
         ip::udp::socket sock(context, ipv6 ? ip::udp::v6() : ip::udp::v4());
@@ -183,9 +200,12 @@ void Network::readerRoutine() {
             }
 
             if (reject) {
+                netMetrics().rejected.increment();
                 iPacMan_.rejectLast();
             }
             else {
+                netMetrics().rxPackets.increment();
+                netMetrics().rxBytes.increment(packetSize);
                 iPacMan_.enQueueLast();
 #ifdef LOG_NET
                 csdebug(logger::Net) << "<-- " << packetSize << " bytes from " << task.sender << " " << task.pack;
@@ -241,11 +261,13 @@ void Network::sendPackDirect(Packet& pack, const ip::udp::endpoint& ep) {
     if (lastError || size < encodedSize) {
         cserror() << "Cannot send packet. Error " << lastError;
     }
-#ifdef LOG_NET
     else {
+        netMetrics().txPackets.increment();
+        netMetrics().txBytes.increment(size);
+#ifdef LOG_NET
         csdebug(logger::Net) << "--> " << size << " bytes to " << ep << " " << pack;
-    }
 #endif
+    }
 }
 
 [[maybe_unused]]
@@ -274,11 +296,13 @@ static inline void sendPack(ip::udp::socket& sock, TaskPtr<OPacMan>& task, const
     if (lastError || size < encodedSize) {
         cserror() << "Cannot send packet. Error " << lastError;
     }
-#ifdef LOG_NET
     else {
+        netMetrics().txPackets.increment();
+        netMetrics().txBytes.increment(size);
+#ifdef LOG_NET
         csdebug(logger::Net) << "--> " << size << " bytes to " << ep << " " << task->pack;
-    }
 #endif
+    }
 }
 
 void Network::writerRoutine() {
@@ -374,6 +398,14 @@ void Network::writerRoutine() {
                     if (errno != EAGAIN)
                         break;
                 }
+                else if (cs::metrics::isEnabled()) {
+                    size_t bytes = 0;
+                    for (int i = 0; i < sended; ++i) {
+                        bytes += messages[i].msg_len;
+                    }
+                    netMetrics().txPackets.increment(static_cast<uint64_t>(sended));
+                    netMetrics().txBytes.increment(bytes);
+                }
                 messages += sended;
                 tasks -= sended;
             } while (tasks);
@@ -410,7 +442,6 @@ void Network::writerRoutine() {
 
 // Processors
 void Network::processorRoutine() {
-    CallsQueue& externals = CallsQueue::instance();
 #ifdef __linux__
     struct pollfd pfd {};
     pfd.fd = readerEventfd_;
@@ -422,8 +453,16 @@ void Network::processorRoutine() {
     };                                             // 50ms
 #endif
 
+    auto pass = [this](TaskPtr<IPacMan>& task) {
+        if (!inboundQueue_.push(task, inboundQueue_.classify(task->pack))) {
+            csdebug() << "net: inbound queue is full, packet from " << task->sender << " is dropped";
+        }
+
+        last_processed_time.store(task->timestamp, std::memory_order_relaxed);
+        task.release();
+    };
+
     while (stopProcessorRoutine == false) {
-        externals.callAll();
 #ifdef __linux__
         uint64_t tasks;
         while (true) {
@@ -431,7 +470,6 @@ void Network::processorRoutine() {
             if (ret != 0) {
                 break;
             }
-            externals.callAll();
         }
         int s = read(readerEventfd_, &tasks, sizeof(uint64_t));
         if (s != sizeof(uint64_t)) {
@@ -446,9 +484,7 @@ void Network::processorRoutine() {
                 cswarning() << "net: invalid packet processor!!!!!!!!!";
                 continue;
             }
-            processTask(task);
-            last_processed_time.store(task->timestamp, std::memory_order_relaxed);
-            task.release();
+            pass(task);
         }
 #endif
 #if defined(WIN32) || defined(__APPLE__)
@@ -458,7 +494,6 @@ void Network::processorRoutine() {
             if (ret != WAIT_TIMEOUT || iPacMan_.getSize()) {
                 break;
             }
-            externals.callAll();
         };
 #else
         while (true) {
@@ -466,7 +501,6 @@ void Network::processorRoutine() {
             int ret = kevent(readerKq_, NULL, 0, &event, 1, &timeout);
             if (ret)
                 break;
-            externals.callAll();
         }
 #endif
         while (readerLock.test_and_set(std::memory_order_acquire))  // acquire lock
@@ -479,16 +513,49 @@ void Network::processorRoutine() {
             bool is_empty = false;
             auto task = iPacMan_.getNextTask(is_empty);
             if (is_empty) break;
-            processTask(task);
-            last_processed_time.store(task->timestamp, std::memory_order_relaxed);
-            task.release();
+            pass(task);
         }
 #endif
     }
     cswarning() << "processorRoutine STOPPED!!!\n";
 }
 
+void Network::executorRoutine() {
+    constexpr std::chrono::milliseconds timeout(50);
+    constexpr std::chrono::seconds statsPeriod(60);
+
+    CallsQueue& externals = CallsQueue::instance();
+    auto statsTime = std::chrono::steady_clock::now() + statsPeriod;
+
+    while (stopExecutorRoutine == false) {
+        externals.callAll();
+
+        // externals are called between packets, so they do not wait for the whole queue
+        inboundQueue_.process(timeout, [this](TaskPtr<IPacMan>& task) {
+            processTask(task);
+        });
+
+        if (std::chrono::steady_clock::now() < statsTime) {
+            continue;
+        }
+
+        statsTime = std::chrono::steady_clock::now() + statsPeriod;
+
+        for (size_t i = 0; i < InboundQueue::kClassesCount; ++i) {
+            const auto messageClass = static_cast<MessageClass>(i);
+            const auto stats = inboundQueue_.stats(messageClass);
+
+            csdebug() << "net: inbound " << InboundQueue::classToString(messageClass) << " processed " << stats.processed << ", dropped "
+                      << stats.dropped << ", average wait " << (stats.processed ? stats.totalWaitUs / stats.processed : 0) << " us, max wait "
+                      << stats.maxWaitUs << " us";
+        }
+    }
+    cswarning() << "executorRoutine STOPPED!!!\n";
+}
+
 inline void Network::processTask(TaskPtr<IPacMan>& task) {
+    cs::metrics::ScopedTimer timer(netMetrics().processTime);
+
     auto remoteSender = transport_->getPackSenderEntry(task->sender);
 
     if (!(task->pack.isHeaderValid())) {
@@ -680,6 +747,7 @@ Network::Network(Transport* transport)
     readerThread_ = std::thread(&Network::readerRoutine, this);
     writerThread_ = std::thread(&Network::writerRoutine, this);
     processorThread_ = std::thread(&Network::processorRoutine, this);
+    executorThread_ = std::thread(&Network::executorRoutine, this);
 
     while (readerStatus_.load() == ThreadStatus::NonInit)
         ;
@@ -768,5 +836,12 @@ Network::~Network() {
         processorThread_.join();
     }
 
+    stopExecutorRoutine = true;
+    inboundQueue_.stop();
+
+    if (executorThread_.joinable()) {
+        executorThread_.join();
+    }
+
     delete singleSock_.load();
 }
@@ -1,11 +1,25 @@
 #include <lz4.h>
 
+#include <lib/system/metrics.hpp>
 #include <lib/system/utils.hpp>
 #include "packet.hpp"
 #include "transport.hpp"  // for NetworkCommand
 
 RegionAllocator Message::allocator_;
 
+namespace {
+struct CollectorMetrics {
+    cs::metrics::Counter& fragments = cs::metrics::counter("cs_net_fragments_total", "Received fragments of messages");
+    cs::metrics::Counter& messages = cs::metrics::counter("cs_net_messages_reassembled_total", "Fragmented messages reassembled");
+    cs::metrics::Histogram& reassemblyTime = cs::metrics::timer("cs_net_fragment_reassembly_seconds", "Time from the first to the last fragment of message");
+};
+
+CollectorMetrics& collectorMetrics() {
+    static CollectorMetrics metrics;
+    return metrics;
+}
+}  // namespace
+
 enum Lengths {
     FragmentedHeader = 36
 };
@@ -82,6 +96,10 @@ const char* Packet::messageTypeToString(MsgTypes messageType) {
             return "StateReply";
         case EmptyRoundPack:
             return "EmptyRoundPack";
+        case TransactionProofRequest:
+            return "TransactionProofRequest";
+        case TransactionProofReply:
+            return "TransactionProofReply";
         default:
             return "Unknown";
     }
@@ -177,6 +195,10 @@ MessagePtr PacketCollector::getMessage(const Packet& pack, bool& newFragmentedMs
         msg->packets_.resize(msg->packetsTotal_);
         msg->headerHash_ = pack.getHeaderHash();
         newFragmentedMsg = true;
+
+        if (cs::metrics::isEnabled()) {
+            msg->started_ = std::chrono::steady_clock::now();
+        }
     }
     else {
         msg = *msgPtr;
@@ -192,6 +214,16 @@ MessagePtr PacketCollector::getMessage(const Packet& pack, bool& newFragmentedMs
             msg->maxFragment_ = std::max(pack.getFragmentsNum(), msg->maxFragment_);
             --msg->packetsLeft_;
             goodPlace = pack;
+
+            collectorMetrics().fragments.increment();
+
+            if (msg->packetsLeft_ == 0) {
+                collectorMetrics().messages.increment();
+
+                if (msg->started_ != std::chrono::steady_clock::time_point{}) {
+                    collectorMetrics().reassemblyTime.observe(std::chrono::steady_clock::now() - msg->started_);
+                }
+            }
         }
 
         if (msg->packetsTotal_ >= 20) {
@@ -214,6 +246,7 @@ MessagePtr PacketCollector::getMessage(const Packet& pack, bool& newFragmentedMs
 void PacketCollector::dropMessage(MessagePtr msg) {
     (*msg)->packetsLeft_ = (*msg)->packetsTotal_;
     (*msg)->packets_.clear();
+    (*msg)->started_ = std::chrono::steady_clock::time_point{};
 }
 
 /* WARN: All the cases except FRAG + COMPRESSED have bugs in them */
@@ -16,6 +16,13 @@ void IPacMan::enQueueLast() {
     size_.fetch_add(1, std::memory_order_acq_rel);
 }
 
+void IPacMan::enQueue(Task&& task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(task));
+
+    size_.fetch_add(1, std::memory_order_acq_rel);
+}
+
 void IPacMan::rejectLast() {
     std::lock_guard<std::mutex> lock(mutex_);
     queue_.pop_back();
@@ -797,6 +797,10 @@ void Transport::dispatchNodeMessage(const MsgTypes type, const cs::RoundNumber r
             return node_->getBlockAlarm(data, size, rNum, firstPack.getSender());
         case MsgTypes::EventReport:
             return node_->getEventReport(data, size, rNum, firstPack.getSender());
+        case MsgTypes::TransactionProofRequest:
+            return node_->getTransactionProofRequest(data, size, rNum, firstPack.getSender());
+        case MsgTypes::TransactionProofReply:
+            return node_->getTransactionProofReply(data, size, rNum, firstPack.getSender());
         default:
             cserror() << "TRANSPORT> Unknown message type " << Packet::messageTypeToString(type) << " pack round " << rNum;
             break;
@@ -1,13 +1,14 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
-#include <map>
-#include <set>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 
 // template<typename TResol = std::chrono::milliseconds>
 class CallsQueueScheduler {
@@ -38,7 +39,7 @@ public:
      */
 
     CallsQueueScheduler()
-    : _queue(compare) {
+    : _start(ClockType::now()) {
     }
 
     CallsQueueScheduler(const CallsQueueScheduler&) = delete;
@@ -219,53 +220,90 @@ public:
         return _cnt_block_exe;
     }
 
-private:
     /**
-     * @struct  Context
+     * @fn  uint64_t CallsQueueScheduler::MaxJitterUs() const
      *
-     * @brief   Stores all info to call, re-schedule and cancel further calls in queue.
+     * @brief   Max delay of call put into CallsQueue after its scheduled time
      *
-     * @author  aae
-     * @date    17.09.2018
+     * @return  The max delay in microseconds.
+     */
+
+    uint64_t MaxJitterUs() const {
+        return _jitter_max_us;
+    }
+
+    /**
+     * @fn  uint64_t CallsQueueScheduler::AverageJitterUs() const
+     *
+     * @brief   Average delay of calls put into CallsQueue after their scheduled time
+     *
+     * @return  The average delay in microseconds.
      */
 
-    struct Context {
-        /** @brief   The identifier: lets find item in queue (e.g. for remove) */
-        CallTag id;
+    uint64_t AverageJitterUs() const {
+        const uint64_t total = _cnt_total + _cnt_block_exe;
+        return total ? _jitter_total_us / total : 0;
+    }
+
+private:
+    // timer wheel: kLevels levels of kSlots slots, slot of level n spans kSlots^n ticks of kTick
+    constexpr static ClockType::duration kTick = std::chrono::milliseconds(1);
+    constexpr static size_t kLevels = 4;
+    constexpr static size_t kSlotBits = 6;
+    constexpr static size_t kSlots = 1 << kSlotBits;
+    constexpr static uint64_t kNoTick = UINT64_MAX;
 
-        /** @brief   The time point for scheduled execution */
+    /**
+     * @struct  Entry
+     *
+     * @brief   Stores all info to call, re-schedule and cancel further calls of the tag. Entry lives while its tag is
+     *          known to scheduler, so schedules of the same tag do not allocate
+     */
+
+    struct Entry {
+        CallTag id = no_tag;
+
+        /** @brief   The time point for scheduled execution and its tick */
         ClockType::time_point tp;
+        uint64_t due = 0;
 
-        /** @brief   The delta - time period for periodic calls */
-        long long dt;
+        /** @brief   The delta - time period for periodic calls in ms, 0 for once calls */
+        long long dt = 0;
 
-        /** @brief   The procedure to call*/
         ProcType proc;
 
-        // support for std::find() by id
-        bool operator==(const CallTag rhs) const {
-            return id == rhs;
-        }
+        /** @brief   Syncing with CallsQueue (to block proc execution if this one still in queue) */
+        uint32_t queued = 0;
+        uint32_t done = 0;
+
+        /** @brief   Place in wheel, the entry is linked into slot list while scheduled */
+        bool scheduled = false;
+        uint8_t level = 0;
+        uint8_t slot = 0;
+        Entry* prev = nullptr;
+        Entry* next = nullptr;
     };
 
-    // used for sort items in _queue by time to call
-    std::function<bool(const Context& lhs, const Context& rhs)> compare = [](const Context& lhs, const Context& rhs) { return lhs.tp < rhs.tp; };
+    ClockType::time_point _start;
+
+    std::unordered_map<CallTag, Entry> _entries;
 
-    // container requirements: auto sort by tp, search by id
-    std::multiset<Context, decltype(compare)> _queue;
-    // sync access to _queue
+    std::array<std::array<Entry*, kSlots>, kLevels> _slots{};
+    std::array<uint64_t, kLevels> _occupied{};
+
+    // the next tick to process, scheduled entries count and tick worker sleeps till
+    uint64_t _current = 0;
+    size_t _scheduled = 0;
+    uint64_t _wake = kNoTick;
+
+    // sync access to all above
     std::mutex _mtx_queue;
 
-    // process _queue and puts on time calls into CallsQueue::instance() object
+    // process wheel and puts on time calls into CallsQueue::instance() object
     std::thread _worker;
 
-    // signals to _worker thread that _queue was updated
+    // signals to _worker thread that earlier call was scheduled or it stops
     std::condition_variable _signal;
-    // need by _signal
-    std::mutex _mtx_signal;
-
-    // avoids "false" signals
-    bool _flag = {false};
 
     // flag to stop _worker thread
     std::atomic_bool _stop = {false};
@@ -274,27 +312,31 @@ private:
     uint32_t _cnt_total{0};
     uint32_t _cnt_block_exe{0};
     uint32_t _cnt_block_que{0};
-
-    // Syncing with CallsQueue (to block proc execution if this one still in queue)
-
-    struct ExeSync {
-        uint32_t queued;
-        uint32_t done;
-    };
-
-    std::map<CallTag, ExeSync> _exe_sync;
+    uint64_t _jitter_total_us{0};
+    uint64_t _jitter_max_us{0};
 
     // thread procedure
     void SchedulerProc();
 
     // methods below are NOT thread-safe, they must be synced at point of call!
 
-    // must be called when put the lambda in CallsQueue for execution
-    void OnExeQueued(CallTag id);
+    // the first tick not earlier than tp
+    uint64_t DueTick(ClockType::time_point tp) const;
+
+    void Link(Entry& entry);
+    void Unlink(Entry& entry);
+    void UnlinkAll();
+
+    // moves wheel up to tick, calls due entries
+    void Advance(uint64_t tick);
+    void Cascade(size_t level);
+    void Fire(Entry& entry);
+
+    // tick worker has to wake at, kNoTick if nothing is scheduled
+    uint64_t NextTick() const;
+
     // must be called from within lambda executed by CallsQueue
     void OnExeDone(CallTag id);
-    // must be called before put lambda in CallsQueue to avoid duplicated lambdas in CallsQueue
-    bool CanExe(CallTag id);
     // must be called from within lambda to confirm execution
     bool ConfirmExe(CallTag id);
 };
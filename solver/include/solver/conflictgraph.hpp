@@ -0,0 +1,55 @@
+#pragma once
+
+#include <csdb/address.hpp>
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace cs {
+
+/**
+ * Conflict graph of contract executions in queue order.
+ *
+ * Every item occupies its footprint: absolute addresses of the target contract and of all
+ * contracts it uses. Two items conflict if their footprints intersect. A pending item is
+ * ready to start if it conflicts neither with any earlier item of the queue nor with any
+ * active (running or finished but not yet stored) item. So non-conflicting items may be
+ * executed concurrently while conflicting ones always start in queue order, the same on
+ * every node.
+ */
+class ConflictGraph {
+public:
+    enum class State {
+        Pending,
+        Active
+    };
+
+    // adds the next item of the queue, returns its index
+    size_t add(std::vector<csdb::Address> footprint, State state);
+
+    // pending items which may start now, in queue order
+    std::vector<size_t> ready() const;
+
+    bool conflicts(size_t lhs, size_t rhs) const;
+
+    size_t size() const {
+        return items.size();
+    }
+
+    void clear();
+
+private:
+    struct Item {
+        // sorted unique addresses
+        std::vector<csdb::Address> footprint;
+        State state;
+    };
+
+    std::vector<Item> items;
+
+    // items occupying the address, in queue order
+    std::map<csdb::Address, std::vector<size_t>> owners;
+};
+
+}  // namespace cs
@@ -15,6 +15,10 @@ public:
     /** @brief   True if write node may to reduce desired count of hashes on big bang and spawn next round immediately*/
     constexpr static bool ReduceMinHashesOnBigBang = false;
 
+    /** @brief   True if merkle root of block transactions is stored in block user field. Changes block hash, so must be
+     * switched on the whole network at once */
+    constexpr static bool MerkleRootInBlocks = false;
+
     /** @brief   The default state timeout */
     constexpr static unsigned int DefaultStateTimeout = 5000;
 
@@ -486,6 +486,9 @@ public slots:
     // called when block should be removed from database
     void on_remove_block(const csdb::Pool& block);
 
+    // called when packet of transactions is received, starts speculative execution of its contract calls
+    void on_packet_added(const cs::TransactionsPacket& packet);
+
     void on_start_reading_blocks(cs::Sequence lastBlockNum) {
         cs::Lock lock(public_access_lock);
         max_read_sequence = lastBlockNum;
@@ -731,6 +734,9 @@ private:
 
     void test_exe_queue(bool reading_db);
 
+    // absolute addresses of contract and all contracts used by its executions
+    std::vector<csdb::Address> get_footprint(const QueueItem& item) const;
+
     // true if target of transaction is smart contract which implements payable() method
     bool is_payable_target(const csdb::Transaction& tr);
 
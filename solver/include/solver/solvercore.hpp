@@ -196,6 +196,8 @@ private:
     std::unique_ptr<SolverContext> pcontext;
     CallsQueueScheduler scheduler;
     CallsQueueScheduler::CallTag tag_state_expired;
+    // when current state is set, only while metrics are enabled
+    std::chrono::steady_clock::time_point state_started;
     bool req_stop;
     std::map<StatePtr, Transitions> transitions;
     StatePtr pstate;
@@ -2,93 +2,41 @@
 #include <algorithm>
 #include <lib/system/utils.hpp>  // CallsQueue
 
+namespace {
+uint64_t rotateRight(uint64_t value, size_t shift) {
+    return shift ? (value >> shift) | (value << (64 - shift)) : value;
+}
+
+size_t countTrailingZeros(uint64_t value) {
+    size_t result = 0;
+
+    while (!(value & 1)) {
+        value >>= 1;
+        ++result;
+    }
+
+    return result;
+}
+}  // namespace
+
 void CallsQueueScheduler::SchedulerProc() {
-    bool signaled{false};
-    constexpr long long min_wait_for = 5;
+    std::unique_lock<std::mutex> lque(_mtx_queue);
+
     while (!_stop) {
-        // get earliest action time
-        auto earliest = ClockType::now() + std::chrono::seconds(60);
-        {
-            std::lock_guard<std::mutex> lque(_mtx_queue);
-            if (!_queue.empty()) {
-                earliest = _queue.cbegin()->tp;
-            }
-        }
-        // sleep until scheduled event and get ready to awake at any time
-        std::unique_lock<std::mutex> lsig(_mtx_signal);
-        signaled = _signal.wait_until(lsig, earliest, [this]() { return _flag; });  // std::system_error!
-        // test stop condition before reaction
-        if (_stop) {
-            break;
-        }
-        // event occurs
-        if (signaled) {
-            // reset _flag for the next signal
-            _flag = false;
-            // awake by direct notification: re-schedule next timeout
-            std::lock_guard<std::mutex> lque(_mtx_queue);
-            if (!_queue.empty()) {
-                // test whether to call immediately
-                if ((_queue.cbegin()->tp - ClockType::now()).count() >= min_wait_for) {
-                    // schedule next wait period
-                    continue;
-                }
-                // fall through to execute proc now (either timeout almost coincided with the signal, or proc is scheduled with
-                // tiny wait_for)
-            }
-            else {
-                // queue is empty, schedule next wait period
-                continue;
-            }
+        Advance(static_cast<uint64_t>((ClockType::now() - _start) / kTick));
+
+        // sleep until the next scheduled tick, Insert() awakes worker only if it schedules earlier call
+        _wake = NextTick();
+
+        if (_wake == kNoTick) {
+            _signal.wait_for(lque, std::chrono::seconds(60));
         }
-        // awake due timeout: the most probable its time to execute earliest proc
-        // test scheduled time (if it was at all)
-        Context run;
-        run.id = no_tag;
-        {
-            std::lock_guard<std::mutex> lque(_mtx_queue);
-            // execute calls until wait time >= min_wait_for
-            while (!_queue.empty()) {
-                if ((_queue.cbegin()->tp - ClockType::now()).count() >= min_wait_for) {
-                    break;
-                }
-                run = *_queue.cbegin();
-                _queue.erase(_queue.cbegin());
-                ProcType proc = run.proc;
-                // push to CallsQueue only if there are no any previous calls
-                if (CanExe(run.id)) {
-                    OnExeQueued(run.id);
-                    CallsQueue::instance().insert([this, run]() {
-                        {
-                            std::lock_guard<std::mutex> lque(_mtx_queue);
-                            if (!ConfirmExe(run.id)) {
-                                // its highly likely the job was canceled
-                                return;
-                            }
-                        }
-                        // call out of lock to avoid recursive mutex locking if proc to insert another scheduled call
-                        run.proc();
-                        {
-                            std::lock_guard<std::mutex> lque(_mtx_queue);
-                            OnExeDone(run.id);
-                        }
-                    });
-                    _cnt_total += 1;
-                }
-                else {
-                    _cnt_block_exe += 1;
-                }
-                // Launch::periodic -> schedule next item
-                if (run.dt > 0) {
-                    run.tp = ClockType::now() + std::chrono::milliseconds(run.dt);
-                    auto pos = _queue.insert(run);
-                    if (pos == _queue.end()) {
-                        // periodic calls aborted due to unexpected problem!
-                    }
-                }
-            }
+        else {
+            _signal.wait_until(lque, _start + kTick * _wake);
         }
     }
+
+    _wake = kNoTick;
 }
 
 void CallsQueueScheduler::Run() {
@@ -96,34 +44,217 @@ void CallsQueueScheduler::Run() {
     _worker = std::thread([this]() { SchedulerProc(); });
 }
 
-void CallsQueueScheduler::OnExeQueued(CallTag id) {
-    auto it = _exe_sync.find(id);
-    if (it == _exe_sync.cend()) {
-        _exe_sync.insert({id, {1, 0}});
+uint64_t CallsQueueScheduler::DueTick(ClockType::time_point tp) const {
+    if (tp <= _start) {
+        return 0;
+    }
+
+    return static_cast<uint64_t>((tp - _start + kTick - ClockType::duration(1)) / kTick);
+}
+
+void CallsQueueScheduler::Link(Entry& entry) {
+    // too late calls go to the next processed slot
+    entry.due = std::max(entry.due, _current);
+
+    const uint64_t delta = entry.due - _current;
+    uint64_t due = entry.due;
+    size_t level = 0;
+
+    while (level + 1 < kLevels && delta >= (uint64_t(1) << (kSlotBits * (level + 1)))) {
+        ++level;
+    }
+
+    // calls farther than the wheel wait in the last slot and are placed again by cascade
+    const uint64_t span = uint64_t(1) << (kSlotBits * kLevels);
+
+    if (delta >= span) {
+        due = _current + span - 1;
+    }
+
+    const size_t slot = (due >> (kSlotBits * level)) & (kSlots - 1);
+    Entry*& head = _slots[level][slot];
+
+    entry.prev = nullptr;
+    entry.next = head;
+
+    if (head) {
+        head->prev = &entry;
+    }
+
+    head = &entry;
+    _occupied[level] |= uint64_t(1) << slot;
+
+    entry.level = static_cast<uint8_t>(level);
+    entry.slot = static_cast<uint8_t>(slot);
+    entry.scheduled = true;
+    ++_scheduled;
+}
+
+void CallsQueueScheduler::Unlink(Entry& entry) {
+    if (entry.prev) {
+        entry.prev->next = entry.next;
     }
     else {
-        it->second.queued += 1;
+        Entry*& head = _slots[entry.level][entry.slot];
+        head = entry.next;
+
+        if (!head) {
+            _occupied[entry.level] &= ~(uint64_t(1) << entry.slot);
+        }
     }
+
+    if (entry.next) {
+        entry.next->prev = entry.prev;
+    }
+
+    entry.prev = nullptr;
+    entry.next = nullptr;
+    entry.scheduled = false;
+    --_scheduled;
 }
 
-void CallsQueueScheduler::OnExeDone(CallTag id) {
-    auto it = _exe_sync.find(id);
-    if (it != _exe_sync.end()) {
-        it->second.done += 1;
+void CallsQueueScheduler::UnlinkAll() {
+    for (auto& level : _slots) {
+        level.fill(nullptr);
+    }
+
+    _occupied.fill(0);
+    _scheduled = 0;
+
+    for (auto& [id, entry] : _entries) {
+        entry.prev = nullptr;
+        entry.next = nullptr;
+        entry.scheduled = false;
     }
 }
 
-bool CallsQueueScheduler::CanExe(CallTag id) {
-    auto it = _exe_sync.find(id);
-    if (it != _exe_sync.end()) {
-        return it->second.done == it->second.queued;
+void CallsQueueScheduler::Advance(uint64_t tick) {
+    while (_current <= tick) {
+        if (_scheduled == 0) {
+            _current = tick + 1;
+            break;
+        }
+
+        // at boundary of upper level slot its calls move to lower levels
+        size_t level = 0;
+
+        while (level + 1 < kLevels && (_current & ((uint64_t(1) << (kSlotBits * (level + 1))) - 1)) == 0) {
+            ++level;
+        }
+
+        for (; level > 0; --level) {
+            Cascade(level);
+        }
+
+        const size_t slot = _current & (kSlots - 1);
+        Entry* entry = _slots[0][slot];
+
+        _slots[0][slot] = nullptr;
+        _occupied[0] &= ~(uint64_t(1) << slot);
+
+        while (entry) {
+            Entry* next = entry->next;
+
+            entry->prev = nullptr;
+            entry->next = nullptr;
+            entry->scheduled = false;
+            --_scheduled;
+
+            Fire(*entry);
+            entry = next;
+        }
+
+        ++_current;
+    }
+}
+
+void CallsQueueScheduler::Cascade(size_t level) {
+    const size_t slot = (_current >> (kSlotBits * level)) & (kSlots - 1);
+    Entry* entry = _slots[level][slot];
+
+    _slots[level][slot] = nullptr;
+    _occupied[level] &= ~(uint64_t(1) << slot);
+
+    while (entry) {
+        Entry* next = entry->next;
+
+        --_scheduled;
+        Link(*entry);
+
+        entry = next;
+    }
+}
+
+void CallsQueueScheduler::Fire(Entry& entry) {
+    const auto now = ClockType::now();
+    const auto jitter = std::chrono::duration_cast<std::chrono::microseconds>(now - entry.tp).count();
+
+    if (jitter > 0) {
+        _jitter_total_us += static_cast<uint64_t>(jitter);
+        _jitter_max_us = std::max(_jitter_max_us, static_cast<uint64_t>(jitter));
+    }
+
+    // push to CallsQueue only if there are no any previous calls
+    if (entry.queued == entry.done) {
+        entry.queued += 1;
+
+        CallsQueue::instance().insert([this, id = entry.id, proc = entry.proc]() {
+            {
+                std::lock_guard<std::mutex> lque(_mtx_queue);
+                if (!ConfirmExe(id)) {
+                    // its highly likely the job was canceled
+                    return;
+                }
+            }
+            // call out of lock to avoid recursive mutex locking if proc to insert another scheduled call
+            proc();
+            {
+                std::lock_guard<std::mutex> lque(_mtx_queue);
+                OnExeDone(id);
+            }
+        });
+
+        _cnt_total += 1;
+    }
+    else {
+        _cnt_block_exe += 1;
+    }
+
+    // Launch::periodic -> schedule next item
+    if (entry.dt > 0) {
+        entry.tp = now + std::chrono::milliseconds(entry.dt);
+        entry.due = DueTick(entry.tp);
+        Link(entry);
+    }
+}
+
+uint64_t CallsQueueScheduler::NextTick() const {
+    if (_scheduled == 0) {
+        return kNoTick;
+    }
+
+    // level 0 slots are looked from the current one, so the first set bit is the nearest call
+    const uint64_t near = rotateRight(_occupied[0], _current & (kSlots - 1));
+    const uint64_t nearest = near ? _current + countTrailingZeros(near) : kNoTick;
+
+    if (std::all_of(_occupied.begin() + 1, _occupied.end(), [](uint64_t occupied) { return occupied == 0; })) {
+        return nearest;
+    }
+
+    // upper levels are cascaded at boundary of level 0 turn, level 0 call may be past it
+    return std::min(nearest, (_current + kSlots - 1) & ~uint64_t(kSlots - 1));
+}
+
+void CallsQueueScheduler::OnExeDone(CallTag id) {
+    auto it = _entries.find(id);
+    if (it != _entries.end()) {
+        it->second.done += 1;
     }
-    return true;
 }
 
 bool CallsQueueScheduler::ConfirmExe(CallTag id) {
-    auto it = _exe_sync.find(id);
-    if (it != _exe_sync.end()) {
+    auto it = _entries.find(id);
+    if (it != _entries.end()) {
         return (it->second.queued - it->second.done) == 1;
     }
     return false;
@@ -131,9 +262,11 @@ bool CallsQueueScheduler::ConfirmExe(CallTag id) {
 
 void CallsQueueScheduler::Stop() {
     Clear();
-    _stop = true;
+    {
+        std::lock_guard<std::mutex> l(_mtx_queue);
+        _stop = true;
+    }
     // awake worker thread if it sleeps
-    _flag = true;
     _signal.notify_one();
     if (_worker.joinable()) {
         _worker.join();
@@ -150,10 +283,12 @@ CallsQueueScheduler::CallTag CallsQueueScheduler::Insert(ClockType::duration wai
     // CallTag id = (CallTag) &proc;
     // current solution requires enable RTTI = Yes (/GR) to compile:
     CallTag id = (tag == auto_tag ? proc.target_type().hash_code() : tag);
+    const auto tp = ClockType::now() + wait_for;
     {
         std::lock_guard<std::mutex> l(_mtx_queue);
-        auto it = std::find(_queue.cbegin(), _queue.cend(), id);
-        if (it != _queue.cend()) {
+        // entry of known tag is reused
+        auto& entry = _entries[id];
+        if (entry.scheduled) {
             if (!replace_existing) {
                 // reject schedule, the one already added before and still in queue
                 _cnt_block_que += 1;
@@ -161,66 +296,54 @@ CallsQueueScheduler::CallTag CallsQueueScheduler::Insert(ClockType::duration wai
             }
             else {
                 // remove from queue, below we will add a new schedule
-                csdebug() << "Erasing existing calls: " << it->id;
-                _queue.erase(it);
+                csdebug() << "Erasing existing calls: " << id;
+                Unlink(entry);
             }
         }
         // add new item
-        auto result = _queue.insert(CallsQueueScheduler::Context{
-            id, ClockType::now() + wait_for, (scheme == Launch::once ? 0 : std::chrono::duration_cast<std::chrono::milliseconds>(wait_for).count()), std::move(proc)
-            //, std::move(comment)
-        });
-        if (result == _queue.end()) {
-            return no_tag;
+        entry.id = id;
+        entry.tp = tp;
+        entry.due = DueTick(tp);
+        entry.dt = (scheme == Launch::once ? 0 : std::chrono::duration_cast<std::chrono::milliseconds>(wait_for).count());
+        entry.proc = proc;
+        Link(entry);
+        if (entry.due >= _wake) {
+            // worker awakes in time anyway
+            return id;
         }
     }
     // awake worker thread to re-schedule its waiting
-    _flag = true;
     _signal.notify_one();
     return id;
 }
 
 bool CallsQueueScheduler::Remove(CallsQueueScheduler::CallTag id) {
-    {
-        std::lock_guard<std::mutex> l(_mtx_queue);
-        // rollback last counter increment
-        auto it_sync = _exe_sync.find(id);
-        if (it_sync != _exe_sync.end()) {
-            it_sync->second.queued = it_sync->second.done;
-        }
-        auto it = std::find(_queue.cbegin(), _queue.cend(), id);
-        if (it == _queue.cend()) {
-            return false;
-        }
-        _queue.erase(it);
+    std::lock_guard<std::mutex> l(_mtx_queue);
+    auto it = _entries.find(id);
+    if (it == _entries.end()) {
+        return false;
     }
-    // awake worker thread to re-schedule its waiting
-    _flag = true;
-    _signal.notify_one();
+    // rollback last counter increment
+    it->second.queued = it->second.done;
+    if (!it->second.scheduled) {
+        return false;
+    }
+    // worker is not awaken, nothing happens at the tick it waits for
+    Unlink(it->second);
     return true;
 }
 
 void CallsQueueScheduler::RemoveAll() {
-    {
-        std::lock_guard<std::mutex> l(_mtx_queue);
-        _queue.clear();
-        for (auto& sync : _exe_sync) {
-            // rollback last counter increment
-            sync.second.queued = sync.second.done;
-        }
+    std::lock_guard<std::mutex> l(_mtx_queue);
+    UnlinkAll();
+    for (auto& [id, entry] : _entries) {
+        // rollback last counter increment
+        entry.queued = entry.done;
     }
-    // awake worker thread to re-schedule its waiting
-    _flag = true;
-    _signal.notify_one();
 }
 
 void CallsQueueScheduler::Clear() {
-    {
-        std::lock_guard<std::mutex> l(_mtx_queue);
-        _queue.clear();
-        _exe_sync.clear();
-    }
-    // awake worker thread to re-schedule its waiting
-    _flag = true;
-    _signal.notify_one();
+    std::lock_guard<std::mutex> l(_mtx_queue);
+    UnlinkAll();
+    _entries.clear();
 }
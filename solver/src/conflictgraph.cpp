@@ -0,0 +1,89 @@
+#include <conflictgraph.hpp>
+
+#include <algorithm>
+
+namespace cs {
+
+size_t ConflictGraph::add(std::vector<csdb::Address> footprint, State state) {
+    std::sort(footprint.begin(), footprint.end());
+    footprint.erase(std::unique(footprint.begin(), footprint.end()), footprint.end());
+
+    const size_t index = items.size();
+
+    for (const auto& addr : footprint) {
+        owners[addr].push_back(index);
+    }
+
+    items.push_back(Item{std::move(footprint), state});
+    return index;
+}
+
+std::vector<size_t> ConflictGraph::ready() const {
+    std::vector<size_t> result;
+
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (items[i].state != State::Pending) {
+            continue;
+        }
+
+        bool blocked = false;
+
+        for (const auto& addr : items[i].footprint) {
+            const auto& list = owners.at(addr);
+
+            // owners are in queue order, so the first one tells if any earlier item conflicts
+            if (list.front() < i) {
+                blocked = true;
+                break;
+            }
+
+            // active items may stand later in queue if they were re-enqueued
+            blocked = std::any_of(list.cbegin(), list.cend(), [this, i](size_t j) {
+                return j != i && items[j].state == State::Active;
+            });
+
+            if (blocked) {
+                break;
+            }
+        }
+
+        if (!blocked) {
+            result.push_back(i);
+        }
+    }
+
+    return result;
+}
+
+bool ConflictGraph::conflicts(size_t lhs, size_t rhs) const {
+    if (lhs >= items.size() || rhs >= items.size() || lhs == rhs) {
+        return false;
+    }
+
+    const auto& a = items[lhs].footprint;
+    const auto& b = items[rhs].footprint;
+
+    auto ia = a.cbegin();
+    auto ib = b.cbegin();
+
+    while (ia != a.cend() && ib != b.cend()) {
+        if (*ia < *ib) {
+            ++ia;
+        }
+        else if (*ib < *ia) {
+            ++ib;
+        }
+        else {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ConflictGraph::clear() {
+    items.clear();
+    owners.clear();
+}
+
+}  // namespace cs
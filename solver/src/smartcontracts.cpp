@@ -1,4 +1,5 @@
 #include <smartcontracts.hpp>
+#include <conflictgraph.hpp>
 #include <solvercontext.hpp>
 
 #include <ContractExecutor.h>
@@ -188,10 +189,11 @@ SmartContracts::SmartContracts(BlockChain& blockchain, CallsQueueScheduler& call
     // signals subscription (MUST occur AFTER the BlockChains has already subscribed to storage)
     // as event receiver:
     cs::Connector::connect(&bc.startReadingBlocksEvent(), this, &SmartContracts::on_start_reading_blocks);
-    cs::Connector::connect(&bc.readBlockEvent(), this, &SmartContracts::on_read_block);
-    cs::Connector::connect(&bc.storeBlockEvent, this, &SmartContracts::on_store_block);
+    cs::Connector::connect<&SmartContracts::on_read_block>(&bc.readBlockEvent(), this);
+    cs::Connector::connect<&SmartContracts::on_store_block>(&bc.storeBlockEvent, this);
     cs::Connector::connect(&bc.removeBlockEvent, this, &SmartContracts::on_remove_block);
     cs::Connector::connect(&cs::Conveyer::instance().statesCreated, this, &SmartContracts::on_update);
+    cs::Connector::connect(&cs::Conveyer::instance().packetAdded, this, &SmartContracts::on_packet_added);
     // as event source:
     cs::Connector::connect(&signal_payable_invoke, &bc, &BlockChain::onPayableContractReplenish);
     cs::Connector::connect(&signal_contract_timeout, &bc, &BlockChain::onContractTimeout);
@@ -669,7 +671,7 @@ void SmartContracts::enqueue(const csdb::Pool& block, size_t trx_idx, bool skip_
 }
 
 void SmartContracts::test_exe_queue(bool reading_db) {
-    // update queue items status
+    // remove closed and senseless items
     auto it = exe_queue.begin();
     while (it != exe_queue.end()) {
         if (it->status == SmartContractStatus::Canceled) {
@@ -687,16 +689,30 @@ void SmartContracts::test_exe_queue(bool reading_db) {
             it = remove_from_queue(it, reading_db);
             continue;
         }
-        if (it->status == SmartContractStatus::Running) {
-            // some contract is already running
-            ++it;
-            continue;
-        }
-        if (it->status == SmartContractStatus::Finished) {
-            // some contract is under consensus
-            ++it;
-            continue;
-        }
+        ++it;
+    }
+
+    // build conflict graph of queue items: running and finished (under consensus) items are active,
+    // waiting and idle ones start only if conflict neither with active nor with any earlier item,
+    // so independent contracts are executed concurrently and dependent ones keep queue order
+    ConflictGraph graph;
+    std::vector<queue_iterator> items;
+    items.reserve(exe_queue.size());
+
+    for (auto iq = exe_queue.begin(); iq != exe_queue.end(); ++iq) {
+        const bool active = (iq->status == SmartContractStatus::Running || iq->status == SmartContractStatus::Finished);
+        graph.add(get_footprint(*iq), active ? ConflictGraph::State::Active : ConflictGraph::State::Pending);
+        items.push_back(iq);
+    }
+
+    const auto ready = graph.ready();
+
+    if (!reading_db && ready.size() > 1) {
+        csdebug() << kLogPrefix << ready.size() << " independent item(s) in queue are ready to execute concurrently";
+    }
+
+    for (const size_t index : ready) {
+        it = items[index];
         // status: Waiting or Idle
 
         // is locked:
@@ -723,7 +739,6 @@ void SmartContracts::test_exe_queue(bool reading_db) {
             }
         }
         if (wait_until_unlock) {
-            ++it;
             continue;
         }
 
@@ -779,9 +794,20 @@ void SmartContracts::test_exe_queue(bool reading_db) {
                 csdebug() << kLogPrefix << "skip " << FormatRef(it->seq_enqueue) << " execution, not in trusted list";
             }
         } // under !reading_db block
+    }
+}
 
-        ++it;
+std::vector<csdb::Address> SmartContracts::get_footprint(const QueueItem& item) const {
+    std::vector<csdb::Address> footprint;
+    footprint.push_back(item.abs_addr);
+
+    for (const auto& execution : item.executions) {
+        for (const auto& u : execution.uses) {
+            footprint.push_back(absolute_address(u));
+        }
     }
+
+    return footprint;
 }
 
 SmartContractStatus SmartContracts::get_smart_contract_status(const csdb::Address& addr) const {
@@ -1785,6 +1811,60 @@ void SmartContracts::remove_from_queue(const SmartContractRef& item, bool skip_l
     }
 }
 
+void SmartContracts::on_packet_added(const cs::TransactionsPacket& packet) {
+    if (!exec_handler_ptr) {
+        return;
+    }
+
+    // packet is received by network thread, contracts of its calls are looked up by thread pool
+    cs::Concurrent::run([this, transactions = packet.transactions()] {
+        std::vector<std::pair<csdb::Transaction, csdb::Address>> starts;
+
+        for (const auto& transaction : transactions) {
+            if (is_start(transaction)) {
+                starts.emplace_back(transaction, absolute_address(transaction.target()));
+            }
+        }
+
+        if (starts.empty()) {
+            return;
+        }
+
+        std::vector<cs::Executor::ExecuteTransactionInfo> calls;
+
+        {
+            cs::Lock lock(public_access_lock);
+
+            // trusted nodes are busy with consensus, others prepare results for rounds they may be trusted in
+            if (pnode == nullptr || pnode->getNodeLevel() == Node::Level::Confidant) {
+                return;
+            }
+
+            // packet received now gets into the next round table, so into the block after the one being built
+            const cs::Sequence sequence = bc.getLastSeq() + 2;
+
+            for (const auto& [transaction, contract] : starts) {
+                csdb::Transaction deploy = get_deploy_transaction(contract);
+
+                if (!deploy.is_valid()) {
+                    continue;
+                }
+
+                auto& info = calls.emplace_back(cs::Executor::ExecuteTransactionInfo{});
+                info.transaction = transaction;
+                info.deploy = deploy;
+                info.convention = cs::Executor::MethodNameConvention::Default;
+                info.feeLimit = csdb::Amount(0);
+                info.sequence = sequence;
+            }
+        }
+
+        for (const auto& info : calls) {
+            exec_handler_ptr->getExecutor().speculate(info);
+        }
+    });
+}
+
 bool SmartContracts::execute(SmartExecutionData& data, bool validationMode) {
     if (!data.result.smartsRes.empty()) {
         data.result.smartsRes.clear();
@@ -1970,8 +2050,8 @@ bool SmartContracts::execute_async(const std::vector<ExecutionItem>& executions)
         return data_list;
     };
 
-    // run async and watch result
-    auto watcher = cs::Concurrent::run(cs::RunPolicy::CallQueuePolicy, runnable);
+    // run async and watch result, execution waits for executor, so it takes own thread
+    auto watcher = cs::Concurrent::run(cs::RunPolicy::CallQueuePolicy, cs::ConcurrentPolicy::Thread, runnable);
     cs::Connector::connect(&watcher->finished, this, &SmartContracts::on_execution_completed);
 
     return true;
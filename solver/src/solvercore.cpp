@@ -12,6 +12,7 @@
 #include <csnode/datastream.hpp>
 #include <csnode/walletsstate.hpp>
 #include <lib/system/logger.hpp>
+#include <lib/system/metrics.hpp>
 
 #include <functional>
 #include <limits>
@@ -139,6 +140,12 @@ void SolverCore::setState(const StatePtr& pState) {
     if (pstate) {
         csdetails() << log_prefix << "pstate-off";
         pstate->off(*pcontext);
+
+        if (cs::metrics::isEnabled() && state_started != std::chrono::steady_clock::time_point{}) {
+            // few switches per round, so the registry lookup is affordable
+            cs::metrics::timer("cs_solver_state_seconds", "Time spent by solver in state", cs::metrics::label("state", pstate->name()))
+                .observe(std::chrono::steady_clock::now() - state_started);
+        }
     }
     if (Consensus::Log) {
         csdebug() << log_prefix << "switch " << (pstate ? pstate->name() : "null") << " -> " << (pState ? pState->name() : "null");
@@ -147,6 +154,7 @@ void SolverCore::setState(const StatePtr& pState) {
     if (!pstate) {
         return;
     }
+    state_started = cs::metrics::isEnabled() ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
     pstate->on(*pcontext);
 
     auto closure = [this]() {
@@ -314,6 +322,9 @@ std::string SolverCore::chooseTimeStamp(cs::Bytes mask) {
 
 // TODO: this function is to be implemented the block and RoundTable building <====
 void SolverCore::spawn_next_round(const cs::PublicKeys& nodes, const cs::PacketsHashes& hashes, std::string&& currentTimeStamp, cs::StageThree& stage3) {
+    static auto& spawnTime = cs::metrics::timer("cs_solver_spawn_next_round_seconds", "Time of building the next round and block");
+    cs::metrics::ScopedTimer timer(spawnTime);
+
     csmeta(csdetails) << "start";
     cs::Conveyer& conveyer = cs::Conveyer::instance();
     if (conveyer.roundTable(conveyer.currentRoundNumber()) == nullptr) {
@@ -403,6 +414,10 @@ void SolverCore::spawn_next_round(const cs::PublicKeys& nodes, const cs::Packets
         for (auto& it : deferredBlock_.transactions()) {
             tmpPool.add_transaction(it);
         }
+        // merkle root and other fields are kept, timestamp is taken from round package
+        for (const auto id : deferredBlock_.user_field_ids()) {
+            tmpPool.add_user_field(id, deferredBlock_.user_field(id));
+        }
         tmpPool.add_user_field(0, justCreatedRoundPackage.poolMetaInfo().timestamp);
         for (auto& it : deferredBlock_.smartSignatures()) {
             tmpPool.add_smart_signature(it);
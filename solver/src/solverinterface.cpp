@@ -9,6 +9,7 @@
 
 #include <csdb/currency.hpp>
 #include <lib/system/logger.hpp>
+#include <lib/system/metrics.hpp>
 
 #include <chrono>
 #include <algorithm>
@@ -172,6 +173,9 @@ void SolverCore::nextRound(bool updateRound) {
 }
 
 void SolverCore::gotStageOne(const cs::StageOne& stage) {
+    static auto& stageTime = cs::metrics::timer("cs_solver_stage_process_seconds", "Time of processing of received stage", cs::metrics::label("stage", "1"));
+    cs::metrics::ScopedTimer timer(stageTime);
+
     if (find_stage1(stage.sender) != nullptr) {
         uint64_t lastTimeStamp = 0;
         uint64_t currentTimeStamp = 0;
@@ -262,6 +266,9 @@ void SolverCore::gotStageThreeRequest(uint8_t requester, uint8_t required, uint8
 }
 
 void SolverCore::gotStageTwo(const cs::StageTwo& stage) {
+    static auto& stageTime = cs::metrics::timer("cs_solver_stage_process_seconds", "Time of processing of received stage", cs::metrics::label("stage", "2"));
+    cs::metrics::ScopedTimer timer(stageTime);
+
     if (find_stage2(stage.sender) != nullptr) {
         // duplicated
         return;
@@ -280,6 +287,9 @@ void SolverCore::gotStageTwo(const cs::StageTwo& stage) {
 }
 
 void SolverCore::gotStageThree(const cs::StageThree& stage, const uint8_t flagg) {
+    static auto& stageTime = cs::metrics::timer("cs_solver_stage_process_seconds", "Time of processing of received stage", cs::metrics::label("stage", "3"));
+    cs::metrics::ScopedTimer timer(stageTime);
+
     if (stage.iteration < currentStage3iteration_) {
         // stage with old iteration
         return;
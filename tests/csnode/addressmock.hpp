@@ -0,0 +1,20 @@
+#ifndef PROJECT_ADDRESSMOCK_HPP
+#define PROJECT_ADDRESSMOCK_HPP
+
+#include <cstdint>
+
+#include <csdb/address.hpp>
+#include <lib/system/common.hpp>
+
+// address of public key with the first byte set to value, the rest are zeros
+inline csdb::Address makeAddress(uint8_t value) {
+    cs::PublicKey key{};
+    key[0] = value;
+    return csdb::Address::from_public_key(key);
+}
+
+inline csdb::Address makeContract(uint8_t value) {
+    return makeAddress(value);
+}
+
+#endif  // PROJECT_ADDRESSMOCK_HPP
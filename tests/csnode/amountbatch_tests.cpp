@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <csdb/amount.hpp>
+#include <csdb/amount_batch.hpp>
+
+namespace {
+using Generator = std::mt19937_64;
+
+csdb::Amount randomAmount(Generator& generator, int32_t maxIntegral) {
+    std::uniform_int_distribution<int32_t> integral(-maxIntegral, maxIntegral);
+    std::uniform_int_distribution<uint64_t> fraction(0, csdb::Amount::AMOUNT_MAX_FRACTION - 1);
+
+    // edge fractions are the interesting ones for carry handling
+    switch (generator() % 8) {
+        case 0:
+            return csdb::Amount(integral(generator), 0);
+        case 1:
+            return csdb::Amount(integral(generator), csdb::Amount::AMOUNT_MAX_FRACTION - 1);
+        default:
+            return csdb::Amount(integral(generator), fraction(generator));
+    }
+}
+
+void expectBitIdentical(const csdb::Amount& expected, const csdb::Amount& actual) {
+    ASSERT_EQ(expected.integral(), actual.integral());
+    ASSERT_EQ(expected.fraction(), actual.fraction());
+}
+}  // namespace
+
+TEST(AmountBatch, SumIsSameAsScalarAccumulation) {
+    Generator generator(42);
+
+    for (size_t count : {0, 1, 3, 4, 5, 7, 8, 63, 64, 65, 1000}) {
+        std::vector<int32_t> integral;
+        std::vector<uint64_t> fraction;
+        csdb::Amount expected;
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto value = randomAmount(generator, 1000);
+            integral.push_back(value.integral());
+            fraction.push_back(value.fraction());
+            expected += value;
+        }
+
+        expectBitIdentical(expected, csdb::AmountBatch::sum(integral.data(), fraction.data(), count));
+    }
+}
+
+TEST(AmountBatch, ApplyIsSameAsScalarOperators) {
+    constexpr size_t kRuns = 50;
+
+    for (size_t run = 0; run < kRuns; ++run) {
+        Generator generator(run);
+
+        const size_t walletsCount = 1 + generator() % 300;
+        const size_t operationsCount = generator() % 5000;
+
+        std::vector<csdb::Amount> scalar;
+        csdb::AmountBatch batch;
+        batch.reserve(walletsCount, operationsCount);
+
+        for (size_t i = 0; i < walletsCount; ++i) {
+            scalar.push_back(randomAmount(generator, 100000));
+            batch.addWallet(scalar.back());
+        }
+
+        csdb::Amount scalarFee;
+
+        for (size_t i = 0; i < operationsCount; ++i) {
+            const auto slot = static_cast<csdb::AmountBatch::Slot>(generator() % walletsCount);
+            const auto value = randomAmount(generator, 100);
+
+            if (generator() % 2) {
+                scalar[slot] += value;
+                batch.credit(slot, value);
+            }
+            else {
+                scalar[slot] -= value;
+                batch.debit(slot, value);
+            }
+
+            const auto fee = randomAmount(generator, 1);
+            scalarFee += fee;
+            batch.addFee(fee);
+        }
+
+        batch.apply();
+
+        std::vector<csdb::AmountBatch::Slot> scalarNegative;
+
+        for (size_t i = 0; i < walletsCount; ++i) {
+            const auto slot = static_cast<csdb::AmountBatch::Slot>(i);
+            expectBitIdentical(scalar[i], batch.balance(slot));
+
+            if (scalar[i] < csdb::Amount(0)) {
+                scalarNegative.push_back(slot);
+            }
+        }
+
+        expectBitIdentical(scalarFee, batch.feeTotal());
+        ASSERT_EQ(scalarNegative, batch.negative());
+    }
+}
+
+TEST(AmountBatch, VectorizedKernelsAreSameAsScalar) {
+    // nothing to compare without AVX2, both calls run the same scalar loop
+    if (!csdb::AmountBatch::isVectorized()) {
+        return;
+    }
+
+    Generator generator(7);
+
+    for (size_t count : {0, 1, 3, 4, 5, 7, 8, 9, 63, 64, 65, 1000}) {
+        std::vector<int32_t> integral;
+        std::vector<uint64_t> fraction;
+        std::vector<int32_t> deltaIntegral;
+        std::vector<uint64_t> deltaFraction;
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto value = randomAmount(generator, 1000);
+            integral.push_back(value.integral());
+            fraction.push_back(value.fraction());
+
+            const auto delta = randomAmount(generator, 1000);
+            deltaIntegral.push_back(delta.integral());
+            deltaFraction.push_back(delta.fraction());
+        }
+
+        expectBitIdentical(csdb::AmountBatch::sumScalar(integral.data(), fraction.data(), count),
+                           csdb::AmountBatch::sum(integral.data(), fraction.data(), count));
+
+        std::vector<csdb::AmountBatch::Slot> scalarNegative;
+        std::vector<csdb::AmountBatch::Slot> negative;
+        csdb::AmountBatch::findNegativeScalar(integral.data(), count, scalarNegative);
+        csdb::AmountBatch::findNegative(integral.data(), count, negative);
+        ASSERT_EQ(scalarNegative, negative);
+
+        auto scalarIntegral = integral;
+        auto scalarFraction = fraction;
+        csdb::AmountBatch::addScalar(scalarIntegral.data(), scalarFraction.data(), deltaIntegral.data(), deltaFraction.data(), count);
+        csdb::AmountBatch::add(integral.data(), fraction.data(), deltaIntegral.data(), deltaFraction.data(), count);
+        ASSERT_EQ(scalarIntegral, integral);
+        ASSERT_EQ(scalarFraction, fraction);
+    }
+}
+
+TEST(AmountBatch, ApplyResetsDeltas) {
+    csdb::AmountBatch batch;
+    const auto slot = batch.addWallet(csdb::Amount(1, 500000000000000000ULL));
+
+    batch.debit(slot, csdb::Amount(2));
+    batch.apply();
+
+    expectBitIdentical(csdb::Amount(-1, 500000000000000000ULL), batch.balance(slot));
+    ASSERT_EQ(batch.negative().size(), 1);
+
+    batch.apply();
+
+    expectBitIdentical(csdb::Amount(-1, 500000000000000000ULL), batch.balance(slot));
+    expectBitIdentical(csdb::Amount(0), batch.feeTotal());
+}
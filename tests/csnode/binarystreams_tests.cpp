@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+
+#include "transactionspacket.hpp"
+
+#include <csdb/address.hpp>
+#include <csdb/currency.hpp>
+#include <csdb/transaction.hpp>
+#include <csdb/user_field.hpp>
+
+#include <src/binary_streams.hpp>
+
+// allocations are counted per thread, so other test threads do not affect assertions
+static thread_local size_t allocationsCount = 0;
+
+void* operator new(std::size_t size) {
+    ++allocationsCount;
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+class AllocationsCounter {
+public:
+    AllocationsCounter()
+    : start_(allocationsCount) {
+    }
+
+    size_t count() const {
+        return allocationsCount - start_;
+    }
+
+private:
+    size_t start_;
+};
+
+csdb::Transaction makeTransaction(int64_t innerId) {
+    csdb::Transaction transaction;
+
+    cs::PublicKey target;
+    target.fill(0x2a);
+
+    transaction.set_source(csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000007"));
+    transaction.set_target(csdb::Address::from_public_key(target));
+    transaction.set_currency(1);
+    transaction.set_amount(csdb::Amount(10000, 0));
+    transaction.set_innerID(innerId);
+    transaction.add_user_field(1, csdb::UserField(std::string(100, 'x')));
+
+    return transaction;
+}
+
+cs::TransactionsPacket makePacket(size_t count) {
+    cs::TransactionsPacket packet;
+
+    for (size_t i = 0; i < count; ++i) {
+        packet.addTransaction(makeTransaction(static_cast<int64_t>(i + 1)));
+    }
+
+    return packet;
+}
+}  // namespace
+
+TEST(BinaryStreams, CounterDoesNotAllocate) {
+    const auto transaction = makeTransaction(1);
+    const auto expected = transaction.to_byte_stream();
+
+    AllocationsCounter counter;
+
+    auto os = csdb::priv::obstream::counter();
+    os.put(transaction);
+
+    ASSERT_EQ(counter.count(), 0);
+    ASSERT_TRUE(os.isCounter());
+    ASSERT_EQ(os.size(), expected.size());
+}
+
+TEST(BinaryStreams, SerializeAllocatesOnceByExactSize) {
+    const auto transaction = makeTransaction(1);
+    cs::Bytes buffer;
+
+    {
+        AllocationsCounter counter;
+        csdb::priv::serialize(buffer, [&](csdb::priv::obstream& os) { os.put(transaction); });
+
+        ASSERT_EQ(counter.count(), 1);
+    }
+
+    ASSERT_EQ(buffer.size(), buffer.capacity());
+    ASSERT_EQ(buffer, transaction.to_byte_stream());
+}
+
+TEST(BinaryStreams, PacketToBinaryReusesBuffer) {
+    const auto packet = makePacket(50);
+    const auto expected = packet.toBinary();
+
+    cs::Bytes buffer;
+    packet.toBinary(buffer);
+
+    ASSERT_EQ(buffer, expected);
+    ASSERT_EQ(buffer.size(), buffer.capacity());
+
+    AllocationsCounter counter;
+    packet.toBinary(buffer);
+
+    ASSERT_EQ(counter.count(), 0);
+    ASSERT_EQ(buffer, expected);
+}
+
+TEST(BinaryStreams, TransactionSignedContentReusesBuffer) {
+    const auto transaction = makeTransaction(1);
+    const auto expected = transaction.to_byte_stream_for_sig();
+
+    cs::Bytes buffer;
+    transaction.to_byte_stream_for_sig(buffer);
+
+    ASSERT_EQ(buffer, expected);
+
+    AllocationsCounter counter;
+    transaction.to_byte_stream_for_sig(buffer);
+
+    ASSERT_EQ(counter.count(), 0);
+    ASSERT_EQ(buffer, expected);
+}
+
+TEST(BinaryStreams, ViewsPointIntoSource) {
+    const std::string text = "user field value";
+    const cs::Bytes bytes(64, 0x11);
+
+    csdb::priv::obstream os;
+    os.put(text);
+    os.put(bytes);
+
+    const auto& data = os.buffer();
+    csdb::priv::ibstream is(data.data(), data.size());
+
+    std::string_view textView;
+    cs::BytesView bytesView;
+
+    AllocationsCounter counter;
+
+    ASSERT_TRUE(is.get_view(textView));
+    ASSERT_TRUE(is.get_view(bytesView));
+    ASSERT_TRUE(is.empty());
+    ASSERT_EQ(counter.count(), 0);
+
+    ASSERT_EQ(textView, text);
+    ASSERT_EQ(bytesView.size(), bytes.size());
+    ASSERT_TRUE(std::equal(bytesView.begin(), bytesView.end(), bytes.begin()));
+    ASSERT_GE(reinterpret_cast<const cs::Byte*>(textView.data()), data.data());
+    ASSERT_LT(bytesView.data(), data.data() + data.size());
+}
+
+TEST(BinaryStreams, ViewOutOfRangeFails) {
+    csdb::priv::obstream os;
+    os.put(static_cast<size_t>(100));
+    os.put(static_cast<uint32_t>(1));
+
+    const auto& data = os.buffer();
+    csdb::priv::ibstream is(data.data(), data.size());
+
+    cs::BytesView view;
+    ASSERT_FALSE(is.get_view(view));
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <csnode/blocksprefetcher.hpp>
+
+namespace {
+// chain 100 -> 90 -> 80 -> ... -> 10
+cs::Sequence previous(cs::Sequence sequence) {
+    return sequence > 10 && sequence <= 100 ? sequence - 10 : cs::kWrongSequence;
+}
+
+csdb::Pool load(cs::Sequence sequence) {
+    return csdb::Pool(csdb::PoolHash{}, sequence);
+}
+
+class Gate {
+public:
+    void open() {
+        {
+            std::lock_guard lock(mutex_);
+            opened_ = true;
+        }
+
+        condition_.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock lock(mutex_);
+        condition_.wait(lock, [this] { return opened_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool opened_ = false;
+};
+}  // namespace
+
+TEST(BlocksPrefetcher, ReturnsChainInOrder) {
+    for (size_t window : {1, 3, 16}) {
+        cs::BlocksPrefetcher prefetcher(previous, load, window);
+        prefetcher.reset(100);
+
+        std::vector<cs::Sequence> sequences;
+
+        for (auto pool = prefetcher.next(); pool.is_valid(); pool = prefetcher.next()) {
+            sequences.push_back(pool.sequence());
+        }
+
+        ASSERT_EQ(sequences, (std::vector<cs::Sequence>{90, 80, 70, 60, 50, 40, 30, 20, 10}));
+        ASSERT_FALSE(prefetcher.next().is_valid());
+    }
+}
+
+TEST(BlocksPrefetcher, ResolvesNotMoreThanWindow) {
+    size_t resolved = 0;
+
+    cs::BlocksPrefetcher prefetcher(
+        [&resolved](cs::Sequence sequence) {
+            ++resolved;
+            return previous(sequence);
+        },
+        load, 3);
+
+    prefetcher.reset(100);
+    ASSERT_EQ(resolved, 3);
+
+    ASSERT_EQ(prefetcher.next().sequence(), 90);
+    ASSERT_EQ(resolved, 4);
+}
+
+TEST(BlocksPrefetcher, EmptyChain) {
+    cs::BlocksPrefetcher prefetcher(previous, load);
+
+    prefetcher.reset(10);
+    ASSERT_FALSE(prefetcher.next().is_valid());
+
+    prefetcher.reset(cs::kWrongSequence);
+    ASSERT_FALSE(prefetcher.next().is_valid());
+}
+
+TEST(BlocksPrefetcher, CancelledLoadsAreNotStarted) {
+    auto gate = std::make_shared<Gate>();
+    auto started = std::make_shared<std::atomic<size_t>>(0);
+
+    {
+        // the first load blocks, so the rest of window stays queued or is blocked as well
+        cs::BlocksPrefetcher prefetcher(
+            previous,
+            [gate, started](cs::Sequence sequence) {
+                ++*started;
+                gate->wait();
+                return load(sequence);
+            },
+            8);
+
+        prefetcher.reset(100);
+
+        std::thread opener([gate] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            gate->open();
+        });
+
+        prefetcher.cancel();
+        ASSERT_FALSE(prefetcher.next().is_valid());
+
+        opener.join();
+    }
+
+    const size_t startedOnCancel = *started;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    ASSERT_LE(startedOnCancel, 8);
+    ASSERT_EQ(*started, startedOnCancel);
+}
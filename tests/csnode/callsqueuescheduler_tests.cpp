@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <lib/system/structures.hpp>
+#include <solver/callsqueuescheduler.hpp>
+
+namespace {
+using Clock = CallsQueueScheduler::ClockType;
+
+// CallsQueue is called by network executor in node, tests call it themselves
+template <typename Predicate>
+bool waitFor(Predicate predicate, std::chrono::milliseconds timeout) {
+    const auto deadline = Clock::now() + timeout;
+
+    while (Clock::now() < deadline) {
+        CallsQueue::instance().callAll();
+
+        if (predicate()) {
+            return true;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return false;
+}
+}  // namespace
+
+TEST(CallsQueueScheduler, CallsOnceNotEarlier) {
+    CallsQueueScheduler scheduler;
+
+    for (auto delay : {0, 5, 100, 300}) {
+        const auto start = Clock::now();
+        Clock::time_point called;
+        int calls = 0;
+
+        scheduler.InsertOnce(static_cast<uint32_t>(delay), [&] {
+            called = Clock::now();
+            ++calls;
+        }, false, 1);
+
+        ASSERT_TRUE(waitFor([&] { return calls != 0; }, std::chrono::milliseconds(delay + 1000)));
+        ASSERT_GE(called - start, std::chrono::milliseconds(delay));
+
+        // once call is not repeated
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        CallsQueue::instance().callAll();
+        ASSERT_EQ(calls, 1);
+    }
+
+    ASSERT_EQ(scheduler.TotalExecutedCalls(), 4u);
+    scheduler.Stop();
+}
+
+TEST(CallsQueueScheduler, CallsPeriodicUntilRemoved) {
+    CallsQueueScheduler scheduler;
+    int calls = 0;
+
+    const auto tag = scheduler.InsertPeriodic(10, [&] { ++calls; });
+    ASSERT_NE(tag, CallsQueueScheduler::no_tag);
+
+    ASSERT_TRUE(waitFor([&] { return calls >= 5; }, std::chrono::seconds(2)));
+    ASSERT_TRUE(scheduler.Remove(tag));
+
+    CallsQueue::instance().callAll();
+    const int removed = calls;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CallsQueue::instance().callAll();
+
+    ASSERT_EQ(calls, removed);
+    ASSERT_FALSE(scheduler.Remove(tag));
+
+    scheduler.Stop();
+}
+
+TEST(CallsQueueScheduler, RejectsOrReplacesExisting) {
+    CallsQueueScheduler scheduler;
+    int first = 0;
+    int second = 0;
+
+    scheduler.InsertOnce(1000, [&] { ++first; }, false, 7);
+    scheduler.InsertOnce(10, [&] { ++second; }, false, 7);
+
+    ASSERT_EQ(scheduler.TotalBlockedOnQueue(), 1u);
+
+    scheduler.InsertOnce(20, [&] { ++second; }, true, 7);
+
+    ASSERT_TRUE(waitFor([&] { return second != 0; }, std::chrono::seconds(2)));
+    ASSERT_EQ(first, 0);
+
+    scheduler.Stop();
+}
+
+TEST(CallsQueueScheduler, CancelsQueuedCall) {
+    CallsQueueScheduler scheduler;
+    int calls = 0;
+
+    scheduler.InsertOnce(0, [&] { ++calls; }, false, 3);
+
+    // call is put to CallsQueue but removed before CallsQueue calls it
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    scheduler.Remove(3);
+    CallsQueue::instance().callAll();
+
+    ASSERT_EQ(calls, 0);
+    scheduler.Stop();
+}
+
+TEST(CallsQueueScheduler, KeepsOrderOfManyCalls) {
+    CallsQueueScheduler scheduler;
+    std::vector<int> calls;
+
+    // calls land to different levels of wheel
+    for (int i = 0; i < 10; ++i) {
+        scheduler.InsertOnce(static_cast<uint32_t>(250 - i * 25), [&calls, i] { calls.push_back(i); }, false, static_cast<CallsQueueScheduler::CallTag>(i + 1));
+    }
+
+    ASSERT_TRUE(waitFor([&] { return calls.size() == 10; }, std::chrono::seconds(2)));
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(calls[static_cast<size_t>(i)], 9 - i);
+    }
+
+    scheduler.Stop();
+}
+
+TEST(CallsQueueScheduler, CascadesBeforeLaterNearCall) {
+    CallsQueueScheduler scheduler;
+    const auto start = Clock::now();
+    std::vector<int> calls;
+
+    // the first call waits in upper level, the third one lands to level 0 past its cascade
+    scheduler.InsertOnce(69, [&] { calls.push_back(1); }, false, 1);
+    std::this_thread::sleep_until(start + std::chrono::milliseconds(30));
+    scheduler.InsertOnce(5, [&] { calls.push_back(2); }, false, 2);
+    std::this_thread::sleep_until(start + std::chrono::milliseconds(40));
+    scheduler.InsertOnce(50, [&] { calls.push_back(3); }, false, 3);
+    std::this_thread::sleep_until(start + std::chrono::milliseconds(45));
+    scheduler.InsertOnce(3, [&] { calls.push_back(4); }, false, 4);
+
+    const bool isCalled = waitFor([&] { return calls.size() == 4; }, std::chrono::seconds(2));
+    scheduler.Stop();
+
+    ASSERT_TRUE(isCalled);
+
+    // late cascade would make the first call after the third one, due 21 ms later
+    ASSERT_EQ(calls, (std::vector<int>{2, 4, 1, 3}));
+
+    // wall clock bound depends on machine load, so jitter is only reported
+    RecordProperty("MaxJitterUs", static_cast<int>(scheduler.MaxJitterUs()));
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <csdb/address.hpp>
+#include <csdb/amount.hpp>
+#include <csdb/amount_commission.hpp>
+#include <csdb/currency.hpp>
+#include <csdb/pool.hpp>
+#include <csdb/transaction.hpp>
+#include <csdb/user_field.hpp>
+
+namespace {
+cs::PublicKey makeKey(uint8_t seed) {
+    cs::PublicKey key;
+    key.fill(seed);
+    return key;
+}
+
+csdb::Transaction makeTransaction(int64_t innerId, bool isWalletIdSource) {
+    csdb::Transaction transaction;
+
+    if (isWalletIdSource) {
+        transaction.set_source(csdb::Address::from_wallet_id(static_cast<csdb::internal::WalletId>(innerId)));
+    }
+    else {
+        transaction.set_source(csdb::Address::from_public_key(makeKey(static_cast<uint8_t>(innerId % 3))));
+    }
+
+    transaction.set_target(csdb::Address::from_public_key(makeKey(0x7f)));
+    transaction.set_currency(1);
+    transaction.set_amount(csdb::Amount(static_cast<int32_t>(innerId), 500000000000000000ULL));
+    transaction.set_max_fee(csdb::AmountCommission(0.1));
+    transaction.set_counted_fee(csdb::AmountCommission(0.01));
+    transaction.set_innerID(innerId);
+
+    cs::Signature signature;
+    signature.fill(static_cast<uint8_t>(innerId));
+    transaction.set_signature(signature);
+
+    if (innerId % 2) {
+        transaction.add_user_field(1, csdb::UserField(std::string(static_cast<size_t>(innerId), 'u')));
+        transaction.add_user_field(2, csdb::UserField(innerId));
+    }
+
+    return transaction;
+}
+
+csdb::Pool makePool(size_t transactionsCount) {
+    csdb::Pool pool(csdb::PoolHash{}, 42);
+    pool.add_user_field(0, csdb::UserField(std::string("1577836800000")));
+
+    for (size_t i = 0; i < transactionsCount; ++i) {
+        pool.add_transaction(makeTransaction(static_cast<int64_t>(i + 1), i % 4 == 0));
+    }
+
+    pool.compose();
+    return pool;
+}
+}  // namespace
+
+TEST(ColumnarPool, RestoresRowRepresentation) {
+    for (size_t count : {0, 1, 2, 17, 300}) {
+        const auto pool = makePool(count);
+        const auto columnar = pool.to_columnar_binary();
+
+        ASSERT_FALSE(columnar.empty());
+        ASSERT_NE(columnar, pool.to_binary());
+
+        const auto restored = csdb::Pool::from_binary(cs::Bytes(columnar));
+
+        ASSERT_TRUE(restored.is_valid());
+        ASSERT_EQ(restored.to_binary(), pool.to_binary());
+        ASSERT_EQ(restored.hash(), pool.hash());
+        ASSERT_EQ(restored.transactions_count(), count);
+    }
+}
+
+TEST(ColumnarPool, HashAndMetaAreReadFromBothFormats) {
+    const auto pool = makePool(10);
+
+    ASSERT_EQ(csdb::Pool::hash_from_binary(pool.to_columnar_binary()), pool.hash());
+    ASSERT_EQ(csdb::Pool::hash_from_binary(cs::Bytes(pool.to_binary())), pool.hash());
+
+    size_t count = 0;
+    const auto meta = csdb::Pool::meta_from_binary(pool.to_columnar_binary(), count);
+
+    ASSERT_TRUE(meta.is_valid());
+    ASSERT_EQ(count, 10);
+    ASSERT_EQ(meta.sequence(), pool.sequence());
+}
+
+TEST(ColumnarPool, IsSmallerForRepeatedKeys) {
+    const auto pool = makePool(300);
+    ASSERT_LT(pool.to_columnar_binary().size(), pool.to_binary().size());
+}
+
+TEST(ColumnarPool, CorruptedDataIsRejected) {
+    const auto pool = makePool(20);
+    auto columnar = pool.to_columnar_binary();
+
+    auto truncated = columnar;
+    truncated.resize(truncated.size() / 2);
+    ASSERT_FALSE(csdb::Pool::from_binary(std::move(truncated)).is_valid());
+
+    // transactions count does not match columns
+    columnar[2] ^= 0x01;
+    ASSERT_FALSE(csdb::Pool::from_binary(std::move(columnar)).is_valid());
+}
+
+TEST(ColumnarPool, NotComposedPoolHasNoColumnarRepresentation) {
+    csdb::Pool pool(csdb::PoolHash{}, 1);
+    ASSERT_TRUE(pool.to_columnar_binary().empty());
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <solver/conflictgraph.hpp>
+
+namespace {
+csdb::Address contract(uint8_t id) {
+    cs::PublicKey key;
+    key.fill(id);
+    return csdb::Address::from_public_key(key);
+}
+
+using Ready = std::vector<size_t>;
+}  // namespace
+
+TEST(ConflictGraph, IndependentItemsAreReadyTogether) {
+    cs::ConflictGraph graph;
+
+    graph.add({contract(1)}, cs::ConflictGraph::State::Pending);
+    graph.add({contract(2), contract(3)}, cs::ConflictGraph::State::Pending);
+    graph.add({contract(4)}, cs::ConflictGraph::State::Pending);
+
+    ASSERT_EQ(graph.ready(), (Ready{0, 1, 2}));
+    ASSERT_FALSE(graph.conflicts(0, 1));
+}
+
+TEST(ConflictGraph, ConflictingItemsKeepQueueOrder) {
+    cs::ConflictGraph graph;
+
+    // item 1 uses contract of item 0, item 2 targets contract used by item 1
+    graph.add({contract(1)}, cs::ConflictGraph::State::Pending);
+    graph.add({contract(2), contract(1)}, cs::ConflictGraph::State::Pending);
+    graph.add({contract(2)}, cs::ConflictGraph::State::Pending);
+    graph.add({contract(5)}, cs::ConflictGraph::State::Pending);
+
+    ASSERT_TRUE(graph.conflicts(0, 1));
+    ASSERT_TRUE(graph.conflicts(1, 2));
+    ASSERT_FALSE(graph.conflicts(0, 2));
+
+    // item 2 does not conflict with item 0, but must not overtake item 1
+    ASSERT_EQ(graph.ready(), (Ready{0, 3}));
+}
+
+TEST(ConflictGraph, ActiveItemsBlockConflicting) {
+    cs::ConflictGraph graph;
+
+    graph.add({contract(1), contract(2)}, cs::ConflictGraph::State::Active);
+    graph.add({contract(2)}, cs::ConflictGraph::State::Pending);
+    graph.add({contract(3)}, cs::ConflictGraph::State::Pending);
+    graph.add({contract(4)}, cs::ConflictGraph::State::Active);
+    graph.add({contract(5), contract(5)}, cs::ConflictGraph::State::Pending);
+
+    ASSERT_EQ(graph.ready(), (Ready{2, 4}));
+}
+
+TEST(ConflictGraph, LaterActiveItemBlocksEarlierPending) {
+    cs::ConflictGraph graph;
+
+    graph.add({contract(1)}, cs::ConflictGraph::State::Pending);
+    graph.add({contract(1)}, cs::ConflictGraph::State::Active);
+
+    ASSERT_TRUE(graph.ready().empty());
+
+    graph.clear();
+    ASSERT_EQ(graph.size(), 0);
+    ASSERT_TRUE(graph.ready().empty());
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <csdb/currency.hpp>
+#include <csdb/pool.hpp>
+#include <csnode/blockchain.hpp>
+#include <csnode/contractstatesindex.hpp>
+#include <solver/smartcontracts.hpp>
+
+#include "addressmock.hpp"
+
+namespace {
+const csdb::Address genesisAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000001");
+const csdb::Address startAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000002");
+
+const std::string kIndexPath = "./contractstatesindex_tests";
+
+csdb::Transaction makeTransfer(const csdb::Address& target) {
+    return csdb::Transaction(1LL, makeAddress(0xff), target, csdb::Currency(1), csdb::Amount(1), csdb::AmountCommission(0.0), csdb::AmountCommission(0.0),
+                             cs::Signature{});
+}
+
+csdb::Transaction makeNewState(const csdb::Address& contract) {
+    csdb::Transaction transaction(1LL, contract, contract, csdb::Currency(1), csdb::Amount(0), csdb::AmountCommission(0.0), csdb::AmountCommission(0.0),
+                                  cs::Signature{});
+    transaction.add_user_field(cs::trx_uf::new_state::Value, std::string("state"));
+    transaction.add_user_field(cs::trx_uf::new_state::RefStart, cs::SmartContractRef().to_user_field());
+    return transaction;
+}
+
+csdb::Pool makePool(cs::Sequence sequence, const std::vector<csdb::Transaction>& transactions) {
+    csdb::Pool pool(csdb::PoolHash{}, sequence);
+
+    for (const auto& transaction : transactions) {
+        pool.add_transaction(transaction);
+    }
+
+    return pool;
+}
+
+void expectState(const csdb::TransactionID& id, cs::Sequence sequence, cs::Sequence index) {
+    ASSERT_TRUE(id.is_valid());
+    ASSERT_EQ(id.pool_seq(), sequence);
+    ASSERT_EQ(id.index(), index);
+}
+
+class ContractStatesIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        boost::filesystem::remove_all(kIndexPath);
+        boost::filesystem::create_directories(kIndexPath);
+    }
+
+    void TearDown() override {
+        boost::filesystem::remove_all(kIndexPath);
+    }
+
+    // contract 1 updates state at 10 and twice at 20, contract 2 at 15
+    void fill(cs::ContractStatesIndex& index) {
+        index.update(makePool(10, {makeTransfer(first), makeNewState(first)}));
+        index.update(makePool(15, {makeNewState(second)}));
+        index.update(makePool(20, {makeNewState(first), makeTransfer(second), makeNewState(first)}));
+    }
+
+    const csdb::Address first = makeAddress(1);
+    const csdb::Address second = makeAddress(2);
+
+    BlockChain blockChain{genesisAddress, startAddress};
+};
+}  // namespace
+
+TEST_F(ContractStatesIndexTest, FindsStateAtSequence) {
+    cs::ContractStatesIndex index(blockChain, kIndexPath, true);
+    fill(index);
+
+    expectState(index.getStateTransaction(first, 10), 10, 1);
+    expectState(index.getStateTransaction(first, 19), 10, 1);
+    expectState(index.getStateTransaction(first, 20), 20, 2);
+    expectState(index.getStateTransaction(first, 100), 20, 2);
+
+    expectState(index.getStateTransaction(second, 15), 15, 0);
+    expectState(index.getStateTransaction(second, 20), 15, 0);
+
+    index.close();
+}
+
+TEST_F(ContractStatesIndexTest, NoStateBeforeFirstUpdate) {
+    cs::ContractStatesIndex index(blockChain, kIndexPath, true);
+    fill(index);
+
+    ASSERT_FALSE(index.getStateTransaction(first, 9).is_valid());
+
+    // floor key of the second contract here belongs to the first one
+    ASSERT_FALSE(index.getStateTransaction(second, 14).is_valid());
+    ASSERT_FALSE(index.getStateTransaction(makeAddress(3), 100).is_valid());
+
+    index.close();
+}
+
+TEST_F(ContractStatesIndexTest, RemovesBlockStates) {
+    cs::ContractStatesIndex index(blockChain, kIndexPath, true);
+    fill(index);
+
+    index.onRemoveBlock(makePool(20, {makeNewState(first), makeTransfer(second), makeNewState(first)}));
+
+    expectState(index.getStateTransaction(first, 20), 10, 1);
+    expectState(index.getStateTransaction(second, 20), 15, 0);
+
+    index.close();
+}
+
+TEST_F(ContractStatesIndexTest, KeepsStatesAfterReopen) {
+    {
+        cs::ContractStatesIndex index(blockChain, kIndexPath, true);
+        fill(index);
+        index.close();
+    }
+
+    cs::ContractStatesIndex index(blockChain, kIndexPath);
+
+    expectState(index.getStateTransaction(first, 20), 20, 2);
+    expectState(index.getStateTransaction(second, 16), 15, 0);
+
+    index.close();
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+#include <string>
+
+#include <csnode/contractstatestore.hpp>
+
+#include "addressmock.hpp"
+
+namespace {
+std::string makeState(size_t size, uint32_t seed) {
+    std::mt19937 generator(seed);
+    std::string state(size, '\0');
+
+    for (auto& byte : state) {
+        byte = static_cast<char>(generator());
+    }
+
+    return state;
+}
+}  // namespace
+
+TEST(ContractStateStore, SplitsByContent) {
+    const auto state = makeState(256 * 1024, 1);
+    const auto lengths = cs::ContractStateStore::split(state.data(), state.size());
+
+    ASSERT_EQ(std::accumulate(lengths.begin(), lengths.end(), size_t{0}), state.size());
+
+    for (size_t i = 0; i + 1 < lengths.size(); ++i) {
+        ASSERT_GE(lengths[i], cs::ContractStateStore::kMinChunkSize);
+        ASSERT_LE(lengths[i], cs::ContractStateStore::kMaxChunkSize);
+    }
+
+    // insertion at the beginning shifts data, but boundaries after it are the same
+    const auto shifted = std::string("inserted") + state;
+    const auto shiftedLengths = cs::ContractStateStore::split(shifted.data(), shifted.size());
+
+    ASSERT_EQ(lengths.back(), shiftedLengths.back());
+    ASSERT_EQ(lengths[lengths.size() - 2], shiftedLengths[shiftedLengths.size() - 2]);
+}
+
+TEST(ContractStateStore, StoresDeltas) {
+    cs::ContractStateStore store;
+    const auto contract = makeContract(1);
+
+    auto state = makeState(128 * 1024, 2);
+    const auto first = store.put(contract, state);
+
+    state[64 * 1024] ^= 0x01;
+    const auto second = store.put(contract, state);
+
+    ASSERT_NE(first, second);
+    ASSERT_EQ(store.get(second), state);
+
+    state[64 * 1024] ^= 0x01;
+    ASSERT_EQ(store.get(first), state);
+
+    const auto statistics = store.statistics();
+
+    ASSERT_EQ(statistics.states, 2);
+    ASSERT_EQ(statistics.logicalBytes, 2 * state.size());
+    ASSERT_LT(statistics.chunkBytes, state.size() + 2 * cs::ContractStateStore::kMaxChunkSize);
+}
+
+TEST(ContractStateStore, SameStateIsStoredOnce) {
+    cs::ContractStateStore store;
+    const auto state = makeState(16 * 1024, 3);
+
+    const auto first = store.put(makeContract(1), state);
+    const auto second = store.put(makeContract(2), state);
+
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(store.statistics().states, 1);
+
+    store.release(first);
+    ASSERT_EQ(store.get(second), state);
+}
+
+TEST(ContractStateStore, ReleaseKeepsBaseOfDelta) {
+    cs::ContractStateStore store;
+    const auto contract = makeContract(1);
+
+    auto state = makeState(64 * 1024, 4);
+    const auto first = store.put(contract, state);
+
+    state.append("tail");
+    const auto second = store.put(contract, state);
+
+    store.release(first);
+    ASSERT_EQ(store.get(second), state);
+
+    store.release(second);
+
+    const auto statistics = store.statistics();
+
+    ASSERT_EQ(statistics.states, 0);
+    ASSERT_EQ(statistics.chunks, 0);
+    ASSERT_EQ(statistics.chunkBytes, 0);
+    ASSERT_EQ(statistics.recipeBytes, 0);
+    ASSERT_EQ(statistics.logicalBytes, 0);
+}
+
+TEST(ContractStateStore, LongHistoryIsReadable) {
+    cs::ContractStateStore store;
+    const auto contract = makeContract(1);
+
+    auto state = makeState(32 * 1024, 5);
+    std::vector<std::pair<cs::ContractStateStore::StateId, std::string>> history;
+
+    for (size_t i = 0; i < 3 * cs::ContractStateStore::kMaxDeltaDepth; ++i) {
+        state[(i * 4099) % state.size()] ^= 0x5A;
+        history.emplace_back(store.put(contract, state), state);
+    }
+
+    for (const auto& [id, expected] : history) {
+        ASSERT_EQ(store.get(id), expected);
+    }
+}
+
+TEST(ContractStateStore, DatabaseBoundsMemory) {
+    cs::ContractStateStore::Settings settings;
+    settings.path = "./contractstatestore_tests_db";
+    settings.memoryLimit = 16 * 1024;
+
+    cs::ContractStateStore store(settings);
+
+    const auto state = makeState(256 * 1024, 6);
+    const auto id = store.put(makeContract(1), state);
+
+    ASSERT_LE(store.statistics().cachedBytes, settings.memoryLimit);
+    ASSERT_EQ(store.get(id), state);
+    ASSERT_LE(store.statistics().cachedBytes, settings.memoryLimit);
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include <csdb/currency.hpp>
+#include <csdb/pool.hpp>
+#include <csnode/blockchain.hpp>
+#include <csstats.hpp>
+
+#include "addressmock.hpp"
+
+namespace {
+const csdb::Address genesisAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000001");
+const csdb::Address startAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000002");
+
+const char* kStatsPath = "./caches/stats";
+
+// block of the current minute with transactions of amount 1
+csdb::Pool makeBlock(cs::Sequence sequence, size_t transactions, uint8_t target = 2) {
+    const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    csdb::Pool pool(csdb::PoolHash{}, sequence);
+    pool.add_user_field(0, csdb::UserField(std::to_string(now)));
+
+    for (size_t i = 0; i < transactions; ++i) {
+        pool.add_transaction(csdb::Transaction(static_cast<int64_t>(i + 1), makeAddress(10), makeAddress(target), csdb::Currency(1), csdb::Amount(1),
+                                               csdb::AmountCommission(0.0), csdb::AmountCommission(0.0), cs::Signature{}));
+    }
+
+    pool.compose();
+    return pool;
+}
+
+void expectTotal(csstats::csstats& stats, csstats::Count pools, csstats::Count transactions) {
+    const auto periods = stats.getStats();
+
+    ASSERT_EQ(periods[csstats::PeriodIndex::Total].poolsCount, pools);
+    ASSERT_EQ(periods[csstats::PeriodIndex::Total].transactionsCount, transactions);
+
+    // blocks are of the current minute
+    ASSERT_EQ(periods[csstats::PeriodIndex::Day].poolsCount, pools);
+    ASSERT_EQ(periods[csstats::PeriodIndex::Day].transactionsCount, transactions);
+}
+
+class CsStatsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        boost::filesystem::remove(kStatsPath);
+    }
+
+    void TearDown() override {
+        boost::filesystem::remove(kStatsPath);
+    }
+
+    BlockChain blockChain{genesisAddress, startAddress};
+};
+}  // namespace
+
+TEST_F(CsStatsTest, FoldsStoredBlockOnce) {
+    csstats::csstats stats(blockChain);
+
+    const auto first = makeBlock(1, 2);
+    stats.onStoreBlock(first);
+
+    // deferred block is stored once more when it gets more signatures
+    stats.onStoreBlock(first);
+    expectTotal(stats, 1, 2);
+
+    stats.onStoreBlock(makeBlock(2, 3));
+    expectTotal(stats, 2, 5);
+
+    const auto periods = stats.getStats();
+    ASSERT_EQ(periods[csstats::PeriodIndex::Total].balancePerCurrency.at(1).integral, 5);
+}
+
+TEST_F(CsStatsTest, RemovesLastBlock) {
+    csstats::csstats stats(blockChain);
+
+    const auto second = makeBlock(2, 3);
+
+    stats.onStoreBlock(makeBlock(1, 2));
+    stats.onStoreBlock(second);
+    stats.onRemoveBlock(second);
+    expectTotal(stats, 1, 2);
+
+    // only the last folded block is removed
+    stats.onRemoveBlock(second);
+    expectTotal(stats, 1, 2);
+
+    stats.onStoreBlock(makeBlock(2, 1, 3));
+    expectTotal(stats, 2, 3);
+}
+
+TEST_F(CsStatsTest, SkipsFoldedBlocksAfterReload) {
+    const auto first = makeBlock(1, 2);
+    const auto second = makeBlock(2, 3);
+
+    {
+        csstats::csstats stats(blockChain);
+        stats.onStoreBlock(first);
+        stats.onStoreBlock(second);
+    }
+
+    csstats::csstats stats(blockChain);
+    expectTotal(stats, 2, 5);
+
+    stats.onStartReadBlocks(2);
+    stats.onReadBlock(first, nullptr);
+    stats.onReadBlock(second, nullptr);
+    expectTotal(stats, 2, 5);
+
+    stats.onStoreBlock(makeBlock(3, 1));
+    expectTotal(stats, 3, 6);
+}
+
+TEST_F(CsStatsTest, RebuildsWhenDatabaseIsBehind) {
+    const auto first = makeBlock(1, 2);
+    const auto second = makeBlock(2, 3);
+
+    {
+        csstats::csstats stats(blockChain);
+        stats.onStoreBlock(first);
+        stats.onStoreBlock(second);
+        stats.onStoreBlock(makeBlock(3, 4));
+    }
+
+    // the third block was stored, but not written before restart
+    csstats::csstats stats(blockChain);
+    stats.onStartReadBlocks(2);
+    stats.onReadBlock(first, nullptr);
+    stats.onReadBlock(second, nullptr);
+    expectTotal(stats, 2, 5);
+}
+
+TEST_F(CsStatsTest, RebuildsWhenBlockDiffers) {
+    const auto first = makeBlock(1, 2);
+
+    {
+        csstats::csstats stats(blockChain);
+        stats.onStoreBlock(first);
+        stats.onStoreBlock(makeBlock(2, 3));
+    }
+
+    csstats::csstats stats(blockChain);
+    stats.onStartReadBlocks(2);
+    stats.onReadBlock(first, nullptr);
+
+    // database has other second block, blocks before it are not in test blockchain
+    stats.onReadBlock(makeBlock(2, 1, 3), nullptr);
+    expectTotal(stats, 1, 1);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <executorlanes.hpp>
+
+namespace {
+void waitFor(const cs::ExecutorLanes& lanes, cs::ExecutorLane lane, size_t count) {
+    while (lanes.waiting(lane) != count) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+}  // namespace
+
+TEST(ExecutorLanes, GivesDistinctSlots) {
+    cs::ExecutorLanes lanes(3, {0, 0, 0});
+
+    const auto first = lanes.acquire(cs::ExecutorLane::Consensus);
+    const auto second = lanes.acquire(cs::ExecutorLane::Getter);
+    const auto third = lanes.acquire(cs::ExecutorLane::Compile);
+
+    ASSERT_NE(first, second);
+    ASSERT_NE(second, third);
+    ASSERT_NE(first, third);
+    ASSERT_LT(std::max({first, second, third}), lanes.slotsCount());
+
+    lanes.release(cs::ExecutorLane::Getter, second);
+    ASSERT_EQ(lanes.acquire(cs::ExecutorLane::Getter), second);
+}
+
+TEST(ExecutorLanes, LaneLimitIsRespected) {
+    cs::ExecutorLanes lanes(4, {0, 1, 1});
+
+    const auto getter = lanes.acquire(cs::ExecutorLane::Getter);
+    std::atomic<bool> acquired = false;
+
+    std::thread thread([&] {
+        const auto slot = lanes.acquire(cs::ExecutorLane::Getter);
+        acquired = true;
+        lanes.release(cs::ExecutorLane::Getter, slot);
+    });
+
+    waitFor(lanes, cs::ExecutorLane::Getter, 1);
+
+    // other lanes are not limited by getters
+    const auto consensus = lanes.acquire(cs::ExecutorLane::Consensus);
+    ASSERT_FALSE(acquired);
+
+    lanes.release(cs::ExecutorLane::Getter, getter);
+    thread.join();
+
+    ASSERT_TRUE(acquired);
+    lanes.release(cs::ExecutorLane::Consensus, consensus);
+}
+
+TEST(ExecutorLanes, HigherPriorityLaneGoesFirst) {
+    cs::ExecutorLanes lanes(1, {0, 0, 0});
+
+    const auto slot = lanes.acquire(cs::ExecutorLane::Getter);
+
+    std::mutex mutex;
+    std::vector<cs::ExecutorLane> order;
+
+    auto waiter = [&](cs::ExecutorLane lane) {
+        const auto acquired = lanes.acquire(lane);
+        {
+            std::lock_guard lock(mutex);
+            order.push_back(lane);
+        }
+        lanes.release(lane, acquired);
+    };
+
+    std::thread compile(waiter, cs::ExecutorLane::Compile);
+    waitFor(lanes, cs::ExecutorLane::Compile, 1);
+
+    std::thread getter(waiter, cs::ExecutorLane::Getter);
+    waitFor(lanes, cs::ExecutorLane::Getter, 1);
+
+    std::thread consensus(waiter, cs::ExecutorLane::Consensus);
+    waitFor(lanes, cs::ExecutorLane::Consensus, 1);
+
+    lanes.release(cs::ExecutorLane::Getter, slot);
+
+    compile.join();
+    getter.join();
+    consensus.join();
+
+    ASSERT_EQ(order, (std::vector<cs::ExecutorLane>{cs::ExecutorLane::Consensus, cs::ExecutorLane::Getter, cs::ExecutorLane::Compile}));
+}
+
+TEST(ExecutorLanes, StopRejectsWaiting) {
+    cs::ExecutorLanes lanes(1, {0, 0, 0});
+    const auto slot = lanes.acquire(cs::ExecutorLane::Consensus);
+
+    size_t rejected = 0;
+    std::thread thread([&] { rejected = lanes.acquire(cs::ExecutorLane::Compile); });
+
+    waitFor(lanes, cs::ExecutorLane::Compile, 1);
+    lanes.stop();
+    thread.join();
+
+    ASSERT_EQ(rejected, cs::ExecutorLanes::kNoSlot);
+    ASSERT_EQ(lanes.acquire(cs::ExecutorLane::Consensus), cs::ExecutorLanes::kNoSlot);
+
+    lanes.release(cs::ExecutorLane::Consensus, slot);
+}
+
+TEST(LatencyHistogram, Percentiles) {
+    cs::LatencyHistogram histogram;
+
+    for (int i = 0; i < 90; ++i) {
+        histogram.add(std::chrono::milliseconds(3));
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        histogram.add(std::chrono::milliseconds(700));
+    }
+
+    const auto snapshot = histogram.snapshot();
+
+    ASSERT_EQ(snapshot.count, 100);
+    ASSERT_EQ(snapshot.sum, 90 * 3 + 10 * 700);
+    ASSERT_EQ(snapshot.percentile(0.5), 5);
+    ASSERT_EQ(snapshot.percentile(0.95), 1000);
+    ASSERT_EQ(snapshot.percentile(1.0), 1000);
+
+    histogram.add(std::chrono::milliseconds(60000));
+    ASSERT_EQ(histogram.snapshot().percentile(1.0), std::numeric_limits<uint32_t>::max());
+}
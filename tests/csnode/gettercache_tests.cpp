@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <gettercache.hpp>
+
+#include "addressmock.hpp"
+
+namespace {
+using Cache = cs::GetterCache<std::string>;
+
+cs::Hash makeKey(uint8_t value) {
+    cs::Hash key{};
+    key[0] = value;
+    return key;
+}
+}  // namespace
+
+TEST(GetterCache, HitsAfterMiss) {
+    Cache cache(4);
+    size_t calls = 0;
+
+    auto producer = [&]() -> std::optional<std::string> {
+        ++calls;
+        return std::string("result");
+    };
+
+    ASSERT_EQ(cache.get(makeContract(1), makeKey(1), producer), std::string("result"));
+    ASSERT_EQ(cache.get(makeContract(1), makeKey(1), producer), std::string("result"));
+    ASSERT_EQ(calls, 1);
+
+    const auto statistics = cache.statistics();
+    ASSERT_EQ(statistics.hits, 1);
+    ASSERT_EQ(statistics.misses, 1);
+}
+
+TEST(GetterCache, EvictsLeastRecentlyUsed) {
+    Cache cache(2);
+    size_t calls = 0;
+
+    auto producer = [&]() -> std::optional<std::string> {
+        ++calls;
+        return std::to_string(calls);
+    };
+
+    cache.get(makeContract(1), makeKey(1), producer);
+    cache.get(makeContract(1), makeKey(2), producer);
+
+    // touch the first, so the second is evicted
+    cache.get(makeContract(1), makeKey(1), producer);
+    cache.get(makeContract(1), makeKey(3), producer);
+
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(calls, 3);
+
+    ASSERT_EQ(cache.get(makeContract(1), makeKey(1), producer), std::string("1"));
+    ASSERT_EQ(cache.get(makeContract(1), makeKey(2), producer), std::string("4"));
+}
+
+TEST(GetterCache, InvalidatesContractOnly) {
+    Cache cache(4);
+    size_t calls = 0;
+
+    auto producer = [&]() -> std::optional<std::string> {
+        ++calls;
+        return std::string("result");
+    };
+
+    cache.get(makeContract(1), makeKey(1), producer);
+    cache.get(makeContract(1), makeKey(2), producer);
+    cache.get(makeContract(2), makeKey(3), producer);
+
+    cache.invalidate(makeContract(1));
+    ASSERT_EQ(cache.size(), 1);
+
+    cache.get(makeContract(2), makeKey(3), producer);
+    ASSERT_EQ(calls, 3);
+
+    cache.get(makeContract(1), makeKey(1), producer);
+    ASSERT_EQ(calls, 4);
+}
+
+TEST(GetterCache, FailedResultIsNotCached) {
+    Cache cache(4);
+    size_t calls = 0;
+
+    auto producer = [&]() -> std::optional<std::string> {
+        ++calls;
+        return std::nullopt;
+    };
+
+    ASSERT_FALSE(cache.get(makeContract(1), makeKey(1), producer).has_value());
+    ASSERT_FALSE(cache.get(makeContract(1), makeKey(1), producer).has_value());
+    ASSERT_EQ(calls, 2);
+    ASSERT_EQ(cache.size(), 0);
+}
+
+TEST(GetterCache, CoalescesConcurrentRequests) {
+    Cache cache(4);
+
+    std::atomic<size_t> calls = 0;
+    std::atomic<bool> release = false;
+
+    auto producer = [&]() -> std::optional<std::string> {
+        ++calls;
+
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return std::string("result");
+    };
+
+    std::optional<std::string> first;
+    std::optional<std::string> second;
+
+    std::thread leader([&] { first = cache.get(makeContract(1), makeKey(1), producer); });
+
+    while (calls == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::thread follower([&] { second = cache.get(makeContract(1), makeKey(1), producer); });
+
+    while (cache.statistics().coalesced == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    release = true;
+
+    leader.join();
+    follower.join();
+
+    ASSERT_EQ(calls, 1);
+    ASSERT_EQ(first, std::string("result"));
+    ASSERT_EQ(second, std::string("result"));
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include <net/inboundqueue.hpp>
+
+namespace {
+constexpr size_t kPacketSize = 64;
+
+// puts broadcast packet of type to source pacman and passes it to queue
+bool push(InboundQueue& queue, IPacMan& source, MsgTypes type, std::chrono::milliseconds age = std::chrono::milliseconds(0)) {
+    auto& task = source.allocNext();
+    auto data = static_cast<cs::Byte*>(task.pack.data());
+
+    std::memset(data, 0, Packet::MaxSize);
+    data[0] = BaseFlags::Broadcast;
+    data[1 + cscrypto::kPublicKeySize + sizeof(uint64_t)] = type;
+
+    task.size = kPacketSize;
+    task.timestamp = InboundQueue::Clock::now() - age;
+    source.enQueueLast();
+
+    bool isEmpty = false;
+    auto ptr = source.getNextTask(isEmpty);
+
+    const bool result = queue.push(ptr, queue.classify(ptr->pack));
+    ptr.release();
+
+    return result;
+}
+
+std::vector<MsgTypes> processAll(InboundQueue& queue) {
+    std::vector<MsgTypes> types;
+
+    while (queue.process(std::chrono::milliseconds(0), [&](TaskPtr<IPacMan>& task) { types.push_back(task->pack.getType()); })) {
+    }
+
+    return types;
+}
+}  // namespace
+
+TEST(InboundQueue, ClassifiesPackets) {
+    InboundQueue queue;
+    IPacMan source;
+
+    push(queue, source, MsgTypes::FirstStage);
+    push(queue, source, MsgTypes::TransactionPacket);
+    push(queue, source, MsgTypes::RequestedBlock);
+    push(queue, source, MsgTypes::TransactionProofRequest);
+
+    ASSERT_EQ(queue.size(), 4u);
+
+    processAll(queue);
+
+    ASSERT_EQ(queue.size(), 0u);
+    ASSERT_EQ(queue.stats(MessageClass::Consensus).processed, 1u);
+    ASSERT_EQ(queue.stats(MessageClass::Transactions).processed, 1u);
+    ASSERT_EQ(queue.stats(MessageClass::Sync).processed, 1u);
+    ASSERT_EQ(queue.stats(MessageClass::Common).processed, 1u);
+}
+
+TEST(InboundQueue, ProcessesConsensusFirst) {
+    InboundQueue queue;
+    IPacMan source;
+
+    push(queue, source, MsgTypes::BlockRequest);
+    push(queue, source, MsgTypes::TransactionPacket);
+    push(queue, source, MsgTypes::FirstStage);
+    push(queue, source, MsgTypes::RoundTable);
+
+    const auto types = processAll(queue);
+    const std::vector<MsgTypes> expected = {MsgTypes::FirstStage, MsgTypes::RoundTable, MsgTypes::TransactionPacket, MsgTypes::BlockRequest};
+
+    ASSERT_EQ(types, expected);
+}
+
+TEST(InboundQueue, TakesAgedPacketsInTurn) {
+    InboundQueue queue;
+    IPacMan source;
+
+    push(queue, source, MsgTypes::RequestedBlock, InboundQueue::kMaxWait * 2);
+
+    for (size_t i = 0; i < 8; ++i) {
+        push(queue, source, MsgTypes::SecondStage);
+    }
+
+    const auto types = processAll(queue);
+
+    ASSERT_EQ(types.size(), 9u);
+    ASSERT_NE(types.back(), MsgTypes::RequestedBlock);
+}
+
+TEST(InboundQueue, DropsPacketsOfFullClass) {
+    InboundQueue queue;
+    IPacMan source;
+
+    size_t dropped = 0;
+
+    for (size_t i = 0; i < 20000; ++i) {
+        dropped += !push(queue, source, MsgTypes::TransactionPacket);
+    }
+
+    ASSERT_GT(dropped, 0u);
+    ASSERT_EQ(queue.stats(MessageClass::Transactions).dropped, dropped);
+
+    // other classes are still accepted
+    ASSERT_TRUE(push(queue, source, MsgTypes::FirstStage));
+    ASSERT_EQ(processAll(queue).front(), MsgTypes::FirstStage);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <csnode/merkletree.hpp>
+
+namespace {
+std::vector<cs::Hash> makeLeaves(size_t count) {
+    std::vector<cs::Hash> leaves;
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto data = std::to_string(i);
+        leaves.push_back(cs::MerkleTree::leafHash(reinterpret_cast<const cs::Byte*>(data.data()), data.size()));
+    }
+
+    return leaves;
+}
+
+// straightforward recursive RFC 6962 definition to compare incremental tree with
+cs::Hash referenceRoot(const std::vector<cs::Hash>& leaves, size_t begin, size_t end) {
+    if (end - begin == 1) {
+        return leaves[begin];
+    }
+
+    size_t split = 1;
+    while ((split << 1) < end - begin) {
+        split <<= 1;
+    }
+
+    return cs::MerkleTree::nodeHash(referenceRoot(leaves, begin, begin + split), referenceRoot(leaves, begin + split, end));
+}
+}  // namespace
+
+TEST(MerkleTree, IncrementalRootMatchesDefinition) {
+    for (size_t count = 1; count <= 70; ++count) {
+        const auto leaves = makeLeaves(count);
+
+        cs::MerkleTree tree;
+        for (const auto& leaf : leaves) {
+            tree.add(leaf);
+        }
+
+        ASSERT_EQ(tree.size(), count);
+        ASSERT_EQ(tree.root(), referenceRoot(leaves, 0, count));
+    }
+}
+
+TEST(MerkleTree, EveryLeafProofIsValid) {
+    for (size_t count = 1; count <= 40; ++count) {
+        const auto leaves = makeLeaves(count);
+        const auto root = cs::MerkleTree::root(leaves);
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto proof = cs::MerkleTree::proof(leaves, i);
+
+            ASSERT_EQ(proof.leavesCount, count);
+            ASSERT_TRUE(cs::MerkleTree::verify(leaves[i], proof, root));
+        }
+    }
+}
+
+TEST(MerkleTree, ProofFailsForWrongLeafOrIndex) {
+    const auto leaves = makeLeaves(13);
+    const auto root = cs::MerkleTree::root(leaves);
+
+    auto proof = cs::MerkleTree::proof(leaves, 5);
+    ASSERT_FALSE(cs::MerkleTree::verify(leaves[6], proof, root));
+
+    proof.index = 6;
+    ASSERT_FALSE(cs::MerkleTree::verify(leaves[5], proof, root));
+
+    proof.index = 13;
+    ASSERT_FALSE(cs::MerkleTree::verify(leaves[5], proof, root));
+}
+
+TEST(MerkleTree, ProofForOutOfRangeIndexIsEmpty) {
+    const auto leaves = makeLeaves(4);
+    const auto proof = cs::MerkleTree::proof(leaves, 4);
+
+    ASSERT_EQ(proof.leavesCount, 0);
+    ASSERT_TRUE(proof.path.empty());
+}
+
+TEST(MerkleTree, ClearResetsTree) {
+    const auto leaves = makeLeaves(3);
+
+    cs::MerkleTree tree;
+    const auto emptyRoot = tree.root();
+
+    for (const auto& leaf : leaves) {
+        tree.add(leaf);
+    }
+
+    ASSERT_NE(tree.root(), emptyRoot);
+
+    tree.clear();
+
+    ASSERT_EQ(tree.size(), 0);
+    ASSERT_EQ(tree.root(), emptyRoot);
+}
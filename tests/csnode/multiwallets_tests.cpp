@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <unordered_map>
+
+#include <csnode/multiwallets.hpp>
+
+namespace {
+cs::PublicKey makeKey(uint8_t value) {
+    cs::PublicKey key{};
+    key[0] = value;
+    return key;
+}
+
+cs::WalletsCache::WalletData makeData(int32_t balance, uint64_t transactions) {
+    cs::WalletsCache::WalletData data;
+    data.balance_ = csdb::Amount(balance);
+    data.transNum_ = transactions;
+    return data;
+}
+
+// wallet i has balance i and 100 - i transactions
+void fill(cs::MultiWallets& wallets, uint8_t count) {
+    std::unordered_map<cs::PublicKey, cs::WalletsCache::WalletData> data;
+
+    for (uint8_t i = 0; i < count; ++i) {
+        data.emplace(makeKey(i), makeData(i, 100 - i));
+    }
+
+    wallets.onDbReadFinished(data);
+}
+}  // namespace
+
+TEST(MultiWallets, PagesFromOffset) {
+    cs::MultiWallets wallets;
+    fill(wallets, 50);
+
+    const auto richest = wallets.iterate<cs::MultiWallets::ByBalance>(10, 5);
+    ASSERT_EQ(richest.size(), 5u);
+
+    for (size_t i = 0; i < richest.size(); ++i) {
+        ASSERT_EQ(richest[i].balance, csdb::Amount(static_cast<int32_t>(39 - i)));
+    }
+
+    const auto poorest = wallets.iterate<cs::MultiWallets::ByBalance>(10, 5, cs::MultiWallets::Order::Less);
+    ASSERT_EQ(poorest.size(), 5u);
+
+    for (size_t i = 0; i < poorest.size(); ++i) {
+        ASSERT_EQ(poorest[i].balance, csdb::Amount(static_cast<int32_t>(10 + i)));
+    }
+
+    // the last page is cut by size
+    ASSERT_EQ(wallets.iterate<cs::MultiWallets::ByTransactionsCount>(45, 10).size(), 5u);
+    ASSERT_TRUE(wallets.iterate<cs::MultiWallets::ByTransactionsCount>(51, 10).empty());
+}
+
+TEST(MultiWallets, RanksWallets) {
+    cs::MultiWallets wallets;
+    fill(wallets, 50);
+
+    ASSERT_EQ(wallets.rank<cs::MultiWallets::ByBalance>(makeKey(49)), 0u);
+    ASSERT_EQ(wallets.rank<cs::MultiWallets::ByBalance>(makeKey(0)), 49u);
+    ASSERT_EQ(wallets.rank<cs::MultiWallets::ByBalance>(makeKey(0), cs::MultiWallets::Order::Less), 0u);
+    ASSERT_EQ(wallets.rank<cs::MultiWallets::ByTransactionsCount>(makeKey(0)), 0u);
+    ASSERT_FALSE(wallets.rank<cs::MultiWallets::ByBalance>(makeKey(200)).has_value());
+}
+
+TEST(MultiWallets, AppliesUpdatesBeforeRead) {
+    cs::MultiWallets wallets;
+    fill(wallets, 10);
+
+    wallets.onWalletCacheUpdated(makeKey(0), makeData(1000, 0));
+    wallets.onWalletCacheUpdated(makeKey(100), makeData(500, 0));
+
+    // the last update of wallet wins
+    wallets.onWalletCacheUpdated(makeKey(100), makeData(700, 0));
+
+    ASSERT_EQ(wallets.size(), 11u);
+    ASSERT_EQ(wallets.rank<cs::MultiWallets::ByBalance>(makeKey(0)), 0u);
+    ASSERT_EQ(wallets.rank<cs::MultiWallets::ByBalance>(makeKey(100)), 1u);
+    ASSERT_EQ(wallets.balance(makeKey(100)), csdb::Amount(700));
+}
+
+TEST(MultiWallets, AppliesBlockUpdates) {
+    cs::MultiWallets wallets;
+    fill(wallets, 10);
+
+    const auto first = makeData(1000, 0);
+    const auto second = makeData(500, 3);
+
+    wallets.onWalletsCacheUpdated(cs::WalletsUpdates{{makeKey(0), &first}, {makeKey(100), &second}});
+
+    ASSERT_EQ(wallets.size(), 11u);
+    ASSERT_EQ(wallets.rank<cs::MultiWallets::ByBalance>(makeKey(0)), 0u);
+    ASSERT_EQ(wallets.balance(makeKey(100)), csdb::Amount(500));
+    ASSERT_EQ(wallets.transactionsCount(makeKey(100)), 3u);
+}
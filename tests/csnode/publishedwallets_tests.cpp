@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <csnode/publishedwallets.hpp>
+
+namespace {
+cs::PublicKey makeKey(uint32_t value) {
+    cs::PublicKey key{};
+    std::memcpy(key.data() + 8, &value, sizeof(value));
+    key[0] = static_cast<cs::Byte>(value * 131);
+    return key;
+}
+
+cs::PublishedWallets::Wallet makeWallet(uint32_t value) {
+    cs::PublishedWallets::Wallet wallet;
+    wallet.balance = csdb::Amount(static_cast<int32_t>(value), value);
+    wallet.transactionsCount = value;
+    wallet.lastInnerId = value;
+    wallet.lastTransaction = csdb::TransactionID(value, value % 7);
+    return wallet;
+}
+}  // namespace
+
+TEST(PublishedWallets, FindsPublishedWallets) {
+    cs::PublishedWallets wallets;
+
+    // several grows of table
+    for (uint32_t i = 0; i < 5000; ++i) {
+        wallets.publish(makeKey(i), makeWallet(i));
+    }
+
+    ASSERT_EQ(wallets.size(), 5000u);
+
+    for (uint32_t i = 0; i < 5000; ++i) {
+        cs::PublishedWallets::Wallet wallet;
+        ASSERT_TRUE(wallets.find(makeKey(i), wallet));
+        ASSERT_EQ(wallet.balance, makeWallet(i).balance);
+        ASSERT_EQ(wallet.transactionsCount, i);
+        ASSERT_EQ(wallet.lastInnerId, static_cast<int64_t>(i));
+        ASSERT_EQ(wallet.lastTransaction, makeWallet(i).lastTransaction);
+    }
+
+    cs::PublishedWallets::Wallet wallet;
+    ASSERT_FALSE(wallets.find(makeKey(5000), wallet));
+}
+
+TEST(PublishedWallets, ErasesAndPublishesAgain) {
+    cs::PublishedWallets wallets;
+    cs::PublishedWallets::Wallet wallet;
+
+    wallets.publish(makeKey(1), makeWallet(1));
+    wallets.erase(makeKey(1));
+
+    ASSERT_FALSE(wallets.find(makeKey(1), wallet));
+    ASSERT_EQ(wallets.size(), 0u);
+
+    auto negative = makeWallet(2);
+    negative.balance = csdb::Amount(-2);
+    negative.lastTransaction = csdb::TransactionID();
+
+    wallets.publish(makeKey(1), negative);
+
+    ASSERT_TRUE(wallets.find(makeKey(1), wallet));
+    ASSERT_EQ(wallet.balance, csdb::Amount(-2));
+    ASSERT_FALSE(wallet.lastTransaction.is_valid());
+    ASSERT_EQ(wallets.size(), 1u);
+}
+
+TEST(PublishedWallets, ReadersSeeWholeRecords) {
+    constexpr uint32_t kWallets = 512;
+    constexpr uint32_t kUpdates = 200;
+
+    cs::PublishedWallets wallets;
+    std::atomic<bool> isDone{false};
+    std::atomic<size_t> torn{0};
+
+    for (uint32_t i = 0; i < kWallets; ++i) {
+        wallets.publish(makeKey(i), makeWallet(0));
+    }
+
+    std::vector<std::thread> readers;
+
+    for (size_t i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            cs::PublishedWallets::Wallet wallet;
+
+            for (uint32_t key = 0; !isDone.load(); key = (key + 1) % kWallets) {
+                if (wallets.find(makeKey(key), wallet) &&
+                    (wallet.transactionsCount != static_cast<uint64_t>(wallet.lastInnerId) || wallet.balance != makeWallet(static_cast<uint32_t>(wallet.transactionsCount)).balance)) {
+                    ++torn;
+                }
+            }
+        });
+    }
+
+    // new wallets grow table while readers walk it
+    for (uint32_t update = 1; update <= kUpdates; ++update) {
+        for (uint32_t i = 0; i < kWallets; ++i) {
+            wallets.publish(makeKey(i), makeWallet(update));
+        }
+
+        wallets.publish(makeKey(kWallets + update), makeWallet(update));
+    }
+
+    isDone = true;
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    ASSERT_EQ(torn.load(), 0u);
+}
+
+TEST(PublishedWallets, ReusesErasedRecords) {
+    cs::PublishedWallets wallets;
+    cs::PublishedWallets::Wallet wallet;
+
+    // wallets come and go as hot ones are evicted, records stay as many as published at once
+    for (uint32_t round = 0; round < 20; ++round) {
+        for (uint32_t i = 0; i < 1000; ++i) {
+            wallets.publish(makeKey(round * 1000 + i), makeWallet(i));
+        }
+
+        for (uint32_t i = 0; i < 1000; ++i) {
+            wallets.erase(makeKey(round * 1000 + i));
+        }
+    }
+
+    ASSERT_EQ(wallets.size(), 0u);
+    ASSERT_EQ(wallets.recordsCount(), 1000u);
+
+    ASSERT_FALSE(wallets.find(makeKey(5), wallet));
+
+    wallets.publish(makeKey(5), makeWallet(5));
+
+    ASSERT_TRUE(wallets.find(makeKey(5), wallet));
+    ASSERT_EQ(wallet.transactionsCount, 5u);
+    ASSERT_FALSE(wallets.find(makeKey(19005), wallet));
+}
+
+TEST(PublishedWallets, ReadersSkipReusedRecords) {
+    constexpr uint32_t kStable = 256;
+    constexpr uint32_t kRounds = 300;
+
+    cs::PublishedWallets wallets;
+    std::atomic<bool> isDone{false};
+    std::atomic<size_t> wrong{0};
+
+    for (uint32_t i = 0; i < kStable; ++i) {
+        wallets.publish(makeKey(i), makeWallet(i));
+    }
+
+    std::vector<std::thread> readers;
+
+    for (size_t i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            cs::PublishedWallets::Wallet wallet;
+
+            // stable wallets are found with their own values while other records are reused
+            for (uint32_t key = 0; !isDone.load(); key = (key + 1) % kStable) {
+                if (!wallets.find(makeKey(key), wallet) || wallet.transactionsCount != key) {
+                    ++wrong;
+                }
+            }
+        });
+    }
+
+    for (uint32_t round = 0; round < kRounds; ++round) {
+        for (uint32_t i = 0; i < 64; ++i) {
+            wallets.publish(makeKey(kStable + round * 64 + i), makeWallet(kStable + round * 64 + i));
+        }
+
+        for (uint32_t i = 0; i < 64; ++i) {
+            wallets.erase(makeKey(kStable + round * 64 + i));
+        }
+    }
+
+    isDone = true;
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    ASSERT_EQ(wrong.load(), 0u);
+    ASSERT_EQ(wallets.size(), kStable);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+
+#include <speculations.hpp>
+
+#include "addressmock.hpp"
+
+namespace {
+using Speculations = cs::Speculations<std::string>;
+
+cs::Hash makeKey(uint8_t value) {
+    cs::Hash key{};
+    key[0] = value;
+    return key;
+}
+
+cs::Signature makeSignature(uint8_t value) {
+    cs::Signature signature{};
+    signature[0] = value;
+    return signature;
+}
+
+std::optional<std::string> produce() {
+    return std::string("result");
+}
+}  // namespace
+
+TEST(Speculations, TakesResultOfSameInputs) {
+    Speculations speculations(4);
+
+    ASSERT_TRUE(speculations.start(makeSignature(1), makeKey(1)));
+    ASSERT_FALSE(speculations.start(makeSignature(1), makeKey(1)));
+
+    speculations.run(makeContract(1), makeKey(1), produce);
+
+    ASSERT_EQ(speculations.take(makeSignature(1), makeContract(1), makeKey(1)), std::string("result"));
+
+    // result is taken once by its call
+    ASSERT_FALSE(speculations.take(makeSignature(1), makeContract(1), makeKey(1)).has_value());
+
+    const auto statistics = speculations.statistics();
+    ASSERT_EQ(statistics.started, 1);
+    ASSERT_EQ(statistics.hits, 1);
+    ASSERT_EQ(statistics.misses, 0);
+}
+
+TEST(Speculations, MissesOnOtherInputs) {
+    Speculations speculations(4);
+
+    speculations.start(makeSignature(1), makeKey(1));
+    speculations.run(makeContract(1), makeKey(1), produce);
+
+    // not speculated call is neither hit nor miss
+    ASSERT_FALSE(speculations.take(makeSignature(2), makeContract(1), makeKey(1)).has_value());
+    ASSERT_FALSE(speculations.take(makeSignature(1), makeContract(1), makeKey(2)).has_value());
+
+    const auto statistics = speculations.statistics();
+    ASSERT_EQ(statistics.hits, 0);
+    ASSERT_EQ(statistics.misses, 1);
+}
+
+TEST(Speculations, InvalidatedByNewState) {
+    Speculations speculations(4);
+
+    speculations.start(makeSignature(1), makeKey(1));
+    speculations.run(makeContract(1), makeKey(1), produce);
+    speculations.start(makeSignature(2), makeKey(2));
+    speculations.run(makeContract(2), makeKey(2), produce);
+
+    speculations.invalidate(makeContract(1));
+
+    ASSERT_FALSE(speculations.take(makeSignature(1), makeContract(1), makeKey(1)).has_value());
+    ASSERT_EQ(speculations.take(makeSignature(2), makeContract(2), makeKey(2)), std::string("result"));
+
+    const auto statistics = speculations.statistics();
+    ASSERT_EQ(statistics.hits, 1);
+    ASSERT_EQ(statistics.misses, 1);
+}
+
+TEST(Speculations, NotKeptIfCalledBack) {
+    Speculations speculations(4);
+
+    speculations.watch(1);
+    speculations.watch(2);
+
+    speculations.onCallback(1);
+    speculations.onCallback(3);
+
+    ASSERT_TRUE(speculations.release(1));
+    ASSERT_FALSE(speculations.release(2));
+    ASSERT_FALSE(speculations.release(3));
+
+    // callback without access id is counted to every execution in flight
+    speculations.watch(4);
+    speculations.watch(5);
+    speculations.onCallback();
+
+    ASSERT_TRUE(speculations.release(4));
+    ASSERT_TRUE(speculations.release(5));
+
+    speculations.watch(6);
+    ASSERT_FALSE(speculations.release(6));
+
+    // producer of called back execution does not keep its result
+    speculations.start(makeSignature(1), makeKey(1));
+    speculations.run(makeContract(1), makeKey(1), [&]() -> std::optional<std::string> {
+        speculations.watch(7);
+        speculations.onCallback();
+
+        if (speculations.release(7)) {
+            return std::nullopt;
+        }
+
+        return std::string("result");
+    });
+
+    ASSERT_FALSE(speculations.take(makeSignature(1), makeContract(1), makeKey(1)).has_value());
+    ASSERT_EQ(speculations.statistics().misses, 1);
+}
+
+TEST(Speculations, WaitsForSpeculationInFlight) {
+    Speculations speculations(4);
+    std::promise<void> started;
+
+    speculations.start(makeSignature(1), makeKey(1));
+
+    std::thread speculation([&] {
+        speculations.run(makeContract(1), makeKey(1), [&]() -> std::optional<std::string> {
+            started.set_value();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            return std::string("result");
+        });
+    });
+
+    started.get_future().wait();
+    ASSERT_EQ(speculations.take(makeSignature(1), makeContract(1), makeKey(1)), std::string("result"));
+
+    speculation.join();
+    ASSERT_EQ(speculations.statistics().hits, 1);
+}
+
+TEST(Speculations, ForgetsOldestCalls) {
+    Speculations speculations(2);
+
+    speculations.start(makeSignature(1), makeKey(1));
+    speculations.start(makeSignature(2), makeKey(2));
+    speculations.start(makeSignature(3), makeKey(3));
+
+    speculations.run(makeContract(1), makeKey(2), produce);
+    speculations.run(makeContract(1), makeKey(3), produce);
+
+    ASSERT_TRUE(speculations.start(makeSignature(1), makeKey(1)));
+    ASSERT_EQ(speculations.take(makeSignature(3), makeContract(1), makeKey(3)), std::string("result"));
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <base58.h>
+
+#include <client/params.hpp>
+#include <tokens.hpp>
+
+#include "addressmock.hpp"
+
+#ifdef TOKENS_CACHE
+
+namespace {
+general::Variant makeParam(const std::string& value) {
+    general::Variant var;
+    var.__set_v_string(value);
+    return var;
+}
+
+general::Variant makeParam(const csdb::Address& address) {
+    const auto key = address.public_key();
+    return makeParam(EncodeBase58(cs::Bytes(key.begin(), key.end())));
+}
+
+TokensMaster::TokenInvocationData::Params makeInvocation(const std::string& method, const std::vector<general::Variant>& params) {
+    TokensMaster::TokenInvocationData::Params invocation;
+    invocation.initiator = makeAddress(1);
+    invocation.method = method;
+    invocation.params = params;
+    return invocation;
+}
+}  // namespace
+
+TEST(TokensMaster, CoalescesBurstOfToken) {
+    std::mutex mutex;
+    std::vector<std::pair<csdb::Address, TokensMaster::Refresh>> refreshes;
+
+    TokensMaster master(nullptr, [&](const csdb::Address& token, const TokensMaster::Refresh& refresh) {
+        std::lock_guard lock(mutex);
+        refreshes.emplace_back(token, refresh);
+    });
+
+    for (uint8_t holder = 2; holder < 12; ++holder) {
+        TokensMaster::Refresh refresh;
+        refresh.holders.insert(makeAddress(holder));
+        master.enqueue(makeAddress(100), std::move(refresh));
+    }
+
+    for (size_t i = 0; i < 100 && master.statistics().refreshes == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // the next refresh could come after one more coalesce delay only
+    std::this_thread::sleep_for(TokensMaster::kCoalesceDelay * 2);
+
+    std::lock_guard lock(mutex);
+    ASSERT_EQ(refreshes.size(), 1u);
+    ASSERT_EQ(refreshes.front().first, makeAddress(100));
+    ASSERT_FALSE(refreshes.front().second.full);
+    ASSERT_EQ(refreshes.front().second.holders.size(), 10u);
+}
+
+TEST(TokensMaster, RefreshesHoldersOfTransfer) {
+    const auto transfer = TokensMaster::refreshOf(TokenStandard::CreditsBasic, makeInvocation("transfer", {makeParam(makeAddress(2)), makeParam("10")}));
+
+    ASSERT_FALSE(transfer.full);
+    ASSERT_EQ(transfer.holders, (std::set<csdb::Address>{makeAddress(1), makeAddress(2)}));
+
+    const auto transferFrom = TokensMaster::refreshOf(TokenStandard::CreditsBasic,
+                                                      makeInvocation("transferFrom", {makeParam(makeAddress(3)), makeParam(makeAddress(4)), makeParam("10")}));
+
+    ASSERT_FALSE(transferFrom.full);
+    ASSERT_EQ(transferFrom.holders, (std::set<csdb::Address>{makeAddress(1), makeAddress(3), makeAddress(4)}));
+
+    // effect of unknown method on balances is unknown
+    const auto burn = TokensMaster::refreshOf(TokenStandard::CreditsBasic, makeInvocation("burn", {makeParam("10")}));
+    ASSERT_TRUE(burn.full);
+}
+
+TEST(TokensMaster, SplitsBalancesIntoBatches) {
+    std::vector<csdb::Address> holders;
+
+    for (size_t i = 0; i < 2 * TokensMaster::kBalancesBatchSize + 1; ++i) {
+        cs::PublicKey key{};
+        key[0] = static_cast<uint8_t>(i);
+        key[1] = static_cast<uint8_t>(i >> 8);
+        holders.push_back(csdb::Address::from_public_key(key));
+    }
+
+    const auto batches = TokensMaster::balanceOfParams(holders);
+
+    ASSERT_EQ(batches.size(), 3u);
+    ASSERT_EQ(batches[0].size(), TokensMaster::kBalancesBatchSize);
+    ASSERT_EQ(batches[1].size(), TokensMaster::kBalancesBatchSize);
+    ASSERT_EQ(batches[2].size(), 1u);
+
+    // one holder key per balanceOf call, in order of holders
+    ASSERT_EQ(batches[1].front().size(), 1u);
+    ASSERT_EQ(batches[1].front().front().v_string, makeParam(holders[TokensMaster::kBalancesBatchSize]).v_string);
+    ASSERT_EQ(batches[2].front().front().v_string, makeParam(holders.back()).v_string);
+}
+
+#endif  // TOKENS_CACHE
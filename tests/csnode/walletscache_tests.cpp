@@ -0,0 +1,316 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <csdb/currency.hpp>
+#include <csdb/pool.hpp>
+#include <csnode/blockchain.hpp>
+#include <csnode/walletscache.hpp>
+#include <csnode/walletsids.hpp>
+
+#include "addressmock.hpp"
+
+namespace {
+cs::WalletsCache::WalletData unpacked(const cs::WalletsCache::WalletData& wallet) {
+    const auto record = cs::WalletsCache::pack(wallet);
+
+    cs::WalletsCache::WalletData result;
+    EXPECT_TRUE(cs::WalletsCache::unpack(reinterpret_cast<const char*>(record.data()), record.size(), result));
+
+    return result;
+}
+
+void expectSameTail(const cs::TransactionsTail& lhs, const cs::TransactionsTail& rhs) {
+    ASSERT_EQ(lhs.empty(), rhs.empty());
+
+    if (lhs.empty()) {
+        return;
+    }
+
+    ASSERT_EQ(lhs.heap().greatest(), rhs.heap().greatest());
+    ASSERT_EQ(lhs.heap().bits(), rhs.heap().bits());
+}
+
+const csdb::Address genesisAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000001");
+const csdb::Address startAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000002");
+
+csdb::Pool makeTransfer(cs::Sequence sequence, const csdb::Address& target) {
+    csdb::Transaction transaction(static_cast<int64_t>(sequence), makeAddress(1), target, csdb::Currency(1), csdb::Amount(1), csdb::AmountCommission(0.0),
+                                  csdb::AmountCommission(0.0), cs::Signature{});
+
+    csdb::Pool pool(csdb::PoolHash{}, sequence);
+    pool.add_transaction(transaction);
+    return pool;
+}
+
+// packed records are exact for all wallet fields
+std::map<cs::PublicKey, cs::Bytes> snapshot(cs::WalletsCache& cache) {
+    std::map<cs::PublicKey, cs::Bytes> result;
+
+    cache.iterateOverWallets([&](const cs::PublicKey& key, const cs::WalletsCache::WalletData& wallet) {
+        result.emplace(key, cs::WalletsCache::pack(wallet));
+        return true;
+    });
+
+    return result;
+}
+
+std::map<cs::PublicKey, csdb::Amount> balances(cs::WalletsCache& cache) {
+    std::map<cs::PublicKey, csdb::Amount> result;
+
+    cache.iterateOverWallets([&](const cs::PublicKey& key, const cs::WalletsCache::WalletData& wallet) {
+        result.emplace(key, wallet.balance_);
+        return true;
+    });
+
+    return result;
+}
+}  // namespace
+
+TEST(WalletsCache, PacksEmptyWallet) {
+    cs::WalletsCache::WalletData wallet;
+    const auto result = unpacked(wallet);
+
+    ASSERT_EQ(result.balance_, wallet.balance_);
+    ASSERT_EQ(result.transNum_, 0u);
+    ASSERT_FALSE(result.lastTransaction_.is_valid());
+    ASSERT_TRUE(result.trxTail_.empty());
+}
+
+TEST(WalletsCache, PacksSequentialTail) {
+    cs::WalletsCache::WalletData wallet;
+    wallet.balance_ = csdb::Amount(12, 345000000000000000ULL);
+    wallet.transNum_ = 2000;
+    wallet.lastTransaction_ = csdb::TransactionID(100500, 7);
+
+    for (int64_t innerId = 1; innerId <= 2000; ++innerId) {
+        wallet.trxTail_.push(innerId);
+    }
+
+    const auto record = cs::WalletsCache::pack(wallet);
+    const auto result = unpacked(wallet);
+
+    // regular tail is packed as a count of bits
+    ASSERT_LT(record.size(), 64u);
+
+    ASSERT_EQ(result.balance_, wallet.balance_);
+    ASSERT_EQ(result.transNum_, wallet.transNum_);
+    ASSERT_EQ(result.lastTransaction_, wallet.lastTransaction_);
+    expectSameTail(result.trxTail_, wallet.trxTail_);
+
+    ASSERT_FALSE(result.trxTail_.isAllowed(2000));
+    ASSERT_TRUE(result.trxTail_.isAllowed(2001));
+}
+
+TEST(WalletsCache, PacksTailWithGaps) {
+    cs::WalletsCache::WalletData wallet;
+    wallet.balance_ = csdb::Amount(-3);
+
+    for (int64_t innerId = 10; innerId <= 700; innerId += 3) {
+        wallet.trxTail_.push(innerId);
+    }
+
+    const auto result = unpacked(wallet);
+
+    ASSERT_EQ(result.balance_, wallet.balance_);
+    expectSameTail(result.trxTail_, wallet.trxTail_);
+
+    // skipped inner ids are still allowed after the wallet comes back
+    ASSERT_TRUE(result.trxTail_.isAllowed(699));
+    ASSERT_FALSE(result.trxTail_.isAllowed(697));
+}
+
+TEST(WalletsCache, RejectsDamagedRecord) {
+    cs::WalletsCache::WalletData wallet;
+    wallet.transNum_ = 5;
+    wallet.trxTail_.push(5);
+
+    auto record = cs::WalletsCache::pack(wallet);
+    record.resize(record.size() / 2);
+
+    cs::WalletsCache::WalletData result;
+    ASSERT_FALSE(cs::WalletsCache::unpack(reinterpret_cast<const char*>(record.data()), record.size(), result));
+}
+
+TEST(WalletsCache, RollbackRestoresJournaledBlocks) {
+    BlockChain blockChain(genesisAddress, startAddress);
+    cs::WalletsIds ids;
+    cs::WalletsCache cache(ids);
+
+    auto updater = cache.createUpdater();
+    updater->onStopReadingFromDB();
+
+    // every third block creates a wallet, rollback has to erase it
+    std::vector<csdb::Pool> pools;
+
+    for (cs::Sequence sequence = 1; sequence <= 10; ++sequence) {
+        pools.push_back(makeTransfer(sequence, makeAddress(static_cast<uint8_t>(sequence % 3 == 0 ? 100 + sequence : 2))));
+    }
+
+    std::vector<std::map<cs::PublicKey, cs::Bytes>> states;
+
+    for (auto& pool : pools) {
+        states.push_back(snapshot(cache));
+        updater->loadNextBlock(pool, {}, blockChain);
+    }
+
+    for (size_t i = pools.size(); i > 0; --i) {
+        updater->loadNextBlock(pools[i - 1], {}, blockChain, true);
+        ASSERT_EQ(snapshot(cache), states[i - 1]);
+    }
+
+    ASSERT_EQ(cache.getCount(), 0u);
+}
+
+TEST(WalletsCache, RollbackPastJournalDepth) {
+    BlockChain blockChain(genesisAddress, startAddress);
+    cs::WalletsIds ids;
+    cs::WalletsCache cache(ids);
+
+    auto updater = cache.createUpdater();
+    updater->onStopReadingFromDB();
+
+    std::vector<csdb::Pool> pools;
+
+    for (cs::Sequence sequence = 1; sequence <= cs::WalletsCache::kJournalDepth + 4; ++sequence) {
+        pools.push_back(makeTransfer(sequence, makeAddress(2)));
+    }
+
+    // chain of test is the list of pools
+    updater->setHistory([&pools](const csdb::Address& address, cs::Sequence sequence, const auto& visitor) {
+        for (auto pool = pools.crbegin(); pool != pools.crend(); ++pool) {
+            if (pool->sequence() >= sequence) {
+                continue;
+            }
+
+            for (auto it = pool->transactions().crbegin(); it != pool->transactions().crend(); ++it) {
+                if ((it->source() == address || it->target() == address) && !visitor(*it)) {
+                    return;
+                }
+            }
+        }
+    });
+
+    updater->loadNextBlock(pools.front(), {}, blockChain);
+    const auto initial = snapshot(cache);
+
+    for (size_t i = 1; i < pools.size(); ++i) {
+        updater->loadNextBlock(pools[i], {}, blockChain);
+    }
+
+    // journaled blocks are restored exactly
+    for (size_t i = pools.size() - 1; i >= pools.size() - cs::WalletsCache::kJournalDepth; --i) {
+        updater->loadNextBlock(pools[i], {}, blockChain, true);
+    }
+
+    // older blocks are inverse applied and their tails are rebuilt from the chain
+    for (size_t i = pools.size() - cs::WalletsCache::kJournalDepth - 1; i > 0; --i) {
+        updater->loadNextBlock(pools[i], {}, blockChain, true);
+    }
+
+    std::map<cs::PublicKey, csdb::Amount> expected;
+
+    cache.iterateOverWallets([&](const cs::PublicKey& key, const cs::WalletsCache::WalletData& wallet) {
+        auto it = initial.find(key);
+        EXPECT_NE(it, initial.end());
+
+        if (it == initial.end()) {
+            return true;
+        }
+
+        cs::WalletsCache::WalletData before;
+        EXPECT_TRUE(cs::WalletsCache::unpack(reinterpret_cast<const char*>(it->second.data()), it->second.size(), before));
+
+        expectSameTail(wallet.trxTail_, before.trxTail_);
+        EXPECT_EQ(wallet.lastTransaction_, before.lastTransaction_);
+
+        expected.emplace(key, before.balance_);
+        return true;
+    });
+
+    ASSERT_EQ(balances(cache), expected);
+    ASSERT_FALSE(updater->findWallet(makeAddress(1))->trxTail_.isAllowed(1));
+
+    // journal is dropped by the first block behind it, so the first block is inverse applied too
+    updater->loadNextBlock(pools.front(), {}, blockChain, true);
+
+    for (const auto& [key, balance] : balances(cache)) {
+        ASSERT_EQ(balance, csdb::Amount(0));
+    }
+
+    // no transactions are left before the first block
+    ASSERT_TRUE(updater->findWallet(makeAddress(1))->trxTail_.empty());
+}
+
+TEST(WalletsCache, ContractTimeoutIsPublishedAtOnce) {
+    cs::WalletsIds ids;
+    cs::WalletsCache cache(ids);
+
+    auto updater = cache.createUpdater();
+    updater->onStopReadingFromDB();
+
+    const auto source = makeAddress(1);
+    const csdb::Transaction starter(1LL, source, makeAddress(2), csdb::Currency(1), csdb::Amount(5), csdb::AmountCommission(1.0),
+                                    csdb::AmountCommission(0.0), cs::Signature{});
+
+    // timeout returns amount and fee to starter source, no block follows it, as in blockchain slots
+    updater->rollbackExceededTimeoutContract(starter, csdb::Amount(0));
+    updater->flushUpdates();
+
+    cs::PublishedWallets::Wallet wallet;
+    ASSERT_TRUE(cache.published().find(source.public_key(), wallet));
+    ASSERT_EQ(wallet.balance, csdb::Amount(5) + csdb::Amount(starter.max_fee().to_double()));
+
+    updater->rollbackExceededTimeoutContract(starter, csdb::Amount(0), true);
+    updater->flushUpdates();
+
+    ASSERT_TRUE(cache.published().find(source.public_key(), wallet));
+    ASSERT_EQ(wallet.balance, csdb::Amount(0));
+}
+
+TEST(WalletsCache, PublishesHotWalletsOnly) {
+    BlockChain blockChain(genesisAddress, startAddress);
+    cs::WalletsIds ids;
+
+    const std::string coldPath = "./walletscache_tests_cold";
+    cs::WalletsCache cache(ids, cs::WalletsCache::Settings{coldPath, 10});
+
+    auto updater = cache.createUpdater();
+    updater->onStopReadingFromDB();
+
+    // each block makes a new wallet, the earliest ones go to cold store
+    for (cs::Sequence sequence = 1; sequence <= 40; ++sequence) {
+        auto pool = makeTransfer(sequence, makeAddress(static_cast<uint8_t>(100 + sequence)));
+        updater->loadNextBlock(pool, {}, blockChain);
+    }
+
+    ASSERT_EQ(cache.getCount(), 41u);
+    ASSERT_LE(cache.getHotCount(), 10u);
+    ASSERT_EQ(cache.published().size(), cache.getHotCount());
+
+    // receivers are equally dormant, cold ones are any of them and cache finds them
+    size_t published = 0;
+
+    for (uint8_t i = 101; i <= 140; ++i) {
+        const auto key = makeAddress(i).public_key();
+        cs::PublishedWallets::Wallet wallet;
+
+        if (cache.published().find(key, wallet)) {
+            ++published;
+            ASSERT_EQ(wallet.balance, csdb::Amount(1));
+            continue;
+        }
+
+        const auto data = updater->findWallet(key);
+        ASSERT_NE(data, nullptr);
+        ASSERT_EQ(data->balance_, csdb::Amount(1));
+    }
+
+    // sender is active in every block and stays in memory
+    ASSERT_EQ(published + 1, cache.getHotCount());
+
+    boost::filesystem::remove_all(coldPath);
+}
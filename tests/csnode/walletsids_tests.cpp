@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <csnode/walletsids.hpp>
+
+namespace {
+csdb::Address makeAddress(std::mt19937& generator) {
+    cs::PublicKey key;
+
+    for (auto& byte : key) {
+        byte = static_cast<cs::Byte>(generator());
+    }
+
+    return csdb::Address::from_public_key(key);
+}
+}  // namespace
+
+TEST(WalletsIds, GivesSequentialIds) {
+    cs::WalletsIds ids;
+    std::mt19937 generator(1);
+    std::vector<csdb::Address> addresses;
+
+    // several grows of table
+    for (cs::WalletsIds::WalletId i = 0; i < 10000; ++i) {
+        addresses.push_back(makeAddress(generator));
+
+        cs::WalletsIds::WalletId id = 0;
+        ASSERT_TRUE(ids.normal().get(addresses.back(), id));
+        ASSERT_EQ(id, i);
+    }
+
+    for (cs::WalletsIds::WalletId i = 0; i < addresses.size(); ++i) {
+        cs::WalletsIds::WalletId id = 0;
+        ASSERT_TRUE(ids.normal().find(addresses[i], id));
+        ASSERT_EQ(id, i);
+
+        csdb::Address address;
+        ASSERT_TRUE(ids.normal().findaddr(i, address));
+        ASSERT_EQ(address, addresses[i]);
+
+        ASSERT_FALSE(ids.normal().get(addresses[i], id));
+    }
+
+    ASSERT_EQ(ids.size(), addresses.size());
+}
+
+TEST(WalletsIds, RemovesKeepingOthers) {
+    cs::WalletsIds ids;
+    std::mt19937 generator(2);
+    std::vector<csdb::Address> addresses;
+
+    for (cs::WalletsIds::WalletId i = 0; i < 5000; ++i) {
+        addresses.push_back(makeAddress(generator));
+        ASSERT_TRUE(ids.normal().insert(addresses.back(), i));
+    }
+
+    // the last wallets are removed as their blocks are removed
+    for (size_t i = addresses.size() / 2; i < addresses.size(); ++i) {
+        ASSERT_TRUE(ids.normal().remove(addresses[i]));
+    }
+
+    for (cs::WalletsIds::WalletId i = 0; i < addresses.size(); ++i) {
+        cs::WalletsIds::WalletId id = 0;
+
+        if (i < addresses.size() / 2) {
+            ASSERT_TRUE(ids.normal().find(addresses[i], id));
+            ASSERT_EQ(id, i);
+        }
+        else {
+            ASSERT_FALSE(ids.normal().find(addresses[i], id));
+        }
+    }
+
+    // removed ids are given again
+    cs::WalletsIds::WalletId id = 0;
+    ASSERT_TRUE(ids.normal().get(makeAddress(generator), id));
+    ASSERT_EQ(id, addresses.size() / 2);
+}
+
+TEST(WalletsIds, RejectsGivenId) {
+    cs::WalletsIds ids;
+    std::mt19937 generator(3);
+
+    ASSERT_TRUE(ids.normal().insert(makeAddress(generator), 7));
+    ASSERT_FALSE(ids.normal().insert(makeAddress(generator), 7));
+}
+
+TEST(WalletsIds, ReplacesSpecialByNormal) {
+    cs::WalletsIds ids;
+    std::mt19937 generator(4);
+
+    const auto address = makeAddress(generator);
+
+    cs::WalletsIds::WalletId special = 0;
+    ASSERT_TRUE(ids.special().findAnyOrInsertSpecial(address, special));
+    ASSERT_TRUE(cs::WalletsIds::Special::isSpecial(special));
+
+    cs::WalletsIds::WalletId replaced = 0;
+    ASSERT_TRUE(ids.special().insertNormal(address, 3, replaced));
+    ASSERT_EQ(replaced, special);
+
+    cs::WalletsIds::WalletId id = 0;
+    ASSERT_TRUE(ids.normal().find(address, id));
+    ASSERT_EQ(id, 3u);
+
+    csdb::Address found;
+    ASSERT_TRUE(ids.normal().findaddr(3, found));
+    ASSERT_EQ(found, address);
+    ASSERT_FALSE(ids.normal().findaddr(special, found));
+}
+
+TEST(WalletsIds, LoadsSavedTable) {
+    const char* path = "./walletsids_tests.bin";
+
+    cs::WalletsIds ids;
+    std::mt19937 generator(5);
+    std::vector<csdb::Address> addresses;
+
+    for (size_t i = 0; i < 3000; ++i) {
+        addresses.push_back(makeAddress(generator));
+
+        cs::WalletsIds::WalletId id = 0;
+        ids.normal().get(addresses.back(), id);
+    }
+
+    ASSERT_TRUE(ids.save(path));
+
+    cs::WalletsIds loaded;
+    ASSERT_TRUE(loaded.load(path));
+    ASSERT_EQ(loaded.size(), ids.size());
+
+    for (cs::WalletsIds::WalletId i = 0; i < addresses.size(); ++i) {
+        cs::WalletsIds::WalletId id = 0;
+        ASSERT_TRUE(loaded.normal().find(addresses[i], id));
+        ASSERT_EQ(id, i);
+    }
+
+    // the next id continues saved ones
+    cs::WalletsIds::WalletId id = 0;
+    ASSERT_TRUE(loaded.normal().get(makeAddress(generator), id));
+    ASSERT_EQ(id, addresses.size());
+
+    std::remove(path);
+}
+
+TEST(WalletsIds, RejectsDamagedTable) {
+    const char* path = "./walletsids_damaged_tests.bin";
+
+    cs::WalletsIds ids;
+    std::mt19937 generator(7);
+
+    for (size_t i = 0; i < 100; ++i) {
+        cs::WalletsIds::WalletId id = 0;
+        ids.normal().get(makeAddress(generator), id);
+    }
+
+    ASSERT_TRUE(ids.save(path));
+
+    std::vector<char> content;
+
+    {
+        std::ifstream file(path, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    const auto write = [&](const std::vector<char>& data) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    };
+
+    // header is magic, version, seed, capacity, size, next ids
+    constexpr size_t kSizeOffset = 24;
+    constexpr size_t kHeaderSize = 40;
+
+    // size does not match occupied slots
+    auto wrongSize = content;
+    uint64_t size = 0;
+    std::memcpy(&size, wrongSize.data() + kSizeOffset, sizeof(size));
+    ++size;
+    std::memcpy(wrongSize.data() + kSizeOffset, &size, sizeof(size));
+    write(wrongSize);
+
+    cs::WalletsIds loaded;
+    ASSERT_FALSE(loaded.load(path));
+
+    // no empty slot is left for probe to stop at
+    auto full = content;
+    std::fill(full.begin() + kHeaderSize, full.end(), 1);
+    write(full);
+
+    ASSERT_FALSE(loaded.load(path));
+
+    write(content);
+    ASSERT_TRUE(loaded.load(path));
+    ASSERT_EQ(loaded.size(), ids.size());
+
+    std::remove(path);
+}
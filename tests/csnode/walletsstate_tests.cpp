@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+#include <csnode/walletsids.hpp>
+#include <csnode/walletsstate.hpp>
+
+#include "addressmock.hpp"
+
+TEST(WalletsState, KeepsChangesWithinRound) {
+    cs::WalletsIds ids;
+    cs::WalletsCache cache(ids);
+    auto updater = cache.createUpdater();
+    cs::WalletsState state(*updater);
+
+    auto& wallet = state.getData(makeAddress(1));
+    wallet.balance_ = csdb::Amount(5);
+    wallet.trxTail_.push(1);
+
+    ASSERT_EQ(state.getData(makeAddress(1)).balance_, csdb::Amount(5));
+    ASSERT_FALSE(state.getData(makeAddress(1)).trxTail_.isAllowed(1));
+    ASSERT_EQ(state.getData(makeAddress(2)).balance_, csdb::Amount(0));
+    ASSERT_EQ(state.size(), 2u);
+}
+
+TEST(WalletsState, DropsChangesOfPreviousRound) {
+    cs::WalletsIds ids;
+    cs::WalletsCache cache(ids);
+    auto updater = cache.createUpdater();
+    cs::WalletsState state(*updater);
+
+    for (uint8_t round = 0; round < 3; ++round) {
+        auto& wallet = state.getData(makeAddress(1));
+
+        // each round starts from the cache
+        ASSERT_EQ(wallet.balance_, csdb::Amount(0));
+        ASSERT_TRUE(wallet.trxTail_.empty());
+        ASSERT_EQ(wallet.lastTrxInd_, cs::WalletsState::noInd_);
+
+        wallet.balance_ = csdb::Amount(round + 1);
+        wallet.trxTail_.push(round + 1);
+        wallet.lastTrxInd_ = round;
+
+        state.updateFromSource();
+        ASSERT_EQ(state.size(), 0u);
+    }
+}
@@ -7,6 +7,7 @@
 #include <atomic>
 #include <iostream>
 #include <string>
+#include <vector>
 
 using ThreadId = std::thread::id;
 
@@ -411,3 +412,194 @@ TEST(Concurrent, FutureWatcherHighMultithreading) {
 
     ASSERT_EQ(currentThreadPoolSum, expectedSum);
 }
+
+TEST(Concurrent, SchedulerRunsTasksOfManyProducers) {
+    constexpr size_t kProducers = 8;
+    constexpr size_t kTasks = 20000;
+
+    cs::Scheduler scheduler(4);
+    std::atomic<size_t> counter = 0;
+    std::vector<std::thread> producers;
+
+    for (size_t i = 0; i < kProducers; ++i) {
+        producers.emplace_back([&] {
+            for (size_t task = 0; task < kTasks; ++task) {
+                // every second task spawns a subtask to the queue of its worker, idle workers steal them
+                scheduler.post([&, task] {
+                    if (task % 2 == 0) {
+                        scheduler.post([&] { ++counter; });
+                    }
+
+                    ++counter;
+                });
+            }
+        });
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    const size_t expected = kProducers * kTasks + kProducers * kTasks / 2;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+    while (counter.load() != expected && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    ASSERT_EQ(counter.load(), expected);
+}
+
+TEST(Concurrent, SchedulerTakesHigherPriorityFirst) {
+    cs::Scheduler scheduler(1);
+    std::atomic<bool> isReleased = false;
+    std::atomic<size_t> done = 0;
+    std::vector<cs::TaskPriority> order;
+
+    // holds the only worker while tasks are posted
+    scheduler.post([&] {
+        while (!isReleased) {
+            std::this_thread::yield();
+        }
+    });
+
+    for (auto priority : {cs::TaskPriority::Low, cs::TaskPriority::Normal, cs::TaskPriority::High}) {
+        scheduler.post([&, priority] {
+            order.push_back(priority);
+            ++done;
+        }, priority);
+    }
+
+    isReleased = true;
+
+    while (done != 3) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    ASSERT_EQ(order, std::vector<cs::TaskPriority>({cs::TaskPriority::High, cs::TaskPriority::Normal, cs::TaskPriority::Low}));
+}
+
+TEST(Concurrent, SchedulerRunsDelayedTasks) {
+    cs::Scheduler scheduler(2);
+    std::atomic<size_t> done = 0;
+    std::vector<std::chrono::steady_clock::duration> delays(3);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // posted out of order of their deadlines
+    for (size_t i : {2, 0, 1}) {
+        scheduler.postAfter(std::chrono::milliseconds(50 * (i + 1)), [&, i] {
+            delays[i] = std::chrono::steady_clock::now() - start;
+            ++done;
+        });
+    }
+
+    while (done != 3) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    for (size_t i = 0; i < delays.size(); ++i) {
+        ASSERT_GE(delays[i], std::chrono::milliseconds(50 * (i + 1)));
+    }
+
+    ASSERT_EQ(scheduler.currentWorker(), cs::Scheduler::kNoAffinity);
+}
+
+TEST(Concurrent, FutureWatchersOfManyExecutions) {
+    constexpr size_t kExecutions = 2000;
+
+    static std::atomic<size_t> sum = 0;
+    static std::atomic<size_t> finished = 0;
+    static std::atomic<size_t> failed = 0;
+
+    class Wrapper {
+    public slots:
+        static void onFinished(size_t value) {
+            sum += value;
+            ++finished;
+        }
+
+        static void onFailed() {
+            ++failed;
+        }
+    };
+
+    for (size_t i = 1; i <= kExecutions; ++i) {
+        auto watcher = cs::Concurrent::run(cs::RunPolicy::ThreadPolicy, [](size_t value) {
+            if (value % 100 == 0) {
+                throw std::runtime_error("execution failed");
+            }
+
+            return value;
+        }, i);
+
+        cs::Connector::connect(&watcher->finished, &Wrapper::onFinished);
+        cs::Connector::connect(&watcher->failed, &Wrapper::onFailed);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+    while (finished + failed != kExecutions && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const size_t failedCount = kExecutions / 100;
+    const size_t expectedSum = kExecutions * (kExecutions + 1) / 2 - 100 * failedCount * (failedCount + 1) / 2;
+
+    ASSERT_EQ(failed.load(), failedCount);
+    ASSERT_EQ(finished.load(), kExecutions - failedCount);
+    ASSERT_EQ(sum.load(), expectedSum);
+}
+
+TEST(Concurrent, BlockingExecutionsDoNotDelayDelayedTask) {
+    static std::atomic<bool> isReleased = false;
+    static std::atomic<size_t> finished = 0;
+
+    class Wrapper {
+    public slots:
+        static void onFinished() {
+            ++finished;
+        }
+    };
+
+    // more blocking executions than workers of thread pool
+    const size_t blockingCount = cs::ThreadPool::instance().workersCount() * 2;
+
+    for (size_t i = 0; i < blockingCount; ++i) {
+        auto watcher = cs::Concurrent::run(cs::RunPolicy::ThreadPolicy, cs::ConcurrentPolicy::Thread, [] {
+            while (!isReleased) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+        cs::Connector::connect(&watcher->finished, &Wrapper::onFinished);
+    }
+
+    std::atomic<bool> isCalled = false;
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point called;
+
+    cs::Concurrent::runAfter(std::chrono::milliseconds(20), cs::RunPolicy::ThreadPolicy, [&] {
+        called = std::chrono::steady_clock::now();
+        isCalled = true;
+    });
+
+    auto deadline = start + std::chrono::seconds(5);
+
+    while (!isCalled && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    isReleased = true;
+
+    ASSERT_TRUE(isCalled.load());
+    ASSERT_LT(called - start, std::chrono::milliseconds(500));
+
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (finished != blockingCount && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    ASSERT_EQ(finished.load(), blockingCount);
+}
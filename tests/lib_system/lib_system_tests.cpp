@@ -475,6 +475,78 @@ TEST(FixedHashMap, destroy) {
     ASSERT_EQ(IntWithCounter::counter, 0);
 }
 
+TEST(CallsQueue, CallsNewestFirst) {
+    auto& queue = CallsQueue::instance();
+    queue.callAll();
+
+    std::vector<int> calls;
+    std::array<char, CallsQueue::kCallSize * 2> big{};
+    big[0] = 3;
+
+    queue.insert([&calls] { calls.push_back(1); });
+    queue.insert(std::function<void()>([&calls] { calls.push_back(2); }));
+    queue.insert([&calls, big] { calls.push_back(big[0]); });
+
+    // calls inserted by calls wait for the next callAll
+    queue.insert([&] { queue.insert([&calls] { calls.push_back(5); }); calls.push_back(4); });
+
+    queue.callAll();
+    ASSERT_EQ(calls, std::vector<int>({4, 3, 2, 1}));
+
+    queue.callAll();
+    ASSERT_EQ(calls, std::vector<int>({4, 3, 2, 1, 5}));
+}
+
+TEST(CallsQueue, DestroysCalls) {
+    auto& queue = CallsQueue::instance();
+    IntWithCounter::counter = 0;
+
+    {
+        auto counted = std::make_shared<IntWithCounter>();
+
+        for (int i = 0; i < 100; ++i) {
+            queue.insert([counted] {});
+        }
+    }
+
+    ASSERT_EQ(IntWithCounter::counter, 1);
+
+    queue.callAll();
+    ASSERT_EQ(IntWithCounter::counter, 0);
+}
+
+TEST(CallsQueue, MultithreadedInsert) {
+    constexpr size_t kThreads = 4;
+    constexpr size_t kCalls = 10000;
+
+    auto& queue = CallsQueue::instance();
+    std::atomic<size_t> finished{0};
+    size_t calls = 0;
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            for (size_t j = 0; j < kCalls; ++j) {
+                queue.insert([&calls] { ++calls; });
+            }
+
+            ++finished;
+        });
+    }
+
+    while (finished.load() != kThreads) {
+        queue.callAll();
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    queue.callAll();
+    ASSERT_EQ(calls, kThreads * kCalls);
+}
+
 TEST(FixedCircularBuffer, BasicCreation) {
     IntWithCounter::counter = 0;
     FixedCircularBuffer<IntWithCounter, 32> buffer;
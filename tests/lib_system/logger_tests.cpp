@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <lib/system/logger.hpp>
+
+namespace {
+const char* kLogPath = "./loggertests.log";
+
+struct Point {
+    int x;
+    int y;
+};
+
+std::ostream& operator<<(std::ostream& os, const Point& point) {
+    return os << '(' << point.x << ", " << point.y << ')';
+}
+
+logging::settings fileSettings() {
+    logging::settings settings;
+    settings["Sinks.File.Destination"] = "TextFile";
+    settings["Sinks.File.FileName"] = kLogPath;
+    settings["Sinks.File.Format"] = "%Severity% %Message%";
+    settings["Sinks.File.Filter"] = "%Severity% >= debug";
+    settings["Sinks.File.AutoFlush"] = true;
+
+    return settings;
+}
+
+std::vector<std::string> readLines() {
+    std::ifstream file(kLogPath);
+    std::vector<std::string> lines;
+
+    for (std::string line; std::getline(file, line);) {
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+}  // namespace
+
+TEST(Logger, FormatsRecordsInBackground) {
+    std::remove(kLogPath);
+    logger::initialize(fileSettings());
+
+    const std::string str = "string";
+    const char array[] = "array";
+
+    ASSERT_FALSE(logger::Record<>::isOn(logger::severity_level::trace));
+    ASSERT_TRUE(logger::Record<>::isOn(logger::severity_level::debug));
+
+    csdebug() << "numbers " << -1 << ' ' << 2u << ' ' << 0.5 << ' ' << true << ' ' << static_cast<uint8_t>('z');
+    csdetails() << "filtered out";
+    cslog() << str << ' ' << array << ' ' << std::string_view("view");
+    cswarning() << "point " << Point{1, 2} << ' ' << std::setw(3) << 7;
+
+    std::thread([] { cserror() << "from thread " << 42; }).join();
+
+    logger::cleanup();
+
+    const std::vector<std::string> expected = {
+        "debug numbers -1 2 0.5 1 z",
+        "info string array view",
+        "warning point (1, 2)   7",
+        "error from thread 42"
+    };
+
+    ASSERT_EQ(readLines(), expected);
+    ASSERT_EQ(logger::droppedRecords(), 0u);
+
+    std::remove(kLogPath);
+}
+
+TEST(Logger, NestedRecords) {
+    std::remove(kLogPath);
+    logger::initialize(fileSettings());
+
+    auto value = [] {
+        csdebug() << "inner";
+        return 1;
+    };
+
+    csdebug() << "outer " << value();
+
+    logger::cleanup();
+
+    const std::vector<std::string> expected = {"debug inner", "debug outer 1"};
+    ASSERT_EQ(readLines(), expected);
+
+    std::remove(kLogPath);
+}
+
+TEST(Logger, CompileTimeFilter) {
+    ASSERT_FALSE(logger::Record<logger::None>::isEnabled(logger::severity_level::fatal));
+    ASSERT_TRUE(logger::Record<>::isEnabled(logger::minSeverity()));
+}
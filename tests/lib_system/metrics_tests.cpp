@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <lib/system/metrics.hpp>
+
+namespace {
+// metrics are process wide, so every test enables them on its own
+struct EnableMetrics {
+    EnableMetrics() {
+        cs::metrics::setEnabled(true);
+    }
+
+    ~EnableMetrics() {
+        cs::metrics::setEnabled(false);
+    }
+};
+}  // namespace
+
+TEST(Metrics, CountersAreSummedOverThreads) {
+    EnableMetrics enable;
+
+    auto& counter = cs::metrics::counter("test_threads_total", "Increments from threads");
+    ASSERT_EQ(&counter, &cs::metrics::counter("test_threads_total", "Increments from threads"));
+
+    constexpr size_t kThreads = 16;
+    constexpr size_t kIncrements = 10000;
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&counter] {
+            for (size_t j = 0; j < kIncrements; ++j) {
+                counter.increment();
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(counter.value(), kThreads * kIncrements);
+}
+
+TEST(Metrics, DisabledMetricsAreNotUpdated) {
+    auto& counter = cs::metrics::counter("test_disabled_total", "Not updated");
+    auto& histogram = cs::metrics::histogram("test_disabled_values", "Not updated");
+
+    counter.increment();
+    histogram.observe(10);
+
+    ASSERT_EQ(counter.value(), 0u);
+    ASSERT_EQ(histogram.snapshot().count, 0u);
+}
+
+TEST(Metrics, HistogramQuantiles) {
+    EnableMetrics enable;
+
+    ASSERT_EQ(cs::metrics::Histogram::bucket(7), 7u);
+    ASSERT_EQ(cs::metrics::Histogram::bucket(8), 8u);
+    ASSERT_EQ(cs::metrics::Histogram::bucket(16), 16u);
+    ASSERT_EQ(cs::metrics::Histogram::bucket(17), 16u);
+    ASSERT_EQ(cs::metrics::Histogram::bucket(UINT64_MAX), cs::metrics::Histogram::kBucketsCount - 1);
+
+    for (size_t i = 0; i < cs::metrics::Histogram::kBucketsCount; ++i) {
+        ASSERT_EQ(cs::metrics::Histogram::bucket(cs::metrics::Histogram::lowerBound(i)), i);
+    }
+
+    auto& histogram = cs::metrics::histogram("test_quantiles", "Values from 1 to 1000000");
+
+    for (uint64_t value = 1; value <= 1000000; ++value) {
+        histogram.observe(value);
+    }
+
+    const auto snapshot = histogram.snapshot();
+    ASSERT_EQ(snapshot.count, 1000000u);
+    ASSERT_EQ(snapshot.sum, 500000500000u);
+
+    for (double quantile : {0.5, 0.9, 0.99}) {
+        const double expected = quantile * 1000000;
+        ASSERT_NEAR(snapshot.quantile(quantile), expected, expected * 0.125);
+    }
+}
+
+TEST(Metrics, PrometheusExposition) {
+    EnableMetrics enable;
+
+    cs::metrics::counter("test_packets_total", "Packets \"received\"", cs::metrics::label("direction", "rx")).increment(3);
+    cs::metrics::counter("test_packets_total", "Packets \"received\"", cs::metrics::label("direction", "tx")).increment(5);
+    cs::metrics::gauge("test_queue_size", "Queue size").set(-2);
+
+    auto& timer = cs::metrics::timer("test_call_seconds", "Call time", cs::metrics::label("method", "get\"Value\""));
+    timer.observe(std::chrono::milliseconds(2));
+
+    const auto text = cs::metrics::Registry::instance().exposition();
+
+    ASSERT_NE(text.find("# HELP test_packets_total Packets \"received\"\n"
+                        "# TYPE test_packets_total counter\n"
+                        "test_packets_total{direction=\"rx\"} 3\n"
+                        "test_packets_total{direction=\"tx\"} 5\n"), std::string::npos);
+
+    ASSERT_NE(text.find("# TYPE test_queue_size gauge\ntest_queue_size -2\n"), std::string::npos);
+
+    ASSERT_NE(text.find("# TYPE test_call_seconds summary\n"), std::string::npos);
+    ASSERT_NE(text.find("test_call_seconds{method=\"get\\\"Value\\\"\",quantile=\"0.5\"} 0.00"), std::string::npos);
+    ASSERT_NE(text.find("test_call_seconds_sum{method=\"get\\\"Value\\\"\"} 0.002\n"), std::string::npos);
+    ASSERT_NE(text.find("test_call_seconds_count{method=\"get\\\"Value\\\"\"} 1\n"), std::string::npos);
+
+    ASSERT_THROW(cs::metrics::gauge("test_packets_total", "Wrong type"), std::invalid_argument);
+}
@@ -4,6 +4,7 @@
 #include <lib/system/console.hpp>
 
 #include <string>
+#include <vector>
 
 TEST(Signals, BaseSignalUsingByPointer) {
     static const std::string expectedString = "Hello, world!";
@@ -401,3 +402,117 @@ TEST(Signals, ArgumentsCopy) {
     ASSERT_EQ(isCopied, true);
     ASSERT_EQ(checker.value, 0);
 }
+
+TEST(Signals, MethodSlotsKeepOrderAndDropArguments) {
+    class A {
+    public signals:
+        cs::Signal<void(int, const std::string&)> signal;
+    };
+
+    class Base {
+    public:
+        std::vector<std::string> calls;
+
+    public slots:
+        void onValue(int value) {
+            calls.push_back(std::to_string(value));
+        }
+    };
+
+    class B : public Base {
+    public slots:
+        void onBoth(int value, const std::string& message) {
+            calls.push_back(message + std::to_string(value));
+        }
+
+        void onNothing() {
+            calls.push_back("nothing");
+        }
+    };
+
+    A a;
+    B b;
+
+    cs::Connector::connect(&a.signal, &b, &B::onBoth);
+    cs::Connector::connect(&a.signal, [&b](int, const std::string&) { b.calls.push_back("lambda"); });
+    cs::Connector::connect(&a.signal, &b, &Base::onValue);
+    cs::Connector::connect<&B::onNothing>(&a.signal, &b);
+    cs::Connector::connect<&Base::onValue>(&a.signal, &b);
+
+    emit a.signal(7, "value ");
+
+    const std::vector<std::string> expected = {"value 7", "lambda", "7", "nothing", "7"};
+    ASSERT_EQ(b.calls, expected);
+}
+
+TEST(Signals, DisconnectsExactMethod) {
+    class A {
+    public signals:
+        cs::Signal<void()> signal;
+    };
+
+    class B {
+    public:
+        size_t first = 0;
+        size_t second = 0;
+
+    public slots:
+        void onFirst() {
+            ++first;
+        }
+
+        void onSecond() {
+            ++second;
+        }
+    };
+
+    A a;
+    B b;
+    B other;
+
+    cs::Connector::connect(&a.signal, &b, &B::onFirst);
+    cs::Connector::connect<&B::onSecond>(&a.signal, &b);
+
+    // same method of another object and another method of the same type are not found
+    ASSERT_FALSE(cs::Connector::disconnect(&a.signal, &other, &B::onSecond));
+    ASSERT_TRUE(cs::Connector::disconnect(&a.signal, &b, &B::onSecond));
+    ASSERT_FALSE(cs::Connector::disconnect(&a.signal, &b, &B::onSecond));
+
+    emit a.signal();
+
+    ASSERT_EQ(b.first, 1u);
+    ASSERT_EQ(b.second, 0u);
+    ASSERT_EQ(cs::Connector::callbacks(&a.signal), 1u);
+}
+
+TEST(Signals, FixedSignalCallsAllSlots) {
+    struct A {
+        int sum = 0;
+
+        void onAdd(int value, bool* called) {
+            sum += value;
+            *called = true;
+        }
+    };
+
+    struct B {
+        int calls = 0;
+
+        void onAny(int) {
+            ++calls;
+        }
+    };
+
+    A a;
+    B b;
+
+    cs::FixedSignal<void(int, bool*), &A::onAdd, &B::onAny, &B::onAny> signal(&a, &b, &b);
+
+    bool called = false;
+    emit signal(5, &called);
+    emit signal(6, &called);
+
+    ASSERT_TRUE(called);
+    ASSERT_EQ(a.sum, 11);
+    ASSERT_EQ(b.calls, 4);
+}
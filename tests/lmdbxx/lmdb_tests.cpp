@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <random>
+#include <thread>
 #include <vector>
 #include <utility>
 
@@ -362,3 +363,173 @@ TEST(Lmdbxx, DISABLED_InsertInDifferentTables) {
     ASSERT_TRUE(db->isKeyExists(key1, db1));
     ASSERT_TRUE(db->isKeyExists(key2, db2));
 }
+
+TEST(Lmdbxx, BatchCommitsOnce) {
+    auto db = createDb();
+    db->open();
+
+    std::string key = "Key";
+    std::string value = "Value";
+    constexpr size_t count = 100;
+
+    const size_t commits = db->commitsCount();
+
+    {
+        cs::Lmdb::Batch batch(*db);
+        ASSERT_TRUE(db->isBatchOpened());
+
+        for (size_t i = 0; i < count; ++i) {
+            db->insert(key + std::to_string(i), value + std::to_string(i));
+        }
+
+        // batch sees its own writes
+        ASSERT_EQ(db->size(), count);
+        ASSERT_EQ(db->value<std::string>(key + "7"), value + "7");
+        ASSERT_TRUE(db->remove(key + "0"));
+    }
+
+    ASSERT_FALSE(db->isBatchOpened());
+    ASSERT_EQ(db->commitsCount(), commits + 1);
+    ASSERT_EQ(db->size(), count - 1);
+    ASSERT_FALSE(db->isKeyExists(key + "0"));
+}
+
+TEST(Lmdbxx, BatchIsNotSeenByOtherThreads) {
+    auto db = createDb();
+    db->open();
+
+    db->insert(std::string("Key"), std::string("Committed"));
+
+    cs::Lmdb::Batch batch(*db);
+    db->insert(std::string("Key"), std::string("Batched"));
+
+    // readers of other threads check batch owner while it writes
+    std::thread reader([&db] {
+        for (size_t i = 0; i < 100; ++i) {
+            ASSERT_FALSE(db->isBatchOpened());
+            ASSERT_EQ(db->value<std::string>(std::string("Key")), "Committed");
+        }
+    });
+
+    for (size_t i = 0; i < 100; ++i) {
+        db->insert(std::string("Key") + std::to_string(i), std::string("Value"));
+    }
+
+    reader.join();
+    ASSERT_TRUE(db->isBatchOpened());
+}
+
+TEST(Lmdbxx, NestedBatchSpansTables) {
+    auto db = createDb();
+
+    db->setMaxDbs(2);
+    db->open();
+
+    const char* db1 = "Table1";
+    const char* db2 = "Table2";
+
+    db->createTable(db1);
+    db->createTable(db2);
+
+    const size_t commits = db->commitsCount();
+
+    {
+        cs::Lmdb::Batch batch(*db);
+        db->insert(std::string("Key1"), std::string("Value1"), db1);
+
+        {
+            cs::Lmdb::Batch nested(*db);
+            db->insert(std::string("Key2"), std::string("Value2"), db2);
+        }
+
+        // nested batch is commited with outer one
+        ASSERT_EQ(db->commitsCount(), commits);
+    }
+
+    ASSERT_EQ(db->commitsCount(), commits + 1);
+
+    ASSERT_EQ(db->size(db1), 1u);
+    ASSERT_EQ(db->size(db2), 1u);
+    ASSERT_EQ(db->value<std::string>(std::string("Key2"), db2), "Value2");
+}
+
+TEST(Lmdbxx, BatchGrowsMapSize) {
+    bool isFailed = false;
+    auto db = createDb();
+
+    cs::Connector::connect(&db->failed, [&](const auto& e) {
+        cs::Console::writeLine("Error in database ", e.what());
+        isFailed = true;
+    });
+
+    db->setMapSize(9000);
+    db->setIncreaseSize(50000);
+    db->open();
+
+    std::string key = "Key";
+    std::string value = "Value";
+    constexpr size_t count = 10000;
+
+    {
+        cs::Lmdb::Batch batch(*db);
+
+        for (size_t i = 0; i < count; ++i) {
+            db->insert(key + std::to_string(i), value + std::to_string(i));
+        }
+    }
+
+    ASSERT_FALSE(isFailed);
+    ASSERT_EQ(db->size(), count);
+    ASSERT_GT(db->commitsCount(), 1u);
+}
+
+TEST(Lmdbxx, FloorOfEmptyTable) {
+    auto db = createDb();
+    db->open();
+
+    auto [key, value] = db->floor<std::string, std::string>(std::string("Key"));
+
+    ASSERT_TRUE(key.empty());
+    ASSERT_TRUE(value.empty());
+}
+
+TEST(Lmdbxx, FloorFindsGreatestNotGreaterKey) {
+    auto db = createDb();
+    db->open();
+
+    db->insert(std::string("Key2"), std::string("Value2"));
+    db->insert(std::string("Key4"), std::string("Value4"));
+    db->insert(std::string("Key6"), std::string("Value6"));
+
+    {
+        // exact key
+        auto [key, value] = db->floor<std::string, std::string>(std::string("Key4"));
+
+        ASSERT_EQ(key, "Key4");
+        ASSERT_EQ(value, "Value4");
+    }
+
+    {
+        // key between entries
+        auto [key, value] = db->floor<std::string, std::string>(std::string("Key5"));
+
+        ASSERT_EQ(key, "Key4");
+        ASSERT_EQ(value, "Value4");
+    }
+
+    {
+        // key above the last entry
+        auto [key, value] = db->floor<std::string, std::string>(std::string("Key9"));
+
+        ASSERT_EQ(key, "Key6");
+        ASSERT_EQ(value, "Value6");
+    }
+
+    {
+        // key below the first entry
+        auto [key, value] = db->floor<std::string, std::string>(std::string("Key1"));
+
+        ASSERT_TRUE(key.empty());
+        ASSERT_TRUE(value.empty());
+    }
+}